@@ -0,0 +1,321 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_ARIEL_BATCH_H
+#define SST_ARIEL_BATCH_H
+
+/*
+ * Batched instruction records for the Ariel tunnel.
+ *
+ * Like ariel_shmem.h, this file is compiled both into Ariel and into the
+ * Pin3 pintool and must stay PinCRT compatible (no RTTI, no C++11).
+ *
+ * Instead of one ArielCommand per START/READ/WRITE/END/NOOP, the pintool
+ * packs a thread's records into ARIEL_BATCH commands. Each record is a
+ * header byte, whose low three bits are the record type, followed by
+ * LEB128 varints:
+ *
+ *   START  ip delta, [instClass, simdElemCount]   (if ARIEL_BATCH_NEW_CLASS)
+ *   READ   address delta, [size]                  (if ARIEL_BATCH_NEW_SIZE)
+ *   WRITE  address delta, [size], [payload]       (if ARIEL_BATCH_HAS_PAYLOAD)
+ *   END    -
+ *   NOOP   ip delta
+ *
+ * Deltas are zigzag encoded and taken against the previous value sent on
+ * the same tunnel buffer, so the batches for a buffer have to be decoded
+ * in the order they were written, by one decoder. A write payload is
+ * min(size, ARIEL_MAX_PAYLOAD_SIZE) raw bytes and is only sent when the
+ * pintool is tracing write payloads.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+enum ArielBatchRecord_t {
+    ARIEL_BATCH_START = 0,
+    ARIEL_BATCH_READ = 1,
+    ARIEL_BATCH_WRITE = 2,
+    ARIEL_BATCH_END = 3,
+    ARIEL_BATCH_NOOP = 4,
+};
+
+#define ARIEL_BATCH_TYPE_MASK    0x07
+#define ARIEL_BATCH_NEW_CLASS    0x08
+#define ARIEL_BATCH_NEW_SIZE     0x08
+#define ARIEL_BATCH_HAS_PAYLOAD  0x10
+
+// Largest record: a WRITE with a 64-bit delta, a 32-bit size and a full payload
+#define ARIEL_BATCH_MAX_RECORD (1 + 10 + 5 + ARIEL_MAX_PAYLOAD_SIZE)
+
+// Values the next record's deltas are taken against
+struct ArielBatchState {
+    uint64_t instPtr;
+    uint64_t addr;
+    uint32_t size;
+    uint32_t instClass;
+    uint32_t simdElemCount;
+
+    void reset() {
+        instPtr = 0;
+        addr = 0;
+        size = 0;
+        instClass = ARIEL_INST_UNKNOWN;
+        simdElemCount = 1;
+    }
+};
+
+class ArielBatchEncoder {
+public:
+    ArielBatchEncoder() {
+        state.reset();
+        clear();
+    }
+
+    bool empty() const { return msg.batch.count == 0; }
+    uint32_t getRecordCount() const { return msg.batch.count; }
+
+    /*
+     * Each append returns false, and leaves the batch unchanged, when the
+     * record does not fit. The caller then sends getMessage(), calls clear()
+     * and appends the record again; every record fits in an empty batch.
+     */
+    bool appendStart(uint64_t ip, uint32_t instClass, uint32_t simdElemCount) {
+        uint8_t rec[ARIEL_BATCH_MAX_RECORD];
+        uint32_t len = 1;
+        rec[0] = ARIEL_BATCH_START;
+        len += putVarint(&rec[len], zigzag(ip - state.instPtr));
+        const bool newClass = (instClass != state.instClass) || (simdElemCount != state.simdElemCount);
+        if ( newClass ) {
+            rec[0] |= ARIEL_BATCH_NEW_CLASS;
+            len += putVarint(&rec[len], instClass);
+            len += putVarint(&rec[len], simdElemCount);
+        }
+        if ( !commit(rec, len) ) return false;
+
+        state.instPtr = ip;
+        state.instClass = instClass;
+        state.simdElemCount = simdElemCount;
+        return true;
+    }
+
+    bool appendRead(uint64_t addr, uint32_t size) {
+        return appendAccess(ARIEL_BATCH_READ, addr, size, NULL);
+    }
+
+    // payload is NULL when write payloads are not being traced
+    bool appendWrite(uint64_t addr, uint32_t size, const uint8_t* payload) {
+        return appendAccess(ARIEL_BATCH_WRITE, addr, size, payload);
+    }
+
+    bool appendEnd() {
+        const uint8_t rec = ARIEL_BATCH_END;
+        return commit(&rec, 1);
+    }
+
+    bool appendNoOp(uint64_t ip) {
+        uint8_t rec[11];
+        uint32_t len = 1;
+        rec[0] = ARIEL_BATCH_NOOP;
+        len += putVarint(&rec[len], zigzag(ip - state.instPtr));
+        if ( !commit(rec, len) ) return false;
+
+        state.instPtr = ip;
+        return true;
+    }
+
+    const ArielCommand& getMessage() const { return msg; }
+
+    // Start a new, empty batch. Delta state carries over to the next batch
+    void clear() {
+        msg.command = ARIEL_BATCH;
+        msg.instPtr = 0;
+        msg.batch.count = 0;
+        msg.batch.bytes = 0;
+    }
+
+private:
+    ArielCommand msg;
+    ArielBatchState state;
+
+    bool appendAccess(uint8_t type, uint64_t addr, uint32_t size, const uint8_t* payload) {
+        uint8_t rec[ARIEL_BATCH_MAX_RECORD];
+        uint32_t len = 1;
+        rec[0] = type;
+        len += putVarint(&rec[len], zigzag(addr - state.addr));
+        if ( size != state.size ) {
+            rec[0] |= ARIEL_BATCH_NEW_SIZE;
+            len += putVarint(&rec[len], size);
+        }
+        if ( NULL != payload ) {
+            const uint32_t payloadLen = size < ARIEL_MAX_PAYLOAD_SIZE ? size : ARIEL_MAX_PAYLOAD_SIZE;
+            rec[0] |= ARIEL_BATCH_HAS_PAYLOAD;
+            memcpy(&rec[len], payload, payloadLen);
+            len += payloadLen;
+        }
+        if ( !commit(rec, len) ) return false;
+
+        state.addr = addr;
+        state.size = size;
+        return true;
+    }
+
+    bool commit(const uint8_t* rec, uint32_t len) {
+        if ( msg.batch.bytes + len > ARIEL_MAX_BATCH_SIZE ) return false;
+        memcpy(&msg.batch.data[msg.batch.bytes], rec, len);
+        msg.batch.bytes += len;
+        msg.batch.count++;
+        return true;
+    }
+
+    static uint64_t zigzag(uint64_t delta) {
+        return (delta << 1) ^ (uint64_t) (((int64_t) delta) >> 63);
+    }
+
+    static uint32_t putVarint(uint8_t* out, uint64_t value) {
+        uint32_t len = 0;
+        while ( value >= 0x80 ) {
+            out[len++] = (uint8_t) (value | 0x80);
+            value >>= 7;
+        }
+        out[len++] = (uint8_t) value;
+        return len;
+    }
+};
+
+struct ArielBatchRecord {
+    ArielBatchRecord_t type;
+    uint64_t instPtr;
+    uint64_t addr;
+    uint32_t size;
+    uint32_t instClass;
+    uint32_t simdElemCount;
+    const uint8_t* payload;     // Write data, zeroes if the write carried none
+};
+
+class ArielBatchDecoder {
+public:
+    ArielBatchDecoder() : data(NULL), bytes(0), pos(0), remaining(0) {
+        state.reset();
+        memset(zeroPayload, 0, sizeof(zeroPayload));
+    }
+
+    /*
+     * Start decoding a batch. The command must stay alive, and unmodified,
+     * until next() returns false; record payloads point into it.
+     */
+    void begin(const ArielCommand& ac) {
+        data = &ac.batch.data[0];
+        bytes = ac.batch.bytes < ARIEL_MAX_BATCH_SIZE ? ac.batch.bytes : ARIEL_MAX_BATCH_SIZE;
+        pos = 0;
+        remaining = ac.batch.count;
+    }
+
+    // Decode the next record. Returns false at the end of the batch or on a malformed record
+    bool next(ArielBatchRecord* rec) {
+        if ( 0 == remaining || pos >= bytes ) return false;
+
+        const uint8_t header = data[pos++];
+        uint64_t value = 0;
+        rec->type = (ArielBatchRecord_t) (header & ARIEL_BATCH_TYPE_MASK);
+
+        switch ( rec->type ) {
+        case ARIEL_BATCH_START:
+            if ( !getVarint(&value) ) return false;
+            state.instPtr += unzigzag(value);
+            if ( header & ARIEL_BATCH_NEW_CLASS ) {
+                if ( !getVarint(&value) ) return false;
+                state.instClass = (uint32_t) value;
+                if ( !getVarint(&value) ) return false;
+                state.simdElemCount = (uint32_t) value;
+            }
+            break;
+
+        case ARIEL_BATCH_READ:
+        case ARIEL_BATCH_WRITE:
+            if ( !getVarint(&value) ) return false;
+            state.addr += unzigzag(value);
+            if ( header & ARIEL_BATCH_NEW_SIZE ) {
+                if ( !getVarint(&value) ) return false;
+                state.size = (uint32_t) value;
+            }
+            rec->payload = zeroPayload;
+            if ( header & ARIEL_BATCH_HAS_PAYLOAD ) {
+                const uint32_t payloadLen = state.size < ARIEL_MAX_PAYLOAD_SIZE ? state.size : ARIEL_MAX_PAYLOAD_SIZE;
+                if ( pos + payloadLen > bytes ) return false;
+                rec->payload = &data[pos];
+                pos += payloadLen;
+            }
+            break;
+
+        case ARIEL_BATCH_END:
+            break;
+
+        case ARIEL_BATCH_NOOP:
+            if ( !getVarint(&value) ) return false;
+            state.instPtr += unzigzag(value);
+            break;
+
+        default:
+            return false;
+        }
+
+        rec->instPtr = state.instPtr;
+        rec->addr = state.addr;
+        rec->size = state.size;
+        rec->instClass = state.instClass;
+        rec->simdElemCount = state.simdElemCount;
+        remaining--;
+        return true;
+    }
+
+    // Records left in the current batch; non-zero after next() fails on a malformed batch
+    uint32_t getRemaining() const { return remaining; }
+
+private:
+    const uint8_t* data;
+    uint32_t bytes;
+    uint32_t pos;
+    uint32_t remaining;
+    ArielBatchState state;
+    uint8_t zeroPayload[ARIEL_MAX_PAYLOAD_SIZE];
+
+    static uint64_t unzigzag(uint64_t value) {
+        return (value >> 1) ^ (0 - (value & 1));
+    }
+
+    bool getVarint(uint64_t* value) {
+        uint64_t result = 0;
+        uint32_t shift = 0;
+        while ( pos < bytes && shift < 64 ) {
+            const uint8_t byte = data[pos++];
+            result |= ((uint64_t) (byte & 0x7f)) << shift;
+            if ( 0 == (byte & 0x80) ) {
+                *value = result;
+                return true;
+            }
+            shift += 7;
+        }
+        return false;
+    }
+};
+
+}
+}
+
+#endif
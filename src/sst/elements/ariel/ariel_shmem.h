@@ -42,6 +42,9 @@
 #endif
 
 #define ARIEL_MAX_PAYLOAD_SIZE 64
+// Record bytes carried by one ARIEL_BATCH command, sized so that a batch
+// fits in the space of an instruction command (see ariel_batch.h)
+#define ARIEL_MAX_BATCH_SIZE (ARIEL_MAX_PAYLOAD_SIZE + 20)
 
 namespace SST {
 namespace ArielComponent {
@@ -66,6 +69,7 @@ enum ArielShmemCmd_t {
     ARIEL_ISSUE_RTL = 150,
     ARIEL_FLUSHLINE_INSTRUCTION = 154,
     ARIEL_FENCE_INSTRUCTION = 155,
+    ARIEL_BATCH = 160,
 };
 
 #ifdef HAVE_CUDA
@@ -139,6 +143,11 @@ struct ArielCommand {
             uint32_t simdElemCount;
             uint8_t  payload[ARIEL_MAX_PAYLOAD_SIZE];
         } inst;
+        struct {
+            uint16_t count;
+            uint16_t bytes;
+            uint8_t  data[ARIEL_MAX_BATCH_SIZE];
+        } batch;
         struct {
             uint64_t vaddr;
             uint64_t alloc_len;
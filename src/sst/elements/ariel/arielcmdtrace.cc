@@ -0,0 +1,342 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "arielcmdtrace.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+using namespace SST::ArielComponent;
+
+ArielCommandTraceWriter::ArielCommandTraceWriter(Output* out, const std::string& prefix, uint32_t core) :
+        output(out), emptyPolls(0) {
+
+    path = getTracePath(prefix, core);
+
+#ifdef HAVE_LIBZ
+    traceFile = gzopen(path.c_str(), "wb1");
+#else
+    traceFile = fopen(path.c_str(), "wb");
+#endif
+
+    if(NULL == traceFile) {
+        output->fatal(CALL_INFO, -1, "Error: unable to open command trace %s for writing\n", path.c_str());
+    }
+
+    ArielCommandTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ARIEL_CMD_TRACE_MAGIC, sizeof(header.magic));
+    header.version = ARIEL_CMD_TRACE_VERSION;
+    header.core = core;
+    header.commandSize = sizeof(ArielCommand);
+    write(&header, sizeof(header));
+
+    output->verbose(CALL_INFO, 1, 0, "Recording core %" PRIu32 " command stream to %s\n", core, path.c_str());
+}
+
+ArielCommandTraceWriter::~ArielCommandTraceWriter() {
+    flushEmptyPolls();
+#ifdef HAVE_LIBZ
+    gzclose(traceFile);
+#else
+    fclose(traceFile);
+#endif
+}
+
+std::string ArielCommandTraceWriter::getTracePath(const std::string& prefix, uint32_t core) {
+#ifdef HAVE_LIBZ
+    return prefix + "-" + std::to_string(core) + ".cmd.gz";
+#else
+    return prefix + "-" + std::to_string(core) + ".cmd";
+#endif
+}
+
+void ArielCommandTraceWriter::recordCommand(const ArielCommand& ac) {
+    flushEmptyPolls();
+
+    const uint8_t type = ARIEL_CMD_TRACE_COMMAND;
+    const uint32_t length = getCommandLength(ac);
+    write(&type, sizeof(type));
+    write(&length, sizeof(length));
+    write(&ac, length);
+}
+
+void ArielCommandTraceWriter::flushEmptyPolls() {
+    if(0 == emptyPolls) {
+        return;
+    }
+
+    const uint8_t type = ARIEL_CMD_TRACE_EMPTY;
+    write(&type, sizeof(type));
+    write(&emptyPolls, sizeof(emptyPolls));
+    emptyPolls = 0;
+}
+
+void ArielCommandTraceWriter::write(const void* data, size_t length) {
+#ifdef HAVE_LIBZ
+    const bool ok = gzwrite(traceFile, data, length) == (int) length;
+#else
+    const bool ok = fwrite(data, 1, length, traceFile) == length;
+#endif
+    if(!ok) {
+        output->fatal(CALL_INFO, -1, "Error: unable to write to command trace %s\n", path.c_str());
+    }
+}
+
+// Only the part of the union the command uses is kept
+uint32_t ArielCommandTraceWriter::getCommandLength(const ArielCommand& ac) {
+    const char* base = (const char*) &ac;
+
+    switch(ac.command) {
+        case ARIEL_START_INSTRUCTION:
+        case ARIEL_END_INSTRUCTION:
+        case ARIEL_PERFORM_READ:
+        case ARIEL_NOOP:
+            return (const char*) &ac.inst.payload[0] - base;
+
+        case ARIEL_PERFORM_WRITE:
+            return (const char*) &ac.inst.payload[ARIEL_MAX_PAYLOAD_SIZE] - base;
+
+        case ARIEL_BATCH:
+            return (const char*) &ac.batch.data[std::min((uint32_t) ac.batch.bytes, (uint32_t) ARIEL_MAX_BATCH_SIZE)] - base;
+
+        default:
+            return sizeof(ArielCommand);
+    }
+}
+
+ArielCommandTraceReader::ArielCommandTraceReader(Output* out, const std::string& prefix, uint32_t core,
+        size_t chunkSz, uint32_t maxChk) :
+        output(out), coreID(core), emptyPolls(0), exhausted(false),
+        chunkSize(chunkSz), maxChunks(maxChk), eof(false), readError(false), stopping(false), currentPos(0) {
+
+    path = ArielCommandTraceWriter::getTracePath(prefix, core);
+
+    // Also accept an uncompressed trace; gzopen reads those transparently
+    if(access(path.c_str(), R_OK) != 0) {
+        path = prefix + "-" + std::to_string(core) + ".cmd";
+    }
+
+#ifdef HAVE_LIBZ
+    traceFile = gzopen(path.c_str(), "rb");
+    if(NULL != traceFile) {
+        gzbuffer(traceFile, 256 * 1024);
+    }
+#else
+    traceFile = fopen(path.c_str(), "rb");
+#endif
+
+    if(NULL == traceFile) {
+        output->fatal(CALL_INFO, -1, "Error: unable to open command trace %s for core %" PRIu32 "\n", path.c_str(), core);
+    }
+
+    if(0 == chunkSize) chunkSize = 1;
+    if(0 == maxChunks) maxChunks = 1;
+
+    worker = std::thread(&ArielCommandTraceReader::readAhead, this);
+
+    ArielCommandTraceHeader header;
+    if(!readBytes(&header, sizeof(header)) || memcmp(header.magic, ARIEL_CMD_TRACE_MAGIC, sizeof(header.magic)) != 0) {
+        output->fatal(CALL_INFO, -1, "Error: %s is not an Ariel command trace\n", path.c_str());
+    }
+
+    if(ARIEL_CMD_TRACE_VERSION != header.version || sizeof(ArielCommand) != header.commandSize) {
+        output->fatal(CALL_INFO, -1, "Error: command trace %s was recorded by an incompatible build (version %" PRIu32 ", command size %" PRIu32 ", expected version %d, command size %" PRIu32 ")\n",
+                path.c_str(), header.version, header.commandSize, ARIEL_CMD_TRACE_VERSION, (uint32_t) sizeof(ArielCommand));
+    }
+
+    if(coreID != header.core) {
+        output->verbose(CALL_INFO, 1, 0, "Warning: command trace %s was recorded for core %" PRIu32 " and is replayed on core %" PRIu32 "\n",
+                path.c_str(), header.core, coreID);
+    }
+
+    output->verbose(CALL_INFO, 1, 0, "Replaying core %" PRIu32 " command stream from %s\n", coreID, path.c_str());
+}
+
+ArielCommandTraceReader::~ArielCommandTraceReader() {
+    {
+        std::lock_guard<std::mutex> guard(chunkLock);
+        stopping = true;
+    }
+    chunkSpace.notify_all();
+    worker.join();
+
+#ifdef HAVE_LIBZ
+    gzclose(traceFile);
+#else
+    fclose(traceFile);
+#endif
+}
+
+bool ArielCommandTraceReader::readCommandNB(ArielCommand* ac) {
+    if(emptyPolls > 0) {
+        emptyPolls--;
+        return false;
+    }
+
+    if(exhausted) {
+        return false;
+    }
+
+    if(!nextRecord(ac)) {
+        exhausted = true;
+        return false;
+    }
+
+    // nextRecord sets emptyPolls when it reads an empty-poll run
+    if(emptyPolls > 0) {
+        emptyPolls--;
+        return false;
+    }
+
+    return true;
+}
+
+ArielCommand ArielCommandTraceReader::readCommand() {
+    ArielCommand ac;
+
+    // Blocking reads are never recorded as empty polls, but skip any just in case
+    emptyPolls = 0;
+    while(!exhausted) {
+        if(!nextRecord(&ac)) {
+            exhausted = true;
+            break;
+        }
+        if(0 == emptyPolls) {
+            return ac;
+        }
+        emptyPolls = 0;
+    }
+
+    output->fatal(CALL_INFO, -1, "Error: command trace %s ended in the middle of an instruction\n", path.c_str());
+    return ac;
+}
+
+// Reads one record. For an empty-poll record this sets emptyPolls and leaves ac untouched
+bool ArielCommandTraceReader::nextRecord(ArielCommand* ac) {
+    uint8_t type;
+    uint32_t value;
+
+    if(!readBytes(&type, sizeof(type))) {
+        return false;
+    }
+
+    if(!readBytes(&value, sizeof(value))) {
+        output->fatal(CALL_INFO, -1, "Error: command trace %s is truncated\n", path.c_str());
+    }
+
+    switch(type) {
+        case ARIEL_CMD_TRACE_EMPTY:
+            emptyPolls = value;
+            return true;
+
+        case ARIEL_CMD_TRACE_COMMAND:
+            if(value > sizeof(ArielCommand)) {
+                output->fatal(CALL_INFO, -1, "Error: command trace %s holds a %" PRIu32 " byte command, more than the %" PRIu32 " bytes of an ArielCommand\n",
+                        path.c_str(), value, (uint32_t) sizeof(ArielCommand));
+            }
+            memset(ac, 0, sizeof(ArielCommand));
+            if(!readBytes(ac, value)) {
+                output->fatal(CALL_INFO, -1, "Error: command trace %s is truncated\n", path.c_str());
+            }
+            return true;
+
+        default:
+            output->fatal(CALL_INFO, -1, "Error: command trace %s holds an unknown record type (%d)\n", path.c_str(), (int) type);
+            return false;
+    }
+}
+
+bool ArielCommandTraceReader::readBytes(void* dest, size_t length) {
+    char* out = (char*) dest;
+
+    while(length > 0) {
+        if(currentPos == current.size() && !nextChunk()) {
+            return false;
+        }
+
+        const size_t n = std::min(length, current.size() - currentPos);
+        memcpy(out, &current[currentPos], n);
+        currentPos += n;
+        out += n;
+        length -= n;
+    }
+
+    return true;
+}
+
+bool ArielCommandTraceReader::nextChunk() {
+    std::unique_lock<std::mutex> guard(chunkLock);
+    chunkReady.wait(guard, [this] { return !chunks.empty() || eof; });
+
+    if(chunks.empty()) {
+        if(readError) {
+            output->fatal(CALL_INFO, -1, "Error: unable to read command trace %s\n", path.c_str());
+        }
+        return false;
+    }
+
+    freeChunks.push_back(std::move(current));
+    current = std::move(chunks.front());
+    chunks.pop_front();
+    currentPos = 0;
+
+    guard.unlock();
+    chunkSpace.notify_one();
+    return true;
+}
+
+// Read-ahead thread: inflate the trace into at most maxChunks chunks ahead of the reader
+void ArielCommandTraceReader::readAhead() {
+    while(true) {
+        std::vector<char> chunk;
+        {
+            std::unique_lock<std::mutex> guard(chunkLock);
+            chunkSpace.wait(guard, [this] { return chunks.size() < maxChunks || stopping; });
+            if(stopping) {
+                return;
+            }
+            if(!freeChunks.empty()) {
+                chunk = std::move(freeChunks.back());
+                freeChunks.pop_back();
+            }
+        }
+
+        chunk.resize(chunkSize);
+#ifdef HAVE_LIBZ
+        const int count = gzread(traceFile, chunk.data(), chunkSize);
+        const bool failed = count < 0;
+#else
+        const size_t count = fread(chunk.data(), 1, chunkSize, traceFile);
+        const bool failed = ferror(traceFile) != 0;
+#endif
+
+        std::lock_guard<std::mutex> guard(chunkLock);
+        if(failed || count <= 0) {
+            readError = failed;
+            eof = true;
+            chunkReady.notify_one();
+            return;
+        }
+
+        chunk.resize(count);
+        chunks.push_back(std::move(chunk));
+        chunkReady.notify_one();
+    }
+}
@@ -0,0 +1,154 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_ARIEL_COMMAND_TRACE
+#define _H_SST_ARIEL_COMMAND_TRACE
+
+#include <sst/core/output.h>
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include "zlib.h"
+#endif
+
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Per-core capture of the ArielCommand stream an ArielCore reads from its
+ * tunnel, written when ArielCPU's "commandtrace" parameter is set and played
+ * back by ariel.frontend.replay.
+ *
+ * After the header, a trace is a sequence of records:
+ *   ARIEL_CMD_TRACE_COMMAND  uint32 length, then the first length bytes of the ArielCommand
+ *   ARIEL_CMD_TRACE_EMPTY    uint32 count, the core polled an empty tunnel count times
+ *
+ * Empty polls are kept so that replay refills the core's queue on the same
+ * cycles as the recorded run did; that is what makes the replayed statistics
+ * match. Commands are stored in ArielCommand's in-memory layout, so a trace
+ * can only be replayed by a build with the same layout (checked on open).
+ * Traces are gzip compressed when Ariel is built with libz.
+ */
+
+#define ARIEL_CMD_TRACE_MAGIC   "ARIELCMD"
+#define ARIEL_CMD_TRACE_VERSION 1
+
+enum ArielCommandTraceRecord_t {
+    ARIEL_CMD_TRACE_COMMAND = 1,
+    ARIEL_CMD_TRACE_EMPTY = 2,
+};
+
+struct ArielCommandTraceHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t core;
+    uint32_t commandSize;
+    uint32_t reserved;
+};
+
+class ArielCommandTraceWriter {
+public:
+    ArielCommandTraceWriter(Output* out, const std::string& prefix, uint32_t core);
+    ~ArielCommandTraceWriter();
+
+    void recordCommand(const ArielCommand& ac);
+    void recordEmptyPoll() { if(++emptyPolls == UINT32_MAX) flushEmptyPolls(); }
+
+    static std::string getTracePath(const std::string& prefix, uint32_t core);
+
+private:
+    void flushEmptyPolls();
+    void write(const void* data, size_t length);
+    static uint32_t getCommandLength(const ArielCommand& ac);
+
+    Output* output;
+    std::string path;
+    uint32_t emptyPolls;
+#ifdef HAVE_LIBZ
+    gzFile traceFile;
+#else
+    FILE* traceFile;
+#endif
+};
+
+/*
+ * Reads a trace back. A helper thread decompresses the file into a bounded
+ * queue of chunks ahead of the simulation, so each core's trace is inflated
+ * in parallel with the others and with the simulation itself.
+ */
+class ArielCommandTraceReader {
+public:
+    ArielCommandTraceReader(Output* out, const std::string& prefix, uint32_t core,
+            size_t chunkSize, uint32_t maxChunks);
+    ~ArielCommandTraceReader();
+
+    // Same contract as ArielTunnel::readMessageNB. Returns false for each
+    // recorded empty poll and once the trace is exhausted
+    bool readCommandNB(ArielCommand* ac);
+
+    // Same contract as ArielTunnel::readMessage
+    ArielCommand readCommand();
+
+private:
+    bool nextRecord(ArielCommand* ac);
+    bool readBytes(void* dest, size_t length);
+    bool nextChunk();
+    void readAhead();
+
+    Output* output;
+    std::string path;
+    uint32_t coreID;
+    uint32_t emptyPolls;
+    bool exhausted;
+
+#ifdef HAVE_LIBZ
+    gzFile traceFile;
+#else
+    FILE* traceFile;
+#endif
+
+    // Shared with the read-ahead thread
+    std::thread worker;
+    std::mutex chunkLock;
+    std::condition_variable chunkReady;
+    std::condition_variable chunkSpace;
+    std::deque<std::vector<char>> chunks;
+    std::vector<std::vector<char>> freeChunks;
+    size_t chunkSize;
+    uint32_t maxChunks;
+    bool eof;
+    bool readError;
+    bool stopping;
+
+    // Owned by the simulation thread
+    std::vector<char> current;
+    size_t currentPos;
+};
+
+}
+}
+
+#endif
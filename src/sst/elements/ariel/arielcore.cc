@@ -29,6 +29,10 @@ using namespace SST::ArielComponent;
 
 #define ARIEL_CORE_VERBOSE(LEVEL, OUTPUT) if(verbosity >= (LEVEL)) OUTPUT
 
+// ariel_batch.h is PinCRT compatible and cannot check these itself
+static_assert(ARIEL_BATCH_MAX_RECORD <= ARIEL_MAX_BATCH_SIZE, "A record must fit in an empty batch");
+static_assert(sizeof(((ArielCommand*) 0)->batch) <= sizeof(((ArielCommand*) 0)->inst), "A batch must not grow ArielCommand");
+
 
 ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
 #ifdef HAVE_CUDA
@@ -59,8 +63,10 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     memmgr = memMgr;
 
     writePayloads = params.find<int>("writepayloadtrace") == 0 ? false : true;
-    coreQ = new std::queue<ArielEvent*>();
-    pendingTransactions = new std::unordered_map<StandardMem::Request::id_t, StandardMem::Request*>();
+    // A refill stops once the queue reaches maxQLength, but the last command read
+    // can still add up to a batch's worth of events, so leave room for that
+    coreQ = new ArielEventRing(maxQLength + ARIEL_MAX_BATCH_SIZE);
+    pendingTransactions = new ArielPendingTable(maxPendingTransactions);
     pending_transaction_count = 0;
 
 #ifdef HAVE_CUDA
@@ -125,6 +131,14 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
         traceGen->setCoreID(coreID);
     }
 
+    replay = NULL;
+    recorder = NULL;
+
+    std::string commandTracePrefix = params.find<std::string>("commandtrace", "");
+    if("" != commandTracePrefix) {
+        recorder = new ArielCommandTraceWriter(output, commandTracePrefix, coreID);
+    }
+
     currentCycles = 0;
 }
 
@@ -137,7 +151,10 @@ ArielCore::~ArielCore() {
         delete traceGen;
     }
 
+    delete recorder;
     delete stdMemHandlers;
+    delete coreQ;
+    delete pendingTransactions;
 }
 
 void ArielCore::setCacheLink(StandardMem* newLink) {
@@ -179,7 +196,7 @@ void ArielCore::commitReadEvent(const uint64_t address,
         }else {
 #endif
             pending_transaction_count++;
-            pendingTransactions->insert( std::pair<StandardMem::Request::id_t, StandardMem::Request*>(req->getID(), req) );
+            pendingTransactions->insert(req->getID(), req);
 #ifdef HAVE_CUDA
         }
 #endif
@@ -227,7 +244,7 @@ void ArielCore::commitWriteEvent(const uint64_t address,
         } else{
 #endif
             pending_transaction_count++;
-            pendingTransactions->insert( std::pair<StandardMem::Request::id_t, StandardMem::Request*>(req->getID(), req) );
+            pendingTransactions->insert(req->getID(), req);
 #ifdef HAVE_CUDA
         }
 #endif
@@ -251,7 +268,7 @@ void ArielCore::commitFlushEvent(const uint64_t address,
         /*  Todo: should the request specify the physical address, or the virtual address? */
         StandardMem::Request *req = new StandardMem::FlushAddr( address, length, true, std::numeric_limits<uint32_t>::max());
         pending_transaction_count++;
-        pendingTransactions->insert( std::pair<StandardMem::Request::id_t, StandardMem::Request*>(req->getID(), req) );
+        pendingTransactions->insert(req->getID(), req);
 
         cacheLink->send(req);
         statFlushRequests->addData(1);
@@ -261,7 +278,6 @@ void ArielCore::commitFlushEvent(const uint64_t address,
 void ArielCore::handleEvent(StandardMem::Request* event) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " handling a memory event.\n", coreID));
     StandardMem::Request::id_t mev_id = event->getID();
-    auto find_entry = pendingTransactions->find(mev_id);
 
 #ifdef HAVE_CUDA
     if(pendingGpuTransactions->find(mev_id) != pendingGpuTransactions->end()){
@@ -476,14 +492,14 @@ void ArielCore::handleEvent(StandardMem::Request* event) {
                 }
             }
         }
-    }else if(find_entry != pendingTransactions->end()) {
+    }else if(pendingTransactions->contains(mev_id)) {
 #else
-    if(find_entry != pendingTransactions->end()) {
+    if(pendingTransactions->contains(mev_id)) {
 #endif
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Correctly identified event in pending transactions, removing from list, before there are: %" PRIu32 " transactions pending.\n",
                             (uint32_t) pendingTransactions->size()));
 
-        pendingTransactions->erase(find_entry);
+        pendingTransactions->erase(mev_id);
         pending_transaction_count--;
         if(isCoreFenced() && pending_transaction_count == 0)
             unfence();
@@ -552,6 +568,10 @@ void ArielCore::finishCore() {
         delete traceGen;
         traceGen = NULL;
     }
+
+    // Likewise flush the command trace
+    delete recorder;
+    recorder = NULL;
 }
 
 void ArielCore::halt(){
@@ -579,7 +599,7 @@ void ArielCore::setPhysicalAddresses(SST::Event *ev){
     uint64_t addr_offset;
     uint64_t current_transfer;
     current_transfer = (getRemainingTransfer() > 64) ? 64 : getRemainingTransfer();
-    phy_addr = memmgr->translateAddress(getCurrentAddress());
+    phy_addr = memmgr->translateAddress(getCurrentAddress(), coreID);
     addr_offset = phy_addr % ((uint64_t) cacheLineSize);
     if((addr_offset + current_transfer <= cacheLineSize)){
         physicalAddresses.push_back(phy_addr);
@@ -589,7 +609,7 @@ void ArielCore::setPhysicalAddresses(SST::Event *ev){
         uint64_t rightAddr = (getCurrentAddress() + ((uint64_t) cacheLineSize)) - addr_offset;
         uint64_t rightSize = current_transfer - leftSize;
         uint64_t physLeftAddr = phy_addr;
-        uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        uint64_t physRightAddr = memmgr->translateAddress(rightAddr, coreID);
         physicalAddresses.push_back(physLeftAddr);
     }
 }
@@ -664,73 +684,63 @@ void ArielCore::handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE) {
 }
 
 void ArielCore::createSwitchPoolEvent(uint32_t newPool) {
-    ArielSwitchPoolEvent* ev = new ArielSwitchPoolEvent(newPool);
-    coreQ->push(ev);
+    coreQ->emplace<ArielSwitchPoolEvent>(newPool);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a switch pool event on core %" PRIu32 ", new level is: %" PRIu32 "\n", coreID, newPool));
 }
 
 void ArielCore::createNoOpEvent() {
-    ArielNoOpEvent* ev = new ArielNoOpEvent();
-    coreQ->push(ev);
+    coreQ->emplace<ArielNoOpEvent>();
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a No Op event on core %" PRIu32 "\n", coreID));
 }
 
 void ArielCore::createReadEvent(uint64_t address, uint32_t length) {
-    ArielReadEvent* ev = new ArielReadEvent(address, length);
-    coreQ->push(ev);
+    coreQ->emplace<ArielReadEvent>(address, length);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a READ event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
-    ArielAllocateEvent* ev = new ArielAllocateEvent(vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    coreQ->emplace<ArielAllocateEvent>(vAddr, length, level, instPtr);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an allocate event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
 }
 
 void ArielCore::createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
-    ArielMmapEvent* ev = new ArielMmapEvent(fileID, vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    coreQ->emplace<ArielMmapEvent>(fileID, vAddr, length, level, instPtr);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an mmap event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
 }
 
 void ArielCore::createFreeEvent(uint64_t vAddr) {
-    ArielFreeEvent* ev = new ArielFreeEvent(vAddr);
-    coreQ->push(ev);
+    coreQ->emplace<ArielFreeEvent>(vAddr);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated a free event for virtual address=%" PRIu64 "\n", vAddr));
 }
 
 void ArielCore::createWriteEvent(uint64_t address, uint32_t length, const uint8_t* payload) {
-    ArielWriteEvent* ev = new ArielWriteEvent(address, length, payload);
-    coreQ->push(ev);
+    coreQ->emplace<ArielWriteEvent>(address, length, payload);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a WRITE event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createFlushEvent(uint64_t vAddr){
-    ArielFlushEvent *ev = new ArielFlushEvent(vAddr, cacheLineSize);
-    coreQ->push(ev);
+    coreQ->emplace<ArielFlushEvent>(vAddr, cacheLineSize);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO,4,0, "Generated a FLUSH event.\n"));
 }
 
 void ArielCore::createFenceEvent(){
-    ArielFenceEvent *ev = new ArielFenceEvent();
-    coreQ->push(ev);
+    coreQ->emplace<ArielFenceEvent>();
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a FENCE event.\n"));
 }
 
 void ArielCore::createExitEvent() {
-    ArielExitEvent* xEv = new ArielExitEvent();
-    coreQ->push(xEv);
+    coreQ->emplace<ArielExitEvent>();
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated an EXIT event.\n"));
 }
@@ -842,7 +852,7 @@ bool ArielCore::refillQueue() {
                             coreID, (uint32_t) coreQ->size(), (uint32_t) maxQLength));
 
         ArielCommand ac;
-        const bool avail = tunnel->readMessageNB(coreID, &ac);
+        const bool avail = readCommandNB(&ac);
 
         if ( !avail ) {
                 ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Tunnel claims no data on core: %" PRIu32 "\n", coreID));
@@ -859,32 +869,10 @@ bool ArielCore::refillQueue() {
                 break;
 
             case ARIEL_START_INSTRUCTION:
-                if(ARIEL_INST_SP_FP == ac.inst.instClass) {
-                        statFPSPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPSPSIMDIns->addData(1);
-                        } else {
-                            statFPSPScalarIns->addData(1);
-                        }
-
-                        if(ac.inst.simdElemCount < 32)
-                            statFPSPOps->addData(ac.inst.simdElemCount);
-                } else if(ARIEL_INST_DP_FP == ac.inst.instClass) {
-                        statFPDPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPDPSIMDIns->addData(1);
-                        } else {
-                            statFPDPScalarIns->addData(1);
-                        }
-
-                        if(ac.inst.simdElemCount < 16)
-                            statFPDPOps->addData(ac.inst.simdElemCount);
-                }
+                countInstructionClass(ac.inst.instClass, ac.inst.simdElemCount);
 
                 while(ac.command != ARIEL_END_INSTRUCTION) {
-                        ac = tunnel->readMessage(coreID);
+                        ac = readCommand();
 
                         switch(ac.command) {
                             case ARIEL_PERFORM_READ:
@@ -914,6 +902,10 @@ bool ArielCore::refillQueue() {
                 createNoOpEvent();
                 break;
 
+            case ARIEL_BATCH:
+                refillFromBatch(ac);
+                break;
+
             case ARIEL_FLUSHLINE_INSTRUCTION:
                 createFlushEvent(ac.flushline.vaddr);
                 break;
@@ -962,6 +954,113 @@ bool ArielCore::refillQueue() {
     return true;
 }
 
+// Commands come from the tunnel, or from a command trace when replaying, and
+// are copied to the command trace when recording
+bool ArielCore::readCommandNB(ArielCommand* ac) {
+    const bool avail = (NULL == replay) ? tunnel->readMessageNB(coreID, ac) : replay->readCommandNB(ac);
+
+    if(NULL != recorder) {
+        if(avail) {
+            recorder->recordCommand(*ac);
+        } else {
+            recorder->recordEmptyPoll();
+        }
+    }
+
+    return avail;
+}
+
+ArielCommand ArielCore::readCommand() {
+    ArielCommand ac = (NULL == replay) ? tunnel->readMessage(coreID) : replay->readCommand();
+
+    if(NULL != recorder) {
+        recorder->recordCommand(ac);
+    }
+
+    return ac;
+}
+
+// Decode every record in a batch. An instruction may continue into the
+// next batch, so like the unbatched path, keep reading until its end record.
+void ArielCore::refillFromBatch(ArielCommand& ac) {
+    ArielBatchRecord rec;
+    bool inInstruction = false;
+
+    batchDecoder.begin(ac);
+
+    while(true) {
+        while(batchDecoder.next(&rec)) {
+            switch(rec.type) {
+                case ARIEL_BATCH_START:
+                    countInstructionClass(rec.instClass, rec.simdElemCount);
+                    inInstruction = true;
+                    break;
+
+                case ARIEL_BATCH_READ:
+                    createReadEvent(rec.addr, rec.size);
+                    break;
+
+                case ARIEL_BATCH_WRITE:
+                    createWriteEvent(rec.addr, rec.size, rec.payload);
+                    break;
+
+                case ARIEL_BATCH_END:
+                    inInstruction = false;
+                    break;
+
+                case ARIEL_BATCH_NOOP:
+                    createNoOpEvent();
+                    break;
+            }
+        }
+
+        if(batchDecoder.getRemaining() > 0) {
+            output->fatal(CALL_INFO, -1, "Error: Ariel core %" PRIu32 " received a malformed record batch (%" PRIu32 " records not decoded).\n",
+                    coreID, batchDecoder.getRemaining());
+        }
+
+        if(!inInstruction) {
+            break;
+        }
+
+        ac = readCommand();
+
+        if(ARIEL_BATCH != ac.command) {
+            output->fatal(CALL_INFO, -1, "Error: Ariel did not understand command (%d) provided during batched instruction refill.\n", (int)(ac.command));
+        }
+
+        batchDecoder.begin(ac);
+    }
+
+    ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Core %" PRIu32 " decoded a record batch\n", coreID));
+}
+
+void ArielCore::countInstructionClass(uint32_t instClass, uint32_t simdElemCount) {
+    if(ARIEL_INST_SP_FP == instClass) {
+            statFPSPIns->addData(1);
+
+            if(simdElemCount > 1) {
+                statFPSPSIMDIns->addData(1);
+            } else {
+                statFPSPScalarIns->addData(1);
+            }
+
+            if(simdElemCount < 32)
+                statFPSPOps->addData(simdElemCount);
+    } else if(ARIEL_INST_DP_FP == instClass) {
+            statFPDPIns->addData(1);
+
+            if(simdElemCount > 1) {
+                statFPDPSIMDIns->addData(1);
+            } else {
+                statFPDPScalarIns->addData(1);
+            }
+
+            if(simdElemCount < 16)
+                statFPDPOps->addData(simdElemCount);
+    }
+}
+
 void ArielCore::handleFreeEvent(ArielFreeEvent* rFE) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a free event (for virtual address=%" PRIu64 ")\n", coreID, rFE->getVirtualAddress()));
 
@@ -985,7 +1084,7 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
     // There is a chance that the non-alignment causes an undetected bug if an access spans multiple malloc regions that are contiguous in VA space but non-contiguous in PA space.
     // However, a single access spanning multiple malloc'd regions shouldn't happen...
     // Addresses mapped via first touch are always line/page aligned
-    const uint64_t physAddr = memmgr->translateAddress(readAddress);
+    const uint64_t physAddr = memmgr->translateAddress(readAddress, coreID);
     const uint64_t addr_offset  = physAddr % ((uint64_t) cacheLineSize);
 
     if((addr_offset + readLength) <= cacheLineSize) {
@@ -1010,7 +1109,7 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
         const uint64_t rightSize = readLength - leftSize;
 
         const uint64_t physLeftAddr = physAddr;
-        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr, coreID);
 
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " issuing split-address read, LeftVAddr=%" PRIu64 ", RightVAddr=%" PRIu64 ", LeftSize=%" PRIu64 ", RightSize=%" PRIu64 ", LeftPhysAddr=%" PRIu64 ", RightPhysAddr=%" PRIu64 "\n",
                             coreID, leftAddr, rightAddr, leftSize, rightSize, physLeftAddr, physRightAddr));
@@ -1056,7 +1155,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
     }*/
 
     // See note in handleReadRequest() on alignment issues
-    const uint64_t physAddr = memmgr->translateAddress(writeAddress);
+    const uint64_t physAddr = memmgr->translateAddress(writeAddress, coreID);
     const uint64_t addr_offset  = physAddr % ((uint64_t) cacheLineSize);
 
     // We do not need to perform a split operation
@@ -1093,7 +1192,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
         const uint64_t rightSize = writeLength - leftSize;
 
         const uint64_t physLeftAddr = physAddr;
-        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr, coreID);
 
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " issuing split-address write, LeftVAddr=%" PRIu64 ", RightVAddr=%" PRIu64 ", LeftSize=%" PRIu64 ", RightSize=%" PRIu64 ", LeftPhysAddr=%" PRIu64 ", RightPhysAddr=%" PRIu64 "\n",
                             coreID, leftAddr, rightAddr, leftSize, rightSize, physLeftAddr, physRightAddr));
@@ -1148,7 +1247,7 @@ void ArielCore::handleFlushEvent(ArielFlushEvent *flEv) {
     const uint64_t virtualAddress = (uint64_t) flEv->getVirtualAddress();
     const uint64_t readLength = (uint64_t) flEv->getLength();
 
-    const uint64_t physAddr = memmgr->translateAddress(virtualAddress);
+    const uint64_t physAddr = memmgr->translateAddress(virtualAddress, coreID);
     commitFlushEvent(physAddr, virtualAddress, (uint32_t) readLength);
 }
 
@@ -1449,7 +1548,7 @@ bool ArielCore::processNextEvent() {
                     statInstructionCount->addData(1);
                     inst_count++;
                     removeEvent = true;
-                    handleReadRequest(dynamic_cast<ArielReadEvent*>(nextEvent));
+                    handleReadRequest(static_cast<ArielReadEvent*>(nextEvent));
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1465,7 +1564,7 @@ bool ArielCore::processNextEvent() {
                     statInstructionCount->addData(1);
                     inst_count++;
                             removeEvent = true;
-                    handleWriteRequest(dynamic_cast<ArielWriteEvent*>(nextEvent));
+                    handleWriteRequest(static_cast<ArielWriteEvent*>(nextEvent));
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1485,25 +1584,25 @@ bool ArielCore::processNextEvent() {
         case SWITCH_POOL:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a SWITCH_POOL\n", coreID));
                 removeEvent = true;
-                handleSwitchPoolEvent(dynamic_cast<ArielSwitchPoolEvent*>(nextEvent));
+                handleSwitchPoolEvent(static_cast<ArielSwitchPoolEvent*>(nextEvent));
                 break;
 
         case FREE:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is FREE\n", coreID));
                 removeEvent = true;
-                handleFreeEvent(dynamic_cast<ArielFreeEvent*>(nextEvent));
+                handleFreeEvent(static_cast<ArielFreeEvent*>(nextEvent));
                 break;
 
         case MALLOC:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is MALLOC\n", coreID));
                 removeEvent = true;
-                handleAllocationEvent(dynamic_cast<ArielAllocateEvent*>(nextEvent));
+                handleAllocationEvent(static_cast<ArielAllocateEvent*>(nextEvent));
                 break;
 
         case MMAP:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is MMAP\n", coreID));
                 removeEvent = true;
-                handleMmapEvent(dynamic_cast<ArielMmapEvent*>(nextEvent));
+                handleMmapEvent(static_cast<ArielMmapEvent*>(nextEvent));
                 break;
 
         case CORE_EXIT:
@@ -1519,7 +1618,7 @@ bool ArielCore::processNextEvent() {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Found a FLUSH event, fewer pending transactions than permitted so will process..\n"));
                     statInstructionCount->addData(1);
                     inst_count++;
-                    handleFlushEvent(dynamic_cast<ArielFlushEvent*>(nextEvent));
+                    handleFlushEvent(static_cast<ArielFlushEvent*>(nextEvent));
                     removeEvent = true;
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ",core will stall for new events\n", coreID));
@@ -1529,7 +1628,7 @@ bool ArielCore::processNextEvent() {
         case FENCE:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a FENCE\n", coreID));
                 if(!isCoreFenced()) {// If core is fenced, drop this fence - they can be merged
-                    handleFenceEvent(dynamic_cast<ArielFenceEvent*>(nextEvent));
+                    handleFenceEvent(static_cast<ArielFenceEvent*>(nextEvent));
                 }
                 removeEvent = true;
                 break;
@@ -1538,7 +1637,7 @@ bool ArielCore::processNextEvent() {
             ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 "next event is RTL (RTLEvent call)\n", coreID));
             output->verbose(CALL_INFO, 1, 0, "\nArielRTLEvent is being issued");
             removeEvent = true;
-            handleRtlEvent(dynamic_cast<ArielRtlEvent*>(nextEvent));
+            handleRtlEvent(static_cast<ArielRtlEvent*>(nextEvent));
             break;
 
 #ifdef HAVE_CUDA
@@ -1547,7 +1646,7 @@ bool ArielCore::processNextEvent() {
             removeEvent = true;
             stall();
             gpu();
-            handleGpuEvent(dynamic_cast<ArielGpuEvent*>(nextEvent));
+            handleGpuEvent(static_cast<ArielGpuEvent*>(nextEvent));
             break;
 #endif
         default:
@@ -1560,8 +1659,6 @@ bool ArielCore::processNextEvent() {
         ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Removing event from pending queue, there are %" PRIu32 " events in the queue before deletion.\n",
                             (uint32_t) coreQ->size()));
         coreQ->pop();
-
-        delete nextEvent;
         return true;
     } else {
         ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Event removal was not requested, pending transaction queue length=%" PRIu32 ", maximum transactions: %" PRIu32 "\n",
@@ -47,9 +47,13 @@
 #include "arielfenceev.h"
 #include "arielswitchpool.h"
 #include "arielrtlev.h"
+#include "arieleventring.h"
+#include "arielpendingtable.h"
 #include "tb_header.h"
 
 #include "ariel_shmem.h"
+#include "ariel_batch.h"
+#include "arielcmdtrace.h"
 #include "arieltracegen.h"
 
 #ifdef HAVE_CUDA
@@ -126,6 +130,7 @@ class ArielCore : public ComponentExtension {
         void createFlushEvent(uint64_t vAddr);
         void createFenceEvent();
         void createSwitchPoolEvent(uint32_t pool);
+        void setCommandReplay(ArielCommandTraceReader* reader) { replay = reader; }
 
         void setFilePath(std::string fp) {
           getcwd(file_path, sizeof(file_path));
@@ -194,6 +199,10 @@ class ArielCore : public ComponentExtension {
     private:
         bool processNextEvent();
         bool refillQueue();
+        bool readCommandNB(ArielCommand* ac);
+        ArielCommand readCommand();
+        void refillFromBatch(ArielCommand& ac);
+        void countInstructionClass(uint32_t instClass, uint32_t simdElemCount);
         bool writePayloads;
         uint32_t coreID;
         uint32_t maxPendingTransactions;
@@ -217,13 +226,16 @@ class ArielCore : public ComponentExtension {
 #endif
 
         Output* output;
-        std::queue<ArielEvent*>* coreQ;
+        ArielEventRing* coreQ;
         bool isStalled;
         bool isHalted;
         bool isFenced;
 
         StandardMem* cacheLink;
         ArielTunnel *tunnel;
+        ArielBatchDecoder batchDecoder;
+        ArielCommandTraceWriter* recorder;
+        ArielCommandTraceReader* replay;
         StdMemHandler* stdMemHandlers;
         Link* RtlLink;
 
@@ -234,7 +246,7 @@ class ArielCore : public ComponentExtension {
         std::unordered_map<StandardMem::Request::id_t, StandardMem::Request*>* pendingGpuTransactions;
 #endif
 
-        std::unordered_map<StandardMem::Request::id_t, StandardMem::Request*>* pendingTransactions;
+        ArielPendingTable* pendingTransactions;
         uint32_t maxIssuePerCycle;
         uint32_t maxQLength;
         uint64_t cacheLineSize;
@@ -65,9 +65,7 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
 
     paramStr = params.find<std::string>("translatecacheentries", "", found);
     if (found) {
-        output->verbose(CALL_INFO, 0, 0, "WARNING - ariel parameter name change: change 'translatecacheentries' to 'memmgr.translatecacheentries' in your input. The old parameter will continue to work for now but may not be supported in future releases.\n");
-        params.find<std::string>("memmgr.translatecacheentries", "", found);
-        if (!found) params.insert("memmgr.translatecacheentries", paramStr, true);
+        output->verbose(CALL_INFO, 0, 0, "WARNING - ariel parameter 'translatecacheentries' is ignored. Translation caches are now per core, set 'memmgr.translatecacheentriespercore' instead.\n");
     }
     paramStr = params.find<std::string>("memorylevels", "", found);
     if (found) {
@@ -187,6 +185,7 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
 
         // Set max number of instructions
         cpu_cores[i]->setMaxInsts(max_insts);
+        cpu_cores[i]->setCommandReplay(frontend->getCommandTrace(i));
     }
 
     // Find all the components loaded into the "memory" slot
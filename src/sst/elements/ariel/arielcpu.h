@@ -77,6 +77,8 @@ class ArielCPU : public SST::Component {
         {"tracegen", "Select the trace generator for Ariel (which records traced memory operations", ""},
         {"memmgr", "Memory manager to use for address translation", "ariel.MemoryManagerSimple"},
         {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"},
+        {"commandtrace", "Record each core's command stream to <commandtrace>-<core>.cmd[.gz] for replay with ariel.frontend.replay", ""},
+        {"tunnelbatch", "Pack instruction records into batched, delta-encoded tunnel messages (Pin3 only)", "0"},
         {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"},
         {"gpu_enabled", "If enabled, gpu links will be set up", "0"})
 
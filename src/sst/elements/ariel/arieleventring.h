@@ -0,0 +1,159 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_ARIEL_EVENT_RING
+#define _H_SST_ARIEL_EVENT_RING
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cstddef>
+#include <deque>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "arielevent.h"
+#include "arielreadev.h"
+#include "arielwriteev.h"
+#include "arielnoop.h"
+#include "arielexitev.h"
+#include "arielallocev.h"
+#include "arielfreeev.h"
+#include "arielflushev.h"
+#include "arielfenceev.h"
+#include "arielswitchpool.h"
+
+namespace SST {
+namespace ArielComponent {
+
+template<typename... Events> struct ArielEventMaxSize;
+
+template<typename Event> struct ArielEventMaxSize<Event> {
+    static const size_t value = sizeof(Event);
+};
+
+template<typename Event, typename... Events> struct ArielEventMaxSize<Event, Events...> {
+    static const size_t value = sizeof(Event) > ArielEventMaxSize<Events...>::value ?
+        sizeof(Event) : ArielEventMaxSize<Events...>::value;
+};
+
+// Every event type that ArielCore builds in place in its queue
+#define ARIEL_EVENT_SLOT_SIZE ArielEventMaxSize<ArielReadEvent, ArielWriteEvent, ArielNoOpEvent, ArielExitEvent, \
+        ArielAllocateEvent, ArielMmapEvent, ArielFreeEvent, ArielFlushEvent, ArielFenceEvent, ArielSwitchPoolEvent>::value
+
+/*
+ * Fixed-capacity FIFO of ArielEvents for a core. Events are constructed in
+ * place in a preallocated slot and destroyed there when popped, so the
+ * steady state allocates nothing. Events that are too large for a slot
+ * (RTL, GPU) are pushed as heap pointers and deleted when popped.
+ *
+ * If the ring is full, further events are heap allocated and kept in an
+ * overflow list behind it until the ring drains, so ordering is kept.
+ */
+class ArielEventRing {
+
+    public:
+        ArielEventRing(size_t cap) : slots(cap > 0 ? cap : 1), capacity(cap > 0 ? cap : 1), head(0), tail(0), count(0) { }
+
+        ~ArielEventRing() {
+            while (!empty()) {
+                pop();
+            }
+        }
+
+        template<typename Event, typename... Args>
+        Event* emplace(Args&&... args) {
+            static_assert(sizeof(Event) <= ARIEL_EVENT_SLOT_SIZE, "Event type does not fit in an ArielEventRing slot");
+
+            if (!overflow.empty() || count == capacity) {
+                Event* ev = new Event(std::forward<Args>(args)...);
+                overflow.push_back(ev);
+                return ev;
+            }
+
+            Slot& slot = slots[tail];
+            Event* ev = new (slot.storage) Event(std::forward<Args>(args)...);
+            slot.event = ev;
+            slot.inPlace = true;
+            advance(tail);
+            count++;
+            return ev;
+        }
+
+        /** Queue a heap allocated event, the ring takes ownership */
+        void push(ArielEvent* ev) {
+            if (!overflow.empty() || count == capacity) {
+                overflow.push_back(ev);
+                return;
+            }
+
+            Slot& slot = slots[tail];
+            slot.event = ev;
+            slot.inPlace = false;
+            advance(tail);
+            count++;
+        }
+
+        ArielEvent* front() const {
+            return count > 0 ? slots[head].event : overflow.front();
+        }
+
+        void pop() {
+            if (count > 0) {
+                Slot& slot = slots[head];
+                if (slot.inPlace) {
+                    slot.event->~ArielEvent();
+                } else {
+                    delete slot.event;
+                }
+                slot.event = nullptr;
+                advance(head);
+                count--;
+            } else {
+                delete overflow.front();
+                overflow.pop_front();
+            }
+        }
+
+        size_t size() const { return count + overflow.size(); }
+        bool empty() const { return 0 == count && overflow.empty(); }
+
+    private:
+        struct Slot {
+            alignas(std::max_align_t) unsigned char storage[ARIEL_EVENT_SLOT_SIZE];
+            ArielEvent* event;
+            bool inPlace;
+            Slot() : event(nullptr), inPlace(false) { }
+        };
+
+        void advance(size_t& index) {
+            if (++index == capacity) {
+                index = 0;
+            }
+        }
+
+        std::vector<Slot> slots;
+        std::deque<ArielEvent*> overflow;
+        size_t capacity;
+        size_t head;
+        size_t tail;
+        size_t count;
+};
+
+}
+}
+
+#endif
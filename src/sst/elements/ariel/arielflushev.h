@@ -19,7 +19,6 @@
 
 #include <sst_config.h>
 #include "arielevent.h"
-#include "arielcore.h"
 
 using namespace SST;
 
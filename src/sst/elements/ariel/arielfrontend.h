@@ -26,6 +26,7 @@
 #include <map>
 
 #include "ariel_shmem.h"
+#include "arielcmdtrace.h"
 
 namespace SST {
 namespace ArielComponent {
@@ -48,6 +49,9 @@ public:
 
     virtual ArielTunnel* getTunnel() = 0;
 
+    // Frontends that replay recorded command traces return a core's trace here
+    virtual ArielCommandTraceReader* getCommandTrace(uint32_t core) { return nullptr; }
+
 #ifdef HAVE_CUDA
     virtual GpuDataTunnel* getDataTunnel() { return nullptr; }
     virtual GpuReturnTunnel* getReturnTunnel() { return nullptr; }
@@ -26,6 +26,7 @@
 #include <unordered_map>
 
 #include "arielmemmgr.h"
+#include "arielpagetable.h"
 
 using namespace SST;
 using namespace SST::RNG;
@@ -34,12 +35,21 @@ namespace SST {
 
 namespace ArielComponent {
 
+// Tag of an empty translation cache entry
+#define ARIEL_TLB_INVALID UINT64_MAX
+
 enum ArielPageMappingPolicy {
     LINEAR,
     RANDOMIZED
 };
 
-/* Base class for memory managers that cache translation addresses */
+/* Base class for memory managers that cache translation addresses
+ *
+ * Each core has a direct-mapped translation cache indexed by virtual page,
+ * checked before the manager walks its page tables. Managers report the
+ * smallest page size they map with setTranslationPageSize() and implement
+ * walkPageTables() for the translations that miss.
+ */
 class ArielMemoryManagerCache : public ArielMemoryManager{
 
     public:
@@ -47,9 +57,10 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
     #define ARIEL_ELI_MEMMGR_CACHE_PARAMS {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},\
         {"vtop_translate",  "Set to yes to perform virt-phys translation (TLB) or no to disable", "yes"},\
         {"pagemappolicy",   "Select the page mapping policy for Ariel [LINEAR|RANDOMIZED]", "LINEAR"},\
-        {"translatecacheentries", "Keep a translation cache of this many entries to improve emulated core performance", "4096"}
+        {"translatecacheentriespercore", "Entries in each core's direct-mapped translation cache (rounded up to a power of two, 0 disables it)", "4096"},\
+        {"translatecacheentries", "Replaced by translatecacheentriespercore, which sizes each core's cache instead of one shared cache. Ignored.", ""}
 
-    #define ARIEL_ELI_MEMMGR_CACHE_STATS { "tlb_hits", "Hits in the simple Ariel TLB", "hits", 2 },\
+    #define ARIEL_ELI_MEMMGR_CACHE_STATS { "tlb_page_hits", "Translations that hit in a core's translation cache; any address in a cached page hits", "hits", 2 },\
         { "tlb_evicts",           "Number of evictions in the simple Ariel TLB", "evictions", 2 },\
         { "tlb_translate_queries","Number of TLB translations performed", "translations", 2 },\
         { "tlb_shootdown",        "Number of TLB clears because of page-frees", "shootdowns", 2 },\
@@ -64,7 +75,7 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             translationEnabled = params.find<bool>("vtop_translate", true);
 
             /* Common statistics */
-            statTranslationCacheHits    = registerStatistic<uint64_t>("tlb_hits");
+            statTranslationCacheHits    = registerStatistic<uint64_t>("tlb_page_hits");
             statTranslationCacheEvict   = registerStatistic<uint64_t>("tlb_evicts");
             statTranslationQueries      = registerStatistic<uint64_t>("tlb_translate_queries");
             statTranslationShootdown    = registerStatistic<uint64_t>("tlb_shootdown");
@@ -82,16 +93,79 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             output->fatal(CALL_INFO, -8, "Ariel memory manager - unknown page mapping policy \"%s\"\n", mappingPolicy.c_str());
             }
 
-            // Set up translation cache
-            translationCache = new std::unordered_map<uint64_t, uint64_t>();
-            translationCacheEntries = (uint32_t) params.find<uint32_t>("translatecacheentries", 4096);
+            // Set up translation cache, the size is rounded up to a power of two so the index is a mask
+            if (params.contains("translatecacheentries")) {
+                output->verbose(CALL_INFO, 0, 0, "WARNING - ariel memory manager: 'translatecacheentries' is ignored. Translation caches are now per core, set 'translatecacheentriespercore' instead.\n");
+            }
+            const uint32_t requestedEntries = (uint32_t) params.find<uint32_t>("translatecacheentriespercore", 4096);
+            translationCacheEntries = 0;
+            if (requestedEntries > 0) {
+                translationCacheEntries = 1;
+                while (translationCacheEntries < requestedEntries) {
+                    translationCacheEntries <<= 1;
+                }
+            }
+            setTranslationPageSize(4096);
 
             /* Statistics used by all memory managers; managers may also have their own */
         } // End constructor
 
         ~ArielMemoryManagerCache() {};
+
+        uint64_t translateAddress(uint64_t virtAddr) {
+            return translateAddress(virtAddr, 0);
+        }
+
+        uint64_t translateAddress(uint64_t virtAddr, uint32_t core) {
+            // If translation is disabled, then just return address
+            if( ! translationEnabled ) {
+                return virtAddr;
+            }
+
+            // Keep track of how many translations we are performing
+            statTranslationQueries->addData(1);
+
+            output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
+
+            // Check the core's translation cache otherwise walk the page tables
+            const uint64_t virtPage = virtAddr >> translationPageShift;
+            TranslationCacheEntry* slot = nullptr;
+
+            if (translationCacheEntries > 0) {
+                if (core >= translationCaches.size()) {
+                    translationCaches.resize(core + 1, std::vector<TranslationCacheEntry>(translationCacheEntries, TranslationCacheEntry()));
+                }
+
+                slot = &translationCaches[core][virtPage & (translationCacheEntries - 1)];
+                if (slot->virtPage == virtPage) {
+                    statTranslationCacheHits->addData(1);
+                    return slot->physPage + (virtAddr & translationPageMask);
+                }
+            }
+
+            bool cacheable = true;
+            const uint64_t physAddr = walkPageTables(virtAddr, cacheable);
+
+            if (nullptr != slot && cacheable) {
+                if (slot->virtPage != ARIEL_TLB_INVALID) {
+                    statTranslationCacheEvict->addData(1);
+                }
+                slot->virtPage = virtPage;
+                slot->physPage = physAddr - (virtAddr & translationPageMask);
+            }
+
+            return physAddr;
+        }
+
         void get_tlb_info(std::unordered_map<uint64_t, uint64_t>* translationcache, uint32_t& translationcacheentries, bool& translationenabled) {
-            memcpy((void*)translationcache, (void*)translationCache, sizeof(*translationCache));
+            translationcache->clear();
+            if (!translationCaches.empty()) {
+                for (auto& entry : translationCaches[0]) {
+                    if (entry.virtPage != ARIEL_TLB_INVALID) {
+                        translationcache->insert(std::make_pair(entry.virtPage << translationPageShift, entry.physPage));
+                    }
+                }
+            }
             translationcacheentries = translationCacheEntries;
             translationenabled = translationEnabled;
 
@@ -106,11 +180,82 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
         Statistic<uint64_t>* statTranslationShootdown;
         Statistic<uint64_t>* statPageAllocationCount;
 
-        std::unordered_map<uint64_t, uint64_t>* translationCache;
+        struct TranslationCacheEntry {
+            uint64_t virtPage;
+            uint64_t physPage;
+            TranslationCacheEntry() : virtPage(ARIEL_TLB_INVALID), physPage(0) {}
+        };
+
+        std::vector<std::vector<TranslationCacheEntry> > translationCaches;
         uint32_t translationCacheEntries;
+        uint32_t translationPageShift;
+        uint64_t translationPageMask;
         bool translationEnabled;
         ArielPageMappingPolicy mapPolicy;
 
+        /** Translate an address that missed in the translation cache, allocating it if needed.
+         *  Clear cacheable if the translation does not hold for the rest of its page */
+        virtual uint64_t walkPageTables(uint64_t virtAddr, bool& cacheable) = 0;
+
+        /** Translation cache entries cover pages of this size, which must be the smallest size mapped */
+        void setTranslationPageSize(uint64_t pageSize) {
+            translationPageShift = 0;
+            while ((UINT64_C(1) << (translationPageShift + 1)) <= pageSize) {
+                translationPageShift++;
+            }
+            translationPageMask = (UINT64_C(1) << translationPageShift) - 1;
+            flushTranslationCaches();
+        }
+
+        /** Drop every core's cached translations, needed whenever a mapping changes */
+        void flushTranslationCaches() {
+            for (auto& cache : translationCaches) {
+                std::fill(cache.begin(), cache.end(), TranslationCacheEntry());
+            }
+        }
+
+        /** Map pageCount pages from virtAddr with pages from freePagePool; pages that are
+         *  already mapped are skipped and physically contiguous runs are mapped in bulk.
+         *  Returns the number of pages mapped */
+        uint64_t mapRegion(ArielPageTable* pageTable, std::deque<uint64_t>* freePagePool, uint64_t virtAddr, uint64_t pageCount) {
+            const uint64_t pageSize = pageTable->getPageSize();
+            uint64_t nextVirtPage = virtAddr - (virtAddr % pageSize);
+            uint64_t mapped = 0;
+
+            for (uint64_t i = 0; i < pageCount; ) {
+                if (pageTable->isMapped(nextVirtPage)) {
+                    nextVirtPage += pageSize;
+                    i++;
+                    continue;
+                }
+
+                if (freePagePool->empty()) {
+                    output->fatal(CALL_INFO, -1, "Attempted to map virtual page %" PRIu64 " but no free pages are available\n", nextVirtPage);
+                }
+
+                // Collect the longest run of unmapped virtual pages backed by contiguous physical pages
+                const uint64_t runVirt = nextVirtPage;
+                const uint64_t runPhys = freePagePool->front();
+                uint64_t runLength = 0;
+
+                do {
+                    freePagePool->pop_front();
+                    runLength++;
+                    nextVirtPage += pageSize;
+                    i++;
+                } while (i < pageCount && !freePagePool->empty() && freePagePool->front() == runPhys + runLength * pageSize
+                        && !pageTable->isMapped(nextVirtPage));
+
+                output->verbose(CALL_INFO, 4, 0, "Allocating %" PRIu64 " memory pages, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
+                        runLength, runPhys, runVirt);
+
+                pageTable->mapRange(runVirt, runPhys, runLength);
+                mapped += runLength;
+            }
+
+            return mapped;
+        }
+
         void mapPagesLinear(uint64_t pageCount, uint64_t pageSize, uint64_t startAddr, std::deque<uint64_t>* freePagePool) {
             output->verbose(CALL_INFO, 2, 0, "Page mapping policy is LINEAR map...\n");
             uint64_t nextMemoryAddress = startAddr;
@@ -153,7 +298,7 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             }
         }
 
-        void populatePageTable(std::string popFilePath, std::unordered_map<uint64_t, uint64_t> * pageTable, std::deque<uint64_t>* freePagePool, uint64_t pageSize) {
+        void populatePageTable(std::string popFilePath, ArielPageTable* pageTable, std::deque<uint64_t>* freePagePool, uint64_t pageSize) {
             FILE * popFile = fopen(popFilePath.c_str(), "rt");
             uint64_t pinAddr = 0;
 
@@ -177,23 +322,12 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
                 output->verbose(CALL_INFO, 4, 0, "Pinning address %" PRIu64 " (physical=%" PRIu64 "\n",
                             pinAddr, freePhysical);
 
-                pageTable->insert( std::pair<uint64_t, uint64_t>( pinAddr, freePhysical ) );
+                pageTable->map(pinAddr, freePhysical);
             }
 
             fclose(popFile);
         }
 
-        void cacheTranslation(uint64_t virtualA, uint64_t physicalA) {
-            // Remove the oldest entry if we do not have enough slots TODO is begin() really the oldest...?
-            if(translationCache->size() == translationCacheEntries) {
-            statTranslationCacheEvict->addData(1);
-            translationCache->erase(translationCache->begin());
-            }
-
-            // Insert the translated entry into the cache
-            translationCache->insert(std::pair<uint64_t, uint64_t>(virtualA, physicalA));
-        }
-
 };
 
 }
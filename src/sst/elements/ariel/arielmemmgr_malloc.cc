@@ -31,13 +31,8 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
     freePages = (std::deque<uint64_t>**) malloc(sizeof(std::deque<uint64_t>*) * memoryLevels);
     pageSizes = (uint64_t*) malloc(sizeof(uint64_t) * memoryLevels);
 
-    // PageAllocation and PageTable structures
-    pageAllocations = (std::unordered_map<uint64_t, uint64_t>**) malloc(sizeof(std::unordered_map<uint64_t, uint64_t>*) * memoryLevels);
-    pageTables = (std::unordered_map<uint64_t, uint64_t>**) malloc(sizeof(std::unordered_map<uint64_t, uint64_t>*) * memoryLevels);
-    for (uint32_t i = 0; i <memoryLevels; ++i) {
-        pageAllocations[i] = new std::unordered_map<uint64_t, uint64_t>();
-        pageTables[i] = new std::unordered_map<uint64_t, uint64_t>();
-    }
+    // PageTable structures, created once each level's page size is known
+    pageTables = (ArielPageTable**) malloc(sizeof(ArielPageTable*) * memoryLevels);
 
     // Initialize data structures
     char * level_buffer = (char*) malloc(sizeof(char) * 256);
@@ -47,6 +42,7 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
         sprintf(level_buffer, "pagesize%" PRIu32, i);
         pageSizes[i] = (uint64_t) params.find<uint64_t>(level_buffer, 4096);
         output->verbose(CALL_INFO, 2, 0, "Level %" PRIu32 " page size is %" PRIu64 "\n", i, pageSizes[i]);
+        pageTables[i] = new ArielPageTable(output, pageSizes[i]);
 
         // Page count
         sprintf(level_buffer, "pagecount%" PRIu32, i);
@@ -81,9 +77,20 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
     }
 
     free(level_buffer);
+
+    // Translation cache entries cover the smallest page size in use
+    uint64_t minPageSize = pageSizes[0];
+    for (uint32_t i = 1; i < memoryLevels; ++i) {
+        minPageSize = std::min(minPageSize, pageSizes[i]);
+    }
+    setTranslationPageSize(minPageSize);
 }
 
 ArielMemoryManagerMalloc::~ArielMemoryManagerMalloc() {
+    for (uint32_t i = 0; i < memoryLevels; ++i) {
+        delete pageTables[i];
+    }
+    free(pageTables);
 }
 
 
@@ -132,35 +139,52 @@ void ArielMemoryManagerMalloc::allocate(const uint64_t size, const uint32_t leve
 
     statDemandAllocs[level]->addData(roundedSize/pageSize);
 
-    uint64_t nextVirtPage = virtualAddress;
-    for(uint64_t bytesLeft = 0; bytesLeft < roundedSize; bytesLeft += pageSize) {
-        if(freePages[level]->empty()) {
-                output->verbose(CALL_INFO, 4, 0, "Requesting a memory allocation at level: %" PRIu32 " which will fail due to not having enough free pages\n",
-                    level);
-                    for (uint32_t i = 0; i < memoryLevels; ++i) {
-                        output->verbose(CALL_INFO, -1, 0, "Free pages at level %" PRIu32 " : %" PRIu64 "\n", i, static_cast<uint64_t>(freePages[i]->size()));
-                    }
-                    output->fatal(CALL_INFO, -1, "Requested a memory allocation at level: %" PRIu32 " of size %" PRIu64 " which failed due to not having enough free pages\n",
-                            level, size);
+    if(freePages[level]->size() < roundedSize / pageSize) {
+        output->verbose(CALL_INFO, 4, 0, "Requesting a memory allocation at level: %" PRIu32 " which will fail due to not having enough free pages\n",
+            level);
+        for (uint32_t i = 0; i < memoryLevels; ++i) {
+            output->verbose(CALL_INFO, -1, 0, "Free pages at level %" PRIu32 " : %" PRIu64 "\n", i, static_cast<uint64_t>(freePages[i]->size()));
         }
+        output->fatal(CALL_INFO, -1, "Requested a memory allocation at level: %" PRIu32 " of size %" PRIu64 " which failed due to not having enough free pages\n",
+                level, size);
+    }
 
-        const uint64_t nextPhysPage = freePages[level]->front();
-        freePages[level]->pop_front();
+    mapRegion(pageTables[level], freePages[level], virtualAddress, roundedSize / pageSize);
 
-        pageTables[level]->insert( std::pair<uint64_t, uint64_t>(nextVirtPage, nextPhysPage) );
+    output->verbose(CALL_INFO, 4, 0, "Request leaves: %" PRIu32 " free pages at level: %" PRIu32 "\n",
+        (uint32_t) freePages[level]->size(), level);
+}
 
-        output->verbose(CALL_INFO, 4, 0, "Allocating memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
-                nextPhysPage, nextVirtPage);
+/*
+ *  Map an mmap'd region in the requested level up front instead of on first touch, so it is
+ *  mapped in bulk and large, physically contiguous runs take huge page table entries
+ */
+bool ArielMemoryManagerMalloc::allocateMMAP(const uint64_t size, const uint32_t level, const uint64_t virtualAddress, const uint64_t instructionPointer, const uint32_t file, const uint32_t thread) {
+    if(level >= memoryLevels) {
+        output->verbose(CALL_INFO, 4, 0, "Requested mmap in level: %" PRIu32 ", but only have: %" PRIu32 " levels.\n", level, memoryLevels);
+        return false;
+    }
 
-        nextVirtPage += pageSize;
+    const uint64_t pageSize = pageSizes[level];
+    const uint64_t firstPage = virtualAddress - (virtualAddress % pageSize);
+    const uint64_t pageCount = (virtualAddress + size - firstPage + pageSize - 1) / pageSize;
+
+    output->verbose(CALL_INFO, 4, 0, "Mapping mmap of %" PRIu64 " bytes at virtual address %" PRIu64 " in level %" PRIu32 " (%" PRIu64 " pages)\n",
+        size, virtualAddress, level, pageCount);
+
+    if(freePages[level]->size() < pageCount) {
+        output->verbose(CALL_INFO, 4, 0, "Requested mmap cannot be mapped, not enough pages. Have: %" PRIu64 ", Need: %" PRIu64 "\n",
+            static_cast<uint64_t>(freePages[level]->size()), pageCount);
+        return false;
     }
 
-    output->verbose(CALL_INFO, 4, 0, "Request leaves: %" PRIu32 " free pages at level: %" PRIu32 "\n",
-        (uint32_t) freePages[level]->size(), level);
+    statPageAllocationCount->addData(1);
+    statBytesAlloc[level]->addData(size);
+    mapRegion(pageTables[level], freePages[level], firstPage, pageCount);
 
-    // Record the complete entry in the allocation table (what we allocated in size against the virtual address)
-    // this means we know how much to free and can translate the address successfully.
-    pageAllocations[level]->insert( std::pair<uint64_t, uint64_t>(virtualAddress, roundedSize) );
+    // Levels are searched in order, a lower level may already map part of the region
+    flushTranslationCaches();
+    return true;
 }
 
 /*
@@ -176,16 +200,10 @@ bool ArielMemoryManagerMalloc::allocateMalloc(const uint64_t size, const uint32_
     output->verbose(CALL_INFO, 4, 0, "Allocate malloc received. VA: %" PRIu64 ". Size: %" PRIu64 ". Level: %" PRIu32 ".\n", virtualAddress, size, level);
 
     // Check whether a malloc mapping already exists (i.e., we missed a free)
-    std::map<uint64_t, uint64_t>::iterator it = mallocTranslations.upper_bound(virtualAddress);
-    if (it == mallocTranslations.begin()) it = mallocTranslations.end();
-    else if (!mallocTranslations.empty()) it--;
-
-    if (it != mallocTranslations.end() && it->first <= virtualAddress) {
-        uint64_t primaryAddr = mallocPrimaryVAMap.find(it->first)->second;
-        if (virtualAddress < primaryAddr + (mallocInformation.find(primaryAddr)->second).size) {
-            output->verbose(CALL_INFO, 4, 0, "Found conflicting malloc, freeing address %" PRIu64 "\n", primaryAddr);
-            freeMalloc(primaryAddr);
-        }
+    std::map<uint64_t, mallocInfo>::iterator it = findMalloc(virtualAddress);
+    if (it != mallocInformation.end()) {
+        output->verbose(CALL_INFO, 4, 0, "Found conflicting malloc, freeing address %" PRIu64 "\n", it->first);
+        freeMalloc(it->first);
     }
 
     // Allocate new page(s). Round malloc to nearest whole page TODO fix so we can map partial pages -> needs a local VA->Ariel_VA mapping
@@ -199,24 +217,20 @@ bool ArielMemoryManagerMalloc::allocateMalloc(const uint64_t size, const uint32_
     }
 
     // Allocate the pages
-    std::unordered_set<uint64_t>* virtualPages = new std::unordered_set<uint64_t>;
-    uint64_t nextVirtPage = virtualAddress;
-    uint64_t firstPhysAddr, lastPhysAddr;
-    firstPhysAddr = freePages[level]->front();
+    mallocInfo info(size, level);
+    info.physPages.reserve(pageCount);
     for (uint64_t i = 0; i != pageCount; i++) {
-        uint64_t nextPhysPage = freePages[level]->front();
-        mallocTranslations.insert(std::make_pair(nextVirtPage, nextPhysPage));
-        mallocPrimaryVAMap.insert(std::make_pair(nextVirtPage, virtualAddress));
+        info.physPages.push_back(freePages[level]->front());
         freePages[level]->pop_front();
-        virtualPages->insert(nextVirtPage);
-        nextVirtPage += pageSizes[level];
-        lastPhysAddr = nextPhysPage;
     }
 
-    output->verbose(CALL_INFO, 4, 0, "Malloc mapped %" PRIu64 " to [%" PRIu64 ", %" PRIu64 "] (%" PRIu64 " pages).\n", virtualAddress, firstPhysAddr, lastPhysAddr, pageCount);
+    output->verbose(CALL_INFO, 4, 0, "Malloc mapped %" PRIu64 " to [%" PRIu64 ", %" PRIu64 "] (%" PRIu64 " pages).\n", virtualAddress, info.physPages.front(), info.physPages.back(), pageCount);
 
     // Record malloc
-    mallocInformation.insert(std::make_pair(virtualAddress, mallocInfo(size, level, virtualPages)));
+    mallocInformation.insert(std::make_pair(virtualAddress, std::move(info)));
+
+    // The malloc now takes precedence over any cached demand-paged translation in its range
+    flushTranslationCaches();
 
     statBytesAlloc[level]->addData(size);
     return true;
@@ -232,84 +246,66 @@ void ArielMemoryManagerMalloc::freeMalloc(const uint64_t virtualAddress) {
 
     statBytesFree[it->second.level]->addData(it->second.size);
 
-    // Free each VA in mallocInformation from mallocTranslations & mallocPrimaryVAMap TODO fix so that mapping stays but address is available for future mallocs
-    std::unordered_set<uint64_t>* myKeys = (it->second.VAKeys);
-    for (std::unordered_set<uint64_t>::iterator vaIt = myKeys->begin(); vaIt != myKeys->end(); vaIt++) {
-        mallocPrimaryVAMap.erase(*vaIt);
-        freePages[(it->second).level]->push_front(mallocTranslations.find(*vaIt)->second);
-        mallocTranslations.erase(*vaIt);
+    // Return each physical page to the pool TODO fix so that mapping stays but address is available for future mallocs
+    // Pages are returned in reverse so the pool hands them out again in their original order
+    for (auto pageIt = it->second.physPages.rbegin(); pageIt != it->second.physPages.rend(); ++pageIt) {
+        freePages[(it->second).level]->push_front(*pageIt);
     }
 
     // Remove mallocInformation entry
-    delete myKeys;
-    mallocInformation.erase(virtualAddress);
+    mallocInformation.erase(it);
+
+    // Cached translations may still point into the freed pages
+    statTranslationShootdown->addData(1);
+    flushTranslationCaches();
 }
 
+/*
+ *  Find the malloc whose range holds virtAddr
+ */
+std::map<uint64_t, ArielMemoryManagerMalloc::mallocInfo>::iterator ArielMemoryManagerMalloc::findMalloc(const uint64_t virtAddr) {
+    std::map<uint64_t, mallocInfo>::iterator it = mallocInformation.upper_bound(virtAddr);
+    if (it == mallocInformation.begin()) {
+        return mallocInformation.end();
+    }
 
-uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
-    // If translation is disabled, then just return address
-    if( ! translationEnabled ) {
-        return virtAddr;
+    it--;
+    if (virtAddr < it->first + it->second.size) {
+        return it;
     }
+    return mallocInformation.end();
+}
 
-    // Keep track of how many translations we are performing
-    statTranslationQueries->addData(1);
 
+uint64_t ArielMemoryManagerMalloc::walkPageTables(uint64_t virtAddr, bool& cacheable) {
     uint64_t physAddr = (uint64_t) -1;
     bool found = false;
 
-    output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
-
-    // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
-        statTranslationCacheHits->addData(1);
-        return checkCache->second;
-    }
-
-    // Check malloc mappings
-    if (!mallocTranslations.empty()) {
-        std::map<uint64_t, uint64_t>::iterator it = mallocTranslations.upper_bound(virtAddr);
-        if (it == mallocTranslations.begin()) it = mallocTranslations.end();
-        else it--;
-
-        if (it != mallocTranslations.end() && (it->first <= virtAddr)) {
-            uint64_t primaryAddr = mallocPrimaryVAMap.find(it->first)->second;
-            if (virtAddr < (primaryAddr + (mallocInformation.find(primaryAddr)->second).size)) {
-                uint64_t offset = virtAddr - it->first;
-                physAddr = offset + it->second;
-                found = true;
-            }
+    // Check malloc mappings. A malloc's VA need not be page aligned, so its translations are
+    // not kept in the page-granular translation cache
+    if (!mallocInformation.empty()) {
+        std::map<uint64_t, mallocInfo>::iterator it = findMalloc(virtAddr);
+        if (it != mallocInformation.end()) {
+            const uint64_t offset = virtAddr - it->first;
+            const uint64_t pageSize = pageSizes[it->second.level];
+            physAddr = it->second.physPages[offset / pageSize] + (offset % pageSize);
+            cacheable = false;
+            return physAddr;
         }
     }
 
     // We will have to search every memory level to find where the address lies
     for(uint32_t i = 0; i < memoryLevels; ++i) {
-        if (!found) {
-        std::unordered_map<uint64_t, uint64_t>::iterator page_itr;
-        const uint64_t pageSize = pageSizes[i];
-            const uint64_t page_offset = virtAddr % pageSize;
-        const uint64_t page_start = virtAddr - page_offset;
-
-        page_itr = pageTables[i]->find(page_start);
-
-            if (page_itr != pageTables[i]->end()) {
-                // Located
-            physAddr = page_itr->second + page_offset;
-
-                output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit in level: %" PRIu32 ", virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
-                    virtAddr, i, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
+        if (pageTables[i]->lookup(virtAddr, &physAddr)) {
+            output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit in level: %" PRIu32 ", translates to: phys address: %" PRIu64 "\n",
+                virtAddr, i, physAddr);
 
             found = true;
             break;
         }
-        } else {
-            break;
-        }
     }
 
     if(found) {
-        cacheTranslation(virtAddr, physAddr);
         return physAddr;
     } else {
         output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
@@ -338,7 +334,7 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
             }
 
         // Now attempt to refind it
-        const uint64_t newPhysAddr = translateAddress(virtAddr);
+        const uint64_t newPhysAddr = walkPageTables(virtAddr, cacheable);
 
         output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", newPhysAddr );
 
@@ -353,14 +349,14 @@ void ArielMemoryManagerMalloc::printStats() {
     output->output("Page Table Sizes:\n");
 
     for(uint32_t i = 0; i < memoryLevels; ++i) {
-        output->output("- Demand map entries at level %" PRIu32 "         %" PRIu32 "\n",
-            i, (uint32_t) pageTables[i]->size());
+        output->output("- Demand map entries at level %" PRIu32 "         %" PRIu64 " (%" PRIu64 " huge, %" PRIu64 " table bytes)\n",
+            i, pageTables[i]->getMappedPages(), pageTables[i]->getHugeEntries(), pageTables[i]->getFootprint());
     }
 
     output->output("Page Table Coverages:\n");
 
     for(uint32_t i = 0; i < memoryLevels; ++i) {
         output->output("- Demand bytes at level %" PRIu32 "              %" PRIu64 "\n",
-            i, ((uint64_t) pageTables[i]->size()) * ((uint64_t) pageSizes[i]));
+            i, pageTables[i]->getMappedPages() * pageSizes[i]);
     }
 }
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include <deque>
+#include <map>
 #include <vector>
 #include <unordered_map>
 
@@ -42,7 +43,7 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
 #define ARIEL_MEMMGR_MALLOC_ELI_PARAMS ARIEL_ELI_MEMMGR_CACHE_PARAMS,\
             {"memorylevels",    "Number of memory levels in the system", "1"},\
             {"defaultlevel",    "Default memory level", "0"},\
-            {"pagesize%(memorylevels)d", "Page size for memory Level x", "4096"},\
+            {"pagesize%(memorylevels)d", "Page size for memory Level x, must be a power of two", "4096"},\
             {"pagecount%(memorylevels)d", "Page count for memory Level x", "131072"},\
             {"page_populate_%(memorylevels)d", "Pre-populate/partially pre-populate a page table for a level in memory, this is the file to read in.", ""}
 #define ARIEL_MEMMGR_MALLOC_ELI_STATS ARIEL_ELI_MEMMGR_CACHE_STATS, \
@@ -60,11 +61,14 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
         void setDefaultPool(uint32_t pool);
         uint32_t getDefaultPool();
 
-        uint64_t translateAddress(uint64_t virtAddr);
         void printStats();
 
         void freeMalloc(const uint64_t vAddr);
         bool allocateMalloc(const uint64_t size, const uint32_t level, const uint64_t virtualAddress, const uint64_t instructionPointer, const uint32_t thread);
+        bool allocateMMAP(const uint64_t size, const uint32_t level, const uint64_t virtualAddress, const uint64_t instructionPointer, const uint32_t file, const uint32_t thread);
+
+    protected:
+        uint64_t walkPageTables(uint64_t virtAddr, bool& cacheable);
 
     private:
         void allocate(const uint64_t size, const uint32_t level, const uint64_t virtualAddress);
@@ -73,21 +77,20 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
         struct mallocInfo {
             uint64_t size;
             uint32_t level;
-            std::unordered_set<uint64_t>* VAKeys;
-            mallocInfo(uint64_t size, uint32_t level, std::unordered_set<uint64_t>* VAKeys) : size(size), level(level), VAKeys(VAKeys) {};
+            std::vector<uint64_t> physPages;    // Physical page backing each page-sized chunk from the malloc's VA
+            mallocInfo(uint64_t size, uint32_t level) : size(size), level(level) {};
         };
 
-        std::map<uint64_t, uint64_t> mallocPrimaryVAMap;    // Map VA of each PA to the primary VA of the malloc -> used to find the mallocInfo
-        std::map<uint64_t, uint64_t> mallocTranslations;    // Map VA to PA for mallocs -> primary lookup
-        std::map<uint64_t, mallocInfo> mallocInformation;   // Map mallocID to information about the malloc -> use for frees/allocs
+        std::map<uint64_t, mallocInfo>::iterator findMalloc(const uint64_t virtAddr);
+
+        std::map<uint64_t, mallocInfo> mallocInformation;   // Map the malloc's VA to its information -> translations, frees and allocs
 
         uint32_t defaultLevel;
         uint32_t memoryLevels;
         uint64_t* pageSizes;
 
         std::deque<uint64_t>** freePages;
-        std::unordered_map<uint64_t, uint64_t>** pageAllocations;
-        std::unordered_map<uint64_t, uint64_t>** pageTables;
+        ArielPageTable** pageTables;
 
         std::vector<Statistic<uint64_t>* > statBytesAlloc;
         std::vector<Statistic<uint64_t>* > statBytesFree;
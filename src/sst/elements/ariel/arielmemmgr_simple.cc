@@ -26,6 +26,9 @@ ArielMemoryManagerSimple::ArielMemoryManagerSimple(ComponentId_t id, Params& par
     pageSize = (uint64_t) params.find<uint64_t>("pagesize0", 4096);
     output->verbose(CALL_INFO, 2, 0, "Page size is %" PRIu64 "\n", pageSize);
 
+    pageTable = new ArielPageTable(output, pageSize);
+    setTranslationPageSize(pageSize);
+
     uint64_t pageCount = (uint64_t) params.find<uint64_t>("pagecount0", 131072);
     output->verbose(CALL_INFO, 2, 0, "Page count is %" PRIu64 "\n", pageCount);
 
@@ -40,12 +43,13 @@ ArielMemoryManagerSimple::ArielMemoryManagerSimple(ComponentId_t id, Params& par
     std::string popFilePath = params.find<std::string>("page_populate_0", "");
     if (popFilePath != "") {
         output->verbose(CALL_INFO, 1, 0, "Populating page table from %s...\n", popFilePath.c_str());
-        populatePageTable(popFilePath, &pageTable, &freePages, pageSize);
+        populatePageTable(popFilePath, pageTable, &freePages, pageSize);
     }
 
 }
 
 ArielMemoryManagerSimple::~ArielMemoryManagerSimple() {
+    delete pageTable;
 }
 
 
@@ -67,86 +71,68 @@ void ArielMemoryManagerSimple::allocate(const uint64_t size, const uint32_t leve
 
     output->verbose(CALL_INFO, 4, 0, "Requesting rounded to %" PRIu64 " bytes\n", roundedSize);
 
-    uint64_t nextVirtPage = virtualAddress;
-    for(uint64_t bytesLeft = 0; bytesLeft < roundedSize; bytesLeft += pageSize) {
-        if(freePages.empty()) {
-                output->fatal(CALL_INFO, -1, "Requested a memory allocation of size: %" PRIu64 " which failed due to not having enough free pages\n",
-                    size);
-        }
-
-        const uint64_t nextPhysPage = freePages.front();
-        freePages.pop_front();
-
-        pageTable.insert( std::pair<uint64_t, uint64_t>(nextVirtPage, nextPhysPage) );
-
-        output->verbose(CALL_INFO, 4, 0, "Allocating memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
-                nextPhysPage, nextVirtPage);
-
-        nextVirtPage += pageSize;
+    if(freePages.size() < roundedSize / pageSize) {
+        output->fatal(CALL_INFO, -1, "Requested a memory allocation of size: %" PRIu64 " which failed due to not having enough free pages\n",
+            size);
     }
 
+    mapRegion(pageTable, &freePages, virtualAddress, roundedSize / pageSize);
+
     output->verbose(CALL_INFO, 4, 0, "Request leaves: %" PRIu32 " free pages\n",
         (uint32_t) freePages.size());
 
 }
 
-uint64_t ArielMemoryManagerSimple::translateAddress(uint64_t virtAddr) {
-    // If translation is disabled, then just return address
-    if( ! translationEnabled ) {
-        return virtAddr;
+/*
+ *  Map an mmap'd region up front instead of on first touch, so it is mapped in bulk
+ *  and large, physically contiguous runs take huge page table entries
+ */
+bool ArielMemoryManagerSimple::allocateMMAP(const uint64_t size, const uint32_t level, const uint64_t virtualAddress, const uint64_t instructionPointer, const uint32_t file, const uint32_t thread) {
+    // Simple manager ignores 'level' parameter
+    const uint64_t firstPage = virtualAddress - (virtualAddress % pageSize);
+    const uint64_t pageCount = (virtualAddress + size - firstPage + pageSize - 1) / pageSize;
+
+    output->verbose(CALL_INFO, 4, 0, "Mapping mmap of %" PRIu64 " bytes at virtual address %" PRIu64 " (%" PRIu64 " pages)\n",
+        size, virtualAddress, pageCount);
+
+    if(freePages.size() < pageCount) {
+        output->verbose(CALL_INFO, 4, 0, "Requested mmap cannot be mapped, not enough pages. Have: %" PRIu64 ", Need: %" PRIu64 "\n",
+            static_cast<uint64_t>(freePages.size()), pageCount);
+        return false;
     }
 
+    statPageAllocationCount->addData(1);
+    mapRegion(pageTable, &freePages, firstPage, pageCount);
+    return true;
+}
+
+uint64_t ArielMemoryManagerSimple::walkPageTables(uint64_t virtAddr, bool& cacheable) {
     if( output->getVerboseLevel() > 15 ) {
 	printTable();
     }
 
-    // Keep track of how many translations we are performing
-    statTranslationQueries->addData(1);
-
-    output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
-
-    // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
-        statTranslationCacheHits->addData(1);
-        return checkCache->second;
-    }
-
-    std::unordered_map<uint64_t, uint64_t>::iterator page_itr;
-    const uint64_t page_offset = virtAddr % pageSize;
-    const uint64_t page_start = virtAddr - page_offset;
-
-    page_itr = pageTable.find(page_start);
-
-    if(page_itr != pageTable.end()) {
-        // Located
-        uint64_t physAddr = page_itr->second + page_offset;
-
-        output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit, virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
-                virtAddr, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
-
-        cacheTranslation(virtAddr, physAddr);
+    uint64_t physAddr;
+    if(pageTable->lookup(virtAddr, &physAddr)) {
+        output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " translates to: phys address: %" PRIu64 "\n",
+                virtAddr, physAddr);
         return physAddr;
+    }
 
-    } else {
-        output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
-
-        // We did not find the address in memory, that means we should allocate it one from our default pool
-        uint64_t offset = virtAddr % pageSize;
+    output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
 
-        output->verbose(CALL_INFO, 4, 0, "Page offset calculation (generating a new page allocation request) for address %" PRIu64 ", offset=%" PRIu64 ", requesting virtual map to address: %" PRIu64 "\n",
-                virtAddr, offset, (virtAddr - offset));
+    // We did not find the address in memory, that means we should allocate it one from our default pool
+    uint64_t offset = virtAddr % pageSize;
 
-        // Perform an allocation so we can then re-find the address
-        allocate(8, 0, virtAddr - offset);
+    output->verbose(CALL_INFO, 4, 0, "Page offset calculation (generating a new page allocation request) for address %" PRIu64 ", offset=%" PRIu64 ", requesting virtual map to address: %" PRIu64 "\n",
+            virtAddr, offset, (virtAddr - offset));
 
-        // Now attempt to refind it
-        const uint64_t newPhysAddr = translateAddress(virtAddr);
+    // Perform an allocation so we can then re-find the address
+    allocate(8, 0, virtAddr - offset);
+    pageTable->lookup(virtAddr, &physAddr);
 
-        output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", newPhysAddr );
+    output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", physAddr );
 
-        return newPhysAddr;
-    }
+    return physAddr;
 }
 
 void ArielMemoryManagerSimple::printStats() {
@@ -155,13 +141,17 @@ void ArielMemoryManagerSimple::printStats() {
     output->output("---------------------------------------------------------------------\n");
     output->output("Page Table Sizes:\n");
 
-    output->output("- Map entries         %" PRIu32 "\n",
-        (uint32_t) pageTable.size());
+    output->output("- Mapped pages        %" PRIu64 "\n",
+        pageTable->getMappedPages());
+    output->output("- Huge entries        %" PRIu64 "\n",
+        pageTable->getHugeEntries());
+    output->output("- Table nodes         %" PRIu64 " (%" PRIu64 " bytes)\n",
+        pageTable->getNodeCount(), pageTable->getFootprint());
 
     output->output("Page Table Coverages:\n");
 
     output->output("- Bytes               %" PRIu64 "\n",
-        ((uint64_t) pageTable.size()) * ((uint64_t) pageSize));
+        pageTable->getMappedPages() * pageSize);
 }
 
 void ArielMemoryManagerSimple::printTable() {
@@ -169,18 +159,21 @@ void ArielMemoryManagerSimple::printTable() {
     	output->output("---------------------------------------------------------------------\n");
 	output->verbose(CALL_INFO, 16, 0, "Page Table Map:\n");
 
-	for( auto table_itr : pageTable ) {
+	pageTable->forEachPage([this](uint64_t virtPage, uint64_t physPage) {
 		output->verbose(CALL_INFO, 16, 0, "-> VA: %15" PRIu64 " -> PA: %15" PRIu64 "\n",
-			table_itr.first, table_itr.second);
-	}
+			virtPage, physPage);
+	});
 
     	output->output("---------------------------------------------------------------------\n");
 
 }
 
 void ArielMemoryManagerSimple::get_page_info(std::unordered_map<uint64_t, uint64_t>* pagetable, std::deque<uint64_t>* freepages, uint64_t& pagesize) {
-    memcpy((void*)pagetable, (void*)(&pageTable), sizeof(pageTable));
-    memcpy((void*)freepages, (void*)(&freePages), sizeof(freePages)); 
+    pagetable->clear();
+    pageTable->forEachPage([pagetable](uint64_t virtPage, uint64_t physPage) {
+        pagetable->insert(std::make_pair(virtPage, physPage));
+    });
+    *freepages = freePages;
     pagesize = pageSize;
 
     return;
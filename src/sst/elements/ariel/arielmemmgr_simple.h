@@ -39,7 +39,7 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
                 "Simple allocate-on-first touch memory manager", SST::ArielComponent::ArielMemoryManager)
 
 #define MEMMGR_SIMPLE_ELI_PARAMS ARIEL_ELI_MEMMGR_CACHE_PARAMS,\
-            {"pagesize0", "Page size", "4096"},\
+            {"pagesize0", "Page size, must be a power of two", "4096"},\
             {"pagecount0", "Page count", "131072"},\
             {"page_populate_0", "Pre-populate/partially pre-populate the page table, this is the file to read in.", ""}
 
@@ -50,10 +50,13 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
         ArielMemoryManagerSimple(ComponentId_t id, Params& params);
         ~ArielMemoryManagerSimple();
 
-        uint64_t translateAddress(uint64_t virtAddr);
+        bool allocateMMAP(const uint64_t size, const uint32_t level, const uint64_t virtualAddress, const uint64_t instructionPointer, const uint32_t file, const uint32_t thread);
         void printStats();
         void get_page_info(std::unordered_map<uint64_t, uint64_t>*, std::deque<uint64_t>*, uint64_t&); 
 
+    protected:
+        uint64_t walkPageTables(uint64_t virtAddr, bool& cacheable);
+
     private:
         void allocate(const uint64_t size, const uint32_t level, const uint64_t virtualAddress);
 	void printTable();
@@ -61,7 +64,7 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
         uint64_t pageSize;
         std::deque<uint64_t> freePages;
 
-        std::unordered_map<uint64_t, uint64_t> pageTable;
+        ArielPageTable* pageTable;
 };
 
 }
@@ -0,0 +1,138 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "arielpagetable.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+using namespace SST::ArielComponent;
+
+ArielPageTable::ArielPageTable(Output* out, uint64_t pgSize) :
+            output(out), pageSize(pgSize), mappedPages(0), hugeEntries(0), nodeCount(0) {
+
+    if (pageSize < 2 || (pageSize & (pageSize - 1)) != 0) {
+        output->fatal(CALL_INFO, -1, "Ariel page table - page size %" PRIu64 " is not a power of two\n", pageSize);
+    }
+
+    pageShift = 0;
+    while ((UINT64_C(1) << pageShift) < pageSize) {
+        pageShift++;
+    }
+    pageMask = pageSize - 1;
+
+    // Enough levels to index every page of a 64-bit address space
+    levels = (64 - pageShift + ARIEL_PT_INDEX_BITS - 1) / ARIEL_PT_INDEX_BITS;
+
+    root = newNode();
+}
+
+ArielPageTable::~ArielPageTable() {
+    freeNode(root, levels - 1);
+}
+
+ArielPageTable::Node* ArielPageTable::newNode() {
+    Node* node = new Node();
+    memset(node->entry, 0, sizeof(node->entry));
+    nodeCount++;
+    return node;
+}
+
+void ArielPageTable::freeNode(Node* node, int32_t level) {
+    if (level > 0) {
+        for (uint64_t i = 0; i <= ARIEL_PT_INDEX_MASK; ++i) {
+            const uint64_t entry = node->entry[i];
+            if (0 != entry && 0 == (entry & ARIEL_PT_MAPPED)) {
+                freeNode(reinterpret_cast<Node*>(entry), level - 1);
+            }
+        }
+    }
+    delete node;
+}
+
+void ArielPageTable::mapRange(const uint64_t virtAddr, const uint64_t physAddr, const uint64_t pageCount) {
+    if (physAddr & pageMask) {
+        output->fatal(CALL_INFO, -1, "Ariel page table - physical address %" PRIu64 " is not aligned to the %" PRIu64 " byte page size\n",
+                physAddr, pageSize);
+    }
+
+    uint64_t virtPage = virtAddr >> pageShift;
+    uint64_t nextPhys = physAddr;
+    uint64_t pagesLeft = pageCount;
+
+    while (pagesLeft > 0) {
+        Node* node = root;
+
+        for (int32_t level = levels - 1; level >= 0; --level) {
+            const uint64_t span = UINT64_C(1) << (level * ARIEL_PT_INDEX_BITS);
+            uint64_t& entry = node->entry[(virtPage >> (level * ARIEL_PT_INDEX_BITS)) & ARIEL_PT_INDEX_MASK];
+
+            if (entry & ARIEL_PT_MAPPED) {
+                // Already mapped, keep the existing mapping and skip to the end of it
+                const uint64_t skip = std::min(pagesLeft, span - (virtPage & (span - 1)));
+                virtPage += skip;
+                nextPhys += skip << pageShift;
+                pagesLeft -= skip;
+                break;
+            }
+
+            if (0 == entry && (0 == level || (0 == (virtPage & (span - 1)) && pagesLeft >= span))) {
+                entry = nextPhys | ARIEL_PT_MAPPED;
+                if (level > 0) {
+                    hugeEntries++;
+                }
+                mappedPages += span;
+                virtPage += span;
+                nextPhys += span << pageShift;
+                pagesLeft -= span;
+                break;
+            }
+
+            if (0 == entry) {
+                entry = reinterpret_cast<uint64_t>(newNode());
+            }
+            node = reinterpret_cast<Node*>(entry);
+        }
+    }
+}
+
+void ArielPageTable::forEachPage(std::function<void(uint64_t, uint64_t)> visit) const {
+    visitNode(root, levels - 1, 0, visit);
+}
+
+void ArielPageTable::visitNode(const Node* node, int32_t level, uint64_t virtPage, std::function<void(uint64_t, uint64_t)>& visit) const {
+    const uint64_t span = UINT64_C(1) << (level * ARIEL_PT_INDEX_BITS);
+
+    for (uint64_t i = 0; i <= ARIEL_PT_INDEX_MASK; ++i) {
+        const uint64_t entry = node->entry[i];
+        const uint64_t firstPage = virtPage + i * span;
+
+        if (0 == entry) {
+            continue;
+        }
+
+        if (entry & ARIEL_PT_MAPPED) {
+            const uint64_t physBase = entry & ~ARIEL_PT_MAPPED;
+            for (uint64_t j = 0; j < span; ++j) {
+                visit((firstPage + j) << pageShift, physBase + (j << pageShift));
+            }
+        } else {
+            visitNode(reinterpret_cast<const Node*>(entry), level - 1, firstPage, visit);
+        }
+    }
+}
@@ -0,0 +1,121 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_ARIEL_PAGE_TABLE
+#define _H_ARIEL_PAGE_TABLE
+
+#include <sst/core/output.h>
+
+#include <stdint.h>
+#include <functional>
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Multi-level radix page table used by the Ariel memory managers.
+ *
+ * The virtual page number is split into 9-bit indices, one per level, with
+ * as many levels as it takes to cover a 64-bit address. Each entry is empty,
+ * points to the next level's node, or maps a physical address (low bit set).
+ * A mapping in an upper level covers every page under it, so a run of
+ * 512^n virtual pages that is aligned and physically contiguous takes a
+ * single entry (a huge page) instead of 512^n leaf entries.
+ *
+ * Mappings are never overwritten: as with inserting into the std::unordered_map
+ * this replaces, mapping a page that is already mapped leaves it as it is.
+ */
+#define ARIEL_PT_INDEX_BITS 9
+#define ARIEL_PT_INDEX_MASK ((UINT64_C(1) << ARIEL_PT_INDEX_BITS) - 1)
+#define ARIEL_PT_MAPPED     UINT64_C(1)
+
+class ArielPageTable {
+
+    public:
+        ArielPageTable(Output* out, uint64_t pageSize);
+        ~ArielPageTable();
+
+        /** Translate virtAddr; returns false if its page is not mapped */
+        bool lookup(const uint64_t virtAddr, uint64_t* physAddr) const {
+            const uint64_t virtPage = virtAddr >> pageShift;
+            const Node* node = root;
+
+            for (int32_t level = levels - 1; level >= 0; --level) {
+                const uint64_t entry = node->entry[(virtPage >> (level * ARIEL_PT_INDEX_BITS)) & ARIEL_PT_INDEX_MASK];
+
+                if (0 == entry) {
+                    return false;
+                }
+
+                if (entry & ARIEL_PT_MAPPED) {
+                    const uint64_t spanMask = (UINT64_C(1) << (level * ARIEL_PT_INDEX_BITS)) - 1;
+                    *physAddr = (entry & ~ARIEL_PT_MAPPED) + ((virtPage & spanMask) << pageShift) + (virtAddr & pageMask);
+                    return true;
+                }
+
+                node = reinterpret_cast<const Node*>(entry);
+            }
+
+            return false;
+        }
+
+        bool isMapped(const uint64_t virtAddr) const {
+            uint64_t physAddr;
+            return lookup(virtAddr, &physAddr);
+        }
+
+        /** Map the page holding virtAddr to the physical page at physAddr */
+        void map(const uint64_t virtAddr, const uint64_t physAddr) {
+            mapRange(virtAddr, physAddr, 1);
+        }
+
+        /** Map pageCount pages from virtAddr to physically contiguous pages from physAddr,
+         *  using huge entries wherever the run covers a whole aligned upper-level entry */
+        void mapRange(const uint64_t virtAddr, const uint64_t physAddr, const uint64_t pageCount);
+
+        /** Visit every mapped page, huge mappings are expanded one page at a time */
+        void forEachPage(std::function<void(uint64_t, uint64_t)> visit) const;
+
+        uint64_t getPageSize() const { return pageSize; }
+        uint64_t getMappedPages() const { return mappedPages; }
+        uint64_t getHugeEntries() const { return hugeEntries; }
+        uint64_t getNodeCount() const { return nodeCount; }
+        uint64_t getFootprint() const { return nodeCount * sizeof(Node); }
+
+    private:
+        struct Node {
+            uint64_t entry[UINT64_C(1) << ARIEL_PT_INDEX_BITS];
+        };
+
+        Node* newNode();
+        void freeNode(Node* node, int32_t level);
+        void visitNode(const Node* node, int32_t level, uint64_t virtPage, std::function<void(uint64_t, uint64_t)>& visit) const;
+
+        Output* output;
+        Node* root;
+        int32_t levels;
+        uint32_t pageShift;
+        uint64_t pageSize;
+        uint64_t pageMask;
+
+        uint64_t mappedPages;
+        uint64_t hugeEntries;
+        uint64_t nodeCount;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,139 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_ARIEL_PENDING_TABLE
+#define _H_SST_ARIEL_PENDING_TABLE
+
+#include <sst/core/interfaces/stdMem.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * A core's outstanding memory requests, keyed by request ID.
+ *
+ * Request IDs are handed out across the whole simulation, so a core's
+ * outstanding IDs are not dense; the table is a flat, open-addressed
+ * array with linear probing, sized from maxtranscore so that it does not
+ * allocate while the core runs. It only grows if more requests are
+ * outstanding than it was sized for (split accesses can briefly exceed
+ * maxtranscore).
+ */
+class ArielPendingTable {
+
+    public:
+        typedef SST::Interfaces::StandardMem::Request::id_t id_t;
+        typedef SST::Interfaces::StandardMem::Request Request;
+
+        ArielPendingTable(uint32_t expected) : count(0) {
+            size_t cap = 16;
+            while (cap < (size_t) expected * 2) {
+                cap <<= 1;
+            }
+            entries.resize(cap);
+            mask = cap - 1;
+        }
+
+        void insert(id_t id, Request* req) {
+            if ((count + 1) * 2 > entries.size()) {
+                grow();
+            }
+
+            size_t index = hash(id);
+            while (nullptr != entries[index].req) {
+                index = (index + 1) & mask;
+            }
+            entries[index].id = id;
+            entries[index].req = req;
+            count++;
+        }
+
+        bool contains(id_t id) const {
+            return find(id) != entries.size();
+        }
+
+        /** Remove the request with this ID, returns false if it is not pending */
+        bool erase(id_t id) {
+            size_t index = find(id);
+            if (index == entries.size()) {
+                return false;
+            }
+
+            // Backward-shift the rest of the probe run so no tombstones are needed
+            size_t next = (index + 1) & mask;
+            while (nullptr != entries[next].req) {
+                const size_t home = hash(entries[next].id);
+                if (((next - home) & mask) >= ((next - index) & mask)) {
+                    entries[index] = entries[next];
+                    index = next;
+                }
+                next = (next + 1) & mask;
+            }
+            entries[index].req = nullptr;
+            count--;
+            return true;
+        }
+
+        size_t size() const { return count; }
+
+    private:
+        struct Entry {
+            id_t id;
+            Request* req;
+            Entry() : id(0), req(nullptr) { }
+        };
+
+        size_t hash(id_t id) const {
+            return (size_t) ((((uint64_t) id) * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & mask;
+        }
+
+        size_t find(id_t id) const {
+            size_t index = hash(id);
+            while (nullptr != entries[index].req) {
+                if (entries[index].id == id) {
+                    return index;
+                }
+                index = (index + 1) & mask;
+            }
+            return entries.size();
+        }
+
+        void grow() {
+            std::vector<Entry> old;
+            old.swap(entries);
+            entries.resize(old.size() * 2);
+            mask = entries.size() - 1;
+            count = 0;
+            for (size_t i = 0; i < old.size(); i++) {
+                if (nullptr != old[i].req) {
+                    insert(old[i].id, old[i].req);
+                }
+            }
+        }
+
+        std::vector<Entry> entries;
+        size_t mask;
+        size_t count;
+};
+
+}
+}
+
+#endif
@@ -24,13 +24,16 @@ using namespace SST;
 namespace SST {
 namespace ArielComponent {
 
+// Payloads up to this size (the tunnel's ARIEL_MAX_PAYLOAD_SIZE) are held in the event itself
+#define ARIEL_WRITE_EVENT_INLINE_PAYLOAD 64
+
 class ArielWriteEvent : public ArielEvent {
 
     public:
         ArielWriteEvent(uint64_t wAddr, uint32_t length, const uint8_t* payloadData) :
                 writeAddress(wAddr), writeLength(length) {
 
-                payload = new uint8_t[length];
+                payload = length > ARIEL_WRITE_EVENT_INLINE_PAYLOAD ? new uint8_t[length] : inlinePayload;
 
                 for( int i = 0; i < length; ++i ) {
                 	payload[i] = payloadData[i];
@@ -38,7 +41,9 @@ class ArielWriteEvent : public ArielEvent {
         }
 
         ~ArielWriteEvent() {
-        	delete[] payload;
+        	if(payload != inlinePayload) {
+        		delete[] payload;
+        	}
         }
 
         ArielEventType getEventType() const {
@@ -61,6 +66,7 @@ class ArielWriteEvent : public ArielEvent {
         const uint64_t writeAddress;
         const uint32_t writeLength;
               uint8_t* payload;
+              uint8_t inlinePayload[ARIEL_WRITE_EVENT_INLINE_PAYLOAD];
 
 };
 
@@ -52,6 +52,7 @@
 
 #include <sst/core/interprocess/mmapchild_pin3.h>
 #include "ariel_shmem.h"
+#include "ariel_batch.h"
 #include "ariel_inst_class.h"
 
 #undef __STDC_FORMAT_MACROS
@@ -68,6 +69,7 @@ KNOB<UINT32> StartupMode            (KNOB_MODE_WRITEONCE, "pintool", "s", "1", "
 // Instrumentation control
 KNOB<UINT32> InstrumentInstructions (KNOB_MODE_WRITEONCE, "pintool", "E", "1", "Enable instruction instrumentation");
 KNOB<UINT32> PerformWriteTrace      (KNOB_MODE_WRITEONCE, "pintool", "w", "0", "Perform write tracing (i.e copy values directly into SST memory operations) (0 = disabled, 1 = enabled)");
+KNOB<UINT32> BatchRecords           (KNOB_MODE_WRITEONCE, "pintool", "b", "0", "Pack instruction records into batched, delta-encoded tunnel messages (0 = disabled, 1 = enabled)");
 KNOB<UINT32> TrapFunctionProfile    (KNOB_MODE_WRITEONCE, "pintool", "t", "0", "Function profiling level (0 = disabled, 1 = enabled)");
 // Memory/malloc/etc. tracking
 KNOB<UINT32> InterceptMemAllocations(KNOB_MODE_WRITEONCE, "pintool", "m", "1", "Should intercept multi-level memory allocations, mallocs, and frees, 1 = start enabled, 0 = start disabled");
@@ -96,6 +98,8 @@ PIN_LOCK mainLock;
 // Instrumentation control
 UINT32 instrument_instructions;
 bool writeTrace;
+bool batchRecords;
+std::vector<ArielBatchEncoder> batchEncoders; // Per-core, only touched by the thread writing that core's buffer
 UINT32 funcProfileLevel;
 typedef struct {
     int64_t insExecuted;
@@ -283,16 +287,41 @@ VOID InstrumentTrace (TRACE trace, VOID* args)
 /******************** END SHADOW STACK **************************/
 /****************************************************************/
 
+/* Send any instruction records batched for this core */
+VOID FlushBatch(UINT32 thr)
+{
+    ArielBatchEncoder& batch = batchEncoders[thr];
+    if(!batch.empty()) {
+        tunnel->writeMessage(thr, batch.getMessage());
+        batch.clear();
+    }
+}
+
+/* Send a command, after any instruction records batched ahead of it */
+VOID WriteCommand(UINT32 thr, const ArielCommand& ac)
+{
+    if(batchRecords && thr < core_count) {
+        FlushBatch(thr);
+    }
+    tunnel->writeMessage(thr, ac);
+}
+
 VOID Fini(INT32 code, VOID* v)
 {
     if(SSTVerbosity.Value() > 0) {
         std::cout << "SSTARIEL: Execution completed, shutting down." << std::endl;
     }
 
+    if(batchRecords) {
+        for(UINT32 i = 0; i < core_count; i++) {
+            FlushBatch(i);
+        }
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_PERFORM_EXIT;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(0, ac);
+    WriteCommand(0, ac);
 
     delete tunnelmgr;
 #ifdef HAVE_CUDA
@@ -340,7 +369,7 @@ VOID WriteFlushInstructionMarker(UINT32 thr, ADDRINT ip, ADDRINT vaddr)
     ac.instPtr = (uint64_t) ip;
     ac.flushline.vaddr = (uint32_t) vaddr;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
@@ -349,7 +378,7 @@ VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
     ac.command = ARIEL_FENCE_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRINT ip,
@@ -358,6 +387,14 @@ VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRI
 
     const uint64_t addr64 = (uint64_t) address;
 
+    if(batchRecords) {
+        if(!batchEncoders[thr].appendRead(addr64, readSize)) {
+            FlushBatch(thr);
+            batchEncoders[thr].appendRead(addr64, readSize);
+        }
+        return;
+    }
+
     ArielCommand ac;
 
     ac.command = ARIEL_PERFORM_READ;
@@ -375,6 +412,21 @@ VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADD
 {
 
     const uint64_t addr64 = (uint64_t) address;
+
+    if(batchRecords) {
+        uint8_t payload[ARIEL_MAX_PAYLOAD_SIZE];
+        const uint8_t* payloadPtr = NULL;
+        if( writeTrace ) {
+            PIN_SafeCopy( &payload[0], address, ARIEL_MIN( writeSize, (UINT32) ARIEL_MAX_PAYLOAD_SIZE ) );
+            payloadPtr = &payload[0];
+        }
+        if(!batchEncoders[thr].appendWrite(addr64, writeSize, payloadPtr)) {
+            FlushBatch(thr);
+            batchEncoders[thr].appendWrite(addr64, writeSize, payloadPtr);
+        }
+        return;
+    }
+
     ArielCommand ac;
 
     ac.command = ARIEL_PERFORM_WRITE;
@@ -402,16 +454,34 @@ VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADD
     tunnel->writeMessage(thr, ac);
 }
 
-VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip)
+VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip, UINT32 instClass, UINT32 simdOpWidth)
 {
+    if(batchRecords) {
+        if(!batchEncoders[thr].appendStart(ip, instClass, simdOpWidth)) {
+            FlushBatch(thr);
+            batchEncoders[thr].appendStart(ip, instClass, simdOpWidth);
+        }
+        return;
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_START_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
+    ac.inst.instClass = instClass;
+    ac.inst.simdElemCount = simdOpWidth;
     tunnel->writeMessage(thr, ac);
 }
 
 VOID WriteEndInstructionMarker(UINT32 thr, ADDRINT ip)
 {
+    if(batchRecords) {
+        if(!batchEncoders[thr].appendEnd()) {
+            FlushBatch(thr);
+            batchEncoders[thr].appendEnd();
+        }
+        return;
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_END_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
@@ -425,7 +495,7 @@ VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
 
     if(enable_output) {
         if(thr < core_count) {
-            WriteStartInstructionMarker( thr, ip );
+            WriteStartInstructionMarker( thr, ip, instClass, simdOpWidth );
             WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
             WriteInstructionWrite( writeAddr, writeSize, thr, ip, instClass, simdOpWidth );
             WriteEndInstructionMarker( thr, ip );
@@ -440,7 +510,7 @@ VOID WriteInstructionReadOnly(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
     if(enable_output) {
         if(thr < core_count) {
             if (first)
-                WriteStartInstructionMarker(thr, ip);
+                WriteStartInstructionMarker(thr, ip, instClass, simdOpWidth);
             WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
             if (last)
                 WriteEndInstructionMarker(thr, ip);
@@ -453,6 +523,14 @@ VOID WriteNoOp(THREADID thr, ADDRINT ip)
 {
     if(enable_output) {
         if(thr < core_count) {
+            if(batchRecords) {
+                if(!batchEncoders[thr].appendNoOp(ip)) {
+                    FlushBatch(thr);
+                    batchEncoders[thr].appendNoOp(ip);
+                }
+                return;
+            }
+
             ArielCommand ac;
             ac.command = ARIEL_NOOP;
             ac.instPtr = (uint64_t) ip;
@@ -468,7 +546,7 @@ VOID WriteInstructionWriteOnly(THREADID thr, ADDRINT* writeAddr, UINT32 writeSiz
     if(enable_output) {
         if(thr < core_count) {
             if (first)
-                WriteStartInstructionMarker(thr, ip);
+                WriteStartInstructionMarker(thr, ip, instClass, simdOpWidth);
             WriteInstructionWrite(writeAddr, writeSize,  thr, ip, instClass, simdOpWidth);
             if (last)
                 WriteEndInstructionMarker(thr, ip);
@@ -753,7 +831,7 @@ void mapped_ariel_output_stats()
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 // same effect as mapped_ariel_output_stats(), but it also sends a user-defined reference number back
@@ -763,7 +841,7 @@ void mapped_ariel_output_stats_buoy(uint64_t marker)
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) marker; //user the instruction pointer slot to send the marker number
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 void mapped_ariel_flushline(void *virtualAddress)
@@ -817,7 +895,7 @@ int ariel_mlm_memcpy(void* dest, void* source, size_t size) {
     ac.dma_start.dest = ariel_dest;
     ac.dma_start.len = length;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "Done with ariel memcpy.\n");
@@ -845,7 +923,7 @@ void ariel_mlm_set_pool(int new_pool)
     ArielCommand ac;
     ac.command = ARIEL_SWITCH_POOL;
     ac.switchPool.pool = newDefaultPool;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     // Keep track of the default pool
     default_pool = (UINT32) new_pool;
@@ -897,7 +975,7 @@ void* ariel_mmap_mlm(int fileID, size_t size, int level)
     std::cout<<"File ID at FESIMPLE IS : "<<ac.mlm_mmap.fileID<<std::endl;
     std::cout<<"After ******"<<std::endl;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mmap_mlm call allocates data at address: 0x%llx\n",
@@ -952,7 +1030,7 @@ void* ariel_mlm_malloc(size_t size, int level) {
         ac.mlm_map.alloc_level = allocationLevel;
     }
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mlm_malloc call allocates data at address: 0x%llx\n",
@@ -997,7 +1075,7 @@ void ariel_mlm_free(void* ptr)
         ArielCommand ac;
         ac.command = ARIEL_ISSUE_TLM_FREE;
         ac.mlm_free.vaddr = virtAddr;
-        tunnel->writeMessage(thr, ac);
+        WriteCommand(thr, ac);
 
     } else {
         fprintf(stderr, "ARIEL: Call to free in Ariel did not find a matching local allocation, this memory will be leaked.\n");
@@ -1049,14 +1127,14 @@ VOID ariel_postmalloc_instrument(ADDRINT allocLocation)
                 if (toFast[thr].count == 0) {
                     toFast[thr].valid = false;
                 }
-                tunnel->writeMessage(thr, ac);
+                WriteCommand(thr, ac);
             }
         } else if (shouldOverride) {
             ac.mlm_map.alloc_level = overridePool;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         } else if (InterceptMemAllocations.Value()) {
             ac.mlm_map.alloc_level = allocationLevel;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         }
 
         /*printf("ARIEL: Created a malloc of size: %" PRIu64 " in Ariel\n",
@@ -1083,7 +1161,7 @@ __host__ cudaError_t CUDARTAPI cudaMalloc(void **devPtr, size_t size){
     ac.API.name = GPU_MALLOC;
     ac.API.CA.cuda_malloc.dev_ptr = devPtr;
     ac.API.CA.cuda_malloc.size = size;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail = false;
@@ -1113,7 +1191,7 @@ void** CUDARTAPI __cudaRegisterFatBinary(void *fatCubin) {
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_REG_FAT_BINARY;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1154,7 +1232,7 @@ void CUDARTAPI __cudaRegisterFunction(
     ac.API.CA.register_function.fat_cubin_handle = (unsigned)(unsigned long long)fatCubinHandle;
     ac.API.CA.register_function.host_fun = reinterpret_cast<uint64_t>(hostFun);
     strncpy(ac.API.CA.register_function.device_fun, deviceFun, 512);
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1219,7 +1297,7 @@ __host__ cudaError_t CUDARTAPI cudaMemcpy(void *dst, const void *src, size_t cou
     ac.API.CA.cuda_memcpy.src = (uint64_t) src;
     ac.API.CA.cuda_memcpy.count = count;
     ac.API.CA.cuda_memcpy.kind = final_kind;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     if(final_kind == cudaMemcpyHostToDevice) {
         if(count <= max_page_size){
@@ -1348,7 +1426,7 @@ __host__ cudaError_t CUDARTAPI cudaConfigureCall(dim3 gridDim, dim3 blockDim, si
     ac.API.CA.cfg_call.bdz = blockDim.z;
     ac.API.CA.cfg_call.sharedMem = sharedMem;
     ac.API.CA.cfg_call.stream = stream;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1396,7 +1474,7 @@ __host__ cudaError_t CUDARTAPI cudaSetupArgument(const void *arg, size_t size, s
     ac.API.CA.set_arg.offset = offset;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_SET_ARG;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1421,7 +1499,7 @@ __host__ cudaError_t CUDARTAPI cudaLaunch(const void *func){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_LAUNCH;
     ac.API.CA.cuda_launch.func = reinterpret_cast<uint64_t>(func);
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1445,7 +1523,7 @@ __host__ cudaError_t CUDARTAPI cudaFree(void *devPtr){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_FREE;
     ac.API.CA.free_address = (uint64_t)devPtr;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1468,7 +1546,7 @@ __host__ __cudart_builtin__ cudaError_t CUDARTAPI cudaGetLastError(void){
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_GET_LAST_ERROR;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
     GpuCommand gc;
 
     bool avail=false;
@@ -1507,7 +1585,7 @@ void CUDARTAPI __cudaRegisterVar(
     ac.API.CA.register_var.size = size;
     ac.API.CA.register_var.constant = constant;
     ac.API.CA.register_var.global = global;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1543,7 +1621,7 @@ __host__ cudaError_t CUDARTAPI __maxActiveBlock(
     ac.API.CA.max_active_block.blockSize = blockSize;
     ac.API.CA.max_active_block.dynamicSMemSize = dynamicSMemSize;
     ac.API.CA.max_active_block.flags = flags;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1571,7 +1649,7 @@ VOID ariel_postfree_instrument(ADDRINT allocLocation)
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_TLM_FREE;
     ac.mlm_free.vaddr = virtAddr;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 void mapped_ariel_malloc_flag_fortran(int* mallocLocId, int* count, int* level)
@@ -1618,7 +1696,7 @@ void ariel_start_RTL_sim(RTL_shmem_info* rtl_shmem) {
 
     THREADID thr = PIN_ThreadId();
     const uint32_t thrID = (uint32_t) thr;
-    tunnel->writeMessage(thrID, acRtl);
+    WriteCommand(thrID, acRtl);
     #ifdef ARIEL_DEBUG
     fprintf(stderr, "\nMessage to add RTL Event into Ariel Event Queue successfully delivered via ArielTunnel");
     #endif
@@ -1639,7 +1717,7 @@ void ariel_update_RTL_signals(RTL_shmem_info* rtl_shmem) {
 
     THREADID thr = PIN_ThreadId();
     const uint32_t thrID = (uint32_t) thr;
-    tunnel->writeMessage(thrID, acRtl);
+    WriteCommand(thrID, acRtl);
     #ifdef ARIEL_DEBUG
     fprintf(stderr, "\nMessage to add RTL Event into Ariel Event Queue to update RTL signals successfully delivered via ArielTunnel");
     #endif
@@ -1908,6 +1986,14 @@ int main(int argc, char *argv[])
     core_count = MaxCoreCount.Value();
     instrument_instructions = InstrumentInstructions.Value();
 
+    batchRecords = BatchRecords.Value() > 0;
+    if(batchRecords) {
+        batchEncoders.resize(core_count);
+        if(SSTVerbosity.Value() > 0) {
+            printf("SSTARIEL: Batching instruction records in the tunnel.\n");
+        }
+    }
+
 // Pin version specific tunnel attach
     tunnelmgr = new SST::Core::Interprocess::MMAPChild_Pin3<ArielTunnel>(SSTNamedPipe.Value());
     tunnel = tunnelmgr->getTunnel();
@@ -75,6 +75,7 @@ class Pin3Frontend : public ArielFrontend {
         {"mallocmapfile", "File with valid 'ariel_malloc_flag' ids", ""},
         {"tracePrefix", "Prefix when tracing is enable", ""},
         {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"},
+        {"tunnelbatch", "Pack instruction records into batched, delta-encoded tunnel messages (Pin3 only)", "0"},
         {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"})
 
         /* Ariel class */
@@ -0,0 +1,77 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "replayfrontend.h"
+
+#include <stdlib.h>
+
+using namespace SST::ArielComponent;
+
+ReplayFrontend::ReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t maxCoreQueueLen, uint32_t defMemPool) :
+            ArielFrontend(id, params, cores, maxCoreQueueLen, defMemPool) {
+
+    int verbosity = params.find<int>("verbose", 0);
+    output = new SST::Output("ReplayFrontend[@f:@l:@p] ", verbosity, 0, SST::Output::STDOUT);
+
+    core_count = cores;
+
+    std::string prefix = params.find<std::string>("commandtrace", "");
+    if("" == prefix) {
+        output->fatal(CALL_INFO, -1, "The replay frontend requires the commandtrace parameter (the prefix the traces were recorded with)\n");
+    }
+
+    const uint32_t maxChunks = params.find<uint32_t>("readahead_chunks", 4);
+    const size_t chunkSize = params.find<size_t>("chunk_size", 1048576);
+
+    // Nothing is written to the tunnel, it only holds the shared time and cycle counters
+    tunnel = new ArielTunnel(core_count, 2, 0);
+    tunnelRegion = calloc(1, tunnel->getTunnelSize());
+    if(NULL == tunnelRegion) {
+        output->fatal(CALL_INFO, -1, "Unable to allocate the replay tunnel\n");
+    }
+    tunnel->initialize(tunnelRegion);
+
+    output->verbose(CALL_INFO, 1, 0, "Replaying %" PRIu32 " cores from traces with prefix %s\n", core_count, prefix.c_str());
+
+    for(uint32_t i = 0; i < core_count; i++) {
+        readers.push_back(new ArielCommandTraceReader(output, prefix, i, chunkSize, maxChunks));
+    }
+}
+
+ReplayFrontend::~ReplayFrontend() {
+    finish();
+
+    delete tunnel;
+    free(tunnelRegion);
+    delete output;
+}
+
+void ReplayFrontend::finish() {
+    for(uint32_t i = 0; i < readers.size(); i++) {
+        delete readers[i];
+    }
+    readers.clear();
+}
+
+ArielTunnel* ReplayFrontend::getTunnel() {
+    return tunnel;
+}
+
+ArielCommandTraceReader* ReplayFrontend::getCommandTrace(uint32_t core) {
+    return core < readers.size() ? readers[core] : nullptr;
+}
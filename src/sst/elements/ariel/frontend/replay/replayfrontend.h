@@ -0,0 +1,75 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_REPLAY_FRONTEND
+#define _H_REPLAY_FRONTEND
+
+#include <sst/core/sst_config.h>
+#include <sst/core/params.h>
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "arielfrontend.h"
+#include "arielcmdtrace.h"
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Replays the command streams recorded with ArielCPU's "commandtrace"
+ * parameter instead of running the application under PIN. The tunnel it
+ * hands out is local to the process and only carries the simulated time;
+ * the cores read their commands from the trace readers.
+ */
+class ReplayFrontend : public ArielFrontend {
+    public:
+
+    /* SST ELI */
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(ReplayFrontend, "ariel", "frontend.replay", SST_ELI_ELEMENT_VERSION(1,0,0), "Ariel frontend that replays recorded command traces without PIN", SST::ArielComponent::ArielFrontend)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+        {"commandtrace", "Prefix the traces were recorded with; core N replays <commandtrace>-N.cmd[.gz]", ""},
+        {"readahead_chunks", "Number of decompressed chunks to buffer ahead of each core", "4"},
+        {"chunk_size", "Size in bytes of each decompressed chunk", "1048576"})
+
+        /* Ariel class */
+        ReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t qSize, uint32_t memPool);
+        ~ReplayFrontend();
+        virtual void init(unsigned int phase) { }
+        virtual void finish();
+        virtual ArielTunnel* getTunnel();
+        virtual ArielCommandTraceReader* getCommandTrace(uint32_t core);
+
+    private:
+
+        SST::Output* output;
+
+        uint32_t core_count;
+        ArielTunnel* tunnel;
+        void* tunnelRegion;
+
+        std::vector<ArielCommandTraceReader*> readers;
+
+};
+
+}
+}
+
+#endif
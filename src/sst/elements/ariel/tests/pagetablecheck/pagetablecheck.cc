@@ -0,0 +1,205 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Checks ArielPageTable against a std::unordered_map reference without SST.
+ *
+ * Single pages, runs that cover whole aligned upper-level entries (huge
+ * entries) and runs that overlap earlier mappings are mapped into both the
+ * page table and a page-to-physical-page map. As with the map, a page that is
+ * already mapped keeps its first mapping, and the pages of a run after it
+ * still get their own offset into the run. Then:
+ *  - lookups of random addresses, mapped and unmapped, must agree with the
+ *    reference, including the offset within the page
+ *  - forEachPage must visit exactly the reference's pages, with huge entries
+ *    expanded page by page
+ *  - the mapped page count must match and huge entries must have been used
+ *
+ * Usage: pagetablecheck [seed]
+ */
+
+#include <sst_config.h>
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <random>
+#include <unordered_map>
+
+#include "arielpagetable.h"
+
+using namespace SST::ArielComponent;
+
+// The page table only uses Output to report fatal errors, so provide that
+// here and the check links without the SST core library
+void SST::Output::fatal(uint32_t line, const char* file, const char* func, int exit_code, const char* format, ...) const {
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "%s:%" PRIu32 " (%s): ", file, line, func);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    exit(exit_code);
+}
+
+class Checker {
+public:
+    Checker(uint64_t pageSize, uint64_t seed) :
+        table(nullptr, pageSize), pageSize(pageSize), rng(seed), errors(0) {}
+
+    void mapRange(uint64_t virtAddr, uint64_t physAddr, uint64_t pageCount) {
+        table.mapRange(virtAddr, physAddr, pageCount);
+
+        const uint64_t firstPage = virtAddr / pageSize;
+        for (uint64_t i = 0; i < pageCount; i++) {
+            reference.insert(std::make_pair(firstPage + i, physAddr + i * pageSize));
+        }
+    }
+
+    void map(uint64_t virtAddr, uint64_t physAddr) {
+        table.map(virtAddr, physAddr);
+        reference.insert(std::make_pair(virtAddr / pageSize, physAddr));
+    }
+
+    // Random addresses near the mapped ones, so most pages are mapped and
+    // the rest are their unmapped neighbours
+    void checkLookups(uint64_t count) {
+        std::vector<uint64_t> pages;
+        for (auto& entry : reference) {
+            pages.push_back(entry.first);
+        }
+
+        std::uniform_int_distribution<uint64_t> pick(0, pages.size() - 1);
+        std::uniform_int_distribution<int64_t> near(-2, 2);
+        std::uniform_int_distribution<uint64_t> offset(0, pageSize - 1);
+
+        for (uint64_t i = 0; i < count; i++) {
+            const uint64_t page = pages[pick(rng)] + near(rng);
+            const uint64_t virtAddr = page * pageSize + offset(rng);
+
+            uint64_t physAddr = 0;
+            const bool mapped = table.lookup(virtAddr, &physAddr);
+            auto expected = reference.find(page);
+
+            if (mapped != (expected != reference.end())) {
+                fail("lookup of 0x%" PRIx64 " says %s, reference says %s\n", virtAddr,
+                        mapped ? "mapped" : "unmapped", mapped ? "unmapped" : "mapped");
+            } else if (mapped && physAddr != expected->second + (virtAddr % pageSize)) {
+                fail("lookup of 0x%" PRIx64 " gives 0x%" PRIx64 ", reference gives 0x%" PRIx64 "\n", virtAddr,
+                        physAddr, expected->second + (virtAddr % pageSize));
+            }
+        }
+    }
+
+    void checkPages() {
+        std::unordered_map<uint64_t, uint64_t> visited;
+        table.forEachPage([&](uint64_t virtAddr, uint64_t physAddr) {
+            if (!visited.insert(std::make_pair(virtAddr / pageSize, physAddr)).second) {
+                fail("forEachPage visits 0x%" PRIx64 " twice\n", virtAddr);
+            }
+        });
+
+        if (visited != reference) {
+            fail("forEachPage pages differ from the reference (%zu visited, %zu in the reference)\n", visited.size(), reference.size());
+        }
+        if (table.getMappedPages() != reference.size()) {
+            fail("page table counts %" PRIu64 " mapped pages, reference has %zu\n", table.getMappedPages(), reference.size());
+        }
+        if (table.getHugeEntries() == 0) {
+            fail("no huge entries were used\n");
+        }
+    }
+
+    uint64_t getErrors() const { return errors; }
+    uint64_t getPages() const { return reference.size(); }
+    const ArielPageTable& getTable() const { return table; }
+
+private:
+    void fail(const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        fprintf(stderr, "Page size %" PRIu64 ": ", pageSize);
+        vfprintf(stderr, format, args);
+        va_end(args);
+        errors++;
+    }
+
+    ArielPageTable table;
+    std::unordered_map<uint64_t, uint64_t> reference;
+    uint64_t pageSize;
+    std::mt19937_64 rng;
+    uint64_t errors;
+};
+
+static uint64_t check(uint64_t pageSize, uint64_t seed) {
+    Checker checker(pageSize, seed);
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<uint64_t> region(0, 1023);
+
+    const uint64_t hugePages = UINT64_C(1) << ARIEL_PT_INDEX_BITS;
+    const uint64_t hugeSize = hugePages * pageSize;
+    uint64_t nextPhys = UINT64_C(1) << 40;
+
+    // Single pages scattered over a large range
+    for (int i = 0; i < 2000; i++) {
+        checker.map(region(rng) * hugeSize + (rng() % hugePages) * pageSize + (rng() % pageSize), nextPhys);
+        nextPhys += pageSize;
+    }
+
+    // Runs that start on and off huge boundaries, some covering several huge entries
+    const uint64_t base = UINT64_C(2048) * hugeSize;
+    checker.mapRange(base, nextPhys, 3 * hugePages);
+    nextPhys += 3 * hugeSize;
+    checker.mapRange(base + 4 * hugeSize + 17 * pageSize, nextPhys, 2 * hugePages + 5);
+    nextPhys += (2 * hugePages + 5) * pageSize;
+
+    // A whole second-level entry maps as a single entry
+    const uint64_t giantBase = UINT64_C(64) * hugePages * hugeSize;
+    checker.mapRange(giantBase, nextPhys, hugePages * hugePages);
+    nextPhys += hugePages * hugeSize;
+
+    // Overlapping runs: these cover single pages, the partial runs and the
+    // huge entries above, which must all keep their first mapping
+    for (int i = 0; i < 200; i++) {
+        const uint64_t start = region(rng) * hugeSize + (rng() % hugePages) * pageSize;
+        const uint64_t pages = 1 + rng() % (2 * hugePages);
+        checker.mapRange(start, nextPhys, pages);
+        nextPhys += pages * pageSize;
+    }
+    checker.mapRange(base + hugeSize - 3 * pageSize, nextPhys, hugePages + 6);
+    nextPhys += (hugePages + 6) * pageSize;
+    checker.mapRange(base + 3 * hugeSize, nextPhys, 2 * hugePages + 40);
+    nextPhys += (2 * hugePages + 40) * pageSize;
+    checker.mapRange(giantBase - 2 * pageSize, nextPhys, 4);
+    nextPhys += 4 * pageSize;
+
+    checker.checkLookups(200000);
+    checker.checkPages();
+
+    printf("Page size %" PRIu64 ": %" PRIu64 " pages, %" PRIu64 " huge entries, %" PRIu64 " nodes, %" PRIu64 " errors\n",
+            pageSize, checker.getPages(), checker.getTable().getHugeEntries(), checker.getTable().getNodeCount(), checker.getErrors());
+    return checker.getErrors();
+}
+
+int main(int argc, char* argv[]) {
+    const uint64_t seed = (argc > 1) ? strtoull(argv[1], NULL, 0) : 1;
+
+    uint64_t errors = 0;
+    errors += check(4096, seed);
+    errors += check(65536, seed);
+
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+import sst
+import os
+
+# Runs the stream example under PIN while recording each core's command
+# stream (ARIEL_REPLAY_MODE=record), or replays the recorded streams
+# without PIN (ARIEL_REPLAY_MODE=replay). Both runs write the same
+# statistics to ARIEL_REPLAY_STATS so they can be compared.
+#
+# triad_cmds-0/1.cmd.gz in this directory are two small checked-in
+# streams (a[i] = b[i] + 3.0 * c[i] over 256 doubles per core, then a
+# flush and a fence; core 0 waits and exits) that replay without PIN:
+#
+#   ARIEL_REPLAY_MODE=replay ARIEL_REPLAY_PREFIX=<this dir>/triad_cmds sst recordreplay.py
+
+sst.setProgramOption("timebase", "1ps")
+
+mode = os.getenv("ARIEL_REPLAY_MODE", "record")
+trace_prefix = os.getenv("ARIEL_REPLAY_PREFIX", "./stream_cmds")
+stats_file = os.getenv("ARIEL_REPLAY_STATS", "./stream_{0}.csv".format(mode))
+
+corecount = 2
+
+ariel = sst.Component("a0", "ariel.ariel")
+ariel.addParams({
+        "verbose" : "0",
+        "corecount" : corecount,
+        "maxcorequeue" : "256",
+        "maxissuepercycle" : "2",
+        "pipetimeout" : "0",
+        })
+
+memmgr = ariel.setSubComponent("memmgr", "ariel.MemoryManagerSimple")
+
+if mode == "record":
+    app = os.getenv("ARIEL_TEST_STREAM_APP")
+    ariel.addParams({
+        "executable" : app,
+        "arielmode" : "1",
+        "launchparamcount" : 1,
+        "launchparam0" : "-ifeellucky",
+        "commandtrace" : trace_prefix,
+        })
+else:
+    frontend = ariel.setSubComponent("frontend", "ariel.frontend.replay")
+    frontend.addParams({
+        "commandtrace" : trace_prefix,
+        })
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+        "clock" : "1GHz",
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+        "access_time" : "10ns",
+        "mem_size" : "2048MiB",
+})
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({
+        "bus_frequency" : "2 Ghz",
+})
+
+for core in range(corecount):
+    l1cache = sst.Component("l1cache_" + str(core), "memHierarchy.Cache")
+    l1cache.addParams({
+        "cache_frequency" : "2 Ghz",
+        "cache_size" : "64 KB",
+        "coherence_protocol" : "MSI",
+        "replacement_policy" : "lru",
+        "associativity" : "8",
+        "access_latency_cycles" : "1",
+        "cache_line_size" : "64",
+        "L1" : "1",
+        "debug" : "0",
+    })
+    l1cache.enableStatistics(["CacheHits", "CacheMisses"])
+
+    cpu_cache_link = sst.Link("cpu_cache_link_" + str(core))
+    cpu_cache_link.connect( (ariel, "cache_link_" + str(core), "50ps"), (l1cache, "high_network_0", "50ps") )
+
+    bus_link = sst.Link("bus_link_" + str(core))
+    bus_link.connect( (l1cache, "low_network_0", "50ps"), (bus, "high_network_" + str(core), "50ps") )
+
+memory_link = sst.Link("mem_bus_link")
+memory_link.connect( (bus, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
+
+sst.setStatisticLoadLevel(5)
+sst.setStatisticOutput("sst.statOutputCSV", {"filepath" : stats_file, "separator" : ", "})
+
+ariel.enableStatistics([
+      "cycles",
+      "active_cycles",
+      "instruction_count",
+      "read_requests",
+      "write_requests",
+      "fp_dp_ins",
+      "flush_requests",
+      "fence_requests"
+])
@@ -3,6 +3,8 @@
 from sst_unittest import *
 from sst_unittest_support import *
 import os
+import filecmp
+import csv
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -46,6 +48,8 @@ class testcase_Ariel(SSTTestCase):
 
 #####
     pin_loaded = testing_is_PIN_loaded()
+    libz_missing = not sst_elements_config_include_file_get_value_int("HAVE_LIBZ", default=0, disable_warning=True)
+    cuda_built = sst_elements_config_include_file_get_value_int("HAVE_CUDA", default=0, disable_warning=True)
 
     @unittest.skipIf(not pin_loaded, "Ariel: Requires PIN, but Env Var 'INTEL_PIN_DIRECTORY' is not found or path does not exist.")
     def test_Ariel_runstream(self):
@@ -77,8 +81,108 @@ class testcase_Ariel(SSTTestCase):
     @unittest.skipIf(not pin_loaded, "Ariel: Requires PIN, but Env Var 'INTEL_PIN_DIRECTORY' is not found or path does not exist.")
     def test_Ariel_test_snb_mlm(self):
         self.ariel_Template("ariel_snb_mlm", app="stream_mlm")
+
+    # Does not need PIN, checks that batched and unbatched tunnel records decode to the same stream
+    def test_Ariel_tunnel_bench(self):
+        test_path = self.get_testsuite_dir()
+        TunnelBenchDir = "{0}/tunnelbench".format(test_path)
+
+        rtn = OSCommand("make", set_cwd=TunnelBenchDir).run()
+        log_debug("Ariel tunnelbench Make result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "tunnelbench failed to compile")
+
+        cmd = "{0}/tunnelbench 200000 1".format(TunnelBenchDir)
+        rtn = OSCommand(cmd, set_cwd=TunnelBenchDir).run()
+        log_debug("Ariel tunnelbench result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "tunnelbench records did not round trip:\n{0}".format(rtn.output()))
+
+    # Does not need PIN, checks page table lookups against a map over mixed single, huge and overlapping mappings
+    def test_Ariel_page_table_check(self):
+        test_path = self.get_testsuite_dir()
+        PageTableCheckDir = "{0}/pagetablecheck".format(test_path)
+
+        rtn = OSCommand("make", set_cwd=PageTableCheckDir).run()
+        log_debug("Ariel pagetablecheck Make result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "pagetablecheck failed to compile")
+
+        cmd = "{0}/pagetablecheck 1".format(PageTableCheckDir)
+        rtn = OSCommand(cmd, set_cwd=PageTableCheckDir).run()
+        log_debug("Ariel pagetablecheck result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "page table does not match the reference map:\n{0}".format(rtn.output()))
+
+    # Records the stream example's command streams, replays them without PIN
+    # and checks that both runs produce the same statistics
+    @unittest.skipIf(not pin_loaded, "Ariel: Requires PIN, but Env Var 'INTEL_PIN_DIRECTORY' is not found or path does not exist.")
+    def test_Ariel_record_replay(self):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        ArielElementStreamDir = os.path.abspath("{0}/../frontend/simple/examples/stream".format(test_path))
+
+        sdlfile = "{0}/testRecordReplay/recordreplay.py".format(test_path)
+        os.environ["ARIEL_TEST_STREAM_APP"] = "{0}/stream".format(ArielElementStreamDir)
+        os.environ["ARIEL_REPLAY_PREFIX"] = "{0}/test_Ariel_record_replay".format(outdir)
+
+        stats = {}
+        for mode in ["record", "replay"]:
+            os.environ["ARIEL_REPLAY_MODE"] = mode
+            stats[mode] = "{0}/test_Ariel_record_replay_{1}.csv".format(outdir, mode)
+            os.environ["ARIEL_REPLAY_STATS"] = stats[mode]
+            outfile = "{0}/test_Ariel_record_replay_{1}.out".format(outdir, mode)
+            errfile = "{0}/test_Ariel_record_replay_{1}.err".format(outdir, mode)
+            self.run_sst(sdlfile, outfile, errfile, set_cwd=outdir, timeout_sec=480)
+
+        self.assertTrue(filecmp.cmp(stats["record"], stats["replay"], shallow=False),
+                        "Replayed statistics {0} differ from the recorded run's {1}".format(stats["replay"], stats["record"]))
+    # Replays the checked-in triad command streams without PIN and checks the
+    # statistics that depend only on the stream against the reference file.
+    # The traces hold ArielCommand in its non-CUDA layout.
+    @unittest.skipIf(libz_missing, "test_Ariel_replay_triad test: Requires LIBZ, but LIBZ is not found in build configuration.")
+    @unittest.skipIf(cuda_built, "test_Ariel_replay_triad test: The checked-in traces do not match the ArielCommand layout of a CUDA build.")
+    def test_Ariel_replay_triad(self):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        sdlfile = "{0}/testRecordReplay/recordreplay.py".format(test_path)
+        reffile = "{0}/testRecordReplay/refFiles/test_Ariel_replay_triad.csv".format(test_path)
+        statfile = "{0}/test_Ariel_replay_triad.csv".format(outdir)
+        outfile = "{0}/test_Ariel_replay_triad.out".format(outdir)
+        errfile = "{0}/test_Ariel_replay_triad.err".format(outdir)
+
+        # The configuration reads its settings from the environment; put
+        # it back afterwards so later tests do not see them
+        replay_env = { "ARIEL_REPLAY_MODE" : "replay",
+                       "ARIEL_REPLAY_PREFIX" : "{0}/testRecordReplay/triad_cmds".format(test_path),
+                       "ARIEL_REPLAY_STATS" : statfile }
+        saved_env = { name : os.environ.get(name) for name in replay_env }
+        os.environ.update(replay_env)
+        try:
+            self.run_sst(sdlfile, outfile, errfile, set_cwd=outdir)
+        finally:
+            for name, value in saved_env.items():
+                if value is None:
+                    del os.environ[name]
+                else:
+                    os.environ[name] = value
+
+        ref_stats = self.ariel_get_stat_values(reffile)
+        out_stats = self.ariel_get_stat_values(statfile)
+        for key, value in ref_stats.items():
+            self.assertEqual(out_stats.get(key), value,
+                             "Statistic {0} in {1} is {2}, expected (Sum, Count) {3}".format(key, statfile, out_stats.get(key), value))
+
 #####
 
+    # Returns {(component, statistic, subid) : (sum, count)} from a CSV statistics file
+    def ariel_get_stat_values(self, filename):
+        values = {}
+        with open(filename) as f:
+            rows = csv.DictReader(f, skipinitialspace=True)
+            for row in rows:
+                key = (row["ComponentName"], row["StatisticName"], row["StatisticSubId"])
+                values[key] = (row["Sum.u64"], row["Count.u64"])
+        return values
+
     def ariel_Template(self, testcase, app="", testtimeout=480):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
@@ -0,0 +1,335 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Measures Ariel tunnel throughput without PIN.
+ *
+ * A producer thread plays the part of the pintool and writes a synthetic
+ * instruction stream (loads, stores, read-modify-writes and no-ops over a few
+ * strided streams and a random region) into an ArielTunnel. A consumer thread
+ * plays the part of ArielCore::refillQueue and reads it back. The stream is
+ * sent once as one command per record and once as ARIEL_BATCH records, and
+ * both sides checksum what they sent and received.
+ *
+ * Usage: tunnelbench [instructions] [writepayloadtrace] [queue length]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <chrono>
+#include <thread>
+
+#include "ariel_shmem.h"
+#include "ariel_batch.h"
+
+using namespace SST::ArielComponent;
+
+struct BenchResult {
+    uint64_t records;
+    uint64_t messages;
+    uint64_t checksum;
+};
+
+static uint64_t mix(uint64_t sum, uint64_t type, uint64_t addr, uint64_t size) {
+    sum ^= type + 0x9e3779b97f4a7c15ULL + (sum << 6) + (sum >> 2);
+    sum ^= addr + 0x9e3779b97f4a7c15ULL + (sum << 6) + (sum >> 2);
+    sum ^= size + 0x9e3779b97f4a7c15ULL + (sum << 6) + (sum >> 2);
+    return sum;
+}
+
+// Deterministic synthetic instruction stream
+class SyntheticStream {
+public:
+    struct Instruction {
+        uint64_t ip;
+        uint32_t instClass;
+        uint32_t simdElemCount;
+        int      reads;
+        bool     write;
+        uint64_t readAddr[2];
+        uint64_t writeAddr;
+        uint32_t size;
+    };
+
+    SyntheticStream() : seed(0x2545F4914F6CDD1DULL), ip(0x400000) {
+        for ( int i = 0; i < 4; i++ ) stream[i] = 0x7f0000000000ULL + (uint64_t) i * 0x10000000ULL;
+    }
+
+    void next(Instruction* ins) {
+        const uint64_t r = rand();
+        ins->ip = ip;
+        ip += 1 + (r & 0xf);
+        if ( 0 == (r >> 60) ) ip = 0x400000 + ((r >> 8) & 0xfffff); // Occasional jump
+
+        const uint32_t kind = (r >> 4) % 10;
+        ins->reads = kind < 6 ? 1 : (kind < 7 ? 2 : (kind < 8 ? 1 : 0));
+        ins->write = (kind == 7 || kind == 8);
+        ins->size = (r >> 12) & 1 ? 8 : 4;
+        ins->instClass = (r >> 13) & 3 ? ARIEL_INST_INT : ARIEL_INST_DP_FP;
+        ins->simdElemCount = ins->instClass == ARIEL_INST_DP_FP ? 2 : 1;
+
+        for ( int i = 0; i < ins->reads; i++ ) ins->readAddr[i] = nextAddress(r >> (16 + 8 * i));
+        ins->writeAddr = nextAddress(r >> 40);
+    }
+
+private:
+    uint64_t seed;
+    uint64_t ip;
+    uint64_t stream[4];
+
+    uint64_t rand() {
+        seed ^= seed >> 12;
+        seed ^= seed << 25;
+        seed ^= seed >> 27;
+        return seed * 0x2545F4914F6CDD1DULL;
+    }
+
+    uint64_t nextAddress(uint64_t r) {
+        // Mostly unit stride streams, some random accesses within 64MB
+        if ( (r & 7) == 0 ) return 0x10000000ULL + (rand() & 0x3fffff8ULL);
+        uint64_t& s = stream[(r >> 3) & 3];
+        s += 8;
+        return s;
+    }
+};
+
+static void produceLegacy(ArielTunnel* tunnel, uint64_t count, bool payloads, BenchResult* result) {
+    SyntheticStream stream;
+    SyntheticStream::Instruction ins;
+    ArielCommand ac;
+    memset(&ac, 0, sizeof(ac));
+
+    for ( uint64_t i = 0; i < count; i++ ) {
+        stream.next(&ins);
+
+        if ( 0 == ins.reads && !ins.write ) {
+            ac.command = ARIEL_NOOP;
+            ac.instPtr = ins.ip;
+            tunnel->writeMessage(0, ac);
+            result->checksum = mix(result->checksum, ARIEL_BATCH_NOOP, 0, 0);
+            result->records++;
+            result->messages++;
+            continue;
+        }
+
+        ac.command = ARIEL_START_INSTRUCTION;
+        ac.instPtr = ins.ip;
+        ac.inst.instClass = ins.instClass;
+        ac.inst.simdElemCount = ins.simdElemCount;
+        tunnel->writeMessage(0, ac);
+        result->checksum = mix(result->checksum, ARIEL_BATCH_START, ins.ip, ins.instClass);
+
+        for ( int r = 0; r < ins.reads; r++ ) {
+            ac.command = ARIEL_PERFORM_READ;
+            ac.inst.addr = ins.readAddr[r];
+            ac.inst.size = ins.size;
+            tunnel->writeMessage(0, ac);
+            result->checksum = mix(result->checksum, ARIEL_BATCH_READ, ins.readAddr[r], ins.size);
+        }
+        if ( ins.write ) {
+            ac.command = ARIEL_PERFORM_WRITE;
+            ac.inst.addr = ins.writeAddr;
+            ac.inst.size = ins.size;
+            if ( payloads ) memcpy(&ac.inst.payload[0], &ins.writeAddr, ins.size);
+            tunnel->writeMessage(0, ac);
+            result->checksum = mix(result->checksum, ARIEL_BATCH_WRITE, ins.writeAddr, ins.size);
+        }
+
+        ac.command = ARIEL_END_INSTRUCTION;
+        tunnel->writeMessage(0, ac);
+        result->checksum = mix(result->checksum, ARIEL_BATCH_END, 0, 0);
+
+        const uint64_t recs = 2 + ins.reads + (ins.write ? 1 : 0);
+        result->records += recs;
+        result->messages += recs;
+    }
+
+    ac.command = ARIEL_PERFORM_EXIT;
+    tunnel->writeMessage(0, ac);
+}
+
+static void send(ArielTunnel* tunnel, ArielBatchEncoder* batch, BenchResult* result) {
+    tunnel->writeMessage(0, batch->getMessage());
+    result->records += batch->getRecordCount();
+    result->messages++;
+    batch->clear();
+}
+
+static void produceBatched(ArielTunnel* tunnel, uint64_t count, bool payloads, BenchResult* result) {
+    SyntheticStream stream;
+    SyntheticStream::Instruction ins;
+    ArielBatchEncoder batch;
+
+    for ( uint64_t i = 0; i < count; i++ ) {
+        stream.next(&ins);
+
+        if ( 0 == ins.reads && !ins.write ) {
+            if ( !batch.appendNoOp(ins.ip) ) {
+                send(tunnel, &batch, result);
+                batch.appendNoOp(ins.ip);
+            }
+            result->checksum = mix(result->checksum, ARIEL_BATCH_NOOP, 0, 0);
+            continue;
+        }
+
+        if ( !batch.appendStart(ins.ip, ins.instClass, ins.simdElemCount) ) {
+            send(tunnel, &batch, result);
+            batch.appendStart(ins.ip, ins.instClass, ins.simdElemCount);
+        }
+        result->checksum = mix(result->checksum, ARIEL_BATCH_START, ins.ip, ins.instClass);
+
+        for ( int r = 0; r < ins.reads; r++ ) {
+            if ( !batch.appendRead(ins.readAddr[r], ins.size) ) {
+                send(tunnel, &batch, result);
+                batch.appendRead(ins.readAddr[r], ins.size);
+            }
+            result->checksum = mix(result->checksum, ARIEL_BATCH_READ, ins.readAddr[r], ins.size);
+        }
+        if ( ins.write ) {
+            const uint8_t* payload = payloads ? (const uint8_t*) &ins.writeAddr : NULL;
+            if ( !batch.appendWrite(ins.writeAddr, ins.size, payload) ) {
+                send(tunnel, &batch, result);
+                batch.appendWrite(ins.writeAddr, ins.size, payload);
+            }
+            result->checksum = mix(result->checksum, ARIEL_BATCH_WRITE, ins.writeAddr, ins.size);
+        }
+
+        if ( !batch.appendEnd() ) {
+            send(tunnel, &batch, result);
+            batch.appendEnd();
+        }
+        result->checksum = mix(result->checksum, ARIEL_BATCH_END, 0, 0);
+    }
+
+    if ( !batch.empty() ) send(tunnel, &batch, result);
+
+    ArielCommand ac;
+    memset(&ac, 0, sizeof(ac));
+    ac.command = ARIEL_PERFORM_EXIT;
+    tunnel->writeMessage(0, ac);
+}
+
+// Reads until ARIEL_PERFORM_EXIT, decoding both kinds of message like ArielCore does
+static void consume(ArielTunnel* tunnel, BenchResult* result) {
+    ArielBatchDecoder decoder;
+    ArielBatchRecord rec;
+    ArielCommand ac;
+
+    while ( true ) {
+        ac = tunnel->readMessage(0);
+        if ( ARIEL_PERFORM_EXIT == ac.command ) break;
+        result->messages++;
+
+        switch ( ac.command ) {
+        case ARIEL_NOOP:
+            result->checksum = mix(result->checksum, ARIEL_BATCH_NOOP, 0, 0);
+            result->records++;
+            break;
+        case ARIEL_START_INSTRUCTION:
+            result->checksum = mix(result->checksum, ARIEL_BATCH_START, ac.instPtr, ac.inst.instClass);
+            result->records++;
+            break;
+        case ARIEL_PERFORM_READ:
+            result->checksum = mix(result->checksum, ARIEL_BATCH_READ, ac.inst.addr, ac.inst.size);
+            result->records++;
+            break;
+        case ARIEL_PERFORM_WRITE:
+            result->checksum = mix(result->checksum, ARIEL_BATCH_WRITE, ac.inst.addr, ac.inst.size);
+            result->records++;
+            break;
+        case ARIEL_END_INSTRUCTION:
+            result->checksum = mix(result->checksum, ARIEL_BATCH_END, 0, 0);
+            result->records++;
+            break;
+        case ARIEL_BATCH:
+            decoder.begin(ac);
+            while ( decoder.next(&rec) ) {
+                switch ( rec.type ) {
+                case ARIEL_BATCH_START:
+                    result->checksum = mix(result->checksum, rec.type, rec.instPtr, rec.instClass);
+                    break;
+                case ARIEL_BATCH_READ:
+                case ARIEL_BATCH_WRITE:
+                    result->checksum = mix(result->checksum, rec.type, rec.addr, rec.size);
+                    break;
+                default:
+                    result->checksum = mix(result->checksum, rec.type, 0, 0);
+                    break;
+                }
+                result->records++;
+            }
+            if ( decoder.getRemaining() > 0 ) {
+                fprintf(stderr, "Error: malformed batch\n");
+                exit(-1);
+            }
+            break;
+        default:
+            fprintf(stderr, "Error: unexpected command %d\n", (int) ac.command);
+            exit(-1);
+        }
+    }
+}
+
+static bool run(const char* name, bool batched, uint64_t count, bool payloads, size_t queueLen) {
+    ArielTunnel* tunnel = new ArielTunnel(1, queueLen, 1);
+    void* region = calloc(1, tunnel->getTunnelSize());
+    tunnel->initialize(region);
+
+    BenchResult sent;
+    BenchResult received;
+    memset(&sent, 0, sizeof(sent));
+    memset(&received, 0, sizeof(received));
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::thread consumer(consume, tunnel, &received);
+    if ( batched ) {
+        produceBatched(tunnel, count, payloads, &sent);
+    } else {
+        produceLegacy(tunnel, count, payloads, &sent);
+    }
+    consumer.join();
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const bool match = sent.records == received.records && sent.messages == received.messages && sent.checksum == received.checksum;
+
+    printf("%-10s %12" PRIu64 " records %12" PRIu64 " messages %6.2f records/message %10.3f s %8.2f Mrecords/s %s\n",
+        name, received.records, received.messages,
+        received.messages ? (double) received.records / (double) received.messages : 0.0,
+        seconds, seconds > 0 ? (double) received.records / seconds / 1.0e6 : 0.0,
+        match ? "OK" : "MISMATCH");
+
+    delete tunnel;
+    free(region);
+    return match;
+}
+
+int main(int argc, char* argv[]) {
+    const uint64_t count = argc > 1 ? strtoull(argv[1], NULL, 0) : 10000000;
+    const bool payloads = argc > 2 ? atoi(argv[2]) != 0 : false;
+    const size_t queueLen = argc > 3 ? strtoull(argv[3], NULL, 0) : 64;
+
+    printf("Ariel tunnel benchmark: %" PRIu64 " instructions, write payloads %s, queue length %zu\n",
+        count, payloads ? "on" : "off", queueLen);
+
+    bool ok = run("unbatched", false, count, payloads, queueLen);
+    ok = run("batched", true, count, payloads, queueLen) && ok;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "boprefetch.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+BestOffsetPrefetcher::BestOffsetPrefetcher(ComponentId_t id, Params& params) : TrackedPrefetcher(id, params) {
+    Output out("", 1, 0, Output::STDOUT);
+
+    uint32_t maxOffset = params.find<uint32_t>("max_offset", 63);
+    uint64_t rrEntries = params.find<uint64_t>("rr_entries", 256);
+    uint32_t insertDelay = params.find<uint32_t>("rr_insert_delay", 8);
+    scoreMax = params.find<uint32_t>("score_max", 31);
+    roundMax = params.find<uint32_t>("round_max", 100);
+    badScore = params.find<uint32_t>("bad_score", 1);
+    degree = params.find<uint32_t>("degree", 1);
+
+    if (rrEntries == 0 || (rrEntries & (rrEntries - 1)) != 0)
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: rr_entries - must be a power of 2. You specified '%" PRIu64 "'.\n", getName().c_str(), rrEntries);
+
+    // Candidate offsets: 1..max_offset with no prime factors above 5
+    for (uint32_t d = 1; d <= maxOffset; d++) {
+        uint32_t n = d;
+        while (n % 2 == 0) n /= 2;
+        while (n % 3 == 0) n /= 3;
+        while (n % 5 == 0) n /= 5;
+        if (n == 1)
+            offsets.push_back(d);
+    }
+    if (offsets.empty())
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: max_offset - must be at least 1.\n", getName().c_str());
+
+    scores.resize(offsets.size(), 0);
+    testIndex = 0;
+    round = 0;
+    bestOffset = 1;
+
+    recentRequests.resize(rrEntries, 0);
+    recentMask = rrEntries - 1;
+
+    pendingInserts.resize(insertDelay, 0);
+    pendingHead = 0;
+
+    statLearningPhases = registerStatistic<uint64_t>("learning_phases");
+    statBestOffset     = registerStatistic<uint64_t>("best_offset");
+}
+
+/* Prefetches are triggered and offsets learned on misses and on first hits to prefetched lines */
+void BestOffsetPrefetcher::train(Addr line, bool miss, bool prefetchHit) {
+    if (!miss && !prefetchHit)
+        return;
+
+    Addr lineNum = line / blockSize;
+    learn(lineNum);
+
+    // The RR table records Y - D for each prefetch Y = X + D, i.e. X, or X itself when prefetching is off
+    insertRecent(lineNum);
+
+    if (bestOffset == 0)
+        return;
+
+    for (uint32_t i = 1; i <= degree; i++) {
+        int64_t target = (int64_t)lineNum + (int64_t)bestOffset * i;
+        if (target < 0 || !samePage(lineNum * blockSize, target * blockSize))
+            break;
+        issuePrefetch(target * blockSize);
+    }
+}
+
+/* Queue a base address; the oldest queued address enters the RR table */
+void BestOffsetPrefetcher::insertRecent(Addr lineNum) {
+    Addr ready = lineNum + 1;
+    if (!pendingInserts.empty()) {
+        std::swap(ready, pendingInserts[pendingHead]);
+        pendingHead = (pendingHead + 1) % pendingInserts.size();
+    }
+    if (ready != 0)
+        recentRequests[(ready ^ (ready >> 8)) & recentMask] = ready;
+}
+
+/* Score the next candidate offset and end the phase if a limit is reached */
+void BestOffsetPrefetcher::learn(Addr lineNum) {
+    int32_t d = offsets[testIndex];
+    if (lineNum >= (Addr)d && samePage(lineNum * blockSize, (lineNum - d) * blockSize)) {
+        Addr base = lineNum - d + 1;
+        if (recentRequests[(base ^ (base >> 8)) & recentMask] == base)
+            scores[testIndex]++;
+    }
+
+    bool done = (scores[testIndex] >= scoreMax);
+    if (++testIndex == offsets.size()) {
+        testIndex = 0;
+        if (++round >= roundMax)
+            done = true;
+    }
+    if (!done)
+        return;
+
+    uint32_t best = 0;
+    for (uint32_t i = 1; i < scores.size(); i++) {
+        if (scores[i] > scores[best])
+            best = i;
+    }
+    bestOffset = (scores[best] > badScore) ? offsets[best] : 0;
+
+    statLearningPhases->addData(1);
+    statBestOffset->addData(bestOffset);
+
+    std::fill(scores.begin(), scores.end(), 0);
+    testIndex = 0;
+    round = 0;
+}
@@ -0,0 +1,101 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_BO_PREFETCH
+#define _H_SST_BO_PREFETCH
+
+#include <vector>
+
+#include "trackedprefetch.h"
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Best-offset prefetcher
+ *
+ * Prefetches line X + D on each miss or prefetch hit to line X, where D is the offset that
+ * would have been most timely recently. Learning tests one candidate offset d per access:
+ * if X - d is in the recent-requests (RR) table, the line would have been prefetched in time
+ * by offset d and d scores a point. After a round limit or once an offset reaches the score
+ * limit, the best offset becomes D; if even the best scores poorly prefetching turns off.
+ *
+ * The cache does not report fills, so base addresses enter the RR table a fixed number of
+ * trigger accesses after their prefetch (or miss) is issued, approximating fill latency.
+ */
+class BestOffsetPrefetcher : public TrackedPrefetcher {
+public:
+    BestOffsetPrefetcher(ComponentId_t id, Params& params);
+    ~BestOffsetPrefetcher() {}
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        BestOffsetPrefetcher,
+        "cassini",
+        "BestOffsetPrefetcher",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Best-offset prefetcher",
+        SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        CASSINI_TRACKED_PREFETCH_ELI_PARAMS,
+        { "max_offset", "Largest candidate offset in lines. Candidates are the numbers up to this with no prime factors other than 2, 3 and 5", "63" },
+        { "rr_entries", "Number of entries in the recent-requests table (direct mapped)", "256" },
+        { "rr_insert_delay", "Number of trigger accesses between issuing a prefetch and recording its base address in the recent-requests table", "8" },
+        { "score_max", "A learning phase ends early when an offset reaches this score", "31" },
+        { "round_max", "Maximum number of rounds through the candidate offsets per learning phase", "100" },
+        { "bad_score", "Prefetching is turned off if the best offset scores this or lower", "1" },
+        { "degree", "Number of lines prefetched per trigger: X+D, X+2D, ...", "1" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        CASSINI_TRACKED_PREFETCH_ELI_STATISTICS,
+        { "learning_phases", "Number of completed learning phases", "phases", 2 },
+        { "best_offset", "Offset selected at the end of each learning phase (0 if prefetching was turned off)", "lines", 2 }
+    )
+
+protected:
+    void train(Addr line, bool miss, bool prefetchHit);
+
+private:
+    void insertRecent(Addr lineNum);
+    void learn(Addr lineNum);
+
+    std::vector<int32_t> offsets;
+    std::vector<uint32_t> scores;
+    uint32_t testIndex;
+    uint32_t round;
+    int32_t bestOffset;         // 0 if prefetching is off
+
+    std::vector<Addr> recentRequests;   // lineNum + 1, 0 if empty
+    uint64_t recentMask;
+
+    std::vector<Addr> pendingInserts;   // Ring of base addresses waiting to enter the RR table
+    uint32_t pendingHead;
+
+    uint32_t scoreMax;
+    uint32_t roundMax;
+    uint32_t badScore;
+    uint32_t degree;
+
+    Statistic<uint64_t>* statLearningPhases;
+    Statistic<uint64_t>* statBestOffset;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
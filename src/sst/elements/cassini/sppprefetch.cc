@@ -0,0 +1,154 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sppprefetch.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+SignaturePathPrefetcher::SignaturePathPrefetcher(ComponentId_t id, Params& params) : TrackedPrefetcher(id, params) {
+    Output out("", 1, 0, Output::STDOUT);
+
+    uint64_t stEntries = params.find<uint64_t>("signature_table_entries", 256);
+    uint32_t sigBits = params.find<uint32_t>("signature_bits", 12);
+    uint32_t threshold = params.find<uint32_t>("prefetch_threshold", 25);
+    maxLookahead = params.find<uint32_t>("max_lookahead", 8);
+    maxPrefetches = params.find<uint32_t>("max_prefetches", 8);
+
+    if (stEntries == 0 || (stEntries & (stEntries - 1)) != 0)
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: signature_table_entries - must be a power of 2. You specified '%" PRIu64 "'.\n", getName().c_str(), stEntries);
+    if (sigBits < 7 || sigBits > 20)
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: signature_bits - must be between 7 and 20. You specified '%" PRIu32 "'.\n", getName().c_str(), sigBits);
+    if (threshold == 0 || threshold > 100)
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: prefetch_threshold - must be between 1 and 100. You specified '%" PRIu32 "'.\n", getName().c_str(), threshold);
+
+    SignatureEntry emptySig = { 0, 0, 0 };
+    signatureTable.resize(stEntries, emptySig);
+    signatureTableMask = stEntries - 1;
+
+    PatternEntry emptyPattern = {};
+    patternTable.resize(1 << sigBits, emptyPattern);
+    signatureMask = (1 << sigBits) - 1;
+
+    prefetchThreshold = threshold * 1024 / 100;
+
+    statSignatureMisses = registerStatistic<uint64_t>("signature_table_misses");
+    statLookaheadDepth  = registerStatistic<uint64_t>("lookahead_depth");
+}
+
+void SignaturePathPrefetcher::train(Addr line, bool miss, bool prefetchHit) {
+    Addr lineNum = line / blockSize;
+    Addr page = lineNum / blocksPerPage;
+    int32_t offset = lineNum % blocksPerPage;
+
+    SignatureEntry& entry = signatureTable[(page ^ (page >> 12)) & signatureTableMask];
+    if (entry.pageTag != page + 1) {
+        statSignatureMisses->addData(1);
+        entry.pageTag = page + 1;
+        entry.lastOffset = offset;
+        entry.signature = 0;
+        return;
+    }
+
+    int32_t delta = offset - entry.lastOffset;
+    if (delta == 0)
+        return;
+
+    updatePattern(entry.signature, delta);
+    entry.signature = nextSignature(entry.signature, delta);
+    entry.lastOffset = offset;
+
+    lookahead(page, offset, entry.signature);
+}
+
+/* Count 'delta' as following 'sig', replacing the least-seen delta if it is new */
+void SignaturePathPrefetcher::updatePattern(uint32_t sig, int32_t delta) {
+    PatternEntry& pattern = patternTable[sig];
+
+    uint32_t slot = 0;
+    bool found = false;
+    for (uint32_t i = 0; i < deltasPerSignature; i++) {
+        if (pattern.deltaCount[i] != 0 && pattern.delta[i] == delta) {
+            slot = i;
+            found = true;
+            break;
+        }
+        if (pattern.deltaCount[i] < pattern.deltaCount[slot])
+            slot = i;
+    }
+    if (!found) {
+        pattern.delta[slot] = delta;
+        pattern.deltaCount[slot] = 0;
+    }
+
+    pattern.deltaCount[slot]++;
+    pattern.sigCount++;
+
+    // Halve the counters on saturation so the ratios are kept
+    if (pattern.sigCount == counterMax || pattern.deltaCount[slot] == counterMax) {
+        pattern.sigCount >>= 1;
+        for (uint32_t i = 0; i < deltasPerSignature; i++)
+            pattern.deltaCount[i] >>= 1;
+    }
+}
+
+/* Walk the signature path from the current access and prefetch confident deltas */
+void SignaturePathPrefetcher::lookahead(Addr page, int32_t offset, uint32_t sig) {
+    uint32_t pathConf = 1024;
+    uint32_t accuracy = getAccuracy();
+    uint32_t issued = 0;
+    uint32_t depth = 0;
+
+    for (depth = 0; depth < maxLookahead && issued < maxPrefetches; depth++) {
+        const PatternEntry& pattern = patternTable[sig];
+        if (pattern.sigCount == 0)
+            break;
+
+        int32_t bestDelta = 0;
+        uint32_t bestConf = 0;
+        for (uint32_t i = 0; i < deltasPerSignature && issued < maxPrefetches; i++) {
+            if (pattern.deltaCount[i] == 0)
+                continue;
+            uint64_t conf = (uint64_t)pathConf * pattern.deltaCount[i] / pattern.sigCount;
+            if (depth != 0)
+                conf = conf * accuracy / 1024;
+            if (conf < prefetchThreshold)
+                continue;
+
+            int32_t target = offset + pattern.delta[i];
+            if (target >= 0 && target < (int32_t)blocksPerPage) {
+                if (issuePrefetch((page * blocksPerPage + target) * blockSize))
+                    issued++;
+            }
+            if (conf > bestConf) {
+                bestConf = conf;
+                bestDelta = pattern.delta[i];
+            }
+        }
+
+        if (bestConf == 0)
+            break;
+        offset += bestDelta;
+        if (offset < 0 || offset >= (int32_t)blocksPerPage)
+            break;
+        pathConf = bestConf;
+        sig = nextSignature(sig, bestDelta);
+    }
+    statLookaheadDepth->addData(depth);
+}
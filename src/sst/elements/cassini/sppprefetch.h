@@ -0,0 +1,109 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_SPP_PREFETCH
+#define _H_SST_SPP_PREFETCH
+
+#include <vector>
+
+#include "trackedprefetch.h"
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Signature path prefetcher
+ *
+ * A signature table, indexed by page, keeps the last block offset accessed in each page
+ * and a signature compressing the recent deltas within the page. A pattern table, indexed
+ * by signature, counts the deltas that followed each signature. On an access, the
+ * prefetcher walks forward through the pattern table, multiplying delta probabilities
+ * into a path confidence, and prefetches every delta whose path confidence is above the
+ * threshold. Confidence beyond the first step is also scaled by measured prefetch accuracy.
+ * Prefetches stay within the page.
+ */
+class SignaturePathPrefetcher : public TrackedPrefetcher {
+public:
+    SignaturePathPrefetcher(ComponentId_t id, Params& params);
+    ~SignaturePathPrefetcher() {}
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        SignaturePathPrefetcher,
+        "cassini",
+        "SignaturePathPrefetcher",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Signature path (SPP) prefetcher with confidence-based lookahead",
+        SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        CASSINI_TRACKED_PREFETCH_ELI_PARAMS,
+        { "signature_table_entries", "Number of pages tracked in the signature table (direct mapped)", "256" },
+        { "signature_bits", "Width of a signature. The pattern table has 2^signature_bits entries", "12" },
+        { "prefetch_threshold", "Minimum path confidence, in percent, to prefetch a line and to continue the lookahead", "25" },
+        { "max_lookahead", "Maximum number of lookahead steps per access", "8" },
+        { "max_prefetches", "Maximum number of prefetches issued per access", "8" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        CASSINI_TRACKED_PREFETCH_ELI_STATISTICS,
+        { "signature_table_misses", "Accesses to a page not in the signature table", "accesses", 2 },
+        { "lookahead_depth", "Number of lookahead steps taken per access", "steps", 2 }
+    )
+
+protected:
+    void train(Addr line, bool miss, bool prefetchHit);
+
+private:
+    static const uint32_t deltasPerSignature = 4;
+    static const uint8_t counterMax = 15;
+
+    struct SignatureEntry {
+        Addr pageTag;       // page + 1, 0 if invalid
+        int32_t lastOffset;
+        uint32_t signature;
+    };
+
+    struct PatternEntry {
+        uint8_t sigCount;
+        uint8_t deltaCount[deltasPerSignature];
+        int16_t delta[deltasPerSignature];
+    };
+
+    uint32_t nextSignature(uint32_t sig, int32_t delta) const {
+        uint32_t enc = (delta < 0) ? (((-delta) & 0x3F) | 0x40) : (delta & 0x3F);
+        return ((sig << 3) ^ enc) & signatureMask;
+    }
+
+    void updatePattern(uint32_t sig, int32_t delta);
+    void lookahead(Addr page, int32_t offset, uint32_t sig);
+
+    std::vector<SignatureEntry> signatureTable;
+    std::vector<PatternEntry> patternTable;
+    uint64_t signatureTableMask;
+    uint32_t signatureMask;
+    uint32_t prefetchThreshold; // In 1/1024ths
+    uint32_t maxLookahead;
+    uint32_t maxPrefetches;
+
+    Statistic<uint64_t>* statSignatureMisses;
+    Statistic<uint64_t>* statLookaheadDepth;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
@@ -0,0 +1,114 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "streamprefetch.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+StreamBufferPrefetcher::StreamBufferPrefetcher(ComponentId_t id, Params& params) : TrackedPrefetcher(id, params) {
+    Output out("", 1, 0, Output::STDOUT);
+
+    uint32_t numStreams = params.find<uint32_t>("streams", 16);
+    window = params.find<uint64_t>("window", 16);
+    distance = params.find<uint32_t>("distance", 8);
+    confThreshold = params.find<uint32_t>("confidence_threshold", 2);
+    confMax = params.find<uint32_t>("confidence_max", 7);
+
+    if (numStreams == 0)
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: streams - must be at least 1.\n", getName().c_str());
+    if (confMax == 0 || confThreshold > confMax)
+        out.fatal(CALL_INFO, -1, "%s, Invalid param combo: confidence_threshold must be at most confidence_max and confidence_max must be at least 1. You specified: confidence_threshold = '%" PRIu32 "', confidence_max = '%" PRIu32 "'\n",
+                getName().c_str(), confThreshold, confMax);
+
+    Stream empty = { 0, 0, 0, 0, 0, 0 };
+    streams.resize(numStreams, empty);
+    useCounter = 0;
+
+    statStreamsAllocated = registerStatistic<uint64_t>("streams_allocated");
+}
+
+/* Streams train on misses and on first hits to prefetched lines, which are misses the prefetcher covered */
+void StreamBufferPrefetcher::train(Addr line, bool miss, bool prefetchHit) {
+    if (!miss && !prefetchHit)
+        return;
+
+    Addr lineNum = line / blockSize;
+    Addr page = lineNum / blocksPerPage + 1;
+    useCounter++;
+
+    Stream* stream = nullptr;
+    Stream* victim = &streams[0];
+    for (std::vector<Stream>::iterator it = streams.begin(); it != streams.end(); it++) {
+        if (it->page == page && (lineNum > it->lastLine ? lineNum - it->lastLine : it->lastLine - lineNum) <= window) {
+            stream = &(*it);
+            break;
+        }
+        if (it->lastUse < victim->lastUse)
+            victim = &(*it);
+    }
+
+    if (stream == nullptr) {
+        if (!miss)
+            return;
+        statStreamsAllocated->addData(1);
+        victim->page = page;
+        victim->lastLine = lineNum;
+        victim->nextLine = lineNum;
+        victim->direction = 0;
+        victim->confidence = 0;
+        victim->lastUse = useCounter;
+        return;
+    }
+
+    stream->lastUse = useCounter;
+    if (lineNum == stream->lastLine)
+        return;
+
+    int32_t step = (lineNum > stream->lastLine) ? 1 : -1;
+    if (step == stream->direction) {
+        if (stream->confidence < confMax)
+            stream->confidence++;
+    } else if (stream->confidence > 0) {
+        stream->confidence--;
+    } else {
+        stream->direction = step;
+        stream->confidence = 1;
+        stream->nextLine = lineNum;
+    }
+    stream->lastLine = lineNum;
+
+    if (stream->confidence < confThreshold || step != stream->direction)
+        return;
+
+    // Run ahead of the access, resuming after the last line this stream prefetched
+    uint32_t ahead = (distance * stream->confidence + confMax - 1) / confMax;
+    Addr first = lineNum + step;
+    if ((step > 0 && stream->nextLine > first) || (step < 0 && stream->nextLine < first))
+        first = stream->nextLine;
+
+    for (Addr next = first; ; next += step) {
+        if ((next > lineNum ? next - lineNum : lineNum - next) > ahead)
+            break;
+        if (next / blocksPerPage + 1 != page)
+            break;
+        issuePrefetch(next * blockSize);
+        stream->nextLine = next + step;
+    }
+}
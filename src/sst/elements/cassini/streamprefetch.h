@@ -0,0 +1,91 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_STREAM_PREFETCH
+#define _H_SST_STREAM_PREFETCH
+
+#include <vector>
+
+#include "trackedprefetch.h"
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Stream buffer prefetcher
+ *
+ * Tracks a fixed number of streams, each confined to a page. A miss within 'window' lines
+ * of a stream's last access trains that stream: a step in the stream's direction raises
+ * its confidence and a step against it lowers it (flipping the direction once confidence
+ * reaches zero). Misses that match no stream allocate the least recently used one.
+ * Once a stream's confidence reaches the threshold it runs ahead of the access by up to
+ * 'distance' lines, scaled by confidence, issuing only lines it has not already prefetched.
+ */
+class StreamBufferPrefetcher : public TrackedPrefetcher {
+public:
+    StreamBufferPrefetcher(ComponentId_t id, Params& params);
+    ~StreamBufferPrefetcher() {}
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        StreamBufferPrefetcher,
+        "cassini",
+        "StreamBufferPrefetcher",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Stream buffer prefetcher with per-stream confidence",
+        SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        CASSINI_TRACKED_PREFETCH_ELI_PARAMS,
+        { "streams", "Number of streams tracked", "16" },
+        { "window", "A miss within this many lines of a stream's last access trains that stream", "16" },
+        { "distance", "Maximum number of lines a confident stream prefetches ahead of the access", "8" },
+        { "confidence_threshold", "Confidence needed before a stream prefetches", "2" },
+        { "confidence_max", "Saturation value of a stream's confidence", "7" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        CASSINI_TRACKED_PREFETCH_ELI_STATISTICS,
+        { "streams_allocated", "Number of streams allocated", "streams", 2 }
+    )
+
+protected:
+    void train(Addr line, bool miss, bool prefetchHit);
+
+private:
+    struct Stream {
+        Addr page;          // page + 1, 0 if invalid
+        Addr lastLine;      // Line number of the last access
+        Addr nextLine;      // Next line number to prefetch in the current direction
+        int32_t direction;  // +1, -1 or 0 if unknown
+        uint32_t confidence;
+        uint64_t lastUse;
+    };
+
+    std::vector<Stream> streams;
+    uint64_t useCounter;
+    uint64_t window;
+    uint32_t distance;
+    uint32_t confThreshold;
+    uint32_t confMax;
+
+    Statistic<uint64_t>* statStreamsAllocated;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
@@ -2,6 +2,7 @@
 
 from sst_unittest import *
 from sst_unittest_support import *
+import re
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -55,6 +56,18 @@ class testcase_cassini_prefetch(SSTTestCase):
     def test_cassini_prefetch_nextblock(self):
         self.cassini_prefetch_test_template("nbp")
 
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_signaturepath skipped if threads > 3")
+    def test_cassini_prefetch_signaturepath(self):
+        self.cassini_prefetch_issue_template("spp")
+
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_bestoffset skipped if threads > 3")
+    def test_cassini_prefetch_bestoffset(self):
+        self.cassini_prefetch_issue_template("bop")
+
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_streambuffer skipped if threads > 3")
+    def test_cassini_prefetch_streambuffer(self):
+        self.cassini_prefetch_issue_template("sbp")
+
 #####
 
     def cassini_prefetch_test_template(self, testcase, testtimeout=180):
@@ -93,6 +106,31 @@ class testcase_cassini_prefetch(SSTTestCase):
             log_failure(diffdata)
             self.assertTrue(filesAreTheSame, "Output file {0} does not pass check against the Reference File {1} ".format(outfile, reffile))
 
+    # Run a streaming workload and check that the prefetcher issued prefetches and that some were useful
+    def cassini_prefetch_issue_template(self, testcase, testtimeout=180):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_cassini_prefetch_{0}".format(testcase)
+
+        sdlfile = "{0}/streamcpu-{1}.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+
+        sums = {}
+        stat = re.compile(r'\s*[\w.:]+\.(\w+) : Accumulator : Sum.u64 = (\d+);')
+        with open(outfile, 'r') as fp:
+            for line in fp:
+                m = stat.match(line)
+                if m != None:
+                    sums[m.group(1)] = sums.get(m.group(1), 0) + int(m.group(2))
+
+        self.assertTrue(sums.get("prefetches_issued", 0) > 0, "Prefetcher in {0} issued no prefetches".format(sdlfile))
+        self.assertTrue(sums.get("prefetch_hits", 0) > 0, "Prefetcher in {0} had no useful prefetches".format(sdlfile))
+
     def _prettyPrintDiffs(self, stat_diff, oth_diff):
         out = ""
         if len(stat_diff) != 0:
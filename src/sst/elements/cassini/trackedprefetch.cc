@@ -0,0 +1,186 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "trackedprefetch.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+/* Round up to a power of two, minimum 1 */
+static uint64_t roundUpPow2(uint64_t val) {
+    uint64_t pow2 = 1;
+    while (pow2 < val)
+        pow2 <<= 1;
+    return pow2;
+}
+
+TrackedPrefetcher::TrackedPrefetcher(ComponentId_t id, Params& params) : CacheListener(id, params) {
+    requireLibrary("memHierarchy");
+
+    blockSize = params.find<uint64_t>("cache_line_size", 64);
+    pageSize = params.find<uint64_t>("page_size", 4096);
+
+    Output out("", 1, 0, Output::STDOUT);
+    if (blockSize == 0 || (blockSize & (blockSize - 1)) != 0)
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: cache_line_size - must be a power of 2. You specified '%" PRIu64 "'.\n", getName().c_str(), blockSize);
+    if (pageSize < blockSize || pageSize % blockSize != 0)
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: page_size - must be a multiple of cache_line_size. You specified '%" PRIu64 "'.\n", getName().c_str(), pageSize);
+    blocksPerPage = pageSize / blockSize;
+
+    uint64_t trackerSets = roundUpPow2(params.find<uint64_t>("tracker_entries", 1024) / trackerWays);
+    trackerLines.resize(trackerSets * trackerWays, 0);
+    trackerAge.resize(trackerSets * trackerWays, 0);
+    trackerSetMask = trackerSets - 1;
+
+    uint64_t filterEntries = roundUpPow2(params.find<uint64_t>("filter_entries", 256));
+    filterLines.resize(filterEntries, 0);
+    filterMask = filterEntries - 1;
+
+    usefulCount = 0;
+    completedCount = 0;
+
+    statPrefetchesIssued    = registerStatistic<uint64_t>("prefetches_issued");
+    statPrefetchesFiltered  = registerStatistic<uint64_t>("prefetches_filtered");
+    statPrefetchesRedundant = registerStatistic<uint64_t>("prefetches_redundant");
+    statPrefetchHits        = registerStatistic<uint64_t>("prefetch_hits");
+    statPrefetchLate        = registerStatistic<uint64_t>("prefetch_late");
+    statPrefetchesUnused    = registerStatistic<uint64_t>("prefetches_unused");
+    statDemandMisses        = registerStatistic<uint64_t>("demand_misses");
+}
+
+void TrackedPrefetcher::notifyAccess(const CacheListenerNotification& notify) {
+    const NotifyAccessType notifyType = notify.getAccessType();
+    const NotifyResultType notifyResType = notify.getResultType();
+    const Addr addr = notify.getPhysicalAddress();
+    const Addr line = addr - (addr % blockSize);
+
+    switch (notifyType) {
+        case READ:
+        case WRITE:
+            {
+                bool miss = (notifyResType == MISS);
+                Tracked tracked = lookupDemand(line, miss);
+                if (tracked == Tracked::Hit)
+                    statPrefetchHits->addData(1);
+                else if (tracked == Tracked::Late)
+                    statPrefetchLate->addData(1);
+                else if (miss)
+                    statDemandMisses->addData(1);
+                train(line, miss, tracked == Tracked::Hit);
+            }
+            break;
+        case PREFETCH:
+            if (notifyResType == MISS)
+                trackPrefetch(line);
+            else
+                statPrefetchesRedundant->addData(1);
+            break;
+        case EVICT:
+            if (lookupEvict(line))
+                statPrefetchesUnused->addData(1);
+            break;
+    }
+}
+
+bool TrackedPrefetcher::issuePrefetch(Addr line) {
+    Addr& filter = filterLines[hashLine(line / blockSize) & filterMask];
+    if (filter == line + 1) {
+        statPrefetchesFiltered->addData(1);
+        return false;
+    }
+    filter = line + 1;
+
+    statPrefetchesIssued->addData(1);
+
+    // Cycle over each registered call back and notify them that we want to issue a prefetch request
+    for (std::vector<Event::HandlerBase*>::iterator it = registeredCallbacks.begin(); it != registeredCallbacks.end(); it++) {
+        // Create a new read request, we cannot issue a write because the data will get
+        // overwritten and corrupt memory (even if we really do want to do a write)
+        MemEvent* ev = new MemEvent(getName(), line, line, Command::GetS);
+        ev->setSize(blockSize);
+        ev->setPrefetchFlag(true);
+        (*(*it))(ev);
+    }
+    return true;
+}
+
+uint32_t TrackedPrefetcher::getAccuracy() const {
+    if (completedCount < 32)
+        return 1024;
+    return (uint64_t)usefulCount * 1024 / completedCount;
+}
+
+/* Record a line that a prefetch will fill, replacing the oldest way in its set */
+void TrackedPrefetcher::trackPrefetch(Addr line) {
+    uint64_t base = (hashLine(line / blockSize) & trackerSetMask) * trackerWays;
+    uint64_t victim = base;
+    for (uint64_t way = base; way < base + trackerWays; way++) {
+        if (trackerLines[way] == line + 1) {
+            victim = way;
+            break;
+        }
+        if (trackerLines[way] == 0 || (trackerLines[victim] != 0 && trackerAge[way] > trackerAge[victim]))
+            victim = way;
+    }
+    for (uint64_t way = base; way < base + trackerWays; way++) {
+        if (trackerAge[way] < 255) trackerAge[way]++;
+    }
+    trackerLines[victim] = line + 1;
+    trackerAge[victim] = 0;
+}
+
+/* First demand access to a tracked line: a hit means the prefetch was timely, a miss means it was late */
+TrackedPrefetcher::Tracked TrackedPrefetcher::lookupDemand(Addr line, bool miss) {
+    uint64_t base = (hashLine(line / blockSize) & trackerSetMask) * trackerWays;
+    for (uint64_t way = base; way < base + trackerWays; way++) {
+        if (trackerLines[way] == line + 1) {
+            trackerLines[way] = 0;
+            usefulCount++;
+            if (++completedCount == 4096) {
+                usefulCount >>= 1;
+                completedCount >>= 1;
+            }
+            return miss ? Tracked::Late : Tracked::Hit;
+        }
+    }
+    return Tracked::None;
+}
+
+/* Eviction of a tracked line: the prefetch was not used */
+bool TrackedPrefetcher::lookupEvict(Addr line) {
+    uint64_t base = (hashLine(line / blockSize) & trackerSetMask) * trackerWays;
+    for (uint64_t way = base; way < base + trackerWays; way++) {
+        if (trackerLines[way] == line + 1) {
+            trackerLines[way] = 0;
+            if (++completedCount == 4096) {
+                usefulCount >>= 1;
+                completedCount >>= 1;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void TrackedPrefetcher::registerResponseCallback(Event::HandlerBase *handler) {
+    registeredCallbacks.push_back(handler);
+}
+
+void TrackedPrefetcher::printStats(Output& out) {
+}
@@ -0,0 +1,136 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_TRACKED_PREFETCH
+#define _H_SST_TRACKED_PREFETCH
+
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/output.h>
+#include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace std;
+
+namespace SST {
+namespace Cassini {
+
+/* Parameters and statistics shared by all TrackedPrefetchers. Include in the derived class's ELI */
+#define CASSINI_TRACKED_PREFETCH_ELI_PARAMS \
+    { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" }, \
+    { "page_size", "Prefetches do not cross page boundaries", "4096" }, \
+    { "tracker_entries", "Number of prefetched lines tracked to measure prefetch accuracy and timeliness (4-way set associative)", "1024" }, \
+    { "filter_entries", "Number of recently issued prefetches remembered to avoid issuing duplicates (direct mapped)", "256" }
+
+#define CASSINI_TRACKED_PREFETCH_ELI_STATISTICS \
+    { "prefetches_issued", "Number of prefetch requests issued", "prefetches", 1 }, \
+    { "prefetches_filtered", "Prefetches not issued because the same line was recently prefetched", "prefetches", 1 }, \
+    { "prefetches_redundant", "Prefetches that found the line already in the cache", "prefetches", 1 }, \
+    { "prefetch_hits", "Demand accesses that hit a prefetched line. Accuracy = prefetch_hits / (prefetch_hits + prefetches_unused)", "accesses", 1 }, \
+    { "prefetch_late", "Demand accesses that missed on a line whose prefetch had not completed. Timeliness = prefetch_hits / (prefetch_hits + prefetch_late)", "accesses", 1 }, \
+    { "prefetches_unused", "Prefetched lines evicted without a demand access", "prefetches", 1 }, \
+    { "demand_misses", "Demand misses to lines that were not prefetched. Coverage = prefetch_hits / (prefetch_hits + prefetch_late + demand_misses)", "misses", 1 }
+
+/*
+ * Base class for prefetchers that report accuracy, coverage and timeliness
+ *
+ * Lines are recorded in a fixed-size set-associative table when the cache reports a prefetch
+ * miss (i.e., the prefetch will fill the line). The first demand access to a recorded line
+ * classifies the prefetch as a hit (line was present) or late (line was still in flight), and
+ * an eviction before any demand access classifies it as unused.
+ *
+ * Derived classes implement train(), which is called for demand accesses, and call
+ * issuePrefetch() for the lines they want. All tables are sized at construction so
+ * notifications do not allocate.
+ */
+class TrackedPrefetcher : public SST::MemHierarchy::CacheListener {
+public:
+    TrackedPrefetcher(ComponentId_t id, Params& params);
+    virtual ~TrackedPrefetcher() {}
+
+    void notifyAccess(const CacheListenerNotification& notify);
+    void registerResponseCallback(Event::HandlerBase *handler);
+    void printStats(Output& out);
+
+protected:
+    /* Called for each demand access.
+     *  line:        line address
+     *  miss:        whether the access missed in the cache
+     *  prefetchHit: whether the access was the first demand access to a prefetched line */
+    virtual void train(Addr line, bool miss, bool prefetchHit) = 0;
+
+    /* Issue a prefetch for a line address. Returns false if the line was filtered */
+    bool issuePrefetch(Addr line);
+
+    /* Whether two line addresses are on the same page */
+    bool samePage(Addr a, Addr b) const { return (a / pageSize) == (b / pageSize); }
+
+    /* Fraction of completed prefetches that were used, in 1/1024ths. Starts optimistic */
+    uint32_t getAccuracy() const;
+
+    uint64_t blockSize;
+    uint64_t pageSize;
+    uint64_t blocksPerPage;
+
+private:
+    enum class Tracked { None, Hit, Late };
+
+    void trackPrefetch(Addr line);
+    Tracked lookupDemand(Addr line, bool miss);
+    bool lookupEvict(Addr line);
+
+    /* Line-number hash used to index the tables */
+    static uint64_t hashLine(uint64_t lineNum) {
+        lineNum ^= lineNum >> 17;
+        lineNum *= 0xed5ad4bbULL;
+        lineNum ^= lineNum >> 11;
+        return lineNum;
+    }
+
+    std::vector<Event::HandlerBase*> registeredCallbacks;
+
+    // Prefetched lines not yet accessed, 4-way set associative. 0 is an empty way
+    static const uint32_t trackerWays = 4;
+    std::vector<Addr> trackerLines;
+    std::vector<uint8_t> trackerAge;
+    uint64_t trackerSetMask;
+
+    // Recently issued prefetches, direct mapped
+    std::vector<Addr> filterLines;
+    uint64_t filterMask;
+
+    // Running totals for the accuracy estimate, halved periodically so they follow phase changes
+    uint32_t usefulCount;
+    uint32_t completedCount;
+
+    Statistic<uint64_t>* statPrefetchesIssued;
+    Statistic<uint64_t>* statPrefetchesFiltered;
+    Statistic<uint64_t>* statPrefetchesRedundant;
+    Statistic<uint64_t>* statPrefetchHits;
+    Statistic<uint64_t>* statPrefetchLate;
+    Statistic<uint64_t>* statPrefetchesUnused;
+    Statistic<uint64_t>* statDemandMisses;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
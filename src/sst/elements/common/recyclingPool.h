@@ -0,0 +1,144 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef SST_ELEMENTS_COMMON_RECYCLINGPOOL_H
+#define SST_ELEMENTS_COMMON_RECYCLINGPOOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace SST {
+namespace Common {
+
+// Recycling allocator shared by the event and instruction pools
+//
+// Classes that are created and destroyed at a high rate route their
+// class operator new/delete through a pool type derived from this
+// template (merlin's EventPool, memHierarchy's MemEventPool and
+// vanadis' VanadisInstructionPool).  Each derived type gets its own
+// flag, free lists and counters; Tag only has to be unique.
+//
+// When the pool is off (the default) this is plain new/delete.  Once
+// a component turns it on, freed blocks are kept on per thread, per
+// size free lists and handed back out.  Every block is an ordinary
+// ::operator new allocation, so a block may be freed on a different
+// thread than it was allocated on, or after the pool is turned on.
+//
+// Counters are per thread, not per component: a block allocated by
+// one component is often freed by another.  Components that report
+// them should use claimThreadReport() so that each thread's counters
+// are recorded once.
+template <typename Tag, std::size_t MaxBlockSize, std::size_t MaxFreeBlocks>
+class RecyclingPool {
+public:
+
+    struct Counters {
+        uint64_t requests;  // Allocations
+        uint64_t hits;      // Allocations served from a free list
+        int64_t live;       // Blocks allocated and not yet freed
+        int64_t liveMax;    // High-water mark of live
+    };
+
+    // Turn the pool on.  Called by components during construction,
+    // which may run on several threads at once
+    static void enable() { enabledFlag().store(true, std::memory_order_relaxed); }
+    static bool isEnabled() { return enabledFlag().load(std::memory_order_relaxed); }
+
+    static void* allocate(std::size_t size) {
+        if ( !isEnabled() ) return ::operator new(blockSize(size));
+        ThreadPool& pool = local();
+        pool.counters.requests++;
+        if ( ++pool.counters.live > pool.counters.liveMax ) pool.counters.liveMax = pool.counters.live;
+        if ( size <= MaxBlockSize ) {
+            std::vector<void*>& bin = pool.blocks[binOf(size)];
+            if ( !bin.empty() ) {
+                void* ptr = bin.back();
+                bin.pop_back();
+                pool.counters.hits++;
+                return ptr;
+            }
+        }
+        return ::operator new(blockSize(size));
+    }
+
+    static void release(void* ptr, std::size_t size) {
+        if ( !isEnabled() ) {
+            ::operator delete(ptr);
+            return;
+        }
+        ThreadPool& pool = local();
+        pool.counters.live--;
+        if ( size <= MaxBlockSize ) {
+            std::vector<void*>& bin = pool.blocks[binOf(size)];
+            if ( bin.size() < MaxFreeBlocks ) {
+                bin.push_back(ptr);
+                return;
+            }
+        }
+        ::operator delete(ptr);
+    }
+
+    // Counters of the calling thread
+    static const Counters& getCounters() { return local().counters; }
+
+    // Returns true for the first caller on each thread only
+    static bool claimThreadReport() {
+        ThreadPool& pool = local();
+        if ( pool.reported ) return false;
+        pool.reported = true;
+        return true;
+    }
+
+private:
+    static const std::size_t bin_size = 16;
+
+    struct ThreadPool {
+        ThreadPool() : counters(), reported(false) {}
+        ~ThreadPool() {
+            for ( std::size_t i = 0; i <= MaxBlockSize / bin_size; i++ ) {
+                for ( std::size_t j = 0; j < blocks[i].size(); j++ ) ::operator delete(blocks[i][j]);
+            }
+        }
+        std::vector<void*> blocks[MaxBlockSize / bin_size + 1];
+        Counters counters;
+        bool reported;
+    };
+
+    static std::size_t binOf(std::size_t size) { return (size + bin_size - 1) / bin_size; }
+
+    // Round small blocks up to their bin size so that any freed block
+    // can serve any size in its bin
+    static std::size_t blockSize(std::size_t size) { return size <= MaxBlockSize ? binOf(size) * bin_size : size; }
+
+    static std::atomic<bool>& enabledFlag() {
+        static std::atomic<bool> enabled(false);
+        return enabled;
+    }
+
+    static ThreadPool& local() {
+        static thread_local ThreadPool pool;
+        return pool;
+    }
+};
+
+}
+}
+
+#endif // SST_ELEMENTS_COMMON_RECYCLINGPOOL_H
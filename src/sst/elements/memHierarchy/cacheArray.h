@@ -17,8 +17,10 @@
 #define CACHEARRAY_H
 
 #include <vector>
+#include <new>
 
 #include <sst/core/output.h>
+#include <sst/core/stringize.h>
 
 #include "sst/elements/memHierarchy/memTypes.h"
 #include "sst/elements/memHierarchy/hash.h"
@@ -51,7 +53,20 @@ class CacheArray {
         unsigned int    banks_;
         vector<T*>      lines_; // The actual cache
         State* setStates;
-        std::map<unsigned int, std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
+        std::vector<ReplacementInfo*> rInfo;    // Replacement info per line, a set's entries are contiguous
+
+        /** Constructor for derived arrays that allocate the line objects themselves.
+         *  Derived class must fill lines_ and then call buildReplacementInfo() */
+        CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash, bool allocateLines);
+
+        /** Check geometry parameters and initialize sizes */
+        void initGeometry();
+
+        /** Build per-set replacement info & check compatibility with the replacement manager */
+        void buildReplacementInfo();
+
+        /** Compute the set an address maps to */
+        unsigned int getSet(Addr addr) { return hash_->hash(0, toLineAddr(addr)) % numSets_; }
     public:
 
         CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash);
@@ -74,18 +89,25 @@ class CacheArray {
 
         /** Function returns the cacheline if found, otherwise a null pointer.
             If updateReplacement is set, the replacement stats are updated */
-        T * lookup(Addr addr, bool updateReplacement);
+        virtual T * lookup(Addr addr, bool updateReplacement);
 
         /** Identify a replacement candidate using the replacement manager */
-        T * findReplacementCandidate(Addr addr);
+        virtual T * findReplacementCandidate(Addr addr);
 
         /** Replace a line with address 'addr' and update its replacement info */
-        void replace(Addr addr, T* candidate);
+        virtual void replace(Addr addr, T* candidate);
 
         /** Deallocate a line and notify replacement manager that it's been deallocated */
-        void deallocate(T* candidate);
+        virtual void deallocate(T* candidate);
 
     /**** Configuration and output */
+        /** Apply a function to every line, e.g., to give lines a pointer to controller-owned state */
+        template <typename F>
+        void forEachLine(F func) {
+            for (unsigned int i = 0; i < numLines_; i++)
+                func(lines_[i]);
+        }
+
         void setSliceAware(Addr size, Addr step);
         void setBanked(unsigned int numBanks);
         void printCacheArray(Output &out);
@@ -97,6 +119,31 @@ template <class T>
 CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash) :
     dbg_(dbg), numLines_(numLines), associativity_(associativity), lineSize_(lineSize), replacementMgr_(replacementMgr), hash_(hash) {
 
+    initGeometry();
+
+    for (unsigned int i = 0; i < numLines_; i++) {
+        lines_[i] = new T(lineSize_, i);
+    }
+
+    buildReplacementInfo();
+}
+
+template <class T>
+CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash, bool allocateLines) :
+    dbg_(dbg), numLines_(numLines), associativity_(associativity), lineSize_(lineSize), replacementMgr_(replacementMgr), hash_(hash) {
+
+    initGeometry();
+
+    if (allocateLines) {
+        for (unsigned int i = 0; i < numLines_; i++) {
+            lines_[i] = new T(lineSize_, i);
+        }
+        buildReplacementInfo();
+    }
+}
+
+template <class T>
+void CacheArray<T>::initGeometry() {
     // Error check parameters
     if (numLines_ == 0)
         dbg_->fatal(CALL_INFO, -1, "CacheArray, Error: number of lines is 0. Must be greater than 0.\n");
@@ -121,22 +168,18 @@ CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int assoc
     sliceSize_ = 1;
     banks_ = 1;
 
-    for (unsigned int i = 0; i < numLines_; i++) {
-        lines_[i] = new T(lineSize_, i);
-    }
+    setStates = new State[associativity_];
+}
 
+template <class T>
+void CacheArray<T>::buildReplacementInfo() {
     // Construct rInfo
-    for (unsigned int i = 0; i < numSets_; i++) {
-        std::vector<ReplacementInfo*> setInfo;
-        for (unsigned int j = 0; j < associativity; j++)
-            setInfo.push_back(lines_[i*associativity + j]->getReplacementInfo());
-        rInfo.insert(std::make_pair(i, setInfo));
-    }
-    ReplacementInfo * info = rInfo.find(0)->second.front();
+    rInfo.resize(numLines_);
+    for (unsigned int i = 0; i < numLines_; i++)
+        rInfo[i] = lines_[i]->getReplacementInfo();
+    ReplacementInfo * info = rInfo.front();
     if (!replacementMgr_->checkCompatibility(info))
         dbg_->fatal(CALL_INFO, -1, "CacheArray, Error: The replacement policy expects cache line state that is not provided by the cache line type of this cache. Check the type of the ReplacementInfo returned by the coherence protocol's line type and the ReplacementInfo type expected by the replacement policy.\n");
-
-    setStates = new State[associativity_];
 }
 
 template <class T>
@@ -158,8 +201,7 @@ Addr CacheArray<T>::toLineAddr(Addr addr) {
 
 template <class T>
 T* CacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
-    Addr laddr = toLineAddr(addr);
-    int set = hash_->hash(0, laddr) % numSets_;
+    int set = getSet(addr);
     int setBegin = set * associativity_;
     int setEnd = setBegin + associativity_;
 
@@ -175,10 +217,9 @@ T* CacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
 
 template <class T>
 T * CacheArray<T>::findReplacementCandidate(Addr addr) {
-    Addr laddr = toLineAddr(addr);
-    int set = hash_->hash(0, laddr) % numSets_;
+    int set = getSet(addr);
 
-    unsigned int id = replacementMgr_->findBestCandidate(rInfo[set]);
+    unsigned int id = replacementMgr_->findBestCandidate(&rInfo[set * associativity_], associativity_);
 
     return lines_[id];
 }
@@ -219,5 +260,95 @@ void CacheArray<T>::printCacheArray(Output &out) {
     }
 }
 
+/*
+ * Structure-of-arrays variant of CacheArray
+ * Tags are stored contiguously by set so that a lookup probes a single
+ * run of addresses instead of dereferencing each line object. Line objects
+ * (coherence state, payload) are constructed in one contiguous arena rather
+ * than one heap allocation per line.
+ * Tags mirror each line's address; only CacheArray sets line addresses
+ * (in replace()) so the two cannot diverge.
+ */
+template <class T>
+class SoACacheArray : public CacheArray<T> {
+    protected:
+        using CacheArray<T>::lines_;
+        using CacheArray<T>::numLines_;
+        using CacheArray<T>::associativity_;
+        using CacheArray<T>::lineSize_;
+        using CacheArray<T>::replacementMgr_;
+
+        vector<Addr>    tags_;  // Tag store, tags_[set * associativity_ + way]
+        T*              arena_; // Line objects, allocated as a single block
+    public:
+        SoACacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash);
+
+        /** Destructor - Destroy line objects in place and release the arena */
+        virtual ~SoACacheArray();
+
+        virtual T * lookup(Addr addr, bool updateReplacement);
+        virtual void replace(Addr addr, T* candidate);
+};
+
+template <class T>
+SoACacheArray<T>::SoACacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash) :
+    CacheArray<T>(dbg, numLines, associativity, lineSize, replacementMgr, hash, false) {
+
+    tags_.assign(numLines_, 0);
+    arena_ = static_cast<T*>(::operator new(sizeof(T) * numLines_));
+    for (unsigned int i = 0; i < numLines_; i++) {
+        lines_[i] = new (arena_ + i) T(lineSize_, i);
+    }
+
+    this->buildReplacementInfo();
+}
+
+template <class T>
+SoACacheArray<T>::~SoACacheArray() {
+    for (size_t i = 0; i < lines_.size(); i++)
+        lines_[i]->~T();
+    lines_.clear(); // Base class must not delete lines
+    ::operator delete(arena_);
+}
+
+template <class T>
+T* SoACacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
+    unsigned int setBegin = this->getSet(addr) * associativity_;
+    const Addr * tags = tags_.data() + setBegin;
+
+    for (unsigned int way = 0; way < associativity_; way++) {
+        if (tags[way] == addr) {
+            unsigned int index = setBegin + way;
+            if (updateReplacement)
+                replacementMgr_->update(index, lines_[index]->getReplacementInfo());
+            return lines_[index];
+        }
+    }
+    return nullptr; // Not found
+}
+
+template <class T>
+void SoACacheArray<T>::replace(Addr addr, T* candidate) {
+    tags_[candidate->getIndex()] = addr;
+    CacheArray<T>::replace(addr, candidate);
+}
+
+/*
+ * Construct a cache array with the requested tag store layout
+ * 'aos' - one heap object per line (default)
+ * 'soa' - contiguous per-set tag store, see SoACacheArray
+ */
+template <class T>
+CacheArray<T>* createCacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash, std::string layout) {
+    to_lower(layout);
+    if (layout == "aos")
+        return new CacheArray<T>(dbg, numLines, associativity, lineSize, replacementMgr, hash);
+    if (layout == "soa")
+        return new SoACacheArray<T>(dbg, numLines, associativity, lineSize, replacementMgr, hash);
+
+    dbg->fatal(CALL_INFO, -1, "CacheArray, Error: Invalid param: tag_store_layout - valid options are 'aos' or 'soa'. You specified '%s'.\n", layout.c_str());
+    return nullptr;
+}
+
 }}
 #endif	/* CACHEARRAY_H */
@@ -37,8 +37,7 @@ using namespace SST::MemHierarchy;
 /* Handle incoming event on the cache links */
 void Cache::handleEvent(SST::Event * ev) {
     MemEventBase* event = static_cast<MemEventBase*>(ev);
-    if (!clockIsOn_)
-        turnClockOn();
+    activate();
 
     // Record the time at which requests arrive for latency statistics
     if (CommandClassArr[(int)event->getCmd()] == CommandClass::Request && !CommandWriteback[(int)event->getCmd()])
@@ -76,9 +75,7 @@ void Cache::processPrefetchEvent(SST::Event * ev) {
     event->setRqstr(getName());
     event->setSrc(getName());
 
-    if (!clockIsOn_) {
-        turnClockOn();
-    }
+    activate();
 
     // Record the time at which requests arrive for latency statistics
     coherenceMgr_->recordIncomingRequest(event);
@@ -100,12 +97,14 @@ bool Cache::clockTick(Cycle_t time) {
     // Drain any outgoing messages
     bool idle = coherenceMgr_->sendOutgoingEvents();
 
+    linksIdle_ = true;
     if (clockUpLink_) {
-        idle &= linkUp_->clock();
+        linksIdle_ &= linkUp_->clock();
     }
     if (clockDownLink_) {
-        idle &= linkDown_->clock();
+        linksIdle_ &= linkDown_->clock();
     }
+    idle &= linksIdle_;
 
     // MSHR occupancy
     statMSHROccupancy->addData(mshr_->getSize());
@@ -215,6 +214,68 @@ void Cache::turnClockOff() {
     lastActiveClockCycle_ = timestamp_;
 }
 
+/* Called when an event arrives. Make sure the cache runs next cycle */
+void Cache::activate() {
+    if (!clockless_) {
+        if (!clockIsOn_)
+            turnClockOn();
+        return;
+    }
+
+    Cycle_t cycle = getCurrentSimCycle() / cycleFactor_;
+
+    // A clock handler runs before events that arrive on the same cycle, so run a wakeup that is due now first
+    if (nextWakeCycle_ == cycle)
+        eventTick(cycle);
+
+    catchUp(cycle);
+    scheduleWakeup(cycle + 1);
+}
+
+/*
+ * Clockless mode
+ * Instead of a registered clock, the cache sends itself a wakeup for the next cycle in which
+ * clockTick() could do something: the next cycle while it has events to handle, or the cycle the
+ * next outgoing event is due while it is only waiting to send. Cycles in between are skipped and
+ * accounted for by catchUp() so that timestamps and statistics match the clocked cache.
+ */
+void Cache::wakeup(SST::Event * ev) {
+    Cycle_t cycle = getCurrentSimCycle() / cycleFactor_;
+    if (cycle != nextWakeCycle_) // Stale; an earlier wakeup replaced this one
+        return;
+    eventTick(cycle);
+}
+
+void Cache::eventTick(Cycle_t cycle) {
+    nextWakeCycle_ = 0;
+    catchUp(cycle - 1);
+    clockIsOn_ = true;
+
+    if (clockTick(cycle))
+        return;
+
+    Cycle_t next = cycle + 1;
+    if (retryBuffer_.empty() && eventBuffer_.empty() && prefetchBuffer_.empty() && linksIdle_)
+        next = std::max(next, (Cycle_t)coherenceMgr_->getNextSendTime());
+    scheduleWakeup(next);
+}
+
+void Cache::catchUp(Cycle_t cycle) {
+    while (timestamp_ < cycle) {
+        timestamp_++;
+        statMSHROccupancy->addData(mshr_->getSize());
+    }
+    coherenceMgr_->updateTimestamp(timestamp_);
+}
+
+void Cache::scheduleWakeup(Cycle_t cycle) {
+    if (nextWakeCycle_ != 0 && nextWakeCycle_ <= cycle)
+        return;
+    nextWakeCycle_ = cycle;
+    clockIsOn_ = true;
+    wakeSelfLink_->send(cycle * cycleFactor_ - getCurrentSimCycle(), nullptr);
+}
+
 /**************************************************************************
  * Event processing
  **************************************************************************/
@@ -526,15 +587,29 @@ void Cache::setup() {
     // Enqueue the first wakeup event to check for deadlock
     if (timeout_ != 0)
         timeoutSelfLink_->send(1, nullptr);
+
+    // Clockless: first wakeup is on the cycle the clock would have first ticked
+    if (clockless_)
+        scheduleWakeup(1);
 }
 
 
 void Cache::finish() {
-    if (!clockIsOn_) { // Correct statistics
+    if (clockless_) { // Correct statistics
+        catchUp(getCurrentSimCycle() / cycleFactor_);
+    } else if (!clockIsOn_) {
         turnClockOn();
     }
     for (int i = 0; i < listeners_.size(); i++)
         listeners_[i]->printStats(*out_);
+    /* The counters belong to the thread, so only the first cache or memory controller to finish on each thread records them */
+    if (MemEventPool::isEnabled() && MemEventPool::claimThreadReport()) {
+        const MemEventPool::Counters& pool = MemEventPool::getCounters();
+        statEventPoolAllocs->addData(pool.requests);
+        statEventPoolHits->addData(pool.hits);
+        statEventPoolLiveMax->addData(pool.liveMax);
+        statEventPoolLive->addData(pool.live);
+    }
     linkDown_->finish();
     if (linkUp_ != linkDown_) linkUp_->finish();
 }
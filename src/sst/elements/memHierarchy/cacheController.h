@@ -89,6 +89,9 @@ public:
             {"force_noncacheable_reqs", "(bool) Used for verification purposes. All requests are considered to be 'noncacheable'. Options: 0[off], 1[on]", "false"},
             {"min_packet_size",         "(string) Number of bytes in a request/response not including payload (e.g., addr + cmd). Specify in B.", "8B"},
             {"banks",                   "(uint) Number of cache banks: One access per bank per cycle. Use '0' to simulate no bank limits (only limits on bandwidth then are max_requests_per_cycle and *_link_width", "0"},
+            {"tag_store_layout",        "(string) Layout of the simulator's tag store. Does not affect simulated timing. Options: aos[one object per line], soa[contiguous per-set tag arrays, faster lookups for large caches]", "aos"},
+            {"clockless",               "(bool) Do not register a clock. The cache schedules its own wakeups only for cycles in which it has work to do. Timing and statistics match the clocked cache. Requires the default 1ps core timebase", "false"},
+            {"event_pool",              "(bool) Recycle memHierarchy event objects and payload buffers instead of freeing them. Turning this on in any component enables it for the whole simulation", "false"},
             /* Old parameters - deprecated or moved */
             {"network_address",             "DEPRECATED - Now auto-detected by link control."}, // Remove 9.0
             {"network_bw",                  "MOVED - Now a member of the MemNIC subcomponent.", "80GiB/s"}, // Remove 9.0
@@ -116,9 +119,14 @@ public:
             {"TotalEventsReceived",     "Total number of events received by this cache", "events", 1},
             {"TotalEventsReplayed",     "Total number of events that were initially blocked and then were replayed", "events", 1},
             {"MSHR_occupancy",          "Number of events in MSHR each cycle", "events", 1},
+            {"MSHR_address_occupancy",  "Peak number of MSHR entries held by an address, recorded when the address leaves the MSHR", "entries", 2},
             {"Bank_conflicts",          "Total number of bank conflicts detected", "count", 1},
             {"Prefetch_requests",       "Number of prefetches received from prefetcher at this cache", "events", 1},
             {"Prefetch_drops",          "Number of prefetches that were cancelled. Reasons: too many prefetches outstanding, cache can't handle prefetch this cycle, currently handling another event for the address.", "events", 1},
+            {"EventPool_allocations",   "With event_pool, events allocated by the thread this cache runs on. The pool is per thread, so this is recorded at end of simulation by only one cache or memory controller per thread", "events", 3},
+            {"EventPool_hits",          "With event_pool, allocations on this thread served from recycled events. Hit rate is EventPool_hits / EventPool_allocations. Recorded once per thread", "events", 3},
+            {"EventPool_live_max",      "With event_pool, high-water mark of events allocated and not yet freed on this thread. Recorded once per thread", "events", 3},
+            {"EventPool_live_at_finish","With event_pool, events still allocated on this thread at the end of simulation; a large value points to a leak. Recorded once per thread", "events", 3},
             /*Event receives */
             {"GetS_recv",               "Event received: GetS", "count", 2},
             {"GetX_recv",               "Event received: GetX", "count", 2},
@@ -239,6 +247,17 @@ private:
     void turnClockOn();
     void turnClockOff();
 
+    // Clockless mode - called when an event arrives, ensures the cache wakes up next cycle
+    void activate();
+
+    // Clockless mode - run the clock handler for a cycle and schedule the next wakeup
+    void wakeup(SST::Event * ev);
+    void eventTick(Cycle_t cycle);
+
+    // Clockless mode - advance timestamp_ over cycles in which the cache had nothing to do
+    void catchUp(Cycle_t cycle);
+    void scheduleWakeup(Cycle_t cycle);
+
     // Trigger timeouts if events sit in MSHR for too long
     void timeoutWakeup(SST::Event * ev);
     void checkTimeout();
@@ -279,6 +298,12 @@ private:
     bool                    clockUpLink_;   // Whether link actually needs clock() called or not
     bool                    clockDownLink_; // Whether link actually needs clock() called or not
     SimTime_t               lastActiveClockCycle_;  // Cycle we turned the clock off at - for re-syncing stats
+    bool                    linksIdle_;     // Whether the links had nothing to send on the last clock
+
+    bool                    clockless_;     // Schedule wakeups on a self link instead of registering a clock
+    Link*                   wakeSelfLink_;  // Clockless mode - delivers wakeups on clock edges
+    Cycle_t                 nextWakeCycle_; // Clockless mode - cycle of the pending wakeup, 0 if none
+    SimTime_t               cycleFactor_;   // Clockless mode - core time units per cache cycle
 
     /** Cache state ************************************************************/
     uint64_t                    timestamp_;
@@ -309,6 +334,12 @@ private:
     Statistic<uint64_t>* statRetryEvents;
     Statistic<uint64_t>* statUncacheRecv[(int)Command::LAST_CMD];
     Statistic<uint64_t>* statCacheRecv[(int)Command::LAST_CMD];
+
+    // Event pool counters
+    Statistic<uint64_t>* statEventPoolAllocs;
+    Statistic<uint64_t>* statEventPoolHits;
+    Statistic<uint64_t>* statEventPoolLiveMax;
+    Statistic<uint64_t>* statEventPoolLive;
 };
 
 }}
@@ -64,6 +64,8 @@ Cache::Cache(ComponentId_t id, Params &params) : Component(id) {
 
 
     allNoncacheableRequests_    = params.find<bool>("force_noncacheable_reqs", false);
+    if (params.find<bool>("event_pool", false))
+        MemEventPool::enable();
     maxRequestsPerCycle_        = params.find<int>("max_requests_per_cycle",-1);
     string packetSize           = params.find<std::string>("min_packet_size", "8B");
 
@@ -154,6 +156,7 @@ void Cache::createCoherenceManager(Params &params) {
     coherenceParams.insert("dlines", params.find<std::string>("noninclusive_directory_entries", "0"));
     coherenceParams.insert("dassoc", params.find<std::string>("noninclusive_directory_associativity", "0"));
     coherenceParams.insert("drpolicy", params.find<std::string>("noninclusive_directory_repl", "lru"));
+    coherenceParams.insert("tag_store_layout", params.find<std::string>("tag_store_layout", "aos"));
 
     bool prefetch = (statPrefetchRequest != nullptr);
 
@@ -721,11 +724,26 @@ void Cache::createClock(Params &params) {
         out_->fatal(CALL_INFO, -1, "%s, Param not specified: frequency - cache frequency.\n", getName().c_str());
 
     clockHandler_       = new Clock::Handler<Cache>(this, &Cache::clockTick);
-    defaultTimeBase_    = registerClock(frequency, clockHandler_);
+    clockless_          = params.find<bool>("clockless", false);
+
+    if (clockless_) {
+        // Wakeups are sent at clock edges computed in core time units
+        if (getTimeConverter("1ps")->getFactor() != 1)
+            out_->fatal(CALL_INFO, -1, "%s, Invalid param: clockless - requires the simulation timebase to be 1ps.\n", getName().c_str());
+        defaultTimeBase_ = getTimeConverter(frequency);
+        cycleFactor_ = defaultTimeBase_->getFactor();
+        wakeSelfLink_ = configureSelfLink("wake", "1ps", new Event::Handler<Cache>(this, &Cache::wakeup));
+    } else {
+        defaultTimeBase_ = registerClock(frequency, clockHandler_);
+        cycleFactor_ = 0;
+        wakeSelfLink_ = nullptr;
+    }
 
     clockIsOn_ = true;
     timestamp_ = 0;
     lastActiveClockCycle_ = 0;
+    linksIdle_ = true;
+    nextWakeCycle_ = 0;
 
     // Deadlock timeout
     timeout_ = params.find<SimTime_t>("maxRequestDelay", 0);
@@ -792,5 +810,10 @@ void Cache::registerStatistics() {
     }
 
     statMSHROccupancy               = registerStatistic<uint64_t>("MSHR_occupancy");
+    mshr_->setAddressOccupancyStat(registerStatistic<uint64_t>("MSHR_address_occupancy"));
     statBankConflicts               = registerStatistic<uint64_t>("Bank_conflicts");
+    statEventPoolAllocs             = registerStatistic<uint64_t>("EventPool_allocations");
+    statEventPoolHits               = registerStatistic<uint64_t>("EventPool_hits");
+    statEventPoolLiveMax            = registerStatistic<uint64_t>("EventPool_live_max");
+    statEventPoolLive               = registerStatistic<uint64_t>("EventPool_live_at_finish");
 }
@@ -144,7 +144,7 @@ public:
         ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, true);
         HashFunction * ht = createHashFunction(params);
 
-        cacheArray_ = new CacheArray<PrivateCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        cacheArray_ = createCacheArray<PrivateCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht, params.find<std::string>("tag_store_layout", "aos"));
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         stat_eventState[(int)Command::GetS][I] = registerStatistic<uint64_t>("stateEvent_GetS_I");
@@ -99,7 +99,7 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
             }
 
             recordPrefetchResult(line, statPrefetchHit);
-            line->addSharer(event->getSrc());
+            line->addSharer(nodeIDs_.getID(event->getSrc()));
 
             sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime - 1);
@@ -160,10 +160,10 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
                     if (inMSHR) mshr_->setProfiled(addr);
                 }
                 if (!line->hasSharers() && protocol_) {
-                    line->setOwner(event->getSrc());
+                    line->setOwner(nodeIDs_.getID(event->getSrc()));
                     respcmd = Command::GetXResp;
                 } else {
-                    line->addSharer(event->getSrc());
+                    line->addSharer(nodeIDs_.getID(event->getSrc()));
                     respcmd = Command::GetSResp;
                 }
             }
@@ -273,7 +273,7 @@ bool MESIInclusive::handleGetX(MemEvent * event, bool inMSHR) {
 
             recordPrefetchResult(line, statPrefetchHit);
 
-            if (line->hasOtherSharers(event->getSrc())) {
+            if (line->hasOtherSharers(nodeIDs_.getID(event->getSrc()))) {
                 if (!inMSHR)
                     status = allocateMSHR(event, false);
                 if (status == MemEventStatus::OK) {
@@ -297,9 +297,9 @@ bool MESIInclusive::handleGetX(MemEvent * event, bool inMSHR) {
                 break;
             }
 
-            line->setOwner(event->getSrc());
-            if (line->isSharer(event->getSrc()))
-                line->removeSharer(event->getSrc());
+            line->setOwner(nodeIDs_.getID(event->getSrc()));
+            if (line->isSharer(nodeIDs_.getID(event->getSrc())))
+                line->removeSharer(nodeIDs_.getID(event->getSrc()));
             sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime);
 
@@ -361,7 +361,7 @@ bool MESIInclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
 
     if (event->getEvict()) {
         state = doEviction(event, line, state);
-        line->addSharer(event->getSrc());
+        line->addSharer(nodeIDs_.getID(event->getSrc()));
         ack = true;
     }
 
@@ -787,7 +787,7 @@ bool MESIInclusive::handlePutX(MemEvent * event, bool inMSHR) {
     stat_eventState[(int)Command::PutX][state]->addData(1);
 
     state = doEviction(event, line, state);
-    line->addSharer(event->getSrc());
+    line->addSharer(nodeIDs_.getID(event->getSrc()));
 
     if (sendWritebackAck_)
        sendAckPut(event);
@@ -1030,7 +1030,7 @@ bool MESIInclusive::handleForceInv(MemEvent * event, bool inMSHR) {
             cleanUpEvent(event, inMSHR); // No replay since state doesn't change
             break;
         case SM_Inv: { // ForceInv if there's an un-inv'd sharer, else in mshr & stall
-            std::string src = mshr_->getFrontEvent(addr)->getSrc();
+            NodeID src = nodeIDs_.getID(mshr_->getFrontEvent(addr)->getSrc());
             status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
             if (status != MemEventStatus::Reject) {
                 profile = true;
@@ -1156,7 +1156,7 @@ bool MESIInclusive::handleFetchInv(MemEvent * event, bool inMSHR) {
             status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, true, 0);
             if (status != MemEventStatus::Reject) {
                 profile = true;
-                std::string shr = mshr_->getFrontEvent(addr)->getSrc();
+                NodeID shr = nodeIDs_.getID(mshr_->getFrontEvent(addr)->getSrc());
                 if (line->isSharer(shr)) {
                     invalidateSharer(shr, event, line, inMSHR);
                 }
@@ -1314,7 +1314,7 @@ bool MESIInclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
     if (localPrefetch) {
         line->setPrefetch(true);
     } else {
-        line->addSharer(req->getSrc());
+        line->addSharer(nodeIDs_.getID(req->getSrc()));
         Addr offset = req->getAddr() - req->getBaseAddr();
         uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp());
         line->setTimestamp(sendTime-1);
@@ -1370,11 +1370,11 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
                     eventDI.action = "Done";
             } else {
                 if (protocol_ && line->getState() != S && mshr_->getSize(addr) == 1) {
-                    line->setOwner(req->getSrc());
+                    line->setOwner(nodeIDs_.getID(req->getSrc()));
                     uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp(), Command::GetXResp);
                     line->setTimestamp(sendTime - 1);
                 } else {
-                    line->addSharer(req->getSrc());
+                    line->addSharer(nodeIDs_.getID(req->getSrc()));
                     uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp(), Command::GetSResp);
                     line->setTimestamp(sendTime - 1);
                 }
@@ -1389,9 +1389,9 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
         case SM:
         {
             line->setState(M);
-            line->setOwner(req->getSrc());
-            if (line->isSharer(req->getSrc()))
-                line->removeSharer(req->getSrc());
+            line->setOwner(nodeIDs_.getID(req->getSrc()));
+            if (line->isSharer(nodeIDs_.getID(req->getSrc())))
+                line->removeSharer(nodeIDs_.getID(req->getSrc()));
 
             uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp());
             line->setTimestamp(sendTime-1);
@@ -1511,7 +1511,7 @@ bool MESIInclusive::handleFetchXResp(MemEvent * event, bool inMSHR) {
     state = doEviction(event, line, state);
     responses.find(addr)->second.erase(event->getSrc());
     if (responses.find(addr)->second.empty()) responses.erase(addr);
-    line->addSharer(event->getSrc());
+    line->addSharer(nodeIDs_.getID(event->getSrc()));
 
     if (state == M_InvX)
         line->setState(M);
@@ -1543,8 +1543,8 @@ bool MESIInclusive::handleAckInv(MemEvent * event, bool inMSHR) {
 
     stat_eventState[(int)Command::AckInv][state]->addData(1);
 
-    if (line->isSharer(event->getSrc()))
-        line->removeSharer(event->getSrc());
+    if (line->isSharer(nodeIDs_.getID(event->getSrc())))
+        line->removeSharer(nodeIDs_.getID(event->getSrc()));
     else
         line->removeOwner();
 
@@ -1959,10 +1959,10 @@ State MESIInclusive::doEviction(MemEvent * event, SharedCacheLine * line, State
                 break;
         }
     }
-    if (line->getOwner() == event->getSrc())
+    if (line->getOwner() == nodeIDs_.getID(event->getSrc()))
         line->removeOwner();
-    else if (line->isSharer(event->getSrc()))
-        line->removeSharer(event->getSrc());
+    else if (line->isSharer(nodeIDs_.getID(event->getSrc())))
+        line->removeSharer(nodeIDs_.getID(event->getSrc()));
 
     event->setEvict(false); // Avoid doing an eviction twice if the event gets replayed
     line->setState(nState);
@@ -2108,16 +2108,16 @@ void MESIInclusive::downgradeOwner(MemEvent * event, SharedCacheLine* line, bool
     Addr addr = event->getBaseAddr();
     MemEvent * fetch = new MemEvent(cachename_, addr, addr, Command::FetchInvX);
     fetch->copyMetadata(event);
-    fetch->setDst(line->getOwner());
+    fetch->setDst(nodeIDs_.getName(line->getOwner()));
     fetch->setSize(lineSize_);
 
     mshr_->incrementAcksNeeded(addr);
 
     if (responses.find(addr) != responses.end()) {
-        responses.find(addr)->second.insert(std::make_pair(line->getOwner(), fetch->getID())); // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
+        responses.find(addr)->second.insert(std::make_pair(nodeIDs_.getName(line->getOwner()), fetch->getID())); // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
     } else {
         std::map<std::string,MemEvent::id_type> respid;
-        respid.insert(std::make_pair(line->getOwner(), fetch->getID()));
+        respid.insert(std::make_pair(nodeIDs_.getName(line->getOwner()), fetch->getID()));
         responses.insert(std::make_pair(addr, respid));
     }
 
@@ -2139,9 +2139,9 @@ void MESIInclusive::downgradeOwner(MemEvent * event, SharedCacheLine* line, bool
 
 bool MESIInclusive::invalidateExceptRequestor(MemEvent * event, SharedCacheLine * line, bool inMSHR) {
     uint64_t deliveryTime = 0;
-    std::string rqstr = event->getSrc();
+    NodeID rqstr = nodeIDs_.getID(event->getSrc());
 
-    for (set<std::string>::iterator it = line->getSharers()->begin(); it != line->getSharers()->end(); it++) {
+    for (SharerSet::iterator it = line->getSharers()->begin(); it != line->getSharers()->end(); ++it) {
         if (*it == rqstr) continue;
 
         deliveryTime =  invalidateSharer(*it, event, line, inMSHR);
@@ -2160,7 +2160,7 @@ bool MESIInclusive::invalidateAll(MemEvent * event, SharedCacheLine * line, bool
     } else {
         if (cmd == Command::NULLCMD)
             cmd = Command::Inv;
-        for (std::set<std::string>::iterator it = line->getSharers()->begin(); it != line->getSharers()->end(); it++) {
+        for (SharerSet::iterator it = line->getSharers()->begin(); it != line->getSharers()->end(); ++it) {
             deliveryTime = invalidateSharer(*it, event, line, inMSHR, cmd);
         }
         if (deliveryTime != 0) {
@@ -2171,7 +2171,7 @@ bool MESIInclusive::invalidateAll(MemEvent * event, SharedCacheLine * line, bool
     return false;
 }
 
-uint64_t MESIInclusive::invalidateSharer(std::string shr, MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd) {
+uint64_t MESIInclusive::invalidateSharer(NodeID shr, MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd) {
     if (line->isSharer(shr)) {
         Addr addr = line->getAddr();
         MemEvent * inv = new MemEvent(cachename_, addr, addr, cmd);
@@ -2180,13 +2180,13 @@ uint64_t MESIInclusive::invalidateSharer(std::string shr, MemEvent * event, Shar
         } else {
             inv->setRqstr(cachename_);
         }
-        inv->setDst(shr);
+        inv->setDst(nodeIDs_.getName(shr));
         inv->setSize(lineSize_);
         if (responses.find(addr) != responses.end()) {
-            responses.find(addr)->second.insert(std::make_pair(shr, inv->getID())); // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
+            responses.find(addr)->second.insert(std::make_pair(inv->getDst(), inv->getID())); // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
         } else {
             std::map<std::string,MemEvent::id_type> respid;
-            respid.insert(std::make_pair(shr, inv->getID()));
+            respid.insert(std::make_pair(inv->getDst(), inv->getID()));
             responses.insert(std::make_pair(addr, respid));
         }
 
@@ -2208,7 +2208,7 @@ uint64_t MESIInclusive::invalidateSharer(std::string shr, MemEvent * event, Shar
 
 bool MESIInclusive::invalidateOwner(MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd) {
     Addr addr = line->getAddr();
-    if (line->getOwner() == "")
+    if (!line->hasOwner())
         return false;
 
     MemEvent * inv = new MemEvent(cachename_, addr, addr, cmd);
@@ -2217,7 +2217,7 @@ bool MESIInclusive::invalidateOwner(MemEvent * event, SharedCacheLine * line, bo
     } else {
         inv->setRqstr(cachename_);
     }
-    inv->setDst(line->getOwner());
+    inv->setDst(nodeIDs_.getName(line->getOwner()));
     inv->setSize(lineSize_);
 
     mshr_->incrementAcksNeeded(addr);
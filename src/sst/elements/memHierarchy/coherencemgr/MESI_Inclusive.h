@@ -259,7 +259,8 @@ public:
 
         ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, false);
         HashFunction * ht = createHashFunction(params);
-        cacheArray_ = new CacheArray<SharedCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        cacheArray_ = createCacheArray<SharedCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht, params.find<std::string>("tag_store_layout", "aos"));
+        cacheArray_->forEachLine([this](SharedCacheLine* line) { line->setNodeIDTable(&nodeIDs_); });
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         /* Statistics */
@@ -551,7 +552,7 @@ private:
     /** Invalidation **/
     bool invalidateExceptRequestor(MemEvent * event, SharedCacheLine * line, bool inMSHR);
     bool invalidateAll(MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd = Command::NULLCMD);
-    uint64_t invalidateSharer(std::string shr, MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd = Command::Inv);
+    uint64_t invalidateSharer(NodeID shr, MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd = Command::Inv);
     bool invalidateOwner(MemEvent * event, SharedCacheLine * line, bool inMSHR, Command cmd = Command::FetchInv);
 
     /** Forward flush line request, with or without data */
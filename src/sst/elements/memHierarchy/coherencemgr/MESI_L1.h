@@ -199,7 +199,7 @@ public:
         ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, true);
         HashFunction * ht = createHashFunction(params);
 
-        cacheArray_ = new CacheArray<L1CacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        cacheArray_ = createCacheArray<L1CacheLine>(debug, lines, assoc, lineSize_, rmgr, ht, params.find<std::string>("tag_store_layout", "aos"));
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         // Register statistics
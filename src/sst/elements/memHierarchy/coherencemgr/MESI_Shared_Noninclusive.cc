@@ -106,7 +106,7 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
             recordPrefetchResult(tag, statPrefetchHit);
 
             if (data || mshr_->hasData(addr)) {
-                tag->addSharer(event->getSrc());
+                tag->addSharer(nodeIDs_.getID(event->getSrc()));
                 if (mshr_->hasData(addr))
                     sendTime = sendResponseUp(event, &(mshr_->getData(addr)), inMSHR, tag->getTimestamp());
                 else
@@ -170,10 +170,10 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
                 recordLatencyType(event->getID(), LatType::HIT);
                 if (tag->hasSharers()) {
                     respcmd = Command::GetSResp;
-                    tag->addSharer(event->getSrc());
+                    tag->addSharer(nodeIDs_.getID(event->getSrc()));
                 } else {
                     respcmd = Command::GetXResp;
-                    tag->setOwner(event->getSrc());
+                    tag->setOwner(nodeIDs_.getID(event->getSrc()));
                 }
                 if (mshr_->hasData(addr))
                     sendTime = sendResponseUp(event, &(mshr_->getData(addr)), inMSHR, tag->getTimestamp(), respcmd);
@@ -294,7 +294,7 @@ bool MESISharNoninclusive::handleGetX(MemEvent * event, bool inMSHR) {
             }
         case E:
         case M:
-            if (!tag->hasOtherSharers(event->getSrc()) && !tag->hasOwner()) {
+            if (!tag->hasOtherSharers(nodeIDs_.getID(event->getSrc())) && !tag->hasOwner()) {
                 if (is_debug_event(event))
                     eventDI.reason = "hit";
                 if (!inMSHR || !mshr_->getProfiled(addr)) {
@@ -303,9 +303,9 @@ bool MESISharNoninclusive::handleGetX(MemEvent * event, bool inMSHR) {
                     stat_hit[(event->getCmd() == Command::GetX ? 1 : 2)][inMSHR]->addData(1);
                     stat_hits->addData(1);
                 }
-                tag->setOwner(event->getSrc());
-                if (tag->isSharer(event->getSrc())) {
-                    tag->removeSharer(event->getSrc());
+                tag->setOwner(nodeIDs_.getID(event->getSrc()));
+                if (tag->isSharer(nodeIDs_.getID(event->getSrc()))) {
+                    tag->removeSharer(nodeIDs_.getID(event->getSrc()));
                     sendTime = sendResponseUp(event, nullptr, inMSHR, tag->getTimestamp(), Command::GetXResp);
                 } else if (mshr_->hasData(addr))
                     sendTime = sendResponseUp(event, &(mshr_->getData(addr)), inMSHR, tag->getTimestamp(), Command::GetXResp);
@@ -327,8 +327,8 @@ bool MESISharNoninclusive::handleGetX(MemEvent * event, bool inMSHR) {
                     mshr_->setProfiled(addr);
                 }
                 recordLatencyType(event->getID(), LatType::INV);
-                if (tag->hasOtherSharers(event->getSrc())) {
-                    invalidateExceptRequestor(event, tag, inMSHR, !data && !tag->isSharer(event->getSrc()));
+                if (tag->hasOtherSharers(nodeIDs_.getID(event->getSrc()))) {
+                    invalidateExceptRequestor(event, tag, inMSHR, !data && !tag->isSharer(nodeIDs_.getID(event->getSrc())));
                 } else {
                     invalidateOwner(event, tag, inMSHR, Command::FetchInv);
                 }
@@ -423,7 +423,7 @@ bool MESISharNoninclusive::handleFlushLine(MemEvent* event, bool inMSHR) {
                 }
                 if (event->getEvict()) {
                     removeOwnerViaInv(event, tag, data, false);
-                    tag->addSharer(event->getSrc());
+                    tag->addSharer(nodeIDs_.getID(event->getSrc()));
                     event->setEvict(false); // Don't stall
                 } else if (tag->hasOwner()) {
                     uint64_t sendTime = sendFetch(Command::FetchInvX, event, tag->getOwner(), inMSHR, tag->getTimestamp());
@@ -443,7 +443,7 @@ bool MESISharNoninclusive::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_InvX:
             if (event->getEvict()) {
                 removeOwnerViaInv(event, tag, data, true);
-                tag->addSharer(event->getSrc());
+                tag->addSharer(nodeIDs_.getID(event->getSrc()));
 
                 mshr_->decrementAcksNeeded(addr);
                 tag->setState(NextState[tag->getState()]);
@@ -456,7 +456,7 @@ bool MESISharNoninclusive::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_Inv:
             if (event->getEvict()) {
                 removeOwnerViaInv(event, tag, data, false);
-                tag->addSharer(event->getSrc());
+                tag->addSharer(nodeIDs_.getID(event->getSrc()));
                 event->setEvict(false);
             }
             break;
@@ -587,7 +587,7 @@ bool MESISharNoninclusive::handleFlushLineInv(MemEvent* event, bool inMSHR) {
         case SM_D:
         case SB_D:
             if (event->getEvict()) {
-                if (*(tag->getSharers()->begin()) == event->getSrc()) {
+                if (*(tag->getSharers()->begin()) == nodeIDs_.getID(event->getSrc())) {
                     removeSharerViaInv(event, tag, data, true);
                     mshr_->decrementAcksNeeded(addr);
                     tag->setState(NextState[tag->getState()]);
@@ -660,7 +660,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
             if (!inMSHR || !mshr_->getProfiled(addr)) {
                 stat_eventState[(int)Command::PutS][I]->addData(1);
             }
-            tag->removeSharer(event->getSrc());
+            tag->removeSharer(nodeIDs_.getID(event->getSrc()));
             sendWritebackAck(event);
             cleanUpAfterRequest(event, inMSHR);
             break;
@@ -684,7 +684,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
                 status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, false, 1);   // Put just after the Flush, will handle next
                 break;
             }
-            tag->removeSharer(event->getSrc());
+            tag->removeSharer(nodeIDs_.getID(event->getSrc()));
             sendWritebackAck(event);
             if (inMSHR || !mshr_->getProfiled(addr)) {
                 stat_eventState[(int)Command::PutS][state]->addData(1);
@@ -695,7 +695,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
         case E_D:
         case M_D:
         case SB_D:
-            if (event->getSrc() == *(tag->getSharers()->begin())) { // Sent fetch to this requestor
+            if (nodeIDs_.getID(event->getSrc()) == *(tag->getSharers()->begin())) { // Sent fetch to this requestor
                 // Retry the pending fetch
                 mshr_->decrementAcksNeeded(addr);
                 mshr_->setData(addr, event->getPayload());
@@ -707,7 +707,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
 
                 // Handle PutS now if we can, later if not
                 if (tag->numSharers() > 1) {
-                    tag->removeSharer(event->getSrc());
+                    tag->removeSharer(nodeIDs_.getID(event->getSrc()));
                     sendWritebackAck(event);
                     if (inMSHR || !mshr_->getProfiled(addr)) {
                         stat_eventState[(int)Command::PutS][state]->addData(1);
@@ -724,7 +724,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
                 }
                 break;
             }
-            tag->removeSharer(event->getSrc());
+            tag->removeSharer(nodeIDs_.getID(event->getSrc()));
             sendWritebackAck(event);
             if (inMSHR || !mshr_->getProfiled(addr)) {
                 stat_eventState[(int)Command::PutS][state]->addData(1);
@@ -811,7 +811,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
                     stat_eventState[(int)Command::PutE][state]->addData(1);
                 }
             } else {
-                tag->addSharer(event->getSrc());
+                tag->addSharer(nodeIDs_.getID(event->getSrc()));
                 event->setCmd(Command::PutS);
                 if (inMSHR)
                     mshr_->removeFront(addr); // Need to reinsert after the conflicting request
@@ -922,7 +922,7 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                 sendWritebackAck(event);
                 cleanUpEvent(event, inMSHR);
             } else {
-                tag->addSharer(event->getSrc());
+                tag->addSharer(nodeIDs_.getID(event->getSrc()));
                 event->setCmd(Command::PutS);
                 mshr_->setData(addr, event->getPayload());
                 if (inMSHR)
@@ -984,7 +984,7 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
         mshr_->removePendingRetry(addr);
 
     tag->removeOwner();
-    tag->addSharer(event->getSrc());
+    tag->addSharer(nodeIDs_.getID(event->getSrc()));
 
     sendWritebackAck(event);
 
@@ -1799,7 +1799,7 @@ bool MESISharNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
             // Clean up so that when we replay the replacement we get the right downgraded state
             req->setCmd(Command::PutS);
             tag->removeOwner();
-            tag->addSharer(req->getSrc());
+            tag->addSharer(nodeIDs_.getID(req->getSrc()));
             tag->setState(SA);
             delete event;
             break;
@@ -1860,7 +1860,7 @@ bool MESISharNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
         if (is_debug_event(event))
             eventDI.action = "Done";
     } else {
-        tag->addSharer(req->getSrc());
+        tag->addSharer(nodeIDs_.getID(req->getSrc()));
         uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetSResp);
         tag->setTimestamp(sendTime-1);
     }
@@ -1917,11 +1917,11 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
                     eventDI.action = "Done";
             } else {
                 if (tag->getState() == S || !protocol_ || mshr_->getSize(addr) > 1) {
-                    tag->addSharer(req->getSrc());
+                    tag->addSharer(nodeIDs_.getID(req->getSrc()));
                     uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetSResp);
                     tag->setTimestamp(sendTime - 1);
                 } else {
-                    tag->setOwner(req->getSrc());
+                    tag->setOwner(nodeIDs_.getID(req->getSrc()));
                     uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetXResp);
                     tag->setTimestamp(sendTime - 1);
                 }
@@ -1934,10 +1934,10 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
         case SM:
         {
             tag->setState(M);
-            tag->setOwner(req->getSrc());
+            tag->setOwner(nodeIDs_.getID(req->getSrc()));
             uint64_t sendTime = 0;
-            if (tag->isSharer(req->getSrc())) {
-                tag->removeSharer(req->getSrc());
+            if (tag->isSharer(nodeIDs_.getID(req->getSrc()))) {
+                tag->removeSharer(nodeIDs_.getID(req->getSrc()));
                 sendTime = sendResponseUp(req, nullptr, true, tag->getTimestamp(), Command::GetXResp);
             } else if (event->getPayloadSize() != 0) {
                 sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetXResp);
@@ -2063,14 +2063,14 @@ bool MESISharNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
             break;
         case S_Inv:
         case SB_Inv:
-            tag->removeSharer(event->getSrc());
+            tag->removeSharer(nodeIDs_.getID(event->getSrc()));
             if (done) {
                 tag->setState(S);
                 retry(addr);
             }
             break;
         case SM_Inv:
-            tag->removeSharer(event->getSrc());
+            tag->removeSharer(nodeIDs_.getID(event->getSrc()));
             if (done) {
                 tag->setState(SM);
                 if (!mshr_->getInProgress(addr))
@@ -2080,7 +2080,7 @@ bool MESISharNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
         case E_InvX:
         case M_InvX:
             tag->removeOwner();
-            tag->addSharer(event->getSrc());
+            tag->addSharer(nodeIDs_.getID(event->getSrc()));
             tag->setState(NextState[state]); // E or M
             retry(addr);
             break;
@@ -2089,7 +2089,7 @@ bool MESISharNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
             if (tag->hasOwner())
                 tag->removeOwner();
             else
-                tag->removeSharer(event->getSrc());
+                tag->removeSharer(nodeIDs_.getID(event->getSrc()));
             if (done) {
                 tag->setState(NextState[state]);    // E or M
                 retry(addr);
@@ -2138,7 +2138,7 @@ bool MESISharNoninclusive::handleFetchXResp(MemEvent * event, bool inMSHR) {
 
     // Update coherence state
     tag->removeOwner();
-    tag->addSharer(event->getSrc());
+    tag->addSharer(nodeIDs_.getID(event->getSrc()));
 
     if (state == M_InvX || event->getDirty())
         tag->setState(M);
@@ -2179,8 +2179,8 @@ bool MESISharNoninclusive::handleAckInv(MemEvent * event, bool inMSHR) {
 
     stat_eventState[(int)Command::AckInv][state]->addData(1);
 
-    if (tag->isSharer(event->getSrc()))
-        tag->removeSharer(event->getSrc());
+    if (tag->isSharer(nodeIDs_.getID(event->getSrc())))
+        tag->removeSharer(nodeIDs_.getID(event->getSrc()));
     else
         tag->removeOwner();
 
@@ -2932,20 +2932,20 @@ void MESISharNoninclusive::sendWritebackAck(MemEvent * event) {
         eventDI.action = "Ack";
 }
 
-uint64_t MESISharNoninclusive::sendFetch(Command cmd, MemEvent * event, std::string dst, bool inMSHR, uint64_t ts) {
+uint64_t MESISharNoninclusive::sendFetch(Command cmd, MemEvent * event, NodeID dst, bool inMSHR, uint64_t ts) {
     Addr addr = event->getBaseAddr();
     MemEvent * fetch = new MemEvent(cachename_, addr, addr, cmd);
     fetch->copyMetadata(event);
-    fetch->setDst(dst);
+    fetch->setDst(nodeIDs_.getName(dst));
     fetch->setSize(event->getSize());
 
     mshr_->incrementAcksNeeded(addr);
 
     if (responses.find(addr) != responses.end()) {
-        responses.find(addr)->second.insert(std::make_pair(dst, fetch->getID())); // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
+        responses.find(addr)->second.insert(std::make_pair(fetch->getDst(), fetch->getID())); // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
     } else {
         std::map<std::string,MemEvent::id_type> respid;
-        respid.insert(std::make_pair(dst, fetch->getID()));
+        respid.insert(std::make_pair(fetch->getDst(), fetch->getID()));
         responses.insert(std::make_pair(addr, respid));
     }
 
@@ -2963,13 +2963,13 @@ uint64_t MESISharNoninclusive::sendFetch(Command cmd, MemEvent * event, std::str
 
 bool MESISharNoninclusive::invalidateExceptRequestor(MemEvent * event, DirectoryLine * tag, bool inMSHR, bool needData) {
     uint64_t deliveryTime = 0;
-    std::string rqstr = event->getSrc();
+    NodeID rqstr = nodeIDs_.getID(event->getSrc());
 
     bool getData = needData;
-    if (getData && tag->isSharer(event->getSrc()))
+    if (getData && tag->isSharer(nodeIDs_.getID(event->getSrc())))
         getData = false;
 
-    for (set<std::string>::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
+    for (SharerSet::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); ++it) {
         if (*it == rqstr) continue;
 
         if (getData) { // FetchInv
@@ -2993,7 +2993,7 @@ bool MESISharNoninclusive::invalidateAll(MemEvent * event, DirectoryLine * tag,
     } else {
         if (cmd == Command::NULLCMD)
             cmd = Command::Inv;
-        for (std::set<std::string>::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
+        for (SharerSet::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); ++it) {
             deliveryTime = invalidateSharer(*it, event, tag, inMSHR, cmd);
         }
         if (deliveryTime != 0) {
@@ -3006,7 +3006,7 @@ bool MESISharNoninclusive::invalidateAll(MemEvent * event, DirectoryLine * tag,
 
 void MESISharNoninclusive::invalidateSharers(MemEvent * event, DirectoryLine * tag, bool inMSHR, bool needData, Command cmd) {
     uint64_t deliveryTime = 0;
-    for (std::set<std::string>::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
+    for (SharerSet::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); ++it) {
         if (needData) {
             deliveryTime = invalidateSharer(*it, event, tag, inMSHR, Command::FetchInv);
             needData = false;
@@ -3018,7 +3018,7 @@ void MESISharNoninclusive::invalidateSharers(MemEvent * event, DirectoryLine * t
 
 }
 
-uint64_t MESISharNoninclusive::invalidateSharer(std::string shr, MemEvent * event, DirectoryLine * tag, bool inMSHR, Command cmd) {
+uint64_t MESISharNoninclusive::invalidateSharer(NodeID shr, MemEvent * event, DirectoryLine * tag, bool inMSHR, Command cmd) {
     if (tag->isSharer(shr)) {
         Addr addr = tag->getAddr();
         MemEvent * inv = new MemEvent(cachename_, addr, addr, cmd);
@@ -3027,13 +3027,13 @@ uint64_t MESISharNoninclusive::invalidateSharer(std::string shr, MemEvent * even
         } else {
             inv->setRqstr(cachename_);
         }
-        inv->setDst(shr);
+        inv->setDst(nodeIDs_.getName(shr));
         inv->setSize(lineSize_);
         if (responses.find(addr) != responses.end()) {
-            responses.find(addr)->second.insert(std::make_pair(shr, inv->getID())); // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
+            responses.find(addr)->second.insert(std::make_pair(inv->getDst(), inv->getID())); // Record events we're waiting for to avoid trying to figure out what happened if we get a NACK
         } else {
             std::map<std::string,MemEvent::id_type> respid;
-            respid.insert(std::make_pair(shr, inv->getID()));
+            respid.insert(std::make_pair(inv->getDst(), inv->getID()));
             responses.insert(std::make_pair(addr, respid));
         }
 
@@ -3056,7 +3056,7 @@ uint64_t MESISharNoninclusive::invalidateSharer(std::string shr, MemEvent * even
 
 bool MESISharNoninclusive::invalidateOwner(MemEvent * metaEvent, DirectoryLine * tag, bool inMSHR, Command cmd) {
     Addr addr = tag->getAddr();
-    if (tag->getOwner() == "")
+    if (!tag->hasOwner())
         return false;
 
     if (is_debug_addr(addr)) {
@@ -3070,7 +3070,7 @@ bool MESISharNoninclusive::invalidateOwner(MemEvent * metaEvent, DirectoryLine *
     } else {
         inv->setRqstr(cachename_);
     }
-    inv->setDst(tag->getOwner());
+    inv->setDst(nodeIDs_.getName(tag->getOwner()));
     inv->setSize(lineSize_);
 
     mshr_->incrementAcksNeeded(addr);
@@ -3135,7 +3135,7 @@ void MESISharNoninclusive::forwardByDestination(MemEventBase* ev, Cycle_t timest
 
 void MESISharNoninclusive::removeSharerViaInv(MemEvent * event, DirectoryLine * tag, DataLine * data, bool remove) {
     Addr addr = event->getBaseAddr();
-    tag->removeSharer(event->getSrc());
+    tag->removeSharer(nodeIDs_.getID(event->getSrc()));
     if (!data && !mshr_->hasData(addr))
         mshr_->setData(addr, event->getPayload());
 
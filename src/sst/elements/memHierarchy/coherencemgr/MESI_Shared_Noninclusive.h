@@ -277,14 +277,15 @@ public:
 
         ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, false);
         HashFunction * ht = createHashFunction(params);
-        dataArray_ = new CacheArray<DataLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        dataArray_ = createCacheArray<DataLine>(debug, lines, assoc, lineSize_, rmgr, ht, params.find<std::string>("tag_store_layout", "aos"));
         dataArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         uint64_t dLines = params.find<uint64_t>("dlines");
         uint64_t dAssoc = params.find<uint64_t>("dassoc");
         params.insert("replacement_policy", params.find<std::string>("drpolicy", "lru"));
         ReplacementPolicy *drmgr = createReplacementPolicy(dLines, dAssoc, params, false, 1);
-        dirArray_ = new CacheArray<DirectoryLine>(debug, dLines, dAssoc, lineSize_, drmgr, ht);
+        dirArray_ = createCacheArray<DirectoryLine>(debug, dLines, dAssoc, lineSize_, drmgr, ht, params.find<std::string>("tag_store_layout", "aos"));
+        dirArray_->forEachLine([this](DirectoryLine* line) { line->setNodeIDTable(&nodeIDs_); });
         dirArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         /* Statistics */
@@ -589,7 +590,7 @@ private:
     /** Invalidate sharers and/or owner; returns either the new line timestamp (or 0 if no invalidation) or a bool indicating whether anything was invalidated */
     bool invalidateExceptRequestor(MemEvent * event, DirectoryLine * line, bool inMSHR, bool needData);
     bool invalidateAll(MemEvent * event, DirectoryLine * line, bool inMSHR, Command cmd = Command::NULLCMD);
-    uint64_t invalidateSharer(std::string shr, MemEvent * event, DirectoryLine * line, bool inMSHR, Command cmd = Command::Inv);
+    uint64_t invalidateSharer(NodeID shr, MemEvent * event, DirectoryLine * line, bool inMSHR, Command cmd = Command::Inv);
     void invalidateSharers(MemEvent * event, DirectoryLine * line, bool inMSHR, bool needData, Command cmd);
     bool invalidateOwner(MemEvent * event, DirectoryLine * line, bool inMSHR, Command cmd = Command::FetchInv);
 
@@ -607,7 +608,7 @@ private:
     void sendWritebackFromMSHR(Command cmd, DirectoryLine* tag, bool dirty);
     void sendWritebackAck(MemEvent* event);
 
-    uint64_t sendFetch(Command cmd, MemEvent * event, std::string dst, bool inMSHR, uint64_t ts);
+    uint64_t sendFetch(Command cmd, MemEvent * event, NodeID dst, bool inMSHR, uint64_t ts);
 
     /** Call through to coherenceController with statistic recording */
     void forwardByAddress(MemEventBase* ev, Cycle_t timestamp);
@@ -400,15 +400,11 @@ void CoherenceController::forwardByAddress(MemEventBase * event) {
 
 void CoherenceController::forwardByAddress(MemEventBase * event, Cycle_t ts) {
     event->setSrc(cachename_);
-    std::string dst = linkDown_->findTargetDestination(event->getRoutingAddress());
-    if (dst != "") { /* Common case */
-        event->setDst(dst);
+    if (linkDown_->setTargetDestination(event)) { /* Common case */
         Response fwdReq = {event, ts, packetHeaderBytes + event->getPayloadSize()};
         addToOutgoingQueue(fwdReq);
     } else {
-        dst = linkUp_->findTargetDestination(event->getRoutingAddress());
-        if (dst != "") {
-            event->setDst(dst);
+        if (linkUp_->setTargetDestination(event)) {
             Response fwdReq = {event, ts, packetHeaderBytes + event->getPayloadSize()};
             addToOutgoingQueueUp(fwdReq);
         } else {
@@ -466,6 +462,10 @@ void CoherenceController::processInitCoherenceEvent(MemEventInitCoherence* event
     if (source && event->getRecvWBAck())
         sendWritebackAck_ = true;
 
+    // Intern upper-level endpoint names so that they get the lowest (densest) sharer IDs
+    if (source)
+        nodeIDs_.addSorted(event->getSrc());
+
     // Track CPU names so we can broadcast L1 invalidation snoops if needed
     if (source && (event->getType() == Endpoint::CPU || event->getType() == Endpoint::MMIO))
         cpus.insert(event->getSrc());
@@ -17,6 +17,7 @@
 #define MEMHIERARCHY_COHERENCECONTROLLER_H
 
 #include <array>
+#include <limits>
 
 #include <sst/core/sst_config.h>
 #include <sst/core/subcomponent.h>
@@ -32,6 +33,7 @@
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
 #include "sst/elements/memHierarchy/hash.h"
+#include "sst/elements/memHierarchy/sharerSet.h"
 
 namespace SST { namespace MemHierarchy {
 using namespace std;
@@ -110,6 +112,16 @@ public:
     /* Check whether the event queues are empty/subcomponent is doing anything */
     bool checkIdle();
 
+    /* Earliest timestamp at which a queued outgoing event can be sent. Max uint64_t if none are queued */
+    uint64_t getNextSendTime() {
+        uint64_t next = std::numeric_limits<uint64_t>::max();
+        if (!outgoingEventQueueDown_.empty())
+            next = outgoingEventQueueDown_.front().deliveryTime;
+        if (!outgoingEventQueueUp_.empty())
+            next = std::min(next, outgoingEventQueueUp_.front().deliveryTime);
+        return next;
+    }
+
     /* Get which bank an address maps to (call through to cache array) */
     virtual Addr getBank(Addr addr) = 0;
 
@@ -257,6 +269,9 @@ protected:
     /* Cache name - used for identifying where events came from/are going to */
     std::string cachename_;
 
+    /* Dense IDs for endpoint names, used by managers that track sharers/owners */
+    NodeIDTable nodeIDs_;
+
     /* Output & debug */
     Output* output; // Output stream for warnings, notices, fatal, etc.
     Output* debug;  // Output stream for debug -> SST must be compiled with --enable-debug
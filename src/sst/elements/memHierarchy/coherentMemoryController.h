@@ -45,6 +45,8 @@ public:
 
     SST_ELI_DOCUMENT_PORTS( MEMCONTROLLER_ELI_PORTS )
 
+    SST_ELI_DOCUMENT_STATISTICS( MEMCONTROLLER_ELI_STATISTICS )
+
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( MEMCONTROLLER_ELI_SUBCOMPONENTSLOTS )
 
 /* Begin class definition */
@@ -312,6 +312,7 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     int mshrSize    = params.find<int>("mshr_num_entries",-1);
     if (mshrSize == 0) dbg.fatal(CALL_INFO, -1, "Invalid param(%s): mshr_num_entries - must be at least 1 or else negative to indicate an unlimited size MSHR\n", getName().c_str());
     mshr                = loadComponentExtension<MSHR>(&dbg, mshrSize, getName(), DEBUG_ADDR);
+    mshr->setAddressOccupancyStat(registerStatistic<uint64_t>("MSHR_address_occupancy"));
 
     /* Get latencies */
     accessLatency   = params.find<uint64_t>("access_latency_cycles", 0);
@@ -660,6 +661,8 @@ void DirectoryController::init(unsigned int phase) {
                 if (!(mEv->getTracksPresence()) && cpuLink->isSource(mEv->getSrc())) {
                     incoherentSrc.insert(mEv->getSrc());
                 }
+                if (cpuLink->isSource(mEv->getSrc()))
+                    nodeIDs_.addSorted(mEv->getSrc());
             } else if (ev->getInitCmd() == MemEventInit::InitCommand::Endpoint) {
                 MemEventInit * mEv = ev->clone();
                 mEv->setSrc(getName());
@@ -726,6 +729,7 @@ void DirectoryController::setup(void){
 
 bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
+    NodeID src = nodeIDs_.getID(event->getSrc());
     DirEntry * entry = getDirEntry(addr);
     State state = entry->getState();
     bool cached = entry->isCached();
@@ -759,12 +763,12 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
                         sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
                     } else if (protocol == CoherenceProtocol::MESI) {
                         entry->setState(M);
-                        entry->setOwner(event->getSrc());
+                        entry->setOwner(src);
                         sendDataResponse(event, entry, mshr->getData(addr), Command::GetXResp);
                         mshr->clearData(addr);
                     } else {
                         entry->setState(S);
-                        entry->addSharer(event->getSrc());
+                        entry->addSharer(src);
                         sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
                     }
                     if (is_debug_event(event)) {
@@ -787,7 +791,7 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
         case S:
             if (mshr->hasData(addr)) { // saved from earlier request
                 if (incoherentSrc.find(event->getSrc()) == incoherentSrc.end()) {
-                    entry->addSharer(event->getSrc());
+                    entry->addSharer(src);
                 }
                 sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
                 if (is_debug_event(event)) {
@@ -838,6 +842,7 @@ bool DirectoryController::handleGetSX(MemEvent * event, bool inMSHR) {
 
 bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
+    NodeID src = nodeIDs_.getID(event->getSrc());
     DirEntry * entry = getDirEntry(addr);
     State state = entry->getState();
     bool cached = entry->isCached();
@@ -869,7 +874,7 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
                 } else {
                     if (incoherentSrc.find(event->getSrc()) == incoherentSrc.end()) {
                         entry->setState(M);
-                        entry->setOwner(event->getSrc());
+                        entry->setOwner(src);
                     }
                     sendDataResponse(event, entry, mshr->getData(addr), Command::GetXResp);
                     mshr->clearData(addr);
@@ -894,13 +899,13 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
             // Upgrade request and no other sharers -> respond & M
             // Upgrade request and other sharers -> invalidate other sharers & S_Inv
             // Otherwise need data & invalidate sharers -> invalidate other sharers, request data from Memory, SM_Inv
-            if (entry->isSharer(event->getSrc())) { // Don't need data
+            if (entry->isSharer(src)) { // Don't need data
                 if (entry->getSharerCount() == 1) { // Also don't need to invalidate
                     if (mshr->hasData(addr))
                         mshr->clearData(addr);
                     entry->setState(M);
-                    entry->removeSharer(event->getSrc());
-                    entry->setOwner(event->getSrc());
+                    entry->removeSharer(src);
+                    entry->setOwner(src);
                     sendResponse(event);
                     if (is_debug_event(event)) {
                         eventDI.reason = "hit";
@@ -1054,6 +1059,7 @@ bool DirectoryController::handleWrite(MemEvent * event, bool inMSHR) {
 
 bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
+    NodeID src = nodeIDs_.getID(event->getSrc());
     DirEntry* entry = getDirEntry(addr);
     State state = entry->getState();
     bool cached = entry->isCached();
@@ -1092,7 +1098,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
                     entry->removeOwner();
-                    entry->addSharer(event->getSrc());
+                    entry->addSharer(src);
                     mshr->setData(addr, event->getPayload(), event->getDirty());
                     event->setEvict(false);
                 } else if (entry->hasOwner()) {
@@ -1107,7 +1113,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_Inv:
             if (event->getEvict()) {
                 entry->removeOwner();
-                entry->addSharer(event->getSrc());
+                entry->addSharer(src);
                 mshr->setData(addr, event->getPayload(), event->getDirty());
                 event->setEvict(false);
                 entry->setState(S_Inv);
@@ -1116,7 +1122,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_InvX:
             if (event->getEvict()) {
                 entry->removeOwner();
-                entry->addSharer(event->getSrc());
+                entry->addSharer(src);
                 mshr->setData(addr, event->getPayload(), event->getDirty());
                 entry->setState(S);
                 mshr->decrementAcksNeeded(addr);
@@ -1143,6 +1149,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
 
 bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
+    NodeID src = nodeIDs_.getID(event->getSrc());
     DirEntry* entry = getDirEntry(addr);
     State state = entry->getState();
     bool cached = entry->isCached();
@@ -1173,7 +1180,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
         case S:
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
-                    entry->removeSharer(event->getSrc());
+                    entry->removeSharer(src);
                     event->setEvict(false);
                 }
 
@@ -1205,7 +1212,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_D:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(src);
                 event->setEvict(false);
                 if (!entry->hasSharers())
                     entry->setState(IS);
@@ -1213,7 +1220,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_B:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(src);
                 event->setEvict(false);
                 if (!entry->hasSharers())
                     entry->setState(I);
@@ -1235,7 +1242,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case SD_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(src);
                 event->setEvict(false);
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
@@ -1247,7 +1254,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case SM_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(src);
                 event->setEvict(false);
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
@@ -1258,7 +1265,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(src);
                 event->setEvict(false);
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
@@ -1270,7 +1277,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case M_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(src);
                 event->setEvict(false);
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
@@ -1298,6 +1305,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
 
 bool DirectoryController::handlePutS(MemEvent * event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
+    NodeID src = nodeIDs_.getID(event->getSrc());
     DirEntry* entry = getDirEntry(addr);
     State state = entry->getState();
     bool cached = entry->isCached();
@@ -1317,7 +1325,7 @@ bool DirectoryController::handlePutS(MemEvent * event, bool inMSHR) {
     if (!inMSHR)
         stat_cacheHits->addData(1);
 
-    entry->removeSharer(event->getSrc());
+    entry->removeSharer(src);
     sendAckPut(event);
 
     if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrc()) != responses.find(addr)->second.end()) {
@@ -1378,6 +1386,7 @@ bool DirectoryController::handlePutS(MemEvent * event, bool inMSHR) {
 
 bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
+    NodeID src = nodeIDs_.getID(event->getSrc());
     DirEntry* entry = getDirEntry(addr);
     State state = entry->getState();
     bool cached = entry->isCached();
@@ -1398,7 +1407,7 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
         stat_cacheHits->addData(1);
 
     entry->removeOwner();
-    entry->addSharer(event->getSrc());
+    entry->addSharer(src);
 
     sendAckPut(event);
 
@@ -1781,6 +1790,7 @@ bool DirectoryController::handleGetSResp(MemEvent * event, bool inMSHR) {
     // Entry must be cached since we can't evict non-stable-state entries
 
     MemEvent * reqEv = static_cast<MemEvent*>(mshr->getFrontEvent(addr));
+    NodeID rqstr = nodeIDs_.getID(reqEv->getSrc());
 
     if (state != IS && state != S_D) {
         out.fatal(CALL_INFO, -1, "%s, Error: Received GetSResp in unhandled state '%s'. Event: %s. Time: %" PRIu64 "ns\n",
@@ -1788,7 +1798,7 @@ bool DirectoryController::handleGetSResp(MemEvent * event, bool inMSHR) {
     }
     if (incoherentSrc.find(reqEv->getSrc()) == incoherentSrc.end()) {
         entry->setState(S);
-        entry->addSharer(reqEv->getSrc());
+        entry->addSharer(rqstr);
     } else if (state == IS) {
         entry->setState(I);
     } else {
@@ -1816,6 +1826,7 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
         eventDI.prefill(event->getID(), Command::GetXResp, false, addr, state);
 
     MemEvent * reqEv = static_cast<MemEvent*>(mshr->getFrontEvent(addr));
+    NodeID rqstr = nodeIDs_.getID(reqEv->getSrc());
 
     switch (state) {
         case IS:
@@ -1825,14 +1836,14 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
                 break;
             } else if (protocol == CoherenceProtocol::MESI) {
                 entry->setState(M);
-                entry->setOwner(reqEv->getSrc());
+                entry->setOwner(rqstr);
                 sendDataResponse(reqEv, entry, event->getPayload(), Command::GetXResp);
                 break;
             }
         case S_D:
             entry->setState(S);
             if (incoherentSrc.find(reqEv->getSrc()) == incoherentSrc.end()) {
-                entry->addSharer(reqEv->getSrc());
+                entry->addSharer(rqstr);
             }
             sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
             mshr->setData(addr, event->getPayload(), false); // So subsequent GetS can get data
@@ -1840,7 +1851,7 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
         case IM:
             if (incoherentSrc.find(reqEv->getSrc()) == incoherentSrc.end()) {
                 entry->setState(M);
-                entry->setOwner(reqEv->getSrc());
+                entry->setOwner(rqstr);
             } else {
                 entry->setState(I);
             }
@@ -1952,14 +1963,15 @@ bool DirectoryController::handleAckPut(MemEvent* event, bool inMSHR) {
 
 bool DirectoryController::handleAckInv(MemEvent* event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
+    NodeID src = nodeIDs_.getID(event->getSrc());
     DirEntry* entry = getDirEntry(addr);
     State state = entry->getState();
 
     if (is_debug_addr(addr))
         eventDI.prefill(event->getID(), Command::AckInv, false, addr, state);
 
-    if (entry->isSharer(event->getSrc()))
-        entry->removeSharer(event->getSrc());
+    if (entry->isSharer(src))
+        entry->removeSharer(src);
     else
         entry->removeOwner();
 
@@ -2008,6 +2020,7 @@ bool DirectoryController::handleAckInv(MemEvent* event, bool inMSHR) {
 
 bool DirectoryController::handleFetchXResp(MemEvent* event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
+    NodeID src = nodeIDs_.getID(event->getSrc());
     DirEntry* entry = getDirEntry(addr);
     State state = entry->getState();
 
@@ -2025,7 +2038,7 @@ bool DirectoryController::handleFetchXResp(MemEvent* event, bool inMSHR) {
     mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
 
     entry->removeOwner();
-    entry->addSharer(event->getSrc());
+    entry->addSharer(src);
     entry->setState(S);
     retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
 
@@ -2168,7 +2181,7 @@ DirectoryController::DirEntry* DirectoryController::getDirEntry(Addr addr) {
     std::unordered_map<Addr,DirEntry*>::iterator i = directory.find(addr);
 
     if (directory.end() == i) {
-        directory[addr] = new DirEntry(addr);
+        directory[addr] = new DirEntry(addr, &nodeIDs_);
         i = directory.find(addr);
         i->second->cacheIter = entryCache.end();
         i->second->setCached(true);
@@ -2358,14 +2371,14 @@ void DirectoryController::issueFlush(MemEvent* event) {
 void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command cmd) {
     Addr addr = event->getBaseAddr();
     MemEvent * fetch = new MemEvent(getName(), event->getAddr(), addr, cmd, lineSize);
-    fetch->setDst(entry->getOwner());
+    fetch->setDst(nodeIDs_.getName(entry->getOwner()));
 
     if (responses.find(addr) == responses.end()) {
         std::map<std::string,MemEvent::id_type> resp;
-        resp.insert(std::make_pair(entry->getOwner(), fetch->getID()));
+        resp.insert(std::make_pair(nodeIDs_.getName(entry->getOwner()), fetch->getID()));
         responses.insert(std::make_pair(addr, resp));
     } else {
-        responses.find(addr)->second.insert(std::make_pair(entry->getOwner(), fetch->getID()));
+        responses.find(addr)->second.insert(std::make_pair(nodeIDs_.getName(entry->getOwner()), fetch->getID()));
     }
 
     mshr->incrementAcksNeeded(addr);
@@ -2374,15 +2387,15 @@ void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command c
 }
 
 void DirectoryController::issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd) {
-    std::string rqstr = (event->getSrc());
+    NodeID rqstr = nodeIDs_.getID(event->getSrc());
 
-    for (set<std::string>::iterator it = entry->getSharers()->begin(); it != entry->getSharers()->end(); it++) {
+    for (SharerSet::iterator it = entry->getSharers()->begin(); it != entry->getSharers()->end(); ++it) {
         if (*it == rqstr) continue;
         issueInvalidation(*it, event, entry, cmd);
     }
 }
 
-void DirectoryController::issueInvalidation(std::string dst, MemEvent* event, DirEntry* entry, Command cmd) {
+void DirectoryController::issueInvalidation(NodeID dst, MemEvent* event, DirEntry* entry, Command cmd) {
     Addr addr = entry->getBaseAddr();
     MemEvent* inv = new MemEvent(getName(), addr, addr, cmd, lineSize);
     if (event) {
@@ -2390,16 +2403,16 @@ void DirectoryController::issueInvalidation(std::string dst, MemEvent* event, Di
     } else {
         inv->setRqstr(getName());
     }
-    inv->setDst(dst);
+    inv->setDst(nodeIDs_.getName(dst));
 
     mshr->incrementAcksNeeded(addr);
 
     if (responses.find(addr) == responses.end()) {
         std::map<std::string,MemEvent::id_type> resp;
-        resp.insert(std::make_pair(entry->getOwner(), inv->getID()));
+        resp.insert(std::make_pair(nodeIDs_.getName(entry->getOwner()), inv->getID()));
         responses.insert(std::make_pair(addr, resp));
     } else {
-        responses.find(addr)->second.insert(std::make_pair(entry->getOwner(), inv->getID()));
+        responses.find(addr)->second.insert(std::make_pair(nodeIDs_.getName(entry->getOwner()), inv->getID()));
     }
 
     uint64_t deliveryTime = timestamp + accessLatency;
@@ -2535,14 +2548,10 @@ void DirectoryController::sendOutgoingEvents() {
  * dirAccess has default value of false
  */
 void DirectoryController::forwardByAddress(MemEventBase * ev, Cycle_t ts, bool dirAccess) {
-    std::string dst = memLink->findTargetDestination(ev->getRoutingAddress());
-    if (dst != "") { /* Common case */
-        ev->setDst(dst);
+    if (memLink->setTargetDestination(ev)) { /* Common case */
         memMsgQueue.insert(std::make_pair(ts, MemMsg(ev, dirAccess)));
     } else {
-        dst = cpuLink->findTargetDestination(ev->getRoutingAddress());
-        if (dst != "") {
-            ev->setDst(dst);
+        if (cpuLink->setTargetDestination(ev)) {
             cpuMsgQueue.insert(std::make_pair(ts, ev));
         } else {
             std::string availableDests = "cpulink:\n" + cpuLink->getAvailableDestinationsAsString();
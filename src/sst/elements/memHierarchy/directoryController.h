@@ -37,6 +37,7 @@
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/mshr.h"
+#include "sst/elements/memHierarchy/sharerSet.h"
 
 using namespace std;
 
@@ -139,6 +140,7 @@ public:
             {"eventSent_FlushLineInv",  "Event sent: FlushLineInv", "count", 2},
             {"eventSent_FlushLineResp", "Event sent: FlushLineResp", "count", 2},
             {"MSHR_occupancy",          "Number of events in MSHR each cycle",  "events",       1},
+            {"MSHR_address_occupancy",  "Peak number of MSHR entries held by an address, recorded when the address leaves the MSHR", "entries", 2},
             {"default_stat",            "Default statistic. If not 0 then a statistic is missing", "", 1})
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
@@ -296,10 +298,11 @@ private:
         Addr                addr;           // block address
         State               state;          // state
         std::list<DirEntry*>::iterator cacheIter;
-	std::set<std::string> sharers;      // set of sharers for block
-        std::string         owner;          // Owner of block
+	SharerSet           sharers;        // set of sharers for block
+        NodeID              owner;          // Owner of block
+        const NodeIDTable*  names;          // Sharer/owner names for debug output
 
-        DirEntry(Addr a) {
+        DirEntry(Addr a, const NodeIDTable* n) : names(n) {
             clearEntry();
             addr = a;
             state = I;
@@ -310,21 +313,14 @@ private:
             cached = true;
             addr = 0;
             sharers.clear();
-            owner = "";
+            owner = NO_NODE;
         }
 
         std::string getString() {
             std::ostringstream str;
             str << "State: " << StateString[state];
-            str << " Sharers: [";
-            bool comma = false;
-            for (std::set<std::string>::iterator it = sharers.begin(); it != sharers.end(); it++) {
-                if (comma)
-                    str << ",";
-                str << *it;
-                comma = true;
-            }
-            str << "] Owner: " << owner;
+            str << " Sharers: [" << sharers.getString(names) << "]";
+            str << " Owner: " << (hasOwner() ? names->getName(owner) : "");
             str << " Cached: " << (cached ? "y" : "n");
             return str.str();
         }
@@ -339,23 +335,23 @@ private:
 
         void clearSharers() { sharers.clear(); }
 
-        void addSharer(std::string shr) { sharers.insert(shr); }
+        void addSharer(NodeID shr) { sharers.insert(shr); }
 
-        bool isSharer(std::string shr) { return sharers.find(shr) != sharers.end(); }
+        bool isSharer(NodeID shr) { return sharers.count(shr); }
 
         bool hasSharers() { return !(sharers.empty()); }
 
-        std::set<std::string>* getSharers() { return &sharers; }
+        SharerSet* getSharers() { return &sharers; }
 
-        void removeSharer(std::string shr) { sharers.erase(shr); }
+        void removeSharer(NodeID shr) { sharers.erase(shr); }
 
-        std::string getOwner() { return owner; }
+        NodeID getOwner() { return owner; }
 
-        bool hasOwner() { return owner != ""; }
+        bool hasOwner() { return owner != NO_NODE; }
 
-        void removeOwner() { owner = ""; }
+        void removeOwner() { owner = NO_NODE; }
 
-        void setOwner(std::string own) { owner = own; }
+        void setOwner(NodeID own) { owner = own; }
 
         void setState(State nState) { state = nState; }
 
@@ -380,7 +376,7 @@ private:
     void issueFlush(MemEvent* event);
     void issueFetch(MemEvent* event, DirEntry* entry, Command cmd);
     void issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd);
-    void issueInvalidation(std::string dst, MemEvent* event, DirEntry* entry, Command cmd);
+    void issueInvalidation(NodeID dst, MemEvent* event, DirEntry* entry, Command cmd);
     void sendDataResponse(MemEvent* event, DirEntry* entry, std::vector<uint8_t>& data, Command cmd, uint32_t flags = 0);
     void sendResponse(MemEvent* event, uint32_t flags = 0, uint32_t memflags = 0);
     void writebackData(MemEvent* event);
@@ -421,6 +417,9 @@ private:
     uint64_t mshrLatency;
 
     std::map<Addr, std::map<std::string, MemEvent::id_type> > responses;
+
+    /* Dense IDs for the names of caches that can share/own blocks */
+    NodeIDTable nodeIDs_;
     
     std::map<MemEvent::id_type, Addr> dirMemAccesses;
     
@@ -23,6 +23,7 @@
 #include "sst/elements/memHierarchy/memTypes.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
+#include "sst/elements/memHierarchy/sharerSet.h"
 
 using namespace std;
 
@@ -35,6 +36,10 @@ namespace SST { namespace MemHierarchy {
  * - getString() for debug
  * - getAddr() for identifiying a line
  * - getReplacementInfo() for returning the information that a replacement policy might need
+ *
+ * Lines that track sharers/owners identify them by NodeID (see sharerSet.h).
+ * The owning coherence manager hands its NodeIDTable to each line so that
+ * debug output can print names.
  */
 
 
@@ -45,14 +50,15 @@ class DirectoryLine {
         const unsigned int index_;
         Addr addr_;
         State state_;
-        std::set<std::string> sharers_;
-        std::string owner_;
+        SharerSet sharers_;
+        NodeID owner_;
         uint64_t lastSendTimestamp_;
         CoherenceReplacementInfo * info_;
         bool wasPrefetch_;
+        const NodeIDTable * names_;
 
     public:
-        DirectoryLine(uint32_t size, unsigned int index) : index_(index), addr_(0), state_(I), lastSendTimestamp_(0), wasPrefetch_(false) {
+        DirectoryLine(uint32_t size, unsigned int index) : index_(index), addr_(0), state_(I), owner_(NO_NODE), lastSendTimestamp_(0), wasPrefetch_(false), names_(nullptr) {
             info_ = new CoherenceReplacementInfo(index, I, false, false);
         }
         virtual ~DirectoryLine() { }
@@ -60,7 +66,7 @@ class DirectoryLine {
         void reset() {
             state_ = I;
             sharers_.clear();
-            owner_ = "";
+            owner_ = NO_NODE;
             lastSendTimestamp_ = 0;
             wasPrefetch_ = false;
         }
@@ -77,29 +83,29 @@ class DirectoryLine {
         void setState(State state) { state_ = state; }
 
         // Sharers
-        set<std::string>* getSharers() { return &sharers_; }
-        bool isSharer(std::string shr) {   return sharers_.find(shr) != sharers_.end(); }
+        SharerSet* getSharers() { return &sharers_; }
+        bool isSharer(NodeID shr) { return sharers_.count(shr); }
         size_t numSharers() { return sharers_.size(); }
         bool hasSharers() { return !sharers_.empty(); }
-        bool hasOtherSharers(std::string shr) { return !(sharers_.empty() || (sharers_.size() == 1 && sharers_.find(shr) != sharers_.end())); }
-        void addSharer(std::string shr) {
+        bool hasOtherSharers(NodeID shr) { return !(sharers_.empty() || (sharers_.size() == 1 && sharers_.count(shr))); }
+        void addSharer(NodeID shr) {
             sharers_.insert(shr);
             info_->setShared(true);
         }
-        void removeSharer(std::string shr) {
+        void removeSharer(NodeID shr) {
             sharers_.erase(shr);
             info_->setShared(!sharers_.empty());
         }
 
         // Owner
-        std::string getOwner() { return owner_; }
-        bool hasOwner() { return !owner_.empty(); }
-        void setOwner(std::string owner) {
+        NodeID getOwner() { return owner_; }
+        bool hasOwner() { return owner_ != NO_NODE; }
+        void setOwner(NodeID owner) {
             owner_ = owner;
             info_->setOwned(true);
         }
         void removeOwner() {
-            owner_.clear();
+            owner_ = NO_NODE;
             info_->setOwned(false);
         }
 
@@ -111,6 +117,8 @@ class DirectoryLine {
         bool getPrefetch() { return wasPrefetch_; }
         void setPrefetch(bool prefetch) { wasPrefetch_ = prefetch; }
 
+        // Names for debug output
+        void setNodeIDTable(const NodeIDTable * names) { names_ = names; }
 
         // Replacement
         ReplacementInfo* getReplacementInfo() { return info_; }
@@ -118,13 +126,11 @@ class DirectoryLine {
         // String-ify for debugging
         std::string getString() {
             std::ostringstream str;
-            str << "O: " << (owner_.empty() ? "-" : owner_);
-            str << " S: [";
-            for (std::set<std::string>::iterator it = sharers_.begin(); it != sharers_.end(); it++) {
-                if (it != sharers_.begin()) str << ",";
-                str << *it;
-            }
-            str << "]";
+            str << "O: ";
+            if (!hasOwner()) str << "-";
+            else if (names_) str << names_->getName(owner_);
+            else str << owner_;
+            str << " S: [" << sharers_.getString(names_) << "]";
             return str.str();
         }
 };
@@ -292,13 +298,14 @@ class L1CacheLine : public CacheLine {
 /* With owner/sharer state for shared caches */
 class SharedCacheLine : public CacheLine {
     private:
-        std::set<std::string> sharers_;
-        std::string owner_;
+        SharerSet sharers_;
+        NodeID owner_;
         CoherenceReplacementInfo * info;
+        const NodeIDTable * names_;
     protected:
         virtual void updateReplacement() { info->setState(state_); }
     public:
-        SharedCacheLine(uint32_t size, unsigned int index) : owner_(""), CacheLine(size, index) {
+        SharedCacheLine(uint32_t size, unsigned int index) : owner_(NO_NODE), names_(nullptr), CacheLine(size, index) {
             info = new CoherenceReplacementInfo(index, I, false, false);
         }
 
@@ -309,49 +316,50 @@ class SharedCacheLine : public CacheLine {
         void reset() {
             CacheLine::reset();
             sharers_.clear();
-            owner_ = "";
+            owner_ = NO_NODE;
         }
 
         // Sharers
-        set<std::string>* getSharers() { return &sharers_; }
-        bool isSharer(std::string name) {   return sharers_.find(name) != sharers_.end(); }
+        SharerSet* getSharers() { return &sharers_; }
+        bool isSharer(NodeID shr) { return sharers_.count(shr); }
         size_t numSharers() { return sharers_.size(); }
         bool hasSharers() { return !sharers_.empty(); }
-        bool hasOtherSharers(std::string shr) { return !(sharers_.empty() || (sharers_.size() == 1 && sharers_.find(shr) != sharers_.end())); }
-        void addSharer(std::string s) {
+        bool hasOtherSharers(NodeID shr) { return !(sharers_.empty() || (sharers_.size() == 1 && sharers_.count(shr))); }
+        void addSharer(NodeID s) {
             sharers_.insert(s);
             info->setShared(true);
         }
-        void removeSharer(std::string s) {
+        void removeSharer(NodeID s) {
             sharers_.erase(s);
             info->setShared(!sharers_.empty());
         }
 
         // Owner
-        std::string getOwner() { return owner_; }
-        bool hasOwner() { return !owner_.empty(); }
-        void setOwner(std::string owner) {
+        NodeID getOwner() { return owner_; }
+        bool hasOwner() { return owner_ != NO_NODE; }
+        void setOwner(NodeID owner) {
             owner_ = owner;
             info->setOwned(true);
         }
         void removeOwner() {
-            owner_.clear();
+            owner_ = NO_NODE;
             info->setOwned(false);
         }
 
+        // Names for debug output
+        void setNodeIDTable(const NodeIDTable * names) { names_ = names; }
+
         // Replacement
         ReplacementInfo * getReplacementInfo() { return info; }
 
         // String-ify for debugging
         std::string getString() {
             std::ostringstream str;
-            str << "O: " << (owner_.empty() ? "-" : owner_);
-            str << " S: [";
-            for (std::set<std::string>::iterator it = sharers_.begin(); it != sharers_.end(); it++) {
-                if (it != sharers_.begin()) str << ",";
-                str << *it;
-            }
-            str << "]";
+            str << "O: ";
+            if (!hasOwner()) str << "-";
+            else if (names_) str << names_->getName(owner_);
+            else str << owner_;
+            str << " S: [" << sharers_.getString(names_) << "]";
             return str.str();
         }
 };
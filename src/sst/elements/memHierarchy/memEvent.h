@@ -97,6 +97,10 @@ public:
         return me;
     }
 
+    ~MemEvent() {
+        MemEventPool::recyclePayload(payload_);
+    }
+
     /** Generate a new MemEvent, pre-populated as a response */
     MemEvent* makeResponse() override {
         MemEvent *me      = new MemEvent(*this);
@@ -194,7 +198,10 @@ public:
     /** @return  the data payload. */
     dataVec& getPayload(void) {
         /* Lazily allocate space for payload */
-        if ( payload_.size() < size_ )  payload_.resize(size_);
+        if ( payload_.size() < size_ ) {
+            MemEventPool::reusePayload(payload_);
+            payload_.resize(size_);
+        }
         return payload_;
     }
 
@@ -204,6 +211,7 @@ public:
      */
     void setPayload(std::vector<uint8_t>& data) {
         setSize(data.size());
+        MemEventPool::reusePayload(payload_);
         payload_ = data;
     }
 
@@ -211,17 +219,16 @@ public:
      * @param[in] size  How many bytes to copy from data
      * @param[in] data  Data array to set as payload
      */
-    void setPayload(uint32_t size, uint8_t* data) {
+    void setPayload(uint32_t size, const uint8_t* data) {
         setSize(size);
-        payload_.resize(size);
-        for ( uint32_t i = 0 ; i < size ; i++ ) {
-            payload_[i] = data[i];
-        }
+        MemEventPool::reusePayload(payload_);
+        payload_.assign(data, data + size);
     }
 
     void setZeroPayload(uint32_t size) {
         setSize(size);
         payload_.clear();
+        MemEventPool::reusePayload(payload_);
         payload_.resize(size, 0);
     }
 
@@ -22,6 +22,7 @@
 
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memTypes.h"
+#include "sst/elements/memHierarchy/memEventPool.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -55,6 +56,7 @@ public:
         eventID_        = generateUniqueId();  // Defined in SST::Event
         responseToID_   = NO_ID;
         dst_            = NONE;
+        dstLink_        = nullptr;
         src_            = NONE;
         rqstr_          = NONE;
         tid_            = 0;
@@ -69,10 +71,20 @@ public:
         return me;
     }
 
+    /** Turn this event into its own response. For handlers that would otherwise
+     * make a response and then delete the request */
+    void convertToResponse() {
+        responseToID_ = eventID_;
+        cmd_ = CommandResponse[(int)cmd_];
+        std::swap(src_, dst_);
+        dstLink_ = nullptr;
+    }
+
     void setResponse(MemEventBase * event) {
         responseToID_ = event->eventID_;
         cmd_ = CommandResponse[(int)cmd_];
         dst_ = event->src_;
+        dstLink_ = nullptr;
         src_ = event->dst_;
         rqstr_ = event->rqstr_;
         tid_ = event->tid_;
@@ -106,7 +118,15 @@ public:
     /** @return the destination string - who receives this MemEvent */
     const std::string& getDst(void) const { return dst_; }
     /** Sets the destination string - who received this MemEvent */
-    void setDst(const std::string& dst) { dst_ = dst; }
+    void setDst(const std::string& dst) { dst_ = dst; dstLink_ = nullptr; }
+    /** Sets the destination string along with the network address that link resolved it to */
+    void setDst(const std::string& dst, const void* link, uint64_t linkAddr) { dst_ = dst; dstLink_ = link; dstLinkAddr_ = linkAddr; }
+    /** @return whether link resolved the current destination and, if so, the network address it resolved to */
+    bool getDstLinkAddr(const void* link, uint64_t& linkAddr) const {
+        if (dstLink_ != link) return false;
+        linkAddr = dstLinkAddr_;
+        return true;
+    }
 
     /** @return the requestor string - whose original request caused this MemEvent */
     const std::string& getRqstr(void) const { return rqstr_; }
@@ -208,18 +228,24 @@ public:
         return new MemEventBase(*this);
     }
 
+    /* All memHierarchy events allocate through MemEventPool */
+    static void* operator new(std::size_t size) { return MemEventPool::allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { MemEventPool::release(ptr, size); }
+
 protected:
     id_type         eventID_;           // Unique ID for this event
     id_type         responseToID_;      // For responses, holds the ID to which this event matches
     string          src_;               // Source ID
     string          dst_;               // Destination ID
+    const void*     dstLink_;           // Link that resolved dst_ to dstLinkAddr_, not serialized
+    uint64_t        dstLinkAddr_;
     string          rqstr_;             // Cache that originated this request
     uint32_t        tid_;               // Thread ID that originated this request
     Command         cmd_;               // Command
     uint32_t        flags_;
     uint32_t        memFlags_;
 
-    MemEventBase() {} // For serialization only
+    MemEventBase() : dstLink_(nullptr) {} // For serialization only
 
 public:
     void serialize_order(SST::Core::Serialization::serializer &ser)  override {
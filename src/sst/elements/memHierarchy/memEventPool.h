@@ -0,0 +1,71 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_MEMEVENTPOOL_H
+#define MEMHIERARCHY_MEMEVENTPOOL_H
+
+#include <cstdint>
+#include <vector>
+
+#include <sst/elements/common/recyclingPool.h>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Recycling allocator for memHierarchy events
+ *
+ * MemEventBase and its subclasses allocate through here. The block allocator
+ * is the shared RecyclingPool; see there for threading and counters. On top of
+ * it, MemEvent payload vectors are kept so their storage can be reused by the
+ * next event that needs data.
+ */
+class MemEventPool : public SST::Common::RecyclingPool<MemEventPool, 512, 4096> {
+    public:
+        /* Keep a payload buffer that is about to be destroyed */
+        static void recyclePayload(std::vector<uint8_t>& payload) {
+            if (!isEnabled() || payload.capacity() == 0 || payload.capacity() > maxPayloadSize_)
+                return;
+            std::vector<std::vector<uint8_t> >& buffers = payloads();
+            if (buffers.size() < maxFreePayloads_) {
+                buffers.emplace_back();
+                buffers.back().swap(payload);
+            }
+        }
+
+        /* Give an empty payload a recycled buffer */
+        static void reusePayload(std::vector<uint8_t>& payload) {
+            if (!isEnabled() || payload.capacity() != 0)
+                return;
+            std::vector<std::vector<uint8_t> >& buffers = payloads();
+            if (!buffers.empty()) {
+                payload.swap(buffers.back());
+                buffers.pop_back();
+                payload.clear();
+            }
+        }
+
+    private:
+        static const std::size_t maxPayloadSize_ = 4096;
+        static const std::size_t maxFreePayloads_ = 4096;   // Per thread
+
+        static std::vector<std::vector<uint8_t> >& payloads() {
+            static thread_local std::vector<std::vector<uint8_t> > buffers;
+            return buffers;
+        }
+};
+
+}}
+
+#endif // MEMHIERARCHY_MEMEVENTPOOL_H
@@ -161,6 +161,14 @@ public:
     /* Functions for managing communication according to address */
     virtual std::string findTargetDestination(Addr addr) =0;    /* Return destination and return "" if none found */
     virtual std::string getTargetDestination(Addr addr) =0;     /* Return destination and error if none found */
+
+    /* Set the destination of an event from its routing address, return false if none found */
+    virtual bool setTargetDestination(MemEventBase* ev) {
+        std::string dst = findTargetDestination(ev->getRoutingAddress());
+        if (dst == "") return false;
+        ev->setDst(dst);
+        return true;
+    }
     
     /* Check if a request address maps to our region */
     virtual bool isRequestAddressValid(Addr addr) { return info.region.contains(addr); }
@@ -102,7 +102,7 @@ void MemNIC::send(MemEventBase *ev) {
     SimpleNetwork::Request *req = new SimpleNetwork::Request();
     MemRtrEvent * mre = new MemRtrEvent(ev);
     req->src = info.addr;
-    req->dest = lookupNetworkAddress(ev->getDst());
+    req->dest = lookupNetworkAddress(ev);
     req->size_in_bits = getSizeInBits(ev);
     req->vn = 0;
 
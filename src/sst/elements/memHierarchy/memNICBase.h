@@ -28,6 +28,7 @@
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
+#include "sst/elements/memHierarchy/routingTable.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -41,7 +42,8 @@ class MemNICBase : public MemLinkBase {
 #define MEMNICBASE_ELI_PARAMS MEMLINKBASE_ELI_PARAMS, \
         { "group",                       "(int) Group ID. See params 'sources' and 'destinations'. If not specified, the parent component will guess.", "1"},\
         { "sources",                     "(comma-separated list of ints) List of group IDs that serve as sources for this component. If not specified, defaults to 'group - 1'.", "group-1"},\
-        { "destinations",                "(comma-separated list of ints) List of group IDs that serve as destinations for this component. If not specified, defaults to 'group + 1'.", "group+1"}
+        { "destinations",                "(comma-separated list of ints) List of group IDs that serve as destinations for this component. If not specified, defaults to 'group + 1'.", "group+1"},\
+        { "dump_routing_table",          "(bool) Print the resolved address-to-destination map for this NIC at the end of init", "false"}
 
         SST_ELI_REGISTER_SUBCOMPONENT_DERIVED_API(SST::MemHierarchy::MemNICBase, SST::MemHierarchy::MemLinkBase)
 
@@ -160,12 +162,27 @@ class MemNICBase : public MemLinkBase {
         virtual std::set<EndpointInfo>* getDests() { return &destEndpointInfo; }
         
         virtual std::string findTargetDestination(Addr addr) {
+            if (routingTableBuilt) {
+                int dest = routingTable.lookup(addr);
+                return dest == AddressRoutingTable::NO_DEST ? "" : routingTable.getName(dest);
+            }
             for (std::set<EndpointInfo>::const_iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++) {
                 if (it->region.contains(addr)) return it->name;
             }
             return "";
         }
 
+        /* Also records the destination's network address on the event so send() does not have to look up the name */
+        virtual bool setTargetDestination(MemEventBase* ev) override {
+            if (!routingTableBuilt)
+                return MemLinkBase::setTargetDestination(ev);
+            int dest = routingTable.lookup(ev->getRoutingAddress());
+            if (dest == AddressRoutingTable::NO_DEST)
+                return false;
+            ev->setDst(routingTable.getName(dest), this, routingTable.getNetworkAddress(dest));
+            return true;
+        }
+
         virtual std::string getTargetDestination(Addr addr) {
             std::string dst = findTargetDestination(addr);
             if (dst != "") {
@@ -203,6 +220,8 @@ class MemNICBase : public MemLinkBase {
         virtual void addDest(EndpointInfo info) { 
             destEndpointInfo.insert(info); 
             reachableNames.insert(info.name);
+            if (routingTableBuilt)
+                buildRoutingTable();
         }
 
         virtual void addEndpoint(EndpointInfo info) { endpointInfo.insert(info); }
@@ -398,6 +417,30 @@ class MemNICBase : public MemLinkBase {
                 dbg.fatal(CALL_INFO, -1, "%s, Error: Unable to find destination for init event %s\n",
                         getName().c_str(), (*initWaitForDst.begin())->getVerboseString(dlevel).c_str());
             }
+
+            buildRoutingTable();
+            if (dumpRoutingTable) {
+                Output out("", 1, 0, Output::STDOUT);
+                out.output("%s, Routing table:\n%s", getName().c_str(), routingTable.toString().c_str());
+            }
+        }
+
+        /* Build the address lookup table from destEndpointInfo. Destinations are resolved
+         * in the same order as a scan of destEndpointInfo would find them */
+        void buildRoutingTable() {
+            routingTable.clear();
+            std::unordered_map<std::string,int> destIndex;
+            for (std::set<EndpointInfo>::const_iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++) {
+                std::unordered_map<std::string,int>::iterator dt = destIndex.find(it->name);
+                if (dt == destIndex.end()) {
+                    std::unordered_map<std::string,uint64_t>::const_iterator nt = networkAddressMap.find(it->name);
+                    int dest = routingTable.addDestination(it->name, nt == networkAddressMap.end() ? it->addr : nt->second);
+                    dt = destIndex.insert(std::make_pair(it->name, dest)).first;
+                }
+                routingTable.addRegion(it->region, dt->second);
+            }
+            routingTable.build();
+            routingTableBuilt = true;
         }
 
         // Lookup the network address for a given endpoint
@@ -409,6 +452,16 @@ class MemNICBase : public MemLinkBase {
             return it->second;
         }
 
+        /* Lookup the network address to send an event to. An event whose destination was set by
+         * setTargetDestination() on this NIC carries its network address; events addressed any other
+         * way (e.g., responses to a source) are looked up by name */
+        uint64_t lookupNetworkAddress(MemEventBase* ev) const {
+            uint64_t netAddr;
+            if (ev->getDstLinkAddr(this, netAddr))
+                return netAddr;
+            return lookupNetworkAddress(ev->getDst());
+        }
+
         /*
          * Some helper functions to avoid needing to repeat code everywhere
          */
@@ -482,6 +535,9 @@ class MemNICBase : public MemLinkBase {
         std::set<EndpointInfo> destEndpointInfo;
         std::set<EndpointInfo> endpointInfo;
         std::set<std::string> reachableNames;
+        AddressRoutingTable routingTable;   // Built from destEndpointInfo in setup()
+        bool routingTableBuilt;
+        bool dumpRoutingTable;
 
         // Init queues
         std::queue<MemRtrEvent*> initQueue; // Queue for received init events
@@ -541,6 +597,8 @@ class MemNICBase : public MemLinkBase {
                     destIDs.insert(info.id + 1);
             }
             initMsgSent = false;
+            routingTableBuilt = false;
+            dumpRoutingTable = params.find<bool>("dump_routing_table", false);
 
             dbg.debug(_L10_, "%s memNICBase info is: Name: %s, group: %" PRIu32 "\n",
                     getName().c_str(), info.name.c_str(), info.id);
@@ -19,6 +19,9 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <cstdio>
+#include <cstring>
+#include <memory>
 #include "sst/elements/memHierarchy/util.h"
 
 namespace SST {
@@ -35,6 +38,12 @@ public:
 
     virtual uint8_t get( Addr addr) = 0;
     virtual void get( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+
+    /* Zero-copy access to 'size' bytes at addr. Returns nullptr if the store can't provide
+     * the range contiguously, in which case use get/set instead. A returned pointer is only
+     * valid until the store is next modified. */
+    virtual const uint8_t* getSpan( Addr addr, size_t size ) { return nullptr; }
+    virtual uint8_t* getMutableSpan( Addr addr, size_t size ) { return nullptr; }
 };
 
 class BackingMMAP : public Backing {
@@ -81,10 +90,20 @@ public:
             data[i] = m_buffer[addr + i];
     }
 
+    const uint8_t* getSpan( Addr addr, size_t size ) {
+        return getMutableSpan(addr, size);
+    }
+
+    uint8_t* getMutableSpan( Addr addr, size_t size ) {
+        if (addr < m_offset || addr - m_offset > m_size || size > m_size - (addr - m_offset))
+            return nullptr;
+        return m_buffer + addr - m_offset;
+    }
+
 private:
     uint8_t* m_buffer;
     int m_fd;
-    int m_size;
+    size_t m_size;
     size_t m_offset;
 };
 
@@ -154,6 +173,19 @@ public:
         return m_buffer[bAddr][offset];
     }
 
+    const uint8_t* getSpan( Addr addr, size_t size ) {
+        return getMutableSpan(addr, size);
+    }
+
+    uint8_t* getMutableSpan( Addr addr, size_t size ) {
+        Addr bAddr = addr >> m_shift;
+        Addr offset = addr - (bAddr << m_shift);
+        if (offset + size > m_allocUnit)
+            return nullptr;
+        allocIfNeeded(bAddr);
+        return m_buffer[bAddr] + offset;
+    }
+
 private:
     void allocIfNeeded(Addr bAddr) {
         if (m_buffer.find(bAddr) == m_buffer.end()) {
@@ -175,6 +207,281 @@ private:
     bool m_init;
 };
 
+/*
+ * Sparse, page-granular backing store for very large memories
+ *  - Pages are found through a radix tree with 512-entry nodes and only as many
+ *    levels as the memory size needs
+ *  - Page storage is carved out of anonymous mmap'd chunks reserved on demand, so
+ *    memory that is never written costs no host memory and reads as zero
+ *  - snapshot() returns a copy-on-write copy; pages are shared until one copy writes them
+ *  - load()/dump() read and write an image containing only pages that have been written
+ */
+class BackingSparse : public Backing {
+public:
+    BackingSparse(size_t memSize) : Backing(), m_pool(new PagePool()), m_root(nullptr) {
+        /* Enough 9-bit levels to cover the page numbers of memSize */
+        unsigned int addrBits = m_pageShift + 1;
+        while (addrBits < 64 && (1ull << addrBits) < memSize)
+            addrBits++;
+        m_levels = (addrBits - m_pageShift + m_levelBits - 1) / m_levelBits;
+        m_zeroPage.resize(m_pageSize, 0);
+    }
+
+    ~BackingSparse() {
+        freeNode(m_root, 0);
+    }
+
+    /* Copy-on-write copy of this store */
+    BackingSparse* snapshot() {
+        BackingSparse* copy = new BackingSparse(*this);
+        copy->m_root = copyNode(m_root, 0);
+        return copy;
+    }
+
+    void set( Addr addr, uint8_t value ) {
+        getWritablePage(addr >> m_pageShift)[addr & m_pageMask] = value;
+    }
+
+    void set( Addr addr, size_t size, std::vector<uint8_t> &data ) {
+        size_t dataOffset = 0;
+        while (dataOffset != size) {
+            Addr offset = addr & m_pageMask;
+            size_t len = std::min(size - dataOffset, (size_t)(m_pageSize - offset));
+            memcpy(getWritablePage(addr >> m_pageShift) + offset, data.data() + dataOffset, len);
+            addr += len;
+            dataOffset += len;
+        }
+    }
+
+    uint8_t get( Addr addr ) {
+        return getPage(addr >> m_pageShift)[addr & m_pageMask];
+    }
+
+    void get( Addr addr, size_t size, std::vector<uint8_t> &data ) {
+        size_t dataOffset = 0;
+        while (dataOffset != size) {
+            Addr offset = addr & m_pageMask;
+            size_t len = std::min(size - dataOffset, (size_t)(m_pageSize - offset));
+            memcpy(data.data() + dataOffset, getPage(addr >> m_pageShift) + offset, len);
+            addr += len;
+            dataOffset += len;
+        }
+    }
+
+    /* Reads of unwritten pages see a shared zero page */
+    const uint8_t* getSpan( Addr addr, size_t size ) {
+        if ((addr & m_pageMask) + size > m_pageSize)
+            return nullptr;
+        return getPage(addr >> m_pageShift) + (addr & m_pageMask);
+    }
+
+    uint8_t* getMutableSpan( Addr addr, size_t size ) {
+        if ((addr & m_pageMask) + size > m_pageSize)
+            return nullptr;
+        return getWritablePage(addr >> m_pageShift) + (addr & m_pageMask);
+    }
+
+    /* Image format: magic, page size, then (page number, page data) for each written page in address order */
+    void dump( std::string filename ) {
+        FILE* fp = fopen(filename.c_str(), "wb");
+        if (!fp) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - unable to open '%s' to write memory image.\n", filename.c_str());
+        }
+        uint64_t header[2] = { m_imageMagic, m_pageSize };
+        bool ok = fwrite(header, sizeof(header), 1, fp) == 1;
+        ok = ok && dumpNode(fp, m_root, 0, 0);
+        ok = (fclose(fp) == 0) && ok;
+        if (!ok) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - failed writing memory image '%s'.\n", filename.c_str());
+        }
+    }
+
+    void load( std::string filename ) {
+        Output out("", 1, 0, Output::STDOUT);
+        FILE* fp = fopen(filename.c_str(), "rb");
+        if (!fp)
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - unable to open memory image '%s'.\n", filename.c_str());
+
+        uint64_t header[2];
+        if (fread(header, sizeof(header), 1, fp) != 1 || header[0] != m_imageMagic || header[1] != m_pageSize)
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - '%s' is not a memory image with %" PRIu64 "B pages.\n", filename.c_str(), m_pageSize);
+
+        uint64_t pageNum;
+        while (fread(&pageNum, sizeof(pageNum), 1, fp) == 1) {
+            if (m_levels * m_levelBits < 64 && (pageNum >> (m_levels * m_levelBits)) != 0)
+                out.fatal(CALL_INFO, -1, "BackingSparse: Error - memory image '%s' contains page 0x%" PRIx64 " which is outside this memory.\n", filename.c_str(), pageNum);
+            if (fread(getWritablePage(pageNum), m_pageSize, 1, fp) != 1)
+                out.fatal(CALL_INFO, -1, "BackingSparse: Error - memory image '%s' is truncated.\n", filename.c_str());
+        }
+        fclose(fp);
+    }
+
+private:
+    static const uint64_t m_pageShift = 12;
+    static const uint64_t m_pageSize = 1ull << m_pageShift;
+    static const uint64_t m_pageMask = m_pageSize - 1;
+    static const unsigned int m_levelBits = 9;
+    static const unsigned int m_fanout = 1 << m_levelBits;
+    static const uint64_t m_imageMagic = 0x31504d49484d454dull; // "MEMHIMP1"
+
+    struct Page {
+        uint8_t* data;
+        uint32_t refs;  // Number of stores sharing this page
+    };
+
+    struct Node {
+        Node() { memset(child, 0, sizeof(child)); }
+        void* child[m_fanout];  // Node* for interior levels, Page* for the last level
+    };
+
+    /* Page storage shared by a store and its snapshots */
+    class PagePool {
+    public:
+        ~PagePool() {
+            for (size_t i = 0; i < m_chunks.size(); i++)
+                munmap(m_chunks[i], m_chunkSize);
+            for (size_t i = 0; i < m_freePages.size(); i++)
+                delete m_freePages[i];
+        }
+
+        /* Returns a zero-filled page */
+        Page* allocate() {
+            Page* page;
+            if (!m_freePages.empty()) {
+                page = m_freePages.back();
+                m_freePages.pop_back();
+                memset(page->data, 0, m_pageSize);
+            } else {
+                if (m_next == m_end) {
+                    void* chunk = mmap(NULL, m_chunkSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON|MAP_NORESERVE, -1, 0);
+                    if (chunk == MAP_FAILED) {
+                        Output out("", 1, 0, Output::STDOUT);
+                        out.fatal(CALL_INFO, -1, "BackingSparse: Error - mmap failed.\n");
+                    }
+                    m_chunks.push_back(chunk);
+                    m_next = (uint8_t*)chunk;
+                    m_end = m_next + m_chunkSize;
+                }
+                page = new Page();
+                page->data = m_next;    // Fresh anonymous memory is already zero
+                m_next += m_pageSize;
+            }
+            page->refs = 1;
+            return page;
+        }
+
+        void release(Page* page) {
+            if (--page->refs == 0)
+                m_freePages.push_back(page);
+        }
+
+    private:
+        static const size_t m_chunkSize = 2 * 1024 * 1024;
+        std::vector<void*> m_chunks;
+        std::vector<Page*> m_freePages;
+        uint8_t* m_next = nullptr;
+        uint8_t* m_end = nullptr;
+    };
+
+    BackingSparse(const BackingSparse& other) : Backing(), m_pool(other.m_pool), m_root(nullptr), m_levels(other.m_levels), m_zeroPage(other.m_zeroPage) { }
+
+    unsigned int indexAt(uint64_t pageNum, unsigned int level) {
+        return (pageNum >> ((m_levels - 1 - level) * m_levelBits)) & (m_fanout - 1);
+    }
+
+    /* Read-only lookup, never allocates */
+    const uint8_t* getPage(uint64_t pageNum) {
+        Node* node = m_root;
+        for (unsigned int level = 0; node && level < m_levels - 1; level++)
+            node = (Node*)node->child[indexAt(pageNum, level)];
+        if (!node)
+            return m_zeroPage.data();
+        Page* page = (Page*)node->child[indexAt(pageNum, m_levels - 1)];
+        return page ? page->data : m_zeroPage.data();
+    }
+
+    /* Lookup for writing, allocating the page or breaking sharing as needed */
+    uint8_t* getWritablePage(uint64_t pageNum) {
+        if (!m_root)
+            m_root = new Node();
+        Node* node = m_root;
+        for (unsigned int level = 0; level < m_levels - 1; level++) {
+            void*& child = node->child[indexAt(pageNum, level)];
+            if (!child)
+                child = new Node();
+            node = (Node*)child;
+        }
+        void*& slot = node->child[indexAt(pageNum, m_levels - 1)];
+        Page* page = (Page*)slot;
+        if (!page) {
+            page = m_pool->allocate();
+            slot = page;
+        } else if (page->refs > 1) {
+            Page* copy = m_pool->allocate();
+            memcpy(copy->data, page->data, m_pageSize);
+            m_pool->release(page);
+            page = copy;
+            slot = page;
+        }
+        return page->data;
+    }
+
+    Node* copyNode(Node* node, unsigned int level) {
+        if (!node)
+            return nullptr;
+        Node* copy = new Node();
+        for (unsigned int i = 0; i < m_fanout; i++) {
+            if (!node->child[i])
+                continue;
+            if (level == m_levels - 1) {
+                ((Page*)node->child[i])->refs++;
+                copy->child[i] = node->child[i];
+            } else {
+                copy->child[i] = copyNode((Node*)node->child[i], level + 1);
+            }
+        }
+        return copy;
+    }
+
+    void freeNode(Node* node, unsigned int level) {
+        if (!node)
+            return;
+        for (unsigned int i = 0; i < m_fanout; i++) {
+            if (!node->child[i])
+                continue;
+            if (level == m_levels - 1)
+                m_pool->release((Page*)node->child[i]);
+            else
+                freeNode((Node*)node->child[i], level + 1);
+        }
+        delete node;
+    }
+
+    bool dumpNode(FILE* fp, Node* node, unsigned int level, uint64_t prefix) {
+        if (!node)
+            return true;
+        for (unsigned int i = 0; i < m_fanout; i++) {
+            if (!node->child[i])
+                continue;
+            uint64_t num = (prefix << m_levelBits) | i;
+            if (level == m_levels - 1) {
+                if (fwrite(&num, sizeof(num), 1, fp) != 1 || fwrite(((Page*)node->child[i])->data, m_pageSize, 1, fp) != 1)
+                    return false;
+            } else if (!dumpNode(fp, (Node*)node->child[i], level + 1, num)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::shared_ptr<PagePool> m_pool;
+    Node* m_root;
+    unsigned int m_levels;
+    std::vector<uint8_t> m_zeroPage;
+};
+
 }
 }
 }
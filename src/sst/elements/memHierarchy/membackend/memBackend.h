@@ -49,6 +49,7 @@ public:
             {"mem_size", "(string) Size of memory with units (SI ok). E.g., '2GiB'.", NULL}
 
     typedef MemBackendConvertor::ReqId ReqId;
+    typedef MemBackendConvertor::IssueReq IssueReq;
     MemBackend();
 
     MemBackend(ComponentId_t id, Params &params) : SubComponent(id) { 
@@ -119,20 +120,46 @@ class SimpleMemBackend : public MemBackend {
 
     virtual bool issueRequest( ReqId, Addr, bool isWrite, unsigned numBytes ) = 0;
 
+    /* Batched issue. Backends that return true from supportsBatchIssue() are handed all of
+     * a cycle's requests in one call instead of one issueRequest() per request.
+     * Requests must be accepted in order; returns the number accepted */
+    virtual bool supportsBatchIssue() { return false; }
+    virtual size_t issueBatch( const std::vector<IssueReq>& reqs ) {
+        size_t accepted = 0;
+        while (accepted < reqs.size() && issueRequest(reqs[accepted].id, reqs[accepted].addr, reqs[accepted].isWrite, reqs[accepted].numBytes))
+            accepted++;
+        return accepted;
+    }
+
     void handleMemResponse( ReqId id ) {
         m_respFunc( id );
     }
 
+    /* Return several completions at once, in completion order */
+    void handleMemResponses( const std::vector<ReqId>& ids ) {
+        if (m_batchRespFunc) {
+            m_batchRespFunc( ids );
+        } else {
+            for (std::vector<ReqId>::const_iterator it = ids.begin(); it != ids.end(); it++)
+                m_respFunc( *it );
+        }
+    }
+
     virtual void setResponseHandler( std::function<void(ReqId)> func ) {
         m_respFunc = func;
     }
 
+    virtual void setBatchResponseHandler( std::function<void(const std::vector<ReqId>&)> func ) {
+        m_batchRespFunc = func;
+    }
+
     virtual std::string getBackendConvertorType() {
         return "memHierarchy.simpleMemBackendConvertor";
     }
 
   private:
     std::function<void(ReqId)> m_respFunc;
+    std::function<void(const std::vector<ReqId>&)> m_batchRespFunc;
 };
 
 /* MemBackend - timing and passes request/response flags */
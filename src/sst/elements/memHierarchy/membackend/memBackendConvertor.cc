@@ -48,6 +48,7 @@ MemBackendConvertor::MemBackendConvertor(ComponentId_t id, Params& params, MemBa
     }
 
     m_clockBackend = m_backend->isClocked();
+    m_batchIssue = false;
 
     stat_GetSReqReceived    = registerStatistic<uint64_t>("requests_received_GetS");
     stat_GetSXReqReceived   = registerStatistic<uint64_t>("requests_received_GetSX");
@@ -91,12 +92,34 @@ void MemBackendConvertor::handleCustomEvent( Interfaces::StandardMem::CustomData
     uint32_t id = genReqId();
     CustomReq* req = new CustomReq( info, evId, rqstr, id );
     m_requestQueue.push_back( req );
-    m_pendingRequests[id] = req;
+    m_pendingRequests.insert( id, req );
 }
 
 bool MemBackendConvertor::clock(Cycle_t cycle) {
     m_cycleCount++;
 
+    if (m_batchIssue && !m_requestQueue.empty() && m_requestQueue.front()->isMemEv())
+        issueBatched();
+    else
+        issueSingle();
+
+    stat_outstandingReqs->addData( m_pendingRequests.size() );
+
+    bool unclock = !m_clockBackend;
+    if (m_clockBackend)
+        unclock = m_backend->clock(cycle);
+
+    // Can turn off the clock if:
+    // 1) backend says it's ok
+    // 2) requestQueue is empty
+    if (unclock && m_requestQueue.empty())
+        return true;
+
+    return false;
+}
+
+/* Issue requests to the backend one at a time */
+void MemBackendConvertor::issueSingle() {
     int reqsThisCycle = 0;
     bool cycleWithIssue = false;
     while ( !m_requestQueue.empty()) {
@@ -126,20 +149,45 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
 
     if (cycleWithIssue)
         stat_cyclesWithIssue->addData(1);
+}
 
-    stat_outstandingReqs->addData( m_pendingRequests.size() );
+/*
+ * Issue this cycle's requests to the backend in one call
+ * Gathers the same requests issueSingle() would try, stopping at the per-cycle limit or
+ * at a custom request, and applies the accepted prefix. Statistics match issueSingle().
+ */
+void MemBackendConvertor::issueBatched() {
+    size_t maxReqs = m_backend->getMaxReqPerCycle(); // -1 (unlimited) becomes SIZE_MAX
+    m_batch.clear();
+    m_batchReqs.clear();
 
-    bool unclock = !m_clockBackend;
-    if (m_clockBackend)
-        unclock = m_backend->clock(cycle);
+    for (std::deque<BaseReq*>::iterator it = m_requestQueue.begin(); it != m_requestQueue.end() && m_batch.size() != maxReqs; it++) {
+        if (!(*it)->isMemEv())
+            break;
+        MemReq* req = static_cast<MemReq*>(*it);
+        uint32_t offset = req->processed();
+        do {
+            IssueReq ireq = { req->id(offset), req->addr(offset), req->isWrite(), m_backendRequestWidth };
+            m_batch.push_back(ireq);
+            m_batchReqs.push_back(req);
+            offset += m_backendRequestWidth;
+        } while (offset < req->size() && m_batch.size() != maxReqs);
+    }
 
-    // Can turn off the clock if:
-    // 1) backend says it's ok
-    // 2) requestQueue is empty
-    if (unclock && m_requestQueue.empty())
-        return true;
+    size_t accepted = issueBatch(m_batch);
+    Debug(_L10_, "Issued %zu of %zu requests in batch\n", accepted, m_batch.size());
 
-    return false;
+    for (size_t i = 0; i < accepted; i++) {
+        MemReq* req = m_batchReqs[i];
+        req->increment( m_backendRequestWidth );
+        if ( req->issueDone() )
+            m_requestQueue.pop_front();
+    }
+
+    if (accepted < m_batch.size())
+        stat_cyclesAttemptIssueButRejected->addData(1);
+    else if (accepted != 0)
+        stat_cyclesWithIssue->addData(1);
 }
 
 /*
@@ -169,15 +217,32 @@ void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
         turnClockOn(cycle);
     }
 
+    completeResponse(reqId, flags);
+}
+
+/* Completions returned together by a batching backend, in completion order.
+ * The clock is checked once for the whole batch */
+void MemBackendConvertor::doResponses( const std::vector<ReqId>& reqIds ) {
+    if (reqIds.empty())
+        return;
+
+    if (!m_clockOn) {
+        Cycle_t cycle = m_enableClock();
+        turnClockOn(cycle);
+    }
+
+    for (std::vector<ReqId>::const_iterator it = reqIds.begin(); it != reqIds.end(); it++)
+        completeResponse(*it, 0);
+}
+
+void MemBackendConvertor::completeResponse( ReqId reqId, uint32_t flags ) {
     uint32_t id = BaseReq::getBaseId(reqId);
-    MemEvent* resp = NULL;
 
-    if ( m_pendingRequests.find( id ) == m_pendingRequests.end() ) {
+    BaseReq* req = m_pendingRequests.find( id );
+    if ( !req ) {
         m_dbg.fatal(CALL_INFO, -1, "memory request not found; id=%" PRId32 "\n", id);
     }
 
-    BaseReq* req = m_pendingRequests[id];
-
     req->decrement( );
 
     if ( req->isDone() ) {
@@ -197,23 +262,20 @@ void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
             doResponseStat( event->getCmd(), latency );
 
             if (!flags) flags = event->getFlags();
-            SST::Event::id_type evID = event->getID();
             sendResponse(event->getID(), flags); // Needs to occur before a flush is completed since flush is dependent
 
             // TODO clock responses
-            // Check for flushes that are waiting on this event to finish
-            if (m_dependentRequests.find(evID) != m_dependentRequests.end()) {
-                std::set<MemEvent*, memEventCmp> flushes = m_dependentRequests.find(evID)->second;
-
-                for (std::set<MemEvent*, memEventCmp>::iterator it = flushes.begin(); it != flushes.end(); it++) {
-                    (m_waitingFlushes.find(*it)->second).erase(evID);
-                    if ((m_waitingFlushes.find(*it)->second).empty()) {
-                        MemEvent * flush = *it;
-                        sendResponse(flush->getID(), flush->getFlags());
+            // Check for flushes that are waiting on this event to finish, in event ID order
+            std::vector<MemEvent*>* flushes = static_cast<MemReq*>(req)->getFlushes();
+            if (flushes) {
+                std::sort(flushes->begin(), flushes->end(), memEventCmp());
+                for (std::vector<MemEvent*>::iterator it = flushes->begin(); it != flushes->end(); it++) {
+                    std::unordered_map<MemEvent*, uint32_t>::iterator flush = m_waitingFlushes.find(*it);
+                    if (--(flush->second) == 0) {
+                        sendResponse((*it)->getID(), (*it)->getFlags());
                         m_waitingFlushes.erase(flush);
                     }
                 }
-                m_dependentRequests.erase(evID);
             }
         }
         delete req;
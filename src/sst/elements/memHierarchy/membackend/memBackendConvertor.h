@@ -20,6 +20,9 @@
 #include <sst/core/subcomponent.h>
 #include <sst/core/event.h>
 #include <sst/core/warnmacros.h>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
 
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/customcmd/customCmdMemory.h"
@@ -70,6 +73,7 @@ class MemBackendConvertor : public SubComponent {
         virtual ~BaseReq() { }
 
         static uint32_t getBaseId( ReqId id) { return id >> 32; }
+        uint32_t baseId()       { return m_reqId; }
         virtual uint64_t id()   { return ((uint64_t)m_reqId << 32); }
         virtual void decrement() { }
         virtual void increment( uint32_t UNUSED(bytes) ) { }
@@ -114,15 +118,17 @@ class MemBackendConvertor : public SubComponent {
     class MemReq : public BaseReq {
       public:
         MemReq( MemEvent* event, uint32_t reqId ) : BaseReq(reqId, BaseReq::ReqType::MEM),
-            m_event(event), m_offset(0), m_numReq(0) { }
-        ~MemReq() { }
+            m_event(event), m_offset(0), m_numReq(0), m_flushes(nullptr) { }
+        ~MemReq() { delete m_flushes; }
 
         static uint32_t getBaseId( ReqId id) { return id >> 32; }
         Addr baseAddr() { return m_event->getBaseAddr(); }
         Addr addr()     { return m_event->getBaseAddr() + m_offset; }
+        Addr addr( uint32_t offset ) { return m_event->getBaseAddr() + offset; }
 
         uint32_t processed()    { return m_offset; }
         uint64_t id()           { return ((uint64_t)m_reqId << 32) | m_offset; }
+        uint64_t id( uint32_t offset ) { return ((uint64_t)m_reqId << 32) | offset; }
         MemEvent* getMemEvent() { return m_event; }
         bool isWrite()          { return (m_event->getCmd() == Command::PutM || m_event->getCmd() == Command::Write); }
         uint32_t size()         { return m_event->getSize(); }
@@ -147,10 +153,71 @@ class MemBackendConvertor : public SubComponent {
             return BaseReq::getString() + str.str();
         }
 
+        /* Flushes waiting for this request to complete */
+        void addFlush( MemEvent* flush ) {
+            if (!m_flushes) m_flushes = new std::vector<MemEvent*>;
+            m_flushes->push_back(flush);
+        }
+        std::vector<MemEvent*>* getFlushes() { return m_flushes; }
+
       private:
         MemEvent*   m_event;
         uint32_t    m_offset;
         uint32_t    m_numReq;
+        std::vector<MemEvent*>* m_flushes;
+    };
+
+    /* One backend-width piece of a MemReq, as handed to a batching backend */
+    struct IssueReq {
+        ReqId       id;
+        Addr        addr;
+        bool        isWrite;
+        uint32_t    numBytes;
+    };
+
+    /*
+     * Outstanding requests by ID
+     * IDs are handed out in sequence so the live ones fall in a window and can be
+     * stored in a power-of-two ring at (id & mask). If a new ID lands on a slot that
+     * is still in use, the ring doubles.
+     */
+    class PendingRequests {
+      public:
+        PendingRequests() : m_slots(64, nullptr), m_mask(63), m_count(0) { }
+
+        BaseReq* find( uint32_t id ) {
+            BaseReq* req = m_slots[id & m_mask];
+            return (req && req->baseId() == id) ? req : nullptr;
+        }
+
+        void insert( uint32_t id, BaseReq* req ) {
+            while (m_slots[id & m_mask])
+                grow();
+            m_slots[id & m_mask] = req;
+            m_count++;
+        }
+
+        void erase( uint32_t id ) {
+            m_slots[id & m_mask] = nullptr;
+            m_count--;
+        }
+
+        size_t size() { return m_count; }
+
+      private:
+        void grow() {
+            std::vector<BaseReq*> old(m_slots.size() * 2, nullptr);
+            old.swap(m_slots);
+            m_mask = m_slots.size() - 1;
+            for (std::vector<BaseReq*>::iterator it = old.begin(); it != old.end(); it++) {
+                if (*it)
+                    m_slots[(*it)->baseId() & m_mask] = *it;
+            }
+        }
+
+        std::vector<BaseReq*>   m_slots;
+        uint32_t                m_mask;
+        size_t                  m_count;
     };
 
   public:
@@ -168,11 +235,12 @@ class MemBackendConvertor : public SubComponent {
 
     virtual const std::string getRequestor( ReqId reqId ) {
         uint32_t id = BaseReq::getBaseId(reqId);
-        if ( m_pendingRequests.find( id ) == m_pendingRequests.end() ) {
+        BaseReq* req = m_pendingRequests.find( id );
+        if ( !req ) {
             m_dbg.fatal(CALL_INFO, -1, "memory request not found\n");
         }
 
-        return m_pendingRequests[id]->getRqstr();
+        return req->getRqstr();
     }
 
     virtual void setCallbackHandlers(std::function<void(Event::id_type,uint32_t)> responseCB, std::function<Cycle_t()> clockenableCB);
@@ -189,41 +257,43 @@ class MemBackendConvertor : public SubComponent {
     }
 
     void doResponse( ReqId reqId, uint32_t flags = 0 );
+    void doResponses( const std::vector<ReqId>& reqIds );
+    void completeResponse( ReqId reqId, uint32_t flags );
     inline void sendResponse( SST::Event::id_type id, uint32_t flags );
 
     MemBackend* m_backend;
     uint32_t    m_backendRequestWidth;
 
     bool m_clockBackend;
+    bool m_batchIssue;  // Set by subclasses whose backend takes a cycle's requests in one call
 
   private:
     virtual bool issue(BaseReq*) = 0;
 
+    /* Hand a batch to the backend. Requests are accepted in order; returns how many were accepted */
+    virtual size_t issueBatch( const std::vector<IssueReq>& UNUSED(reqs) ) { return 0; }
+
+    void issueSingle();
+    void issueBatched();
+
 
 
 
     bool setupMemReq( MemEvent* ev ) {
         if ( Command::FlushLine == ev->getCmd() || Command::FlushLineInv == ev->getCmd() ) {
-            // TODO optimize if this becomes a problem, it is slow
-            std::set<SST::Event::id_type> dependsOn;
+            // The flush completes once every queued request to the same line has completed
+            uint32_t dependsOn = 0;
             for (std::deque<BaseReq*>::iterator it = m_requestQueue.begin(); it != m_requestQueue.end(); it++) {
                 if (!(*it)->isMemEv())
                     continue;
                 MemReq * mr = static_cast<MemReq*>(*it);
                 if (mr->baseAddr() == ev->getBaseAddr()) {
-                    MemEvent * req = mr->getMemEvent();
-                    dependsOn.insert(req->getID());
-                    if (m_dependentRequests.find(req->getID()) == m_dependentRequests.end()) {
-                        std::set<MemEvent*, memEventCmp> flushSet;
-                        flushSet.insert(ev);
-                        m_dependentRequests.insert(std::make_pair(req->getID(), flushSet));
-                    } else {
-                        (m_dependentRequests.find(req->getID())->second).insert(ev);
-                    }
+                    mr->addFlush(ev);
+                    dependsOn++;
                 }
             }
 
-            if (dependsOn.empty()) return false;
+            if (dependsOn == 0) return false;
             m_waitingFlushes.insert(std::make_pair(ev, dependsOn));
             return true;
         }
@@ -231,7 +301,7 @@ class MemBackendConvertor : public SubComponent {
         uint32_t id = genReqId();
         MemReq* req = new MemReq( ev, id );
         m_requestQueue.push_back( req );
-        m_pendingRequests[id] = req;
+        m_pendingRequests.insert( id, req );
         return true;
     }
 
@@ -297,14 +367,14 @@ class MemBackendConvertor : public SubComponent {
 
     uint32_t m_reqId;
 
-    typedef std::map<uint32_t,BaseReq*> PendingRequests;
-
     std::deque<BaseReq*>    m_requestQueue;
     PendingRequests         m_pendingRequests;
     uint32_t                m_frontendRequestWidth;
 
-    std::map<MemEvent*, std::set<SST::Event::id_type> > m_waitingFlushes; // Set of request IDs for each flush
-    std::map<SST::Event::id_type, std::set<MemEvent*, memEventCmp> > m_dependentRequests; // Reverse map, set of flushes for each request ID, for faster lookup
+    std::unordered_map<MemEvent*, uint32_t> m_waitingFlushes; // Number of requests each flush is waiting for
+
+    std::vector<IssueReq>   m_batch;        // Reused each cycle when batching
+    std::vector<MemReq*>    m_batchReqs;    // MemReq for each entry in m_batch
 
     Statistic<uint64_t>* stat_GetSLatency;
     Statistic<uint64_t>* stat_GetSXLatency;
@@ -37,7 +37,10 @@ void SimpleMemory::handleSelfEvent(SST::Event *event){
 #ifdef __SST_DEBUG_OUTPUT__
     output->debug(_L10_, "%s: Transaction done for id %" PRIx64 "\n", getName().c_str(),ev->reqId);
 #endif
-    handleMemResponse(ev->reqId);
+    if (ev->reqIds.empty())
+        handleMemResponse(ev->reqId);
+    else
+        handleMemResponses(ev->reqIds);
     delete event;
 }
 
@@ -49,3 +52,18 @@ bool SimpleMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned numB
     return true;
 }
 
+/* Every request has the same latency, so a batch completes together: send one event for all of them */
+size_t SimpleMemory::issueBatch( const std::vector<IssueReq>& reqs ) {
+    if (reqs.empty())
+        return 0;
+    std::vector<ReqId> ids;
+    ids.reserve(reqs.size());
+    for (std::vector<IssueReq>::const_iterator it = reqs.begin(); it != reqs.end(); it++) {
+#ifdef __SST_DEBUG_OUTPUT__
+        output->debug(_L10_, "%s: Issued transaction for address %" PRIx64 " id %" PRIx64"\n", getName().c_str(),(Addr)it->addr,it->id);
+#endif
+        ids.push_back(it->id);
+    }
+    self_link->send(1, new MemCtrlEvent(std::move(ids)));
+    return reqs.size();
+}
@@ -36,14 +36,19 @@ public:
     SimpleMemory();
     SimpleMemory(ComponentId_t id, Params &params);
     bool issueRequest(ReqId, Addr, bool, unsigned );
+    virtual bool supportsBatchIssue() { return true; }
+    virtual size_t issueBatch( const std::vector<IssueReq>& reqs );
     virtual bool isClocked() { return false; }
 
     class MemCtrlEvent : public SST::Event {
     public:
         MemCtrlEvent( ReqId id_) : SST::Event(), reqId(id_)
         { }
+        MemCtrlEvent( std::vector<ReqId>&& ids ) : SST::Event(), reqId(0), reqIds(std::move(ids))
+        { }
 
         ReqId reqId;
+        std::vector<ReqId> reqIds;  // All requests of a batch; empty for a single request
 
     private:
         MemCtrlEvent() {} // For Serialization only
@@ -52,6 +57,7 @@ public:
         void serialize_order(SST::Core::Serialization::serializer &ser)  override {
             Event::serialize_order(ser);
             ser & reqId;  // Cannot serialize pointers unless they are a serializable object
+            ser & reqIds;
        }
 
         ImplementSerializable(SST::MemHierarchy::SimpleMemory::MemCtrlEvent);
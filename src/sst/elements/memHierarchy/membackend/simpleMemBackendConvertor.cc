@@ -28,7 +28,10 @@ SimpleMemBackendConvertor::SimpleMemBackendConvertor(ComponentId_t id, Params &p
         MemBackendConvertor(id, params, backend, reqWidth)
 {
     using std::placeholders::_1;
-    static_cast<SimpleMemBackend*>(m_backend)->setResponseHandler( std::bind( &SimpleMemBackendConvertor::handleMemResponse, this, _1 ) );
+    SimpleMemBackend* simpleBackend = static_cast<SimpleMemBackend*>(m_backend);
+    simpleBackend->setResponseHandler( std::bind( &SimpleMemBackendConvertor::handleMemResponse, this, _1 ) );
+    simpleBackend->setBatchResponseHandler( std::bind( &SimpleMemBackendConvertor::handleMemResponses, this, _1 ) );
+    m_batchIssue = simpleBackend->supportsBatchIssue();
 }
 
 bool SimpleMemBackendConvertor::issue( BaseReq* req ) {
@@ -40,3 +43,7 @@ bool SimpleMemBackendConvertor::issue( BaseReq* req ) {
         return static_cast<SimpleMemBackend*>(m_backend)->issueCustomRequest( creq->id(), creq->getInfo() );
     }
 }
+
+size_t SimpleMemBackendConvertor::issueBatch( const std::vector<IssueReq>& reqs ) {
+    return static_cast<SimpleMemBackend*>(m_backend)->issueBatch( reqs );
+}
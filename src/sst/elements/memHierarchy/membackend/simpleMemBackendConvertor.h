@@ -39,10 +39,15 @@ public:
     SimpleMemBackendConvertor(ComponentId_t id, Params &params, MemBackend* backend, uint32_t);
 
     virtual bool issue( BaseReq* req );
+    virtual size_t issueBatch( const std::vector<IssueReq>& reqs );
 
     virtual void handleMemResponse( ReqId reqId ) {
         doResponse(reqId);
     }
+
+    virtual void handleMemResponses( const std::vector<ReqId>& reqIds ) {
+        doResponses(reqIds);
+    }
 };
 
 }
@@ -83,6 +83,10 @@ bool TimingDRAM::clock(Cycle_t cycle)
     for ( unsigned i = 0; i < m_channels.size(); i++ ) {
         m_channels[i]->clock(m_cycle);
     }
+    if ( ! m_responses.empty() ) {
+        handleMemResponses( m_responses );
+        m_responses.clear();
+    }
     ++m_cycle;
     return false;
 }
@@ -323,9 +323,12 @@ public:
     TimingDRAM();
     TimingDRAM(ComponentId_t, Params& );
     virtual bool issueRequest( ReqId, Addr, bool, unsigned );
+    /* Uses the default issueBatch(); each request still goes to its own channel */
+    virtual bool supportsBatchIssue() { return true; }
+    /* Channels retire at most one transaction per cycle each; collect them and return them together at the end of clock() */
     void handleResponse(ReqId  id ) {
         output->verbose(CALL_INFO, 2, DBG_MASK, "req=%" PRIu64 "\n", id );
-        handleMemResponse( id );
+        m_responses.push_back( id );
     }
     virtual bool clock(Cycle_t cycle);
     virtual void finish() {}
@@ -334,6 +337,7 @@ private:
     std::vector<Channel*> m_channels;
     AddrMapper* m_mapper;
     SimTime_t   m_cycle;
+    std::vector<ReqId> m_responses;
 
 };
 
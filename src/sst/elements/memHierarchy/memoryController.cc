@@ -69,6 +69,13 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
 
     bool initBacking = params.find<bool>("initBacking", false);
 
+    if (params.find<bool>("event_pool", false))
+        MemEventPool::enable();
+    statEventPoolAllocs = registerStatistic<uint64_t>("EventPool_allocations");
+    statEventPoolHits = registerStatistic<uint64_t>("EventPool_hits");
+    statEventPoolLiveMax = registerStatistic<uint64_t>("EventPool_live_max");
+    statEventPoolLive = registerStatistic<uint64_t>("EventPool_live_at_finish");
+
     // Debug address
     std::vector<Addr> addrArr;
     params.find_array<Addr>("debug_addr", addrArr);
@@ -267,8 +274,8 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         if (oldBackVal) backingType = "none";
     }
 
-    if (backingType != "none" && backingType != "mmap" && backingType != "malloc") {
-        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', or 'mmap'. You specified: %s\n",
+    if (backingType != "none" && backingType != "mmap" && backingType != "malloc" && backingType != "sparse") {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', 'mmap', or 'sparse'. You specified: %s\n",
                 getName().c_str(), backingType.c_str());
     }
 
@@ -310,6 +317,18 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         }
     } else if (backingType == "malloc") {
         backing_ = new Backend::BackingMalloc(sizeBytes,initBacking);
+    } else if (backingType == "sparse") {
+        Backend::BackingSparse* sparse = new Backend::BackingSparse(memBackendConvertor_->getMemSize());
+        std::string imageFile = params.find<std::string>("backing_image_load", "");
+        if (!imageFile.empty())
+            sparse->load(imageFile);
+        backing_ = sparse;
+    }
+
+    backingImageDump_ = params.find<std::string>("backing_image_dump", "");
+    if (!backingImageDump_.empty() && backingType != "sparse") {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing_image_dump is only supported with backing = 'sparse'. Backing is '%s'.\n",
+                getName().c_str(), backingType.c_str());
     }
 
     /* Custom command handler */
@@ -525,7 +544,9 @@ void MemController::handleMemResponse( Event::id_type id, uint32_t flags ) {
         return;
     }
 
-    MemEvent * resp = ev->makeResponse();
+    /* The request isn't needed once answered so it becomes the response */
+    MemEvent * resp = ev;
+    resp->convertToResponse();
 
     /* Read order matches execute order so that mis-ordering at backend can result in bad data */
     if (resp->getCmd() == Command::GetSResp || resp->getCmd() == Command::GetXResp) {
@@ -546,7 +567,6 @@ void MemController::handleMemResponse( Event::id_type id, uint32_t flags ) {
     }
 
     link_->send( resp );
-    delete ev;
 }
 
 void MemController::init(unsigned int phase) {
@@ -578,6 +598,18 @@ void MemController::finish(void) {
     cycle--;
     memBackendConvertor_->finish(cycle);
     link_->finish();
+
+    /* The counters belong to the thread, so only the first cache or memory controller to finish on each thread records them */
+    if (MemEventPool::isEnabled() && MemEventPool::claimThreadReport()) {
+        const MemEventPool::Counters& pool = MemEventPool::getCounters();
+        statEventPoolAllocs->addData(pool.requests);
+        statEventPoolHits->addData(pool.hits);
+        statEventPoolLiveMax->addData(pool.liveMax);
+        statEventPoolLive->addData(pool.live);
+    }
+
+    if (!backingImageDump_.empty())
+        static_cast<Backend::BackingSparse*>(backing_)->dump(backingImageDump_);
 }
 
 void MemController::writeData(MemEvent* event) {
@@ -612,6 +644,15 @@ void MemController::readData(MemEvent* event) {
     bool noncacheable = event->queryFlag(MemEvent::F_NONCACHEABLE);
     Addr localAddr = noncacheable ? event->getAddr() : event->getBaseAddr();
 
+    /* Copy straight out of the backing store if it can hand us the range in place */
+    const uint8_t* span = backing_ ? backing_->getSpan(localAddr, event->getSize()) : nullptr;
+    if (span) {
+        event->setPayload(event->getSize(), span);
+        if (is_debug_addr(localAddr))
+            printDataValue(localAddr, &(event->getPayload()), false);
+        return;
+    }
+
     vector<uint8_t> payload;
     payload.resize(event->getSize(), 0);
 
@@ -629,9 +670,7 @@ void MemController::readData(MemEvent* event) {
 void MemController::writeData(Addr addr, std::vector<uint8_t> * data) {
     if (!backing_) return;
 
-    for (size_t i = 0; i < data->size(); i++) {
-        backing_->set(addr + i, data->at(i));
-    }
+    backing_->set(addr, data->size(), *data);
 
     if (is_debug_addr(addr))
         printDataValue(addr, data, true);
@@ -643,9 +682,8 @@ void MemController::readData(Addr addr, size_t bytes, std::vector<uint8_t> &data
 
     if (!backing_) return;
 
-    for (size_t i = 0; i < bytes; i++)
-        data[i] = backing_->get(addr + i);
-    
+    backing_->get(addr, bytes, data);
+
     if (is_debug_addr(addr))
         printDataValue(addr, &data, false);
 }
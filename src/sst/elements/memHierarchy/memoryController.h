@@ -50,14 +50,17 @@ public:
             {"debug_addr",          "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""},\
             {"listenercount",       "(uint) Counts the number of listeners attached to this controller, these are modules for tracing or components like prefetchers", "0"},\
             {"listener%(listenercount)d", "(string) Loads a listener module into the controller", ""},\
-            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
+            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', 'mmap', or 'sparse' (page-granular, for very large memories)", "mmap"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
+            {"backing_image_load",  "(string) For 'sparse' backing stores, optional memory image to load at construction", ""},\
+            {"backing_image_dump",  "(string) For 'sparse' backing stores, optional file to write a memory image to at the end of simulation. Only written pages are saved", ""},\
             {"addr_range_start",    "(uint) Lowest address handled by this memory.", "0"},\
             {"addr_range_end",      "(uint) Highest address handled by this memory.", "uint64_t-1"},\
             {"interleave_size",     "(string) Size of interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
             {"interleave_step",     "(string) Distance between interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
-            {"customCmdMemHandler", "(string) Name of the custom command handler to load", ""}
+            {"customCmdMemHandler", "(string) Name of the custom command handler to load", ""},\
+            {"event_pool",          "(bool) Recycle memHierarchy event objects and payload buffers instead of freeing them. Turning this on in any component enables it for the whole simulation", "false"}
 
     SST_ELI_DOCUMENT_PARAMS( MEMCONTROLLER_ELI_PARAMS )
 
@@ -70,6 +73,13 @@ public:
 
     SST_ELI_DOCUMENT_PORTS( MEMCONTROLLER_ELI_PORTS )
 
+#define MEMCONTROLLER_ELI_STATISTICS {"EventPool_allocations",   "With event_pool, events allocated by the thread this controller runs on. The pool is per thread, so this is recorded at end of simulation by only one cache or memory controller per thread", "events", 3},\
+            {"EventPool_hits",          "With event_pool, allocations on this thread served from recycled events. Hit rate is EventPool_hits / EventPool_allocations. Recorded once per thread", "events", 3},\
+            {"EventPool_live_max",      "With event_pool, high-water mark of events allocated and not yet freed on this thread. Recorded once per thread", "events", 3},\
+            {"EventPool_live_at_finish","With event_pool, events still allocated on this thread at the end of simulation; a large value points to a leak. Recorded once per thread", "events", 3}
+
+    SST_ELI_DOCUMENT_STATISTICS( MEMCONTROLLER_ELI_STATISTICS )
+
 
 #define MEMCONTROLLER_ELI_SUBCOMPONENTSLOTS {"backend", "Backend memory model to use for timing. Defaults to simpleMem", "SST::MemHierarchy::MemBackend"},\
             {"customCmdHandler", "Optional handler for custom command types", "SST::MemHierarchy::CustomCmdMemHandler"}, \
@@ -127,12 +137,18 @@ protected:
 
     MemBackendConvertor*    memBackendConvertor_;
     Backend::Backing*       backing_;
+    std::string             backingImageDump_;
 
     MemLinkBase* link_;         // Link to the rest of memHierarchy
     bool clockLink_;            // Flag - should we call clock() on this link or not
 
     std::vector<CacheListener*> listeners_;
 
+    Statistic<uint64_t>* statEventPoolAllocs;
+    Statistic<uint64_t>* statEventPoolHits;
+    Statistic<uint64_t>* statEventPoolLiveMax;
+    Statistic<uint64_t>* statEventPoolLive;
+
     bool isRequestAddressValid(Addr addr){
         return region_.contains(addr);
     }
@@ -21,14 +21,116 @@
 using namespace SST;
 using namespace SST::MemHierarchy;
 
+/* MSHRTable */
+MSHRTable::MSHRTable(size_t minCapacity) : count_(0) {
+    size_t capacity = 16;
+    unsigned int bits = 4;
+    while (capacity < 2 * minCapacity) {
+        capacity <<= 1;
+        bits++;
+    }
+    slots_.assign(capacity, Slot());
+    mask_ = capacity - 1;
+    shift_ = 64 - bits;
+}
+
+MSHRTable::~MSHRTable() {
+    for (size_t i = 0; i < slots_.size(); i++) {
+        if (slots_[i].reg)
+            delete slots_[i].reg;
+    }
+    for (size_t i = 0; i < freeRegs_.size(); i++)
+        delete freeRegs_[i];
+}
+
+MSHRRegister* MSHRTable::find(Addr addr) const {
+    size_t i = home(addr);
+    while (slots_[i].reg) {
+        if (slots_[i].addr == addr)
+            return slots_[i].reg;
+        i = (i + 1) & mask_;
+    }
+    return nullptr;
+}
+
+MSHRRegister* MSHRTable::insert(Addr addr) {
+    if (2 * (count_ + 1) > slots_.size())
+        grow();
+
+    size_t i = home(addr);
+    while (slots_[i].reg) {
+        if (slots_[i].addr == addr)
+            return slots_[i].reg;
+        i = (i + 1) & mask_;
+    }
+
+    MSHRRegister* reg;
+    if (freeRegs_.empty()) {
+        reg = new MSHRRegister();
+    } else {
+        reg = freeRegs_.back();
+        freeRegs_.pop_back();
+    }
+    slots_[i].addr = addr;
+    slots_[i].reg = reg;
+    count_++;
+    return reg;
+}
+
+void MSHRTable::erase(Addr addr) {
+    size_t i = home(addr);
+    while (slots_[i].reg && slots_[i].addr != addr)
+        i = (i + 1) & mask_;
+    if (!slots_[i].reg)
+        return;
+
+    slots_[i].reg->reset();
+    freeRegs_.push_back(slots_[i].reg);
+    count_--;
+
+    /* Shift later entries in the probe run back so lookups never need tombstones */
+    size_t j = i;
+    while (true) {
+        j = (j + 1) & mask_;
+        if (!slots_[j].reg)
+            break;
+        size_t h = home(slots_[j].addr);
+        bool movable = (i <= j) ? (h <= i || h > j) : (h <= i && h > j);
+        if (movable) {
+            slots_[i] = slots_[j];
+            i = j;
+        }
+    }
+    slots_[i].reg = nullptr;
+}
+
+void MSHRTable::grow() {
+    std::vector<Slot> old;
+    old.swap(slots_);
+    slots_.assign(old.size() * 2, Slot());
+    mask_ = slots_.size() - 1;
+    shift_--;
+
+    for (size_t k = 0; k < old.size(); k++) {
+        if (!old[k].reg)
+            continue;
+        size_t i = home(old[k].addr);
+        while (slots_[i].reg)
+            i = (i + 1) & mask_;
+        slots_[i] = old[k];
+    }
+}
+
+/* MSHR */
 MSHR::MSHR(ComponentId_t cid, Output* debug, int maxSize, string cacheName, std::set<Addr> debugAddr) :
-    ComponentExtension(cid)
+    ComponentExtension(cid), mshr_(maxSize > 0 ? maxSize : 64)
 {
     d_ = debug;
     maxSize_ = maxSize;
     size_ = 0;
     prefetchCount_ = 0;
     ownerName_ = cacheName;
+    statAddrOccupancy_ = nullptr;
 
     d2_ = new Output();
     d2_->init("", 10, 0, (Output::output_location_t)1);
@@ -36,6 +138,82 @@ MSHR::MSHR(ComponentId_t cid, Output* debug, int maxSize, string cacheName, std:
     DEBUG_ADDR = debugAddr;
 }
 
+MSHR::~MSHR() {
+    mshr_.forEach([](Addr addr, MSHRRegister* reg) {
+        for (std::list<MSHREntry>::iterator it = reg->entries.begin(); it != reg->entries.end(); it++) {
+            if (it->getType() == MSHREntryType::Evict)
+                delete it->getPointers();
+        }
+    });
+    for (size_t i = 0; i < ptrListPool_.size(); i++)
+        delete ptrListPool_[i];
+}
+
+/* Insert an entry before pos, reusing a pooled list node if one is available */
+std::list<MSHREntry>::iterator MSHR::allocateEntry(MSHRRegister* reg, std::list<MSHREntry>::iterator pos, const MSHREntry& entry) {
+    std::list<MSHREntry>::iterator it;
+    if (entryPool_.empty()) {
+        it = reg->entries.insert(pos, entry);
+    } else {
+        it = entryPool_.begin();
+        reg->entries.splice(pos, entryPool_, it);
+        *it = entry;
+    }
+    if (reg->entries.size() > reg->peakEntries)
+        reg->peakEntries = reg->entries.size();
+    return it;
+}
+
+/* Move an entry (and its evict pointers, if any) back to the pools */
+void MSHR::releaseEntry(MSHRRegister* reg, std::list<MSHREntry>::iterator entry) {
+    if (entry->getType() == MSHREntryType::Evict) {
+        std::list<Addr>* ptrs = entry->getPointers();
+        ptrPool_.splice(ptrPool_.end(), *ptrs);
+        ptrListPool_.push_back(ptrs);
+    }
+    entryPool_.splice(entryPool_.end(), reg->entries, entry);
+}
+
+void MSHR::releaseRegister(Addr addr, MSHRRegister* reg) {
+    if (is_debug_addr(addr))
+        printDebug(10, "Erase", addr, "");
+    if (statAddrOccupancy_)
+        statAddrOccupancy_->addData(reg->peakEntries);
+    mshr_.erase(addr);
+}
+
+std::list<Addr>* MSHR::allocatePointerList(Addr addr) {
+    std::list<Addr>* ptrs;
+    if (ptrListPool_.empty()) {
+        ptrs = new std::list<Addr>;
+    } else {
+        ptrs = ptrListPool_.back();
+        ptrListPool_.pop_back();
+    }
+    addPointer(ptrs, addr);
+    return ptrs;
+}
+
+void MSHR::addPointer(std::list<Addr>* ptrs, Addr addr) {
+    if (ptrPool_.empty()) {
+        ptrs->push_back(addr);
+    } else {
+        ptrs->splice(ptrs->end(), ptrPool_, ptrPool_.begin());
+        ptrs->back() = addr;
+    }
+}
+
+/* Equivalent to ptrs->remove(addr) but keeps the nodes */
+void MSHR::removePointer(std::list<Addr>* ptrs, Addr addr) {
+    std::list<Addr>::iterator it = ptrs->begin();
+    while (it != ptrs->end()) {
+        std::list<Addr>::iterator next = std::next(it);
+        if (*it == addr)
+            ptrPool_.splice(ptrPool_.end(), *ptrs, it);
+        it = next;
+    }
+}
+
 int MSHR::getMaxSize() {
     return maxSize_;
 }
@@ -45,44 +223,47 @@ int MSHR::getSize() {
 }
 
 unsigned int MSHR::getSize(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg)
         return 0;
     else
-        return mshr_.find(addr)->second.entries.size();
+        return reg->entries.size();
 }
 
 bool MSHR::exists(Addr addr) {
-    return mshr_.find(addr) != mshr_.end();
+    return mshr_.find(addr) != nullptr;
 }
 
-MSHREntry MSHR::getEntry(Addr addr, size_t index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+MSHREntry& MSHR::getEntry(Addr addr, size_t index) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    if (mshr_.find(addr)->second.entries.size() <= index) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %zu.\n", ownerName_.c_str(), addr, index, mshr_.find(addr)->second.entries.size());
+    if (reg->entries.size() <= index) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %zu.\n", ownerName_.c_str(), addr, index, reg->entries.size());
     }
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+    std::list<MSHREntry>::iterator it = reg->entries.begin();
     std::advance(it, index);
     return *it;
 }
 
-MSHREntry MSHR::getFront(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+MSHREntry& MSHR::getFront(Addr addr) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
     }
 
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries.front();
+    return reg->entries.front();
 }
 
 void MSHR::removeEntry(Addr addr, size_t index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
     if (reg->entries.size() <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
     }
@@ -96,78 +277,61 @@ void MSHR::removeEntry(Addr addr, size_t index) {
     if (is_debug_addr(addr))
         printDebug(10, "Remove", addr, (*entry).getString().c_str());
 
-    reg->entries.erase(entry);
-    if (reg->entries.empty()) {
-        if (is_debug_addr(addr))
-            printDebug(10, "Erase", addr, "");
-            //d_->debug(_L10_, "M: %-41" PRIu64 " %-20s Erase        0x%-16" PRIx64 " %-10d\n",
-            //        getCurrentSimCycle(), ownerName_.c_str(), addr, size_);
-            //d_->debug(_L10_, "    MSHR: erasing 0x%" PRIx64 " from MSHR\n", addr);
-        mshr_.erase(addr);
-    }
+    releaseEntry(reg, entry);
+    if (reg->entries.empty())
+        releaseRegister(addr, reg);
 }
 
 void MSHR::removeFront(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
     if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
 
-   // if (is_debug_addr(addr))
-   //     d_->debug(_L10_, "    MSHR::removeFront(0x%" PRIx64 ", %s)\n", addr, reg->entries.front().getString().c_str());
-
-    if (getFrontType(addr) == MSHREntryType::Event)
+    if (reg->entries.front().getType() == MSHREntryType::Event)
         size_--;
 
     if (is_debug_addr(addr))
         printDebug(10, "RemFr", addr, (reg->entries.front()).getString().c_str());
 
-    reg->entries.pop_front();
-    if (reg->entries.empty()) {
-        if (is_debug_addr(addr))
-            printDebug(10, "Erase", addr, "");
-            //d_->debug(_L10_, "    MSHR: erasing 0x%" PRIx64 " from MSHR\n", addr);
-        mshr_.erase(addr);
-    }
+    releaseEntry(reg, reg->entries.begin());
+    if (reg->entries.empty())
+        releaseRegister(addr, reg);
 }
 
 MSHREntryType MSHR::getEntryType(Addr addr, size_t index) {
-    //if (is_debug_addr(addr))
-    //    d_->debug(_L20_, "    MSHR::getEntryType(0x%" PRIx64 ", %zu)\n", addr, index);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    if (mshr_.find(addr)->second.entries.size() <= index) {
+    if (reg->entries.size() <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Entry list is shoerter than index.\n", ownerName_.c_str(), addr, index);
     }
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+    std::list<MSHREntry>::iterator it = reg->entries.begin();
     std::advance(it, index);
     return it->getType();
 }
 
 MSHREntryType MSHR::getFrontType(Addr addr) {
-    //if (is_debug_addr(addr))
-    //    d_->debug(_L20_, "    MSHR::getFrontType(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries.front().getType();
+    return reg->entries.front().getType();
 }
 
 MemEventBase* MSHR::getEntryEvent(Addr addr, size_t index) {
-    //if (is_debug_addr(addr))
-    //    d_->debug(_L20_, "    MSHR::getEntryEvent(0x%" PRIx64 ", %zu)\n", addr, index);
-
-    if (mshr_.find(addr) == mshr_.end() || mshr_.find(addr)->second.entries.size() <= index)
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg || reg->entries.size() <= index)
         return nullptr;
 
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+    std::list<MSHREntry>::iterator it = reg->entries.begin();
     std::advance(it, index);
     if (it->getType() != MSHREntryType::Event)
         return nullptr;
@@ -176,22 +340,18 @@ MemEventBase* MSHR::getEntryEvent(Addr addr, size_t index) {
 
 
 MemEventBase* MSHR::getFrontEvent(Addr addr) {
-    //if (is_debug_addr(addr))
-    //    d_->debug(_L20_, "    MSHR::getFrontEvent(0x%" PRIx64 ")\n", addr);
     if (getFrontType(addr) != MSHREntryType::Event) {
         return nullptr;
     }
-    return mshr_.find(addr)->second.entries.front().getEvent();
+    return mshr_.find(addr)->entries.front().getEvent();
 }
 
 MemEventBase* MSHR::getFirstEventEntry(Addr addr, Command cmd) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getFirstEventEntry(0x%" PRIx64 ", %s)\n", addr, CommandString[(int)cmd]);
-
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg)
         return nullptr;
 
-    for (std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin(); it != mshr_.find(addr)->second.entries.end(); it++) {
+    for (std::list<MSHREntry>::iterator it = reg->entries.begin(); it != reg->entries.end(); it++) {
         if (it->getType() == MSHREntryType::Event && it->getEvent()->getCmd() == cmd)
             return it->getEvent();
     }
@@ -202,7 +362,7 @@ std::list<Addr>* MSHR::getEvictPointers(Addr addr) {
     if (getFrontType(addr) != MSHREntryType::Evict)
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEvictPointers(0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr);
 
-    return mshr_.find(addr)->second.entries.front().getPointers();
+    return mshr_.find(addr)->entries.front().getPointers();
 }
 
 // Return whether we should retry a new event or not
@@ -217,19 +377,20 @@ bool MSHR::removeEvictPointer(Addr addr, Addr addrPtr) {
     }
 
     // Sometimes we insert a WB before the Evict & then remove the Evict pointer, othertimes the Evict is front
-    if (getFrontType(addr) == MSHREntryType::Evict) {
-        MSHREntry * entry = &(mshr_.find(addr)->second.entries.front());
-        entry->getPointers()->remove(addrPtr);
+    MSHRRegister* reg = mshr_.find(addr);
+    if (reg->entries.front().getType() == MSHREntryType::Evict) {
+        MSHREntry * entry = &(reg->entries.front());
+        removePointer(entry->getPointers(), addrPtr);
         if (entry->getPointers()->empty()) {
             removeFront(addr);
             return true;
         }
     } else {
-        std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+        std::list<MSHREntry>::iterator it = reg->entries.begin();
         it++;
         if (it->getType() != MSHREntryType::Evict)
             d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEvictPointer(0x%" PRIx64 ", 0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr, addrPtr);
-        it->getPointers()->remove(addrPtr);
+        removePointer(it->getPointers(), addrPtr);
         if (it->getPointers()->empty()) {
             removeEntry(addr, 1);
         }
@@ -243,7 +404,7 @@ bool MSHR::pendingWriteback(Addr addr) {
 
 bool MSHR::pendingWritebackIsDowngrade(Addr addr) {
     if (pendingWriteback(addr))
-        return mshr_.find(addr)->second.entries.front().getDowngrade();
+        return mshr_.find(addr)->entries.front().getDowngrade();
     return false;
 }
 
@@ -260,11 +421,11 @@ int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest,
     // Success
     size_++;
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(event, stallEvict, getCurrentSimCycle()));
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
+        reg = mshr_.insert(addr);
+        allocateEntry(reg, reg->entries.end(), MSHREntry(event, stallEvict, getCurrentSimCycle()));
 
-        mshr_.insert(std::make_pair(addr, reg));
         if (is_debug_addr(addr)) {
             stringstream reason;
             reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=0";
@@ -274,18 +435,18 @@ int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest,
 
         return 0;
     } else {
-        if (pos == -1 || pos > mshr_.find(addr)->second.entries.size()) {
-            mshr_.find(addr)->second.entries.push_back(MSHREntry(event, stallEvict, getCurrentSimCycle()));
+        if (pos == -1 || pos > reg->entries.size()) {
+            allocateEntry(reg, reg->entries.end(), MSHREntry(event, stallEvict, getCurrentSimCycle()));
             if (is_debug_addr(addr)) {
                 stringstream reason;
-                reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (mshr_.find(addr)->second.entries.size() - 1);
+                reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (reg->entries.size() - 1);
                 printDebug(10, "InsEv", addr, reason.str());
             }
-            return (mshr_.find(addr)->second.entries.size() - 1);
+            return (reg->entries.size() - 1);
         } else {
-            std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+            std::list<MSHREntry>::iterator it = reg->entries.begin();
             std::advance(it, pos);
-            mshr_.find(addr)->second.entries.insert(it, MSHREntry(event, stallEvict, getCurrentSimCycle()));
+            allocateEntry(reg, it, MSHREntry(event, stallEvict, getCurrentSimCycle()));
             if (is_debug_addr(addr)) {
                 stringstream reason;
                 reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << pos;
@@ -300,17 +461,18 @@ MemEventBase* MSHR::swapFrontEvent(Addr addr, MemEventBase* event) {
     if (is_debug_addr(addr))
         printDebug(10, "SwpEv", addr, "");
 
-    if (mshr_.find(addr)->second.entries.empty())
+    MSHRRegister* reg = mshr_.find(addr);
+    if (reg->entries.empty())
         return nullptr;
 
-    return  mshr_.find(addr)->second.entries.front().swapEvent(event, getCurrentSimCycle());
+    return reg->entries.front().swapEvent(event, getCurrentSimCycle());
 }
 
 void MSHR::moveEntryToFront(Addr addr, unsigned int index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
     if (reg->entries.size() <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
     }
@@ -318,57 +480,37 @@ void MSHR::moveEntryToFront(Addr addr, unsigned int index) {
     std::list<MSHREntry>::iterator entry = reg->entries.begin();
     std::advance(entry, index);
 
-    MSHREntry tmpEntry = *entry;
-
     if (is_debug_addr(addr))
         printDebug(10, "MvEnt", addr, entry->getString());
-    reg->entries.erase(entry);
-    reg->entries.push_front(tmpEntry);
+    reg->entries.splice(reg->entries.begin(), reg->entries, entry);
 }
 
 bool MSHR::insertWriteback(Addr addr, bool downgrade) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::insertWriteback(0x%" PRIx64 ")\n", addr);
-
     if (is_debug_addr(addr)) {
         stringstream reason;
         reason << "Downgrade: " << (downgrade ? "T" : "F");
         printDebug(10, "InsWB", addr, reason.str());
     }
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(downgrade, getCurrentSimCycle()));
-        mshr_.insert(std::make_pair(addr, reg));
-    } else {
-        mshr_.find(addr)->second.entries.push_front(MSHREntry(downgrade, getCurrentSimCycle()));
-    }
+    MSHRRegister* reg = mshr_.insert(addr);
+    allocateEntry(reg, reg->entries.begin(), MSHREntry(downgrade, getCurrentSimCycle()));
 
     return true;
 }
 
 
 bool MSHR::insertEviction(Addr oldAddr, Addr newAddr) {
-//    if (is_debug_addr(oldAddr) || is_debug_addr(newAddr))
-//        d_->debug(_L10_, "    MSHR::insertEviction(0x%" PRIx64 ", 0x%" PRIx64 ")\n", oldAddr, newAddr);
-
     if (is_debug_addr(oldAddr) || is_debug_addr(newAddr)) {
         stringstream reason;
         reason << "to 0x" << std::hex << newAddr;
         printDebug(10, "InsPtr", oldAddr, reason.str());
     }
 
-    if (mshr_.find(oldAddr) == mshr_.end()) {  // No MSHR entry for oldAddr
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(newAddr, getCurrentSimCycle()));
-        mshr_.insert(std::make_pair(oldAddr, reg));
-    } else {
-        list<MSHREntry>* entries = &(mshr_.find(oldAddr)->second.entries);
-        if (!entries->empty() && entries->back().getType() == MSHREntryType::Evict) { // MSHR entry for oldAddr is an Evict
-            entries->back().getPointers()->push_back(newAddr);
-        } else { // MSHR entry for oldAddr is not an Evict (or no entry exists)
-            entries->push_back(MSHREntry(newAddr, getCurrentSimCycle()));
-        }
+    MSHRRegister* reg = mshr_.insert(oldAddr);
+    if (!reg->entries.empty() && reg->entries.back().getType() == MSHREntryType::Evict) { // MSHR entry for oldAddr is an Evict
+        addPointer(reg->entries.back().getPointers(), newAddr);
+    } else { // MSHR entry for oldAddr is not an Evict (or no entry exists)
+        allocateEntry(reg, reg->entries.end(), MSHREntry(allocatePointerList(newAddr), getCurrentSimCycle()));
     }
     return true;
 }
@@ -377,53 +519,53 @@ void MSHR::addPendingRetry(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "IncRetry", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::addPendingRetry(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.addPendingRetry();
+    reg->addPendingRetry();
 }
 
 void MSHR::removePendingRetry(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "DecRetry", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removePendingRetry(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.removePendingRetry();
+    reg->removePendingRetry();
 }
 
 uint32_t MSHR::getPendingRetries(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg)
         return 0;
 
-    return mshr_.find(addr)->second.getPendingRetries();
+    return reg->getPendingRetries();
 }
 
 
 void MSHR::setInProgress(Addr addr, bool value) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::setInProgress(0x%" PRIx64 ")\n", addr);
     if (is_debug_addr(addr))
         printDebug(20, "InProg", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setInProgress(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setInProgress(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries.front().setInProgress(value);
+    reg->entries.front().setInProgress(value);
 }
 
 bool MSHR::getInProgress(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
-        return false;
-    }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg || reg->entries.empty()) {
         return false;
     }
-    return mshr_.find(addr)->second.entries.front().getInProgress();
+    return reg->entries.front().getInProgress();
 }
 
 void MSHR::setStalledForEvict(Addr addr, bool set) {
@@ -434,56 +576,56 @@ void MSHR::setStalledForEvict(Addr addr, bool set) {
             printDebug(20, "Unstall", addr, "");
     }
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setStalledForEvict(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setStalledForEvict(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries.front().setStalledForEvict(set);
+    reg->entries.front().setStalledForEvict(set);
 }
 
 bool MSHR::getStalledForEvict(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg || reg->entries.empty()) {
         return false;
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
-        return false;
-    }
-    return mshr_.find(addr)->second.entries.front().getStalledForEvict();
+    return reg->entries.front().getStalledForEvict();
 }
 
 void MSHR::setProfiled(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "Profile", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setProfiled(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries.front().setProfiled();
+    reg->entries.front().setProfiled();
 }
 
 bool MSHR::getProfiled(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getProfiled(0x%" PRIx64 "\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries.front().getProfiled();
+    return reg->entries.front().getProfiled();
 }
 
 bool MSHR::getProfiled(Addr addr, SST::Event::id_type id) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg)
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", ownerName_.c_str(), addr, id.first, id.second);
-    if (mshr_.find(addr)->second.entries.empty())
+    if (reg->entries.empty())
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", ownerName_.c_str(), addr, id.first, id.second);
-    for (list<MSHREntry>::iterator jt = mshr_.find(addr)->second.entries.begin(); jt != mshr_.find(addr)->second.entries.end(); jt++) {
+    for (list<MSHREntry>::iterator jt = reg->entries.begin(); jt != reg->entries.end(); jt++) {
         if (jt->getType() == MSHREntryType::Event && jt->getEvent()->getID() == id) {
             return jt->getProfiled();
         }
@@ -495,13 +637,14 @@ void MSHR::setProfiled(Addr addr, SST::Event::id_type id) {
     if (is_debug_addr(addr))
         printDebug(20, "Profile", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", ownerName_.c_str(), addr, id.first, id.second);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", ownerName_.c_str(), addr, id.first, id.second);
     }
-    for (list<MSHREntry>::iterator jt = mshr_.find(addr)->second.entries.begin(); jt != mshr_.find(addr)->second.entries.end(); jt++) {
+    for (list<MSHREntry>::iterator jt = reg->entries.begin(); jt != reg->entries.end(); jt++) {
         if (jt->getType() == MSHREntryType::Event && jt->getEvent()->getID() == id) {
             jt->setProfiled();
             return;
@@ -510,131 +653,116 @@ void MSHR::setProfiled(Addr addr, SST::Event::id_type id) {
 }
 
 MSHREntry* MSHR::getOldestEntry() {
-    bool first = false;
     MSHREntry* entry = nullptr;
-    uint64_t time;
+    uint64_t time = 0;
 
-    for (MSHRBlock::iterator it = mshr_.begin(); it != mshr_.end(); it++) {
-        for (list<MSHREntry>::iterator jt = it->second.entries.begin(); jt != it->second.entries.end(); jt++) {
+    mshr_.forEach([&entry, &time](Addr addr, MSHRRegister* reg) {
+        for (list<MSHREntry>::iterator jt = reg->entries.begin(); jt != reg->entries.end(); jt++) {
             if (jt->getType() == MSHREntryType::Event) {
-                if (!first) {
-                    entry = &(*jt);
-                    time = jt->getStartTime();
-                } else if (jt->getStartTime() < time) {
+                if (!entry || jt->getStartTime() < time) {
                     entry = &(*jt);
                     time = jt->getStartTime();
                 }
             }
         }
-    }
+    });
     return entry;
 }
 
 void MSHR::incrementAcksNeeded(Addr addr) {
-   // if (is_debug_addr(addr))
-   //     d_->debug(_L10_, "    MSHR::incrementAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        mshr_.insert(std::make_pair(addr, reg));
-    }
-    mshr_.find(addr)->second.acksNeeded++;
+    MSHRRegister* reg = mshr_.insert(addr);
+    reg->acksNeeded++;
 
     if (is_debug_addr(addr)) {
         std::stringstream reason;
-        reason << mshr_.find(addr)->second.acksNeeded << " acks";
+        reason << reg->acksNeeded << " acks";
         printDebug(10, "IncAck", addr, reason.str());
     }
 }
 
 /* Decrement acks needed and return if we're done waiting (acksNeeded == 0) */
 bool MSHR::decrementAcksNeeded(Addr addr) {
-   // if (is_debug_addr(addr))
-   //     d_->debug(_L10_, "    MSHR::decrementAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.acksNeeded == 0) {
+    if (reg->acksNeeded == 0) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). AcksNeeded is already 0.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.acksNeeded--;
+    reg->acksNeeded--;
 
     if (is_debug_addr(addr)) {
         std::stringstream reason;
-        reason << mshr_.find(addr)->second.acksNeeded << " acks";
+        reason << reg->acksNeeded << " acks";
         printDebug(10, "DecAck", addr, reason.str());
     }
 
-    return (mshr_.find(addr)->second.acksNeeded == 0);
+    return (reg->acksNeeded == 0);
 }
 
 uint32_t MSHR::getAcksNeeded(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         return 0;
     }
-    return (mshr_.find(addr)->second.acksNeeded);
+    return reg->acksNeeded;
 }
 
+/* Copies into the register's buffer, which keeps its capacity across reuse */
 void MSHR::setData(Addr addr, vector<uint8_t>& data, bool dirty) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::setData(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
 
     if (is_debug_addr(addr))
         printDebug(10, "SetData", addr, (dirty ? "Dirty" : "Clean"));
 
-    mshr_.find(addr)->second.dataBuffer = data;
-    mshr_.find(addr)->second.dataDirty = dirty;
+    reg->dataBuffer.assign(data.begin(), data.end());
+    reg->dataDirty = dirty;
 }
 
 void MSHR::clearData(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::clearData(0x%" PRIx64 ")\n", addr);
     if (is_debug_addr(addr))
         printDebug(10, "ClrData", addr, "");
 
-    mshr_.find(addr)->second.dataBuffer.clear();
-    mshr_.find(addr)->second.dataDirty = false;
+    MSHRRegister* reg = mshr_.find(addr);
+    reg->dataBuffer.clear();
+    reg->dataDirty = false;
 }
 
 vector<uint8_t>& MSHR::getData(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getData(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.dataBuffer;
+    return reg->dataBuffer;
 }
 
 bool MSHR::hasData(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg)
         return false;
-    return !(mshr_.find(addr)->second.dataBuffer.empty());
+    return !(reg->dataBuffer.empty());
 }
 
 bool MSHR::getDataDirty(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getDataDirty(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getDataDirty(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.dataDirty;
+    return reg->dataDirty;
 }
 
 void MSHR::setDataDirty(Addr addr, bool dirty) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::setDataDirty(0x%" PRIx64 ")\n", addr);
-
     if (is_debug_addr(addr))
         printDebug(20, "SetDirt", addr, (dirty ? "Dirty" : "Clean"));
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (!reg) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setDataDirty(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.dataDirty = dirty;
+    reg->dataDirty = dirty;
 
 }
 
@@ -660,9 +788,13 @@ void MSHR::printDebug(uint32_t lev, std::string action, Addr addr, std::string r
 // Print status. Called by cache controller on EmergencyShutdown and printStatus()
 void MSHR::printStatus(Output &out) {
     out.output("    MSHR Status for %s. Size: %u. Prefetches: %u\b", ownerName_.c_str(), size_, prefetchCount_);
-    for (std::map<Addr,MSHRRegister>::iterator it = mshr_.begin(); it != mshr_.end(); it++) {   // Iterate over addresses
-        out.output("      Entry: Addr = 0x%" PRIx64 "\n", (it->first));
-        for (std::list<MSHREntry>::iterator it2 = it->second.entries.begin(); it2 != it->second.entries.end(); it2++) { // Iterate over entries for each address
+    std::vector<Addr> addrs;
+    mshr_.forEach([&addrs](Addr addr, MSHRRegister* reg) { addrs.push_back(addr); });
+    std::sort(addrs.begin(), addrs.end());
+    for (std::vector<Addr>::iterator it = addrs.begin(); it != addrs.end(); it++) {   // Iterate over addresses
+        out.output("      Entry: Addr = 0x%" PRIx64 "\n", (*it));
+        MSHRRegister* reg = mshr_.find(*it);
+        for (std::list<MSHREntry>::iterator it2 = reg->entries.begin(); it2 != reg->entries.end(); it2++) { // Iterate over entries for each address
             out.output("        %s\n", it2->getString().c_str());
         }
     }
@@ -16,9 +16,11 @@
 #ifndef _MSHR_H_
 #define _MSHR_H_
 
+#include <list>
 #include <map>
 #include <string>
 #include <sstream>
+#include <vector>
 
 #include <sst/core/event.h>
 #include <sst/core/sst_types.h>
@@ -70,12 +72,11 @@ class MSHREntry {
             downgrade = downgr;
         }
 
-        // Evict entry
-    MSHREntry(Addr addr, SimTime_t curr_time) {
+        // Evict entry. Pointer list is owned (and recycled) by the MSHR
+    MSHREntry(std::list<Addr>* ptrs, SimTime_t curr_time) {
             type = MSHREntryType::Evict;
             event = nullptr;
-            evictPtrs = new std::list<Addr>;
-            evictPtrs->push_back(addr);
+            evictPtrs = ptrs;
             time = curr_time;
             inProgress = false;
             needEvict = false;
@@ -164,19 +165,69 @@ class MSHREntry {
 };
 
 struct MSHRRegister {
-    MSHRRegister() : acksNeeded(0), dataDirty(false), pendingRetries(0) { }
+    MSHRRegister() : acksNeeded(0), dataDirty(false), pendingRetries(0), peakEntries(0) { }
     list<MSHREntry> entries;
     uint32_t acksNeeded;
     vector<uint8_t> dataBuffer;
     bool dataDirty;
     uint32_t pendingRetries;
+    uint32_t peakEntries;       // Most entries held at once, for statistics
 
     uint32_t getPendingRetries() { return pendingRetries; }
     void addPendingRetry() { pendingRetries++; }
     void removePendingRetry() { pendingRetries--; }
+
+    /* Return to the initial state. Keeps dataBuffer's capacity so reuse does not allocate */
+    void reset() {
+        acksNeeded = 0;
+        dataBuffer.clear();
+        dataDirty = false;
+        pendingRetries = 0;
+        peakEntries = 0;
+    }
 };
 
-typedef map<Addr, MSHRRegister> MSHRBlock;
+/*
+ * Open-addressed table mapping an address to its MSHRRegister
+ * Linear probing with backward-shift deletion. Registers are recycled
+ * through a free list so steady-state inserts and erases do not allocate.
+ * The table doubles if it becomes more than half full.
+ */
+class MSHRTable {
+public:
+    MSHRTable(size_t minCapacity);
+    ~MSHRTable();
+
+    MSHRRegister* find(Addr addr) const;
+    MSHRRegister* insert(Addr addr);    // Returns the existing register if addr is present
+    void erase(Addr addr);
+
+    size_t size() const { return count_; }
+
+    /* Call func(addr, register) for each address, in no particular order */
+    template <typename F>
+    void forEach(F func) const {
+        for (size_t i = 0; i < slots_.size(); i++) {
+            if (slots_[i].reg)
+                func(slots_[i].addr, slots_[i].reg);
+        }
+    }
+
+private:
+    struct Slot {
+        Addr addr;
+        MSHRRegister* reg;  // nullptr if slot is empty
+    };
+
+    size_t home(Addr addr) const { return (size_t)((addr * 0x9E3779B97F4A7C15ull) >> shift_); }
+    void grow();
+
+    std::vector<Slot> slots_;
+    std::vector<MSHRRegister*> freeRegs_;
+    size_t mask_;
+    unsigned int shift_;
+    size_t count_;
+};
 
 /**
  *  Implements an MSHR with entries of type mshrEntry
@@ -192,8 +243,10 @@ public:
     unsigned int getSize(Addr addr);
     bool exists(Addr addr);
 
+    ~MSHR();
+
     // Accessors for first event since that's most common
-    MSHREntry getFront(Addr addr);
+    MSHREntry& getFront(Addr addr);
     void removeFront(Addr addr);
 
     MSHREntryType getFrontType(Addr addr);
@@ -206,7 +259,7 @@ public:
     void moveEntryToFront(Addr addr, unsigned int index);
 
     // Generic accessors
-    MSHREntry getEntry(Addr addr, size_t index);
+    MSHREntry& getEntry(Addr addr, size_t index);
     void removeEntry(Addr addr, size_t index);
 
     MSHREntryType getEntryType(Addr addr, size_t index);
@@ -253,11 +306,27 @@ public:
 
     void printStatus(Output &out);
 
+    /* Record each address's peak entry count when it leaves the MSHR */
+    void setAddressOccupancyStat(Statistic<uint64_t>* stat) { statAddrOccupancy_ = stat; }
+
 private:
 
     void printDebug(uint32_t level, std::string action, Addr addr, std::string reason);
 
-    MSHRBlock mshr_;
+    /* Entry and evict pointer pools. Nodes are spliced between the pools and the
+     * per-address lists so that steady-state operation does not allocate */
+    std::list<MSHREntry>::iterator allocateEntry(MSHRRegister* reg, std::list<MSHREntry>::iterator pos, const MSHREntry& entry);
+    void releaseEntry(MSHRRegister* reg, std::list<MSHREntry>::iterator entry);
+    void releaseRegister(Addr addr, MSHRRegister* reg);
+    std::list<Addr>* allocatePointerList(Addr addr);
+    void addPointer(std::list<Addr>* ptrs, Addr addr);
+    void removePointer(std::list<Addr>* ptrs, Addr addr);
+
+    MSHRTable mshr_;
+    std::list<MSHREntry> entryPool_;
+    std::list<Addr> ptrPool_;
+    std::vector<std::list<Addr>*> ptrListPool_;
+    Statistic<uint64_t>* statAddrOccupancy_;
     Output* d_;
     Output* d2_;
     int size_;
@@ -17,6 +17,7 @@
 #define	MEMHIERARCHY_REPLACEMENT_POLICY_H
 
 #include "sst/core/subcomponent.h"
+#include "sst/core/output.h"
 #include "sst/core/rng/marsaglia.h"
 
 #include "memEvent.h"
@@ -80,6 +81,17 @@ class ReplacementPolicy : public SubComponent{
         // Get replacement candidates
         virtual uint64_t getBestCandidate() = 0;
         virtual uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) = 0;
+
+        /* Caches pass a set's candidates as a pointer into their flat per-line rInfo array.
+         * Policies that keep per-set state should override this. The default forwards to the
+         * vector version through a reused scratch vector so it does not allocate per miss */
+        virtual uint64_t findBestCandidate(ReplacementInfo** rInfo, unsigned int ways) {
+            candidates_.assign(rInfo, rInfo + ways);
+            return findBestCandidate(candidates_);
+        }
+
+    private:
+        std::vector<ReplacementInfo*> candidates_;
 };
 
 /* ------------------------------------------------------------------------------------------
@@ -705,6 +717,352 @@ public:
 };
 
 
+
+/* ------------------------------------------------------------------------------------------
+ *  Per-set policies
+ *  - Replacement state is packed per set and indexed by set/way, so these assume
+ *    (like NMRU) that the indices of a set are contiguous
+ *  - Invalid lines are still always replaced first
+ * ------------------------------------------------------------------------------------------*/
+
+/* ------------------------------------------------------------------------------------------
+ *  Tree pseudo-LRU
+ *  - One bit per internal node of a binary tree over the ways, stored in a single word per set
+ *  - Each bit points toward the less recently used half of its subtree
+ * ------------------------------------------------------------------------------------------*/
+class TreePLRU : public ReplacementPolicy {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(TreePLRU, "memHierarchy", "replacement.tree-plru", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "tree pseudo-LRU replacement policy. Associativity must be a power of two and at most 64", SST::MemHierarchy::ReplacementPolicy);
+
+
+    TreePLRU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), bestCandidate(0) {
+        ways = associativity;
+        if (ways == 0 || ways > 64 || (ways & (ways - 1)) != 0) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Error: replacement.tree-plru requires a power-of-two associativity no greater than 64. Associativity is %" PRIu64 ".\n",
+                    getName().c_str(), ways);
+        }
+        array.resize(lines/associativity, 0);
+    }
+
+    virtual ~TreePLRU() { }
+
+    bool checkCompatibility(ReplacementInfo * rInfo) { return true; } // No cast
+
+    /* Point every node on the path to this way away from it */
+    void update(uint64_t id, ReplacementInfo * rInfo) {
+        uint64_t& bits = array[id/ways];
+        uint64_t node = ways + (id % ways);
+        while (node > 1) {
+            uint64_t parent = node >> 1;
+            if (node & 1)
+                bits &= ~(1ull << parent);  // Accessed right child, LRU side is left
+            else
+                bits |= (1ull << parent);   // Accessed left child, LRU side is right
+            node = parent;
+        }
+    }
+
+    void replaced(uint64_t id) { }
+
+    uint64_t findBestCandidate(ReplacementInfo** rInfo, unsigned int n) {
+        for (unsigned int i = 0; i < n; i++) {
+            if (rInfo[i]->getState() == I) {
+                bestCandidate = rInfo[i]->getIndex();
+                return bestCandidate;
+            }
+        }
+        uint64_t setBegin = rInfo[0]->getIndex();
+        uint64_t bits = array[setBegin/ways];
+        uint64_t node = 1;
+        while (node < ways)
+            node = (node << 1) | ((bits >> node) & 1);
+        bestCandidate = setBegin + (node - ways);
+        return bestCandidate;
+    }
+
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) { return findBestCandidate(rInfo.data(), rInfo.size()); }
+
+    uint64_t getBestCandidate() { return bestCandidate; }
+
+private:
+    uint64_t bestCandidate;
+    uint64_t ways;
+    std::vector<uint64_t> array;    // Tree bits per set, node n (1..ways-1) is bit n
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Age matrix LRU
+ *  - Exact LRU without timestamps. Each line has a row of bits, one per way in its set;
+ *    bit j of row i is set if way i was used more recently than way j
+ *  - The LRU way is the one whose row is empty
+ * ------------------------------------------------------------------------------------------*/
+class AgeMatrixLRU : public ReplacementPolicy {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(AgeMatrixLRU, "memHierarchy", "replacement.lru-matrix", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "least-recently-used replacement policy using a per-set age matrix instead of timestamps. Associativity must be at most 64", SST::MemHierarchy::ReplacementPolicy);
+
+
+    AgeMatrixLRU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), bestCandidate(0) {
+        ways = associativity;
+        if (ways == 0 || ways > 64) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Error: replacement.lru-matrix supports associativity up to 64. Associativity is %" PRIu64 ".\n",
+                    getName().c_str(), ways);
+        }
+        rowMask = (ways == 64) ? ~0ull : ((1ull << ways) - 1);
+        array.resize(lines, 0);
+    }
+
+    virtual ~AgeMatrixLRU() { }
+
+    bool checkCompatibility(ReplacementInfo * rInfo) { return true; } // No cast
+
+    /* Mark way as newer than every other way in the set */
+    void update(uint64_t id, ReplacementInfo * rInfo) {
+        uint64_t setBegin = id - (id % ways);
+        uint64_t bit = 1ull << (id % ways);
+        for (uint64_t i = setBegin; i < setBegin + ways; i++)
+            array[i] &= ~bit;
+        array[id] = rowMask & ~bit;
+    }
+
+    /* Mark way as older than every other way in the set */
+    void replaced(uint64_t id) {
+        uint64_t setBegin = id - (id % ways);
+        uint64_t bit = 1ull << (id % ways);
+        for (uint64_t i = setBegin; i < setBegin + ways; i++)
+            array[i] |= bit;
+        array[id] = 0;
+    }
+
+    uint64_t findBestCandidate(ReplacementInfo** rInfo, unsigned int n) {
+        for (unsigned int i = 0; i < n; i++) {
+            if (rInfo[i]->getState() == I) {
+                bestCandidate = rInfo[i]->getIndex();
+                return bestCandidate;
+            }
+        }
+        uint64_t setBegin = rInfo[0]->getIndex();
+        bestCandidate = setBegin;
+        for (uint64_t i = setBegin; i < setBegin + ways; i++) {
+            if (array[i] == 0) {
+                bestCandidate = i;
+                break;
+            }
+        }
+        return bestCandidate;
+    }
+
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) { return findBestCandidate(rInfo.data(), rInfo.size()); }
+
+    uint64_t getBestCandidate() { return bestCandidate; }
+
+private:
+    uint64_t bestCandidate;
+    uint64_t ways;
+    uint64_t rowMask;
+    std::vector<uint64_t> array;    // One row per line
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Re-reference interval prediction (RRIP)
+ *  - Each line has an re-reference prediction value (RRPV); hits set it to 0
+ *  - The victim is the first way predicted to be re-referenced furthest in the future. If no
+ *    way is at the maximum RRPV, the set is aged so that one is
+ *  - Subclasses choose the RRPV a newly inserted line gets
+ * ------------------------------------------------------------------------------------------*/
+class RRIPBase : public ReplacementPolicy {
+public:
+    RRIPBase(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), bestCandidate(0) {
+        ways = associativity;
+        uint32_t bits = params.find<uint32_t>("rrpv_bits", 2);
+        if (bits == 0 || bits > 7) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: rrpv_bits - must be between 1 and 7. You specified %" PRIu32 ".\n", getName().c_str(), bits);
+        }
+        maxRRPV = (1 << bits) - 1;
+        array.resize(lines, maxRRPV);
+    }
+
+    virtual ~RRIPBase() { }
+
+    bool checkCompatibility(ReplacementInfo * rInfo) { return true; } // No cast
+
+    /* First update after replaced() is an insertion, otherwise a hit */
+    void update(uint64_t id, ReplacementInfo * rInfo) {
+        if (array[id] == inserting)
+            array[id] = getInsertionRRPV(id / ways);
+        else
+            array[id] = 0;
+    }
+
+    void replaced(uint64_t id) { array[id] = inserting; }
+
+    uint64_t findBestCandidate(ReplacementInfo** rInfo, unsigned int n) {
+        for (unsigned int i = 0; i < n; i++) {
+            if (rInfo[i]->getState() == I) {
+                bestCandidate = rInfo[i]->getIndex();
+                return bestCandidate;
+            }
+        }
+        uint64_t setBegin = rInfo[0]->getIndex();
+        uint8_t oldest = 0;
+        bestCandidate = setBegin;
+        for (uint64_t i = setBegin; i < setBegin + ways; i++) {
+            uint8_t rrpv = (array[i] == inserting) ? maxRRPV : array[i];
+            if (rrpv > oldest) {
+                oldest = rrpv;
+                bestCandidate = i;
+                if (rrpv == maxRRPV)
+                    break;
+            }
+        }
+        // Age the set as if we had repeatedly incremented every RRPV until the candidate reached max
+        uint8_t age = maxRRPV - oldest;
+        if (age != 0) {
+            for (uint64_t i = setBegin; i < setBegin + ways; i++) {
+                if (array[i] != inserting)
+                    array[i] += age;
+            }
+        }
+        return bestCandidate;
+    }
+
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) { return findBestCandidate(rInfo.data(), rInfo.size()); }
+
+    uint64_t getBestCandidate() { return bestCandidate; }
+
+protected:
+    virtual uint8_t getInsertionRRPV(uint64_t set) = 0;
+
+    uint8_t maxRRPV;
+    uint64_t ways;
+
+private:
+    static const uint8_t inserting = 0xFF;  // Marks a line between replaced() and its first update()
+
+    uint64_t bestCandidate;
+    std::vector<uint8_t> array;     // RRPV per line
+};
+
+/* Static RRIP: insert with a long re-reference interval */
+class SRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(SRRIP, "memHierarchy", "replacement.srrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "static re-reference interval prediction (SRRIP) replacement policy", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",   "Bits per re-reference prediction value", "2"} )
+
+    SRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity) { }
+    virtual ~SRRIP() { }
+
+protected:
+    uint8_t getInsertionRRPV(uint64_t set) { return maxRRPV - 1; }
+};
+
+/* Bimodal RRIP: insert with a distant re-reference interval except for an occasional long one */
+class BRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(BRRIP, "memHierarchy", "replacement.brrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "bimodal re-reference interval prediction (BRRIP) replacement policy, resists thrashing", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",           "Bits per re-reference prediction value", "2"},
+            {"bimodal_throttle",    "On average, one in this many insertions uses a long instead of a distant re-reference interval", "32"},
+            {"seed_a",              "Seed for random number generator", "1"},
+            {"seed_b",              "Seed for random number generator", "1"} )
+
+    BRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity) {
+        throttle = params.find<uint32_t>("bimodal_throttle", 32);
+        if (throttle == 0) throttle = 1;
+        uint64_t seeda = params.find<uint64_t>("seed_a", 1);
+        uint64_t seedb = params.find<uint64_t>("seed_b", 1);
+        gen = new SST::RNG::MarsagliaRNG(seeda, seedb);
+    }
+
+    virtual ~BRRIP() {
+        delete gen;
+    }
+
+protected:
+    uint8_t getInsertionRRPV(uint64_t set) {
+        return (gen->generateNextUInt32() % throttle == 0) ? maxRRPV - 1 : maxRRPV;
+    }
+
+private:
+    uint32_t throttle;
+    SST::RNG::MarsagliaRNG* gen;
+};
+
+/* Dynamic RRIP: set dueling between SRRIP and BRRIP insertion */
+class DRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(DRRIP, "memHierarchy", "replacement.drrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "dynamic re-reference interval prediction (DRRIP) replacement policy, chooses between SRRIP and BRRIP insertion using set dueling", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",           "Bits per re-reference prediction value", "2"},
+            {"bimodal_throttle",    "On average, one in this many BRRIP insertions uses a long instead of a distant re-reference interval", "32"},
+            {"leader_sets",         "Number of sets dedicated to each of SRRIP and BRRIP", "32"},
+            {"psel_bits",           "Width of the policy selection counter", "10"},
+            {"seed_a",              "Seed for random number generator", "1"},
+            {"seed_b",              "Seed for random number generator", "1"} )
+
+    DRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity) {
+        throttle = params.find<uint32_t>("bimodal_throttle", 32);
+        if (throttle == 0) throttle = 1;
+        uint64_t seeda = params.find<uint64_t>("seed_a", 1);
+        uint64_t seedb = params.find<uint64_t>("seed_b", 1);
+        gen = new SST::RNG::MarsagliaRNG(seeda, seedb);
+
+        uint64_t sets = lines/associativity;
+        uint64_t leaders = params.find<uint64_t>("leader_sets", 32);
+        if (leaders == 0) leaders = 1;
+        period = sets / leaders;
+        if (period < 2) period = 2;
+
+        uint32_t pselBits = params.find<uint32_t>("psel_bits", 10);
+        if (pselBits == 0 || pselBits > 31) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: psel_bits - must be between 1 and 31. You specified %" PRIu32 ".\n", getName().c_str(), pselBits);
+        }
+        pselMax = (1u << pselBits) - 1;
+        psel = pselMax / 2;
+    }
+
+    virtual ~DRRIP() {
+        delete gen;
+    }
+
+protected:
+    /* Misses in a leader set vote against that leader's policy */
+    uint8_t getInsertionRRPV(uint64_t set) {
+        bool useBRRIP;
+        if (set % period == 0) {
+            if (psel < pselMax) psel++;
+            useBRRIP = false;
+        } else if (set % period == period / 2) {
+            if (psel > 0) psel--;
+            useBRRIP = true;
+        } else {
+            useBRRIP = psel > pselMax / 2;
+        }
+        if (useBRRIP && gen->generateNextUInt32() % throttle != 0)
+            return maxRRPV;
+        return maxRRPV - 1;
+    }
+
+private:
+    uint32_t throttle;
+    uint64_t period;    // One SRRIP and one BRRIP leader set per period
+    uint32_t psel;
+    uint32_t pselMax;
+    SST::RNG::MarsagliaRNG* gen;
+};
+
 }}
 
 
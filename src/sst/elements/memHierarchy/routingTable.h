@@ -0,0 +1,234 @@
+// Copyright 2013-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _MEMHIERARCHY_ROUTINGTABLE_H_
+#define _MEMHIERARCHY_ROUTINGTABLE_H_
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+#include "sst/elements/memHierarchy/memTypes.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Address -> destination lookup table
+ *
+ * Built from a list of (region, destination) pairs. The address space is cut into
+ * segments at every region start and end so that each segment is covered by a fixed
+ * set of regions. A lookup binary searches the segment boundaries, then:
+ *  - Single:     one non-interleaved region covers the segment
+ *  - Interleave: all regions share an interleave step, so (addr % step) indexes a
+ *                slot table giving the destination directly
+ *  - Scan:       anything else; check each covering region in insertion order
+ * Results match a linear scan over the regions in insertion order.
+ */
+class AddressRoutingTable {
+    public:
+        static const int NO_DEST = -1;
+
+        AddressRoutingTable() { }
+
+        /* Add a destination, returns its index */
+        int addDestination(const std::string& name, uint64_t netAddr) {
+            destNames_.push_back(name);
+            destAddrs_.push_back(netAddr);
+            return destNames_.size() - 1;
+        }
+
+        /* Add a region routed to a destination. Regions added earlier take priority */
+        void addRegion(const MemRegion& region, int dest) {
+            regions_.push_back(std::make_pair(region, dest));
+        }
+
+        void clear() {
+            destNames_.clear();
+            destAddrs_.clear();
+            regions_.clear();
+            bounds_.clear();
+            segments_.clear();
+            candidates_.clear();
+            slots_.clear();
+        }
+
+        /* Build the lookup structures once all regions are added */
+        void build() {
+            bounds_.clear();
+            segments_.clear();
+            candidates_.clear();
+            slots_.clear();
+
+            for (auto it = regions_.begin(); it != regions_.end(); it++) {
+                if (it->first.start > it->first.end) continue;
+                bounds_.push_back(it->first.start);
+                if (it->first.end != MemRegion::REGION_MAX)
+                    bounds_.push_back(it->first.end + 1);
+            }
+            std::sort(bounds_.begin(), bounds_.end());
+            bounds_.erase(std::unique(bounds_.begin(), bounds_.end()), bounds_.end());
+
+            for (size_t i = 0; i < bounds_.size(); i++) {
+                Segment seg;
+                seg.mode = Segment::Empty;
+                seg.first = candidates_.size();
+                for (size_t r = 0; r < regions_.size(); r++) {
+                    if (regions_[r].first.start <= bounds_[i] && regions_[r].first.end >= bounds_[i])
+                        candidates_.push_back(r);
+                }
+                seg.count = candidates_.size() - seg.first;
+
+                if (seg.count == 1 && regions_[candidates_[seg.first]].first.interleaveSize == 0) {
+                    seg.mode = Segment::Single;
+                    seg.dest = regions_[candidates_[seg.first]].second;
+                } else if (seg.count != 0) {
+                    seg.mode = buildSlots(seg) ? Segment::Interleave : Segment::Scan;
+                }
+                segments_.push_back(seg);
+            }
+        }
+
+        /* Return the destination index for an address or NO_DEST */
+        int lookup(Addr addr) const {
+            std::vector<Addr>::const_iterator it = std::upper_bound(bounds_.begin(), bounds_.end(), addr);
+            if (it == bounds_.begin())
+                return NO_DEST;
+            const Segment& seg = segments_[it - bounds_.begin() - 1];
+            switch (seg.mode) {
+                case Segment::Single:
+                    return seg.dest;
+                case Segment::Interleave:
+                    return slots_[seg.slotBase + (addr % seg.step) / seg.granularity];
+                case Segment::Scan:
+                    for (uint32_t i = seg.first; i < seg.first + seg.count; i++) {
+                        if (regions_[candidates_[i]].first.contains(addr))
+                            return regions_[candidates_[i]].second;
+                    }
+                    return NO_DEST;
+                default:
+                    return NO_DEST;
+            }
+        }
+
+        const std::string& getName(int dest) const { return destNames_[dest]; }
+        uint64_t getNetworkAddress(int dest) const { return destAddrs_[dest]; }
+
+        /* Print the resolved address map */
+        std::string toString() const {
+            std::stringstream str;
+            for (size_t i = 0; i < segments_.size(); i++) {
+                const Segment& seg = segments_[i];
+                if (seg.mode == Segment::Empty) continue;
+                Addr last = (i + 1 < bounds_.size()) ? bounds_[i + 1] - 1 : MemRegion::REGION_MAX;
+                str << std::hex << "  [0x" << bounds_[i] << ", 0x" << last << "]";
+                if (seg.mode == Segment::Single) {
+                    str << " -> " << destString(seg.dest) << "\n";
+                } else if (seg.mode == Segment::Interleave) {
+                    str << " interleaved, step 0x" << seg.step << "\n";
+                    uint64_t numSlots = seg.step / seg.granularity;
+                    uint64_t run = 0;
+                    for (uint64_t s = 1; s <= numSlots; s++) {
+                        if (s != numSlots && slots_[seg.slotBase + s] == slots_[seg.slotBase + run]) continue;
+                        str << std::hex << "    offset [0x" << run * seg.granularity << ", 0x" << s * seg.granularity - 1 << "] -> ";
+                        str << (slots_[seg.slotBase + run] == NO_DEST ? "none" : destString(slots_[seg.slotBase + run])) << "\n";
+                        run = s;
+                    }
+                } else {
+                    str << " scan\n";
+                    for (uint32_t c = seg.first; c < seg.first + seg.count; c++)
+                        str << "    " << regions_[candidates_[c]].first.toString() << " -> " << destString(regions_[candidates_[c]].second) << "\n";
+                }
+            }
+            return str.str();
+        }
+
+    private:
+        struct Segment {
+            enum Mode { Empty, Single, Interleave, Scan } mode;
+            uint32_t first;     // Covering regions are candidates_[first, first + count)
+            uint32_t count;
+            int dest;           // Single
+            Addr step;          // Interleave
+            Addr granularity;
+            uint32_t slotBase;
+        };
+
+        static const Addr maxSlots_ = 1 << 16;
+
+        std::string destString(int dest) const {
+            std::stringstream str;
+            str << destNames_[dest] << " (" << std::dec << destAddrs_[dest] << ")";
+            return str.str();
+        }
+
+        /* Set up a slot table for a segment if its regions are all interleaved with the same
+         * step and don't overlap. Returns false if the segment has to be scanned instead */
+        bool buildSlots(Segment& seg) {
+            Addr step = regions_[candidates_[seg.first]].first.interleaveStep;
+            Addr gran = step;
+            for (uint32_t c = seg.first; c < seg.first + seg.count; c++) {
+                const MemRegion& reg = regions_[candidates_[c]].first;
+                if (reg.interleaveSize == 0 || reg.interleaveStep != step || step == 0)
+                    return false;
+                gran = gcd(gran, gcd(reg.interleaveSize, reg.start % step));
+            }
+            if (step / gran > maxSlots_)
+                return false;
+
+            seg.step = step;
+            seg.granularity = gran;
+            seg.slotBase = slots_.size();
+            slots_.resize(slots_.size() + step / gran, (int)NO_DEST);
+            for (uint32_t c = seg.first; c < seg.first + seg.count; c++) {
+                const MemRegion& reg = regions_[candidates_[c]].first;
+                Addr numSlots = std::min(reg.interleaveSize, step) / gran;
+                Addr slot = (reg.start % step) / gran;
+                for (Addr i = 0; i < numSlots; i++) {
+                    int& entry = slots_[seg.slotBase + (slot + i) % (step / gran)];
+                    if (entry != NO_DEST) {
+                        slots_.resize(seg.slotBase);
+                        return false;
+                    }
+                    entry = regions_[candidates_[c]].second;
+                }
+            }
+            return true;
+        }
+
+        static Addr gcd(Addr a, Addr b) {
+            while (b != 0) {
+                Addr t = a % b;
+                a = b;
+                b = t;
+            }
+            return a;
+        }
+
+        std::vector<std::string> destNames_;
+        std::vector<uint64_t> destAddrs_;
+        std::vector<std::pair<MemRegion,int> > regions_;
+
+        std::vector<Addr> bounds_;          // Segment i is [bounds_[i], bounds_[i+1])
+        std::vector<Segment> segments_;
+        std::vector<uint32_t> candidates_;  // Indices into regions_
+        std::vector<int> slots_;
+};
+
+} //namespace memHierarchy
+} //namespace SST
+
+#endif
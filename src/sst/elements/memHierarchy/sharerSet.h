@@ -0,0 +1,176 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_SHARERSET_H
+#define MEMHIERARCHY_SHARERSET_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <sstream>
+#include <algorithm>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Sharer/owner tracking
+ *
+ * Endpoint names are interned to dense integer IDs by the component that tracks
+ * sharers (one NodeIDTable per coherence manager/directory). Lines then record
+ * sharers as a bitmap of IDs and the owner as a single ID.
+ * Upper-level endpoints are registered at init in name order so that walking a
+ * sharer bitmap visits sharers in the same order as the std::set<std::string>
+ * it replaced. Names seen later are assigned the next free ID.
+ */
+typedef uint32_t NodeID;
+static const NodeID NO_NODE = (NodeID)-1;
+
+class NodeIDTable {
+    public:
+        /* Return the ID for a name, assigning a new one if the name has not been seen */
+        NodeID getID(const std::string& name) {
+            std::unordered_map<std::string, NodeID>::iterator it = ids_.find(name);
+            if (it != ids_.end())
+                return it->second;
+            NodeID id = names_.size();
+            ids_.insert(std::make_pair(name, id));
+            names_.push_back(name);
+            return id;
+        }
+
+        /* Register a name during init, keeping IDs in name order.
+         * Renumbers existing IDs so must not be called once IDs are in use */
+        void addSorted(const std::string& name) {
+            if (ids_.find(name) != ids_.end())
+                return;
+            names_.insert(std::lower_bound(names_.begin(), names_.end(), name), name);
+            ids_.clear();
+            for (NodeID id = 0; id < names_.size(); id++)
+                ids_.insert(std::make_pair(names_[id], id));
+        }
+
+        /* Return the name for an ID. NO_NODE returns an empty string */
+        const std::string& getName(NodeID id) const {
+            static const std::string none = "";
+            return (id < names_.size()) ? names_[id] : none;
+        }
+
+        size_t size() const { return names_.size(); }
+
+    private:
+        std::unordered_map<std::string, NodeID> ids_;
+        std::vector<std::string> names_;
+};
+
+/*
+ * Set of NodeIDs stored as a bitmap
+ * IDs 0-63 live in an inline word so the common case needs no allocation,
+ * larger IDs extend the bitmap on the heap.
+ */
+class SharerSet {
+    public:
+        SharerSet() : inline_(0), count_(0) { }
+
+        class iterator {
+            public:
+                iterator(const SharerSet* set, NodeID id) : set_(set), id_(id) { advance(); }
+                NodeID operator*() const { return id_; }
+                iterator& operator++() { id_++; advance(); return *this; }
+                bool operator==(const iterator& o) const { return id_ == o.id_; }
+                bool operator!=(const iterator& o) const { return id_ != o.id_; }
+            private:
+                /* Move to the next set bit at or after id_, or to end() */
+                void advance() {
+                    NodeID limit = set_->capacity();
+                    while (id_ < limit) {
+                        uint64_t word = set_->getWord(id_ >> 6) >> (id_ & 63);
+                        if (word) {
+                            id_ += __builtin_ctzll(word);
+                            return;
+                        }
+                        id_ = (id_ | 63) + 1;
+                    }
+                    id_ = NO_NODE;
+                }
+                const SharerSet* set_;
+                NodeID id_;
+        };
+
+        iterator begin() const { return iterator(this, 0); }
+        iterator end() const { return iterator(this, NO_NODE); }
+
+        bool count(NodeID id) const {
+            if (id >= capacity()) return false;
+            return (getWord(id >> 6) >> (id & 63)) & 1;
+        }
+
+        void insert(NodeID id) {
+            uint64_t* word = getWordForWrite(id >> 6);
+            uint64_t bit = 1ull << (id & 63);
+            if (!(*word & bit)) {
+                *word |= bit;
+                count_++;
+            }
+        }
+
+        void erase(NodeID id) {
+            if (id >= capacity()) return;
+            uint64_t* word = getWordForWrite(id >> 6);
+            uint64_t bit = 1ull << (id & 63);
+            if (*word & bit) {
+                *word &= ~bit;
+                count_--;
+            }
+        }
+
+        void clear() {
+            inline_ = 0;
+            ext_.clear();
+            count_ = 0;
+        }
+
+        size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+
+        /* Print sharer names for debug */
+        std::string getString(const NodeIDTable* names) const {
+            std::ostringstream str;
+            for (iterator it = begin(); it != end(); ++it) {
+                if (it != begin()) str << ",";
+                if (names) str << names->getName(*it);
+                else str << *it;
+            }
+            return str.str();
+        }
+
+    private:
+        NodeID capacity() const { return (1 + ext_.size()) * 64; }
+
+        uint64_t getWord(size_t index) const { return index == 0 ? inline_ : ext_[index - 1]; }
+
+        uint64_t* getWordForWrite(size_t index) {
+            if (index == 0) return &inline_;
+            if (index > ext_.size())
+                ext_.resize(index, 0);
+            return &ext_[index - 1];
+        }
+
+        uint64_t inline_;           // IDs 0-63
+        std::vector<uint64_t> ext_; // IDs 64+
+        uint32_t count_;
+};
+
+}} // End namespace
+#endif // MEMHIERARCHY_SHARERSET_H
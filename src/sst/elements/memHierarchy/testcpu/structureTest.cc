@@ -0,0 +1,533 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "testcpu/structureTest.h"
+
+#include <set>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cstdlib>
+#include <sys/stat.h>
+
+#include <sst/core/params.h>
+#include "sharerSet.h"
+#include "membackend/backing.h"
+#include "routingTable.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+namespace {
+
+/*
+ * Drives a replacement policy the way a cache array does: invalid ways are filled first
+ * and a miss replaces the chosen victim and then touches it.
+ * Also timestamps every access so the true LRU and MRU ways of a set are known.
+ */
+class PolicyDriver {
+    public:
+        PolicyDriver(ReplacementPolicy* policy, uint64_t lines, uint64_t ways) : policy_(policy), ways_(ways), time_(0), lastUse_(lines, 0) {
+            infos_.reserve(lines);
+            for (uint64_t i = 0; i < lines; i++)
+                infos_.push_back(ReplacementInfo(i, I));
+            for (uint64_t i = 0; i < lines; i++)
+                ptrs_.push_back(&infos_[i]);
+        }
+
+        uint64_t miss(uint64_t set) {
+            uint64_t victim = policy_->findBestCandidate(&ptrs_[set * ways_], ways_);
+            policy_->replaced(victim);
+            infos_[victim].setState(S);
+            touch(victim);
+            return victim;
+        }
+
+        void hit(uint64_t set, uint64_t way) { touch(set * ways_ + way); }
+
+        /* Way that would be evicted by true LRU. Invalid ways have never been used so come first */
+        uint64_t lruWay(uint64_t set) const {
+            uint64_t best = set * ways_;
+            for (uint64_t i = best + 1; i < (set + 1) * ways_; i++) {
+                if (lastUse_[i] < lastUse_[best])
+                    best = i;
+            }
+            return best;
+        }
+
+        uint64_t mruWay(uint64_t set) const {
+            uint64_t best = set * ways_;
+            for (uint64_t i = best + 1; i < (set + 1) * ways_; i++) {
+                if (lastUse_[i] > lastUse_[best])
+                    best = i;
+            }
+            return best;
+        }
+
+        /* Run count misses in a set and list the victim ways */
+        std::string victims(uint64_t set, int count) {
+            std::ostringstream str;
+            for (int i = 0; i < count; i++) {
+                if (i != 0) str << ",";
+                str << (miss(set) - set * ways_);
+            }
+            return str.str();
+        }
+
+        void fill(uint64_t set) {
+            for (uint64_t i = 0; i < ways_; i++)
+                miss(set);
+        }
+
+    private:
+        void touch(uint64_t id) {
+            lastUse_[id] = ++time_;
+            policy_->update(id, &infos_[id]);
+        }
+
+        ReplacementPolicy* policy_;
+        uint64_t ways_;
+        uint64_t time_;
+        std::vector<uint64_t> lastUse_;
+        std::vector<ReplacementInfo> infos_;
+        std::vector<ReplacementInfo*> ptrs_;
+};
+
+}
+
+structureTest::structureTest(ComponentId_t id, Params& params) : Component(id), slot(0) {
+    out.init("", 1, 0, Output::STDOUT);
+
+    std::string check = params.find<std::string>("check", "sharers");
+    if (check == "sharers") {
+        checkSharers();
+    } else if (check == "replacement") {
+        checkReplacement();
+    } else if (check == "backing") {
+        checkBacking();
+    } else if (check == "routing") {
+        checkRouting();
+    } else {
+        out.fatal(CALL_INFO, -1, "%s, Error: Invalid param: check - valid options are 'sharers', 'replacement', 'backing' or 'routing'. You specified '%s'.\n",
+                getName().c_str(), check.c_str());
+    }
+}
+
+void structureTest::expect(bool cond, const char* group, const char* what) {
+    if (!cond)
+        out.fatal(CALL_INFO, -1, "%s: FAILED: %s\n", group, what);
+    out.output("%s: passed: %s\n", group, what);
+}
+
+/*
+ * NodeIDTable and SharerSet
+ * The coherence managers rely on IDs registered with addSorted() iterating in name order,
+ * so the last check compares a SharerSet walk against the std::set<std::string> it replaced.
+ */
+void structureTest::checkSharers() {
+    const char* group = "sharers";
+
+    NodeIDTable table;
+    NodeID a = table.getID("cpu.b");
+    NodeID b = table.getID("cpu.a");
+    expect(a == 0 && b == 1, group, "getID assigns dense IDs in first-seen order");
+    expect(table.getID("cpu.b") == a && table.size() == 2, group, "getID returns the existing ID for a known name");
+    expect(table.getName(b) == "cpu.a" && table.getName(NO_NODE) == "", group, "getName maps IDs back to names");
+
+    NodeIDTable sorted;
+    sorted.addSorted("l1.c");
+    sorted.addSorted("l1.a");
+    sorted.addSorted("l1.b");
+    sorted.addSorted("l1.a");
+    expect(sorted.size() == 3, group, "addSorted ignores duplicate names");
+    expect(sorted.getID("l1.a") == 0 && sorted.getID("l1.b") == 1 && sorted.getID("l1.c") == 2,
+            group, "addSorted renumbers existing IDs into name order");
+    expect(sorted.getName(0) == "l1.a" && sorted.getName(2) == "l1.c", group, "addSorted keeps names and IDs consistent");
+    expect(sorted.getID("l0.z") == 3 && sorted.size() == 4, group, "getID after addSorted assigns the next free ID");
+
+    SharerSet set;
+    expect(set.empty() && set.begin() == set.end(), group, "new set is empty");
+    set.insert(3);
+    set.insert(3);
+    set.insert(0);
+    expect(set.size() == 2 && set.count(3) && set.count(0) && !set.count(1), group, "insert is idempotent");
+    set.insert(64);
+    set.insert(200);
+    expect(set.size() == 4 && set.count(64) && set.count(200) && !set.count(199) && !set.count(1000),
+            group, "IDs beyond the inline word extend the bitmap");
+
+    std::vector<NodeID> walk;
+    for (SharerSet::iterator it = set.begin(); it != set.end(); ++it)
+        walk.push_back(*it);
+    expect(walk == std::vector<NodeID>({0, 3, 64, 200}), group, "iteration is ascending across words");
+
+    set.erase(64);
+    set.erase(65);
+    set.erase(5000);
+    expect(set.size() == 3 && !set.count(64), group, "erase removes only present IDs");
+    expect(set.getString(nullptr) == "0,3,200", group, "getString lists IDs without a name table");
+    set.clear();
+    expect(set.empty() && !set.count(200) && set.begin() == set.end(), group, "clear empties the set");
+
+    /* Register 150 names out of order, pick a pseudo-random subset and check the bitmap walk
+     * matches the name-ordered set */
+    NodeIDTable names;
+    std::vector<std::string> all;
+    for (int i = 0; i < 150; i++) {
+        std::string name = "l1cache" + std::to_string((i * 37) % 150);
+        all.push_back(name);
+        names.addSorted(name);
+    }
+    std::set<std::string> reference;
+    SharerSet sharers;
+    uint32_t lfsr = 0xACE1u;
+    for (int i = 0; i < 150; i++) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+        if (lfsr & 1) {
+            reference.insert(all[i]);
+            sharers.insert(names.getID(all[i]));
+        }
+    }
+    std::vector<std::string> order;
+    for (SharerSet::iterator it = sharers.begin(); it != sharers.end(); ++it)
+        order.push_back(names.getName(*it));
+    expect(sharers.size() == reference.size() && order == std::vector<std::string>(reference.begin(), reference.end()),
+            group, "sharer walk matches the name order of std::set<std::string>");
+}
+
+ReplacementPolicy* structureTest::loadPolicy(std::string name, Params& params, uint64_t lines, uint64_t ways) {
+    ReplacementPolicy* policy = loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement." + name, "replacement", slot++,
+            ComponentInfo::SHARE_NONE, params, lines, ways);
+    if (!policy)
+        out.fatal(CALL_INFO, -1, "%s, Error: unable to load replacement policy '%s'\n", getName().c_str(), name.c_str());
+    return policy;
+}
+
+/*
+ * Replacement policies
+ * lru and lru-matrix must pick the true LRU way on every miss of a pseudo-random hit/miss stream.
+ * tree-plru is exact at 2 ways; at 4 and 8 ways it must never pick the MRU way and must visit
+ * the ways in tree order when a set only misses. The RRIP policies are checked against victim
+ * orders worked out by hand from their RRPV updates.
+ */
+void structureTest::checkReplacement() {
+    const char* group = "replacement";
+    const uint64_t sets = 4;
+    const int ops = 4000;
+    char what[256];
+
+    uint64_t waysList[] = { 2, 4, 8 };
+    for (uint64_t ways : waysList) {
+        uint64_t lines = sets * ways;
+        const char* names[] = { "lru", "lru-matrix", "tree-plru" };
+        for (const char* name : names) {
+            Params params;
+            PolicyDriver driver(loadPolicy(name, params, lines, ways), lines, ways);
+            for (uint64_t set = 0; set < sets; set++)
+                driver.fill(set);
+            uint32_t x = 2463534242u;
+            int misses = 0, lruVictims = 0, mruVictims = 0;
+            for (int i = 0; i < ops; i++) {
+                x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+                uint64_t set = x % sets;
+                if ((x >> 8) % 3 != 0) {
+                    driver.hit(set, (x >> 16) % ways);
+                } else {
+                    uint64_t lru = driver.lruWay(set);
+                    uint64_t mru = driver.mruWay(set);
+                    uint64_t victim = driver.miss(set);
+                    misses++;
+                    if (victim == lru) lruVictims++;
+                    if (victim == mru) mruVictims++;
+                }
+            }
+            if (std::string(name) == "tree-plru" && ways > 2) {
+                snprintf(what, sizeof(what), "%s never evicts the MRU way at %" PRIu64 " ways (true LRU on %d of %d misses)",
+                        name, ways, lruVictims, misses);
+                expect(mruVictims == 0, group, what);
+            } else {
+                snprintf(what, sizeof(what), "%s evicts the true LRU way at %" PRIu64 " ways (%d misses)", name, ways, misses);
+                expect(lruVictims == misses, group, what);
+            }
+        }
+
+        /* A set that only misses visits the ways in tree order, e.g., 0,2,1,3 at 4 ways */
+        Params params;
+        PolicyDriver driver(loadPolicy("tree-plru", params, ways, ways), ways, ways);
+        driver.fill(0);
+        std::ostringstream expected;
+        uint64_t bits = 0;
+        while ((1ull << bits) < ways) bits++;
+        for (uint64_t i = 0; i < 2 * ways; i++) {
+            uint64_t rev = 0;
+            for (uint64_t b = 0; b < bits; b++)
+                rev |= ((i >> b) & 1) << (bits - 1 - b);
+            if (i != 0) expected << ",";
+            expected << rev;
+        }
+        snprintf(what, sizeof(what), "tree-plru miss-only victim order at %" PRIu64 " ways is %s", ways, expected.str().c_str());
+        expect(driver.victims(0, 2 * ways) == expected.str(), group, what);
+    }
+
+    /* SRRIP, 2-bit RRPVs: fills insert at 2. The first miss ages every line to 3 and takes way 0;
+     * a hit then protects way 2 while ways 1 and 3 go next, after which the set ages again */
+    {
+        Params params;
+        PolicyDriver driver(loadPolicy("srrip", params, 4, 4), 4, 4);
+        driver.fill(0);
+        std::string order = driver.victims(0, 1);
+        driver.hit(0, 2);
+        order += "," + driver.victims(0, 6);
+        expect(order == "0,1,3,0,1,3,0", group, "srrip victim order with a hit on way 2 is 0,1,3,0,1,3,0");
+    }
+
+    /* BRRIP nearly always inserts at the distant RRPV, so a thrashing stream keeps replacing the
+     * same way and a line that hit is kept. With a throttle of 1 it inserts like SRRIP */
+    {
+        Params params;
+        params.insert("bimodal_throttle", "1000000");
+        PolicyDriver driver(loadPolicy("brrip", params, 4, 4), 4, 4);
+        driver.fill(0);
+        driver.hit(0, 0);
+        expect(driver.victims(0, 4) == "1,1,1,1", group, "brrip thrashing misses replace way 1 and keep the hit way 0");
+
+        Params srripParams;
+        srripParams.insert("bimodal_throttle", "1");
+        PolicyDriver srrip(loadPolicy("brrip", srripParams, 4, 4), 4, 4);
+        srrip.fill(0);
+        expect(srrip.victims(0, 4) == "0,1,2,3", group, "brrip with bimodal_throttle=1 inserts like srrip");
+    }
+
+    /* DRRIP with 8 sets and 2 leader sets of each policy: set 0 leads SRRIP, set 2 leads BRRIP,
+     * sets 1 and 3 follow. A 2-bit PSEL starts at 1 and saturates after four leader misses */
+    {
+        Params params;
+        params.insert("bimodal_throttle", "1000000");
+        params.insert("leader_sets", "2");
+        params.insert("psel_bits", "2");
+        PolicyDriver driver(loadPolicy("drrip", params, 32, 4), 32, 4);
+        driver.fill(0);
+        driver.fill(1);
+        expect(driver.victims(1, 3) == "0,0,0", group, "drrip followers insert like brrip after misses in the srrip leader");
+        driver.fill(2);
+        driver.fill(3);
+        expect(driver.victims(3, 4) == "0,1,2,3", group, "drrip followers insert like srrip after misses in the brrip leader");
+    }
+}
+
+/*
+ * Backing stores
+ * Spans must stay inside the store, and a sparse store must read unwritten memory as zero
+ * survive a dump/load round trip through a memory image, and keep its values apart from a
+ * snapshot's once either is written.
+ */
+void structureTest::checkBacking() {
+    const char* group = "backing";
+
+    const Addr base = 0x10000;
+    const size_t size = 16384;
+    Backend::BackingMMAP mmap("", size, base);
+    uint8_t* span = mmap.getMutableSpan(base + 64, 8);
+    if (span) memset(span, 0xA5, 8);
+    expect(span && mmap.get(base + 64) == 0xA5 && mmap.get(base + 71) == 0xA5, group, "mmap span writes are visible through get");
+    expect(mmap.getSpan(base + size - 64, 64) != nullptr, group, "mmap span may end at the end of the store");
+    expect(mmap.getSpan(base + size - 32, 64) == nullptr && mmap.getSpan(base + size, 1) == nullptr,
+            group, "mmap span past the end of the store is rejected");
+    expect(mmap.getSpan(base - 64, 64) == nullptr && mmap.getMutableSpan(base - 1, 2) == nullptr,
+            group, "mmap span below the store's offset is rejected");
+    expect(mmap.getSpan(base + 64, (size_t)-1) == nullptr, group, "mmap span size overflow is rejected");
+
+    const Addr high = 0xF00001000ull;
+    Backend::BackingSparse sparse(1ull << 36);
+    std::vector<uint8_t> data(8, 0);
+    sparse.get(high, 8, data);
+    const uint8_t* zero = sparse.getSpan(0x3000, 16);
+    expect(sparse.get(0x1234) == 0 && data == std::vector<uint8_t>(8, 0) && zero && zero[0] == 0 && zero[15] == 0,
+            group, "sparse unwritten memory reads as zero");
+
+    std::vector<uint8_t> pattern = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    sparse.set(0x1FFC, 8, pattern);
+    sparse.get(0x1FFC, 8, data);
+    expect(data == pattern && sparse.get(0x2000) == 5, group, "sparse access across a page boundary");
+    expect(sparse.getSpan(0x1FFC, 8) == nullptr && sparse.getSpan(0x2000, 4) != nullptr, group, "sparse span across a page boundary is rejected");
+
+    span = sparse.getMutableSpan(0x5010, 4);
+    if (span) memset(span, 0x5A, 4);
+    sparse.set(high, 0xEE);
+    expect(span && sparse.get(0x5013) == 0x5A && sparse.get(0x5014) == 0 && sparse.get(high) == 0xEE,
+            group, "sparse span writes and far addresses are visible through get");
+
+    const char* tmp = getenv("TMPDIR");
+    std::string image = std::string(tmp ? tmp : "/tmp") + "/memHierarchy_structureTest_XXXXXX";
+    std::vector<char> path(image.begin(), image.end());
+    path.push_back('\0');
+    int fd = mkstemp(path.data());
+    if (fd < 0)
+        out.fatal(CALL_INFO, -1, "%s, Error: unable to create a temporary memory image\n", getName().c_str());
+    close(fd);
+    image = path.data();
+
+    sparse.dump(image);
+    struct stat st;
+    stat(image.c_str(), &st);
+    expect(st.st_size == 16 + 4 * (8 + 4096), group, "sparse image holds only the 4 written pages");
+
+    Backend::BackingSparse loaded(1ull << 36);
+    loaded.load(image);
+    unlink(image.c_str());
+    loaded.get(0x1FFC, 8, data);
+    expect(data == pattern && loaded.get(0x5010) == 0x5A && loaded.get(0x5014) == 0 && loaded.get(high) == 0xEE && loaded.get(0x9000) == 0,
+            group, "sparse image round trip restores written memory");
+
+    /* Copy-on-write snapshot: pages are shared until either copy writes them */
+    Backend::BackingSparse* copy = sparse.snapshot();
+    sparse.set(0x5010, 0x11);
+    copy->set(0x1FFC, 0x22);
+    span = copy->getMutableSpan(0x5011, 1);
+    if (span) *span = 0x33;
+    copy->set(0x7000, 0x44);
+    expect(sparse.get(0x5010) == 0x11 && sparse.get(0x5011) == 0x5A && sparse.get(0x1FFC) == 1 && sparse.get(0x7000) == 0 && sparse.get(high) == 0xEE,
+            group, "sparse store keeps its own values after a snapshot");
+    expect(copy->get(0x5010) == 0x5A && copy->get(0x5011) == 0x33 && copy->get(0x1FFC) == 0x22 && copy->get(0x7000) == 0x44 && copy->get(high) == 0xEE,
+            group, "sparse snapshot keeps its own values");
+    delete copy;
+    sparse.get(0x1FFC, 8, data);
+    expect(data == pattern && sparse.get(0x5010) == 0x11 && sparse.get(high) == 0xEE,
+            group, "sparse store is intact after its snapshot is freed");
+}
+
+namespace {
+
+MemRegion makeRegion(Addr start, Addr end, Addr interleaveSize = 0, Addr interleaveStep = 0) {
+    MemRegion region;
+    region.start = start;
+    region.end = end;
+    region.interleaveSize = interleaveSize;
+    region.interleaveStep = interleaveStep;
+    return region;
+}
+
+/*
+ * Builds a routing table from a list of regions (region i routes to destination i) and
+ * compares its lookups with a scan of the regions in order at every region edge, every
+ * interleave chunk edge near the edges, and a spread of pseudo-random addresses
+ */
+class RoutingCheck {
+    public:
+        RoutingCheck(const std::vector<MemRegion>& regions) : regions_(regions) {
+            for (size_t i = 0; i < regions_.size(); i++) {
+                table_.addRegion(regions_[i], table_.addDestination("dest" + std::to_string(i), i));
+            }
+            table_.build();
+        }
+
+        bool matchesScan() const {
+            std::vector<Addr> addrs = { 0, 1, MemRegion::REGION_MAX - 1, MemRegion::REGION_MAX };
+            Addr limit = 0;
+            for (const MemRegion& region : regions_) {
+                for (Addr edge : { region.start, region.end }) {
+                    for (Addr delta = 0; delta < 3; delta++) {
+                        addrs.push_back(edge - delta);
+                        addrs.push_back(edge + delta);
+                    }
+                }
+                for (Addr chunk = 0; region.interleaveStep != 0 && chunk < 16; chunk++) {
+                    Addr chunkStart = region.start + chunk * region.interleaveStep;
+                    addrs.push_back(chunkStart - 1);
+                    addrs.push_back(chunkStart + region.interleaveSize - 1);
+                    addrs.push_back(chunkStart + region.interleaveSize);
+                }
+                if (region.end != MemRegion::REGION_MAX)
+                    limit = std::max(limit, region.end + 1);
+            }
+
+            uint64_t rand = 12345;
+            for (int i = 0; i < 100000; i++) {
+                rand = rand * 6364136223846793005ull + 1442695040888963407ull;
+                addrs.push_back((rand >> 16) % (limit + limit / 4 + 1));
+            }
+
+            for (Addr addr : addrs) {
+                if (table_.lookup(addr) != scan(addr))
+                    return false;
+            }
+            return true;
+        }
+
+        /* Whether the table resolves at least one segment with the given lookup (as printed by toString) */
+        bool uses(const std::string& mode) const { return table_.toString().find(mode) != std::string::npos; }
+
+    private:
+        int scan(Addr addr) const {
+            for (size_t i = 0; i < regions_.size(); i++) {
+                if (regions_[i].contains(addr))
+                    return i;
+            }
+            return AddressRoutingTable::NO_DEST;
+        }
+
+        std::vector<MemRegion> regions_;
+        AddressRoutingTable table_;
+};
+
+}
+
+/*
+ * AddressRoutingTable
+ * Each table must route every address to the first region (in insertion order) that contains it,
+ * as the scan of the endpoint list it replaced did.
+ */
+void structureTest::checkRouting() {
+    const char* group = "routing";
+
+    std::vector<MemRegion> regions;
+    for (Addr i = 0; i < 4; i++)
+        regions.push_back(makeRegion(i * 64, (1ull << 30) - 1, 64, 256));
+    RoutingCheck interleaved(regions);
+    expect(interleaved.matchesScan() && interleaved.uses("interleaved"), group, "power-of-two interleave over 4 destinations");
+
+    regions.clear();
+    for (Addr i = 0; i < 3; i++)
+        regions.push_back(makeRegion(0x1000 + i * 192, 0x100000 + 77, 192, 576));
+    regions.push_back(makeRegion(0x100000 + 78, 0x180000 - 1));
+    RoutingCheck nonPow2(regions);
+    expect(nonPow2.matchesScan() && nonPow2.uses("interleaved"), group, "non-power-of-two interleave with an unaligned end");
+
+    regions.clear();
+    regions.push_back(makeRegion(0, (1ull << 20) - 1, 100, 300));
+    regions.push_back(makeRegion(100, (1ull << 20) - 1, 50, 300));
+    regions.push_back(makeRegion(150, (1ull << 20) + 999, 150, 300));
+    RoutingCheck uneven(regions);
+    expect(uneven.matchesScan() && uneven.uses("interleaved"), group, "interleaved chunks of different sizes and a partial last segment");
+
+    regions.clear();
+    regions.push_back(makeRegion(0x10000, 0x1FFFF));
+    regions.push_back(makeRegion(0x30000, 0x3FFFF));
+    regions.push_back(makeRegion(0x38000, 0x4FFFF));
+    regions.push_back(makeRegion(0x60000, 0x7FFFF, 0x1000, 0x4000));
+    regions.push_back(makeRegion(0x70000, 0x8FFFF, 0x1000, 0x4000));
+    regions.push_back(makeRegion(0x100000, MemRegion::REGION_MAX));
+    RoutingCheck segments(regions);
+    expect(segments.matchesScan() && segments.uses("->"), group, "segments with gaps, overlaps and an unbounded last region");
+
+    regions.clear();
+    regions.push_back(makeRegion(0, (1ull << 24) - 1, 64, 128));
+    regions.push_back(makeRegion(0, (1ull << 24) - 1, 64, 192));
+    regions.push_back(makeRegion(0, (1ull << 24) - 1, 128, 256));
+    regions.push_back(makeRegion(1ull << 23, (1ull << 25) - 1));
+    RoutingCheck scanned(regions);
+    expect(scanned.matchesScan() && scanned.uses("scan"), group, "overlapping interleaves with different steps are scanned in order");
+}
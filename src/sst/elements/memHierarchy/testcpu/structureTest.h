@@ -0,0 +1,69 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _structureTest_H
+#define _structureTest_H
+
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/output.h>
+
+#include "replacementManager.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Checks memHierarchy's internal data structures directly, without a simulation.
+ * Each check group prints one line per check that passes and exits with a fatal
+ * error on the first failure, so the output can be compared against a reference file.
+ */
+class structureTest : public SST::Component {
+public:
+/* Element Library Info */
+    SST_ELI_REGISTER_COMPONENT(structureTest, "memHierarchy", "structureTest", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Checks memHierarchy data structures (sharer tracking, replacement policies, backing stores, address routing) during construction", COMPONENT_CATEGORY_UNCATEGORIZED)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"check",   "(string) Check group to run. Options: sharers[NodeIDTable and SharerSet], replacement[victim order of the per-set replacement policies], backing[span bounds and sparse memory images], routing[address routing table against a scan of the regions]", "sharers"} )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+            {"replacement", "Replacement policies under test, loaded anonymously", "SST::MemHierarchy::ReplacementPolicy"} )
+
+/* Begin class definiton */
+    structureTest(SST::ComponentId_t id, SST::Params& params);
+
+private:
+    structureTest();  // for serialization only
+    structureTest(const structureTest&); // do not implement
+    void operator=(const structureTest&); // do not implement
+
+    void checkSharers();
+    void checkReplacement();
+    void checkBacking();
+    void checkRouting();
+
+    ReplacementPolicy* loadPolicy(std::string name, Params& params, uint64_t lines, uint64_t ways);
+
+    /* Fatal if cond is false, otherwise report the check as passed */
+    void expect(bool cond, const char* group, const char* what);
+
+    Output out;
+    int slot;
+};
+
+}
+}
+#endif /* _structureTest_H */
@@ -0,0 +1,117 @@
+import sst
+import argparse
+from mhlib import componentlist
+
+# Stress test for the memory backends that take batched requests (simpleMem, timingDRAM)
+# simpleDRAM issues singly and is included for comparison.
+# Many cores with tiny L1s stream random addresses over a large footprint so nearly every
+# access misses and the memory controller is kept saturated.
+#
+# Usage:
+#   sst testBackendBatchStress.py --model-options="--backend=timingDRAM --cores=16 --ops=20000"
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--backend", default="timingDRAM", choices=["simpleMem", "simpleDRAM", "timingDRAM"], help="Memory backend to drive")
+parser.add_argument("--cores", type=int, default=8, help="Number of cores")
+parser.add_argument("--ops", type=int, default=5000, help="Requests issued by each core")
+args = parser.parse_args()
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({ "bus_frequency" : "4GHz" })
+
+for i in range(0, args.cores):
+    cpu = sst.Component("core" + str(i), "memHierarchy.standardCPU")
+    cpu.addParams({
+        "memFreq" : 1,
+        "memSize" : "256MiB",
+        "verbose" : 0,
+        "clock" : "4GHz",
+        "rngseed" : i * 17 + 1,
+        "maxOutstanding" : 64,
+        "opCount" : args.ops,
+        "reqsPerIssue" : 4,
+        "write_freq" : 30,
+        "read_freq" : 70,
+    })
+    iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+    l1cache = sst.Component("l1cache" + str(i) + ".mesi", "memHierarchy.Cache")
+    l1cache.addParams({
+        "access_latency_cycles" : "2",
+        "cache_frequency" : "4GHz",
+        "replacement_policy" : "lru",
+        "coherence_protocol" : "MESI",
+        "associativity" : "2",
+        "cache_line_size" : "64",
+        "cache_size" : "1 KB",
+        "mshr_num_entries" : 64,
+        "L1" : "1",
+    })
+
+    link_cpu_l1 = sst.Link("link_cpu_l1_" + str(i))
+    link_cpu_l1.connect( (iface, "port", "100ps"), (l1cache, "high_network_0", "100ps") )
+
+    link_l1_bus = sst.Link("link_l1_bus_" + str(i))
+    link_l1_bus.connect( (l1cache, "low_network_0", "100ps"), (bus, "high_network_" + str(i), "100ps") )
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "2GHz",
+    "backing" : "none",
+    "addr_range_end" : 256*1024*1024-1,
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy." + args.backend)
+if args.backend == "simpleMem":
+    memory.addParams({
+        "mem_size" : "256MiB",
+        "access_time" : "50ns",
+        "max_requests_per_cycle" : -1,
+    })
+elif args.backend == "simpleDRAM":
+    memory.addParams({
+        "mem_size" : "256MiB",
+        "max_requests_per_cycle" : -1,
+        "banks" : 64,
+        "tCAS" : 9,
+        "tRCD" : 9,
+        "tRP" : 9,
+        "cycle_time" : "1ns",
+        "row_size" : "8KiB",
+        "row_policy" : "open",
+    })
+else:
+    memory.addParams({
+        "id" : 0,
+        "max_requests_per_cycle" : -1,
+        "addrMapper" : "memHierarchy.roundRobinAddrMapper",
+        "addrMapper.interleave_size" : "64B",
+        "addrMapper.row_size" : "2KiB",
+        "clock" : "2GHz",
+        "mem_size" : "256MiB",
+        "channels" : 8,
+        "channel.numRanks" : 2,
+        "channel.rank.numBanks" : 16,
+        "channel.transaction_Q_size" : 64,
+        "channel.rank.bank.CL" : 14,
+        "channel.rank.bank.CL_WR" : 12,
+        "channel.rank.bank.RCD" : 14,
+        "channel.rank.bank.TRP" : 14,
+        "channel.rank.bank.dataCycles" : 2,
+        "channel.rank.bank.pagePolicy" : "memHierarchy.simplePagePolicy",
+        "channel.rank.bank.transactionQ" : "memHierarchy.reorderTransactionQ",
+        "channel.rank.bank.pagePolicy.close" : 0,
+        "printconfig" : 0,
+        "channel.printconfig" : 0,
+        "channel.rank.printconfig" : 0,
+        "channel.rank.bank.printconfig" : 0,
+    })
+
+link_bus_mem = sst.Link("link_bus_mem")
+link_bus_mem.connect( (bus, "low_network_0", "100ps"), (memctrl, "direct_link", "100ps") )
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
@@ -0,0 +1,14 @@
+import sst
+import argparse
+
+# Check memHierarchy data structures directly
+# Each check group prints one line per passing check
+#
+#   sst testStructures.py --model-options="--check=sharers"
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--check", default="sharers", help="Check group to run")
+args = parser.parse_args()
+
+comp = sst.Component("structures", "memHierarchy.structureTest")
+comp.addParams({ "check" : args.check })
@@ -0,0 +1,88 @@
+import sst
+import argparse
+
+# Tag store microbenchmark
+# Drives a large shared LLC with random traffic so that simulator time is dominated by tag lookups.
+# Simulated results are identical for both layouts; only wall-clock time differs.
+#
+# Run once per layout and compare:
+#   sst --print-timing-info testTagStoreLayout.py --model-options="--layout=aos"
+#   sst --print-timing-info testTagStoreLayout.py --model-options="--layout=soa"
+# Lookups per second = (l2cache TotalEventsReceived) / (run loop time reported by --print-timing-info)
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--layout", default="soa", choices=["aos", "soa"], help="Tag store layout")
+parser.add_argument("--cores", type=int, default=4, help="Number of cores sharing the LLC")
+parser.add_argument("--ops", type=int, default=200000, help="Operations per core")
+parser.add_argument("--llc_size", default="32MiB", help="LLC size")
+args = parser.parse_args()
+
+mem_size = 4 * 1024 * 1024 * 1024
+
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "20",
+    "cache_frequency" : "2GHz",
+    "coherence_protocol" : "MESI",
+    "associativity" : "16",
+    "cache_line_size" : "64",
+    "cache_size" : args.llc_size,
+    "mshr_num_entries" : "256",
+    "tag_store_layout" : args.layout,
+})
+l2_cpulink = l2cache.setSubComponent("cpulink", "memHierarchy.MemLink")
+l2_memlink = l2cache.setSubComponent("memlink", "memHierarchy.MemLink")
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({ "bus_frequency" : "2GHz" })
+
+for core in range(args.cores):
+    cpu = sst.Component("core" + str(core), "memHierarchy.standardCPU")
+    cpu.addParams({
+        "memFreq" : 1,
+        "memSize" : "4GiB",
+        "clock" : "2GHz",
+        "maxOutstanding" : 64,
+        "opCount" : args.ops,
+        "write_freq" : 25,
+        "read_freq" : 75,
+        "rngseed" : 7 + core,
+    })
+    iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+    l1cache = sst.Component("l1cache" + str(core), "memHierarchy.Cache")
+    l1cache.addParams({
+        "access_latency_cycles" : "2",
+        "cache_frequency" : "2GHz",
+        "coherence_protocol" : "MESI",
+        "associativity" : "4",
+        "cache_line_size" : "64",
+        "L1" : "1",
+        "cache_size" : "4KiB",
+        "tag_store_layout" : args.layout,
+    })
+
+    link_cpu = sst.Link("link_cpu_l1_" + str(core))
+    link_cpu.connect( (iface, "port", "500ps"), (l1cache, "high_network_0", "500ps") )
+    link_l1 = sst.Link("link_l1_bus_" + str(core))
+    link_l1.connect( (l1cache, "low_network_0", "500ps"), (bus, "high_network_" + str(core), "500ps") )
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "addr_range_end" : mem_size - 1,
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "50ns",
+    "mem_size" : "4GiB",
+})
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
+l2cache.enableStatistics(["TotalEventsReceived"])
+
+link_bus_l2 = sst.Link("link_bus_l2")
+link_bus_l2.connect( (bus, "low_network_0", "500ps"), (l2_cpulink, "port", "500ps") )
+link_l2_mem = sst.Link("link_l2_mem")
+link_l2_mem.connect( (l2_memlink, "port", "500ps"), (memctrl, "direct_link", "500ps") )
@@ -8,6 +8,14 @@ import os.path
 # Code to support a single instance module initialize, must be called setUp method
 
 module_init = 0
+
+# Overrides that with_params.py applies to a test config for each variant run
+variant_overrides = {
+    "Clockless" : "--type=memHierarchy.Cache --set=clockless=1",
+    "TagStoreLayout" : "--type=memHierarchy.Cache --set=tag_store_layout=soa",
+    "SparseBacking" : "--type=memHierarchy.MemController --set=backing=sparse",
+    "EventPool" : "--type=memHierarchy.Cache --type=memHierarchy.MemController --set=event_pool=1",
+}
 module_sema = threading.Semaphore()
 
 def initializeTestModule_SingleInstance(class_inst):
@@ -183,10 +191,161 @@ class testcase_memHierarchy_memHA(SSTTestCase):
     
     def test_memHA_StdMem_mmio3(self):
         self.memHA_Template("StdMem_mmio3")
+
+    # Clockless caches must match the clocked reference output
+    def test_memHA_Clockless_DistributedCaches(self):
+        self.memHA_Template("DistributedCaches", variant="Clockless")
+
+    def test_memHA_Clockless_Flushes(self):
+        self.memHA_Template("Flushes", variant="Clockless")
+
+    def test_memHA_Clockless_Noninclusive_1(self):
+        self.memHA_Template("Noninclusive_1", variant="Clockless")
+
+    def test_memHA_Clockless_PrefetchParams(self):
+        self.memHA_Template("PrefetchParams", variant="Clockless")
+
+    def test_memHA_Clockless_ThroughputThrottling(self):
+        self.memHA_Template("ThroughputThrottling", variant="Clockless")
+
+    def test_memHA_Clockless_StdMem(self):
+        self.memHA_Template("StdMem", variant="Clockless")
+
+    def test_memHA_Clockless_StdMem_noninclusive(self):
+        self.memHA_Template("StdMem_noninclusive", variant="Clockless")
+
+    # The structure-of-arrays tag store must match the reference output of the default layout
+    def test_memHA_TagStoreLayout_DistributedCaches(self):
+        self.memHA_Template("DistributedCaches", variant="TagStoreLayout")
+
+    def test_memHA_TagStoreLayout_Flushes(self):
+        self.memHA_Template("Flushes", variant="TagStoreLayout")
+
+    def test_memHA_TagStoreLayout_Incoherent(self):
+        self.memHA_Template("Incoherent", variant="TagStoreLayout")
+
+    def test_memHA_TagStoreLayout_Noninclusive_1(self):
+        self.memHA_Template("Noninclusive_1", variant="TagStoreLayout")
+
+    def test_memHA_TagStoreLayout_Noninclusive_2(self):
+        self.memHA_Template("Noninclusive_2", variant="TagStoreLayout")
+
+    def test_memHA_TagStoreLayout_HashXor(self):
+        self.memHA_Template("HashXor", variant="TagStoreLayout")
+
+    def test_memHA_TagStoreLayout_StdMem(self):
+        self.memHA_Template("StdMem", variant="TagStoreLayout")
+
+    # Each replacement policy must let every CPU complete its operations
+    def test_memHA_ReplacementPolicy_TreePLRU_DistributedCaches(self):
+        self.replacementPolicy_Template("DistributedCaches", "tree-plru")
+
+    def test_memHA_ReplacementPolicy_TreePLRU_Flushes(self):
+        self.replacementPolicy_Template("Flushes", "tree-plru")
+
+    def test_memHA_ReplacementPolicy_TreePLRU_Noninclusive_1(self):
+        self.replacementPolicy_Template("Noninclusive_1", "tree-plru")
+
+    def test_memHA_ReplacementPolicy_TreePLRU_StdMem(self):
+        self.replacementPolicy_Template("StdMem", "tree-plru")
+
+    def test_memHA_ReplacementPolicy_AgeMatrixLRU_DistributedCaches(self):
+        self.replacementPolicy_Template("DistributedCaches", "lru-matrix")
+
+    def test_memHA_ReplacementPolicy_AgeMatrixLRU_Flushes(self):
+        self.replacementPolicy_Template("Flushes", "lru-matrix")
+
+    def test_memHA_ReplacementPolicy_AgeMatrixLRU_Noninclusive_1(self):
+        self.replacementPolicy_Template("Noninclusive_1", "lru-matrix")
+
+    def test_memHA_ReplacementPolicy_AgeMatrixLRU_StdMem(self):
+        self.replacementPolicy_Template("StdMem", "lru-matrix")
+
+    def test_memHA_ReplacementPolicy_SRRIP_DistributedCaches(self):
+        self.replacementPolicy_Template("DistributedCaches", "srrip")
+
+    def test_memHA_ReplacementPolicy_SRRIP_Flushes(self):
+        self.replacementPolicy_Template("Flushes", "srrip")
+
+    def test_memHA_ReplacementPolicy_SRRIP_Noninclusive_1(self):
+        self.replacementPolicy_Template("Noninclusive_1", "srrip")
+
+    def test_memHA_ReplacementPolicy_SRRIP_StdMem(self):
+        self.replacementPolicy_Template("StdMem", "srrip")
+
+    def test_memHA_ReplacementPolicy_BRRIP_DistributedCaches(self):
+        self.replacementPolicy_Template("DistributedCaches", "brrip")
+
+    def test_memHA_ReplacementPolicy_BRRIP_Flushes(self):
+        self.replacementPolicy_Template("Flushes", "brrip")
+
+    def test_memHA_ReplacementPolicy_BRRIP_Noninclusive_1(self):
+        self.replacementPolicy_Template("Noninclusive_1", "brrip")
+
+    def test_memHA_ReplacementPolicy_BRRIP_StdMem(self):
+        self.replacementPolicy_Template("StdMem", "brrip")
+
+    def test_memHA_ReplacementPolicy_DRRIP_DistributedCaches(self):
+        self.replacementPolicy_Template("DistributedCaches", "drrip")
+
+    def test_memHA_ReplacementPolicy_DRRIP_Flushes(self):
+        self.replacementPolicy_Template("Flushes", "drrip")
+
+    def test_memHA_ReplacementPolicy_DRRIP_Noninclusive_1(self):
+        self.replacementPolicy_Template("Noninclusive_1", "drrip")
+
+    def test_memHA_ReplacementPolicy_DRRIP_StdMem(self):
+        self.replacementPolicy_Template("StdMem", "drrip")
+
+    # Direct checks of memHierarchy data structures
+    def test_memHA_Structures_sharers(self):
+        self.structures_Template("sharers")
+
+    def test_memHA_Structures_replacement(self):
+        self.structures_Template("replacement")
+
+    def test_memHA_Structures_backing(self):
+        self.structures_Template("backing")
+
+    def test_memHA_Structures_routing(self):
+        self.structures_Template("routing")
+
+    # A sparse backing store must match the reference output of the default backing
+    def test_memHA_SparseBacking_StdMem(self):
+        self.memHA_Template("StdMem", variant="SparseBacking")
+
+    def test_memHA_SparseBacking_Incoherent(self):
+        self.memHA_Template("Incoherent", variant="SparseBacking")
+
+    # Recycling events must match the reference output with the pool off
+    def test_memHA_EventPool_DistributedCaches(self):
+        self.memHA_Template("DistributedCaches", variant="EventPool")
+
+    def test_memHA_EventPool_Flushes(self):
+        self.memHA_Template("Flushes", variant="EventPool")
+
+    def test_memHA_EventPool_Incoherent(self):
+        self.memHA_Template("Incoherent", variant="EventPool")
+
+    def test_memHA_EventPool_Noninclusive_1(self):
+        self.memHA_Template("Noninclusive_1", variant="EventPool")
+
+    def test_memHA_EventPool_StdMem(self):
+        self.memHA_Template("StdMem", variant="EventPool")
+
+    # Saturating load on the backends that take batched requests, and on simpleDRAM for comparison
+    def test_memHA_BackendBatch_simpleMem(self):
+        self.backendBatch_Template("simpleMem")
+
+    def test_memHA_BackendBatch_simpleDRAM(self):
+        self.backendBatch_Template("simpleDRAM")
+
+    def test_memHA_BackendBatch_timingDRAM(self):
+        self.backendBatch_Template("timingDRAM")
 #####
 
     def memHA_Template(self, testcase,
-                       ignore_err_file=False, testtimeout=240):
+                       ignore_err_file=False, testtimeout=240, variant=None):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -199,6 +358,13 @@ class testcase_memHierarchy_memHA(SSTTestCase):
         testDataFileName=("test_memHA_{0}".format(testcase))
         sdlfile = "{0}/test{1}.py".format(test_path, testcasename_sdl)
         reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+
+        # Variant runs (e.g., clockless) override params in the original configuration and compare against its reference file
+        otherargs = ""
+        if variant is not None:
+            otherargs = '--model-options="--config={0} {1}"'.format(sdlfile, variant_overrides[variant])
+            sdlfile = "{0}/with_params.py".format(test_path)
+            testDataFileName = "test_memHA_{0}_{1}".format(variant, testcase)
         
         tmpfile = "{0}/{1}.tmp".format(outdir, testDataFileName)
 
@@ -212,7 +378,7 @@ class testcase_memHierarchy_memHA(SSTTestCase):
         log_debug("ref file = {0}".format(reffile))
 
         # Run SST in the tests directory
-        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path,
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, other_args=otherargs,
                      timeout_sec=testtimeout, mpi_out_files=mpioutfiles)
         
         # Lines to ignore
@@ -248,6 +414,92 @@ class testcase_memHierarchy_memHA(SSTTestCase):
             log_failure(diffdata)
             self.assertTrue(filesAreTheSame, "Output file {0} does not pass check against the Reference File {1} ".format(outfile, reffile))
 
+    def replacementPolicy_Template(self, testcase, policy, testtimeout=240):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testcasename_sdl = testcase.replace("_", "-")
+        testDataFileName = "test_memHA_ReplacementPolicy_{0}_{1}".format(policy, testcase)
+        configfile = "{0}/test{1}.py".format(test_path, testcasename_sdl)
+        sdlfile = "{0}/with_params.py".format(test_path)
+        reffile = "{0}/refFiles/test_memHA_{1}.out".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        otherargs = '--model-options="--config={0} --type=memHierarchy.Cache --subcomponent=replacement=memHierarchy.replacement.{1}"'.format(configfile, policy)
+
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, other_args=otherargs, timeout_sec=testtimeout)
+
+        # A CPU only lets the simulation end once all of its operations have completed.
+        # Its issued reads, writes, flushes and LL/SC pairs must add up to the same total as
+        # the reference run; the total can be one short when the last operation was an LL.
+        refOps = self._count_cpu_ops(reffile)
+        outOps = self._count_cpu_ops(outfile)
+        self.assertTrue(len(refOps) > 0, "No CPU statistics found in Reference File {0}".format(reffile))
+        for cpu in refOps:
+            self.assertTrue(cpu in outOps, "CPU {0} reported no statistics in output file {1}".format(cpu, outfile))
+            self.assertTrue(abs(outOps[cpu] - refOps[cpu]) <= 1,
+                    "CPU {0} completed {1} operations with replacement policy {2}, reference run completed {3}".format(cpu, outOps[cpu], policy, refOps[cpu]))
+
+    def backendBatch_Template(self, backend, cores=4, ops=1000, testtimeout=240):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName = "test_memHA_BackendBatch_{0}".format(backend)
+        sdlfile = "{0}/testBackendBatchStress.py".format(test_path)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        otherargs = '--model-options="--backend={0} --cores={1} --ops={2}"'.format(backend, cores, ops)
+
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, other_args=otherargs, timeout_sec=testtimeout)
+
+        # Every core must have issued all of its reads and writes before the simulation ended
+        outOps = self._count_cpu_ops(outfile)
+        for i in range(cores):
+            cpu = "core{0}".format(i)
+            self.assertTrue(cpu in outOps, "CPU {0} reported no statistics in output file {1}".format(cpu, outfile))
+            self.assertEqual(outOps[cpu], ops,
+                    "CPU {0} issued {1} operations with backend {2}, expected {3}".format(cpu, outOps[cpu], backend, ops))
+
+    def _count_cpu_ops(self, statfile):
+        weights = { "reads" : 1, "writes" : 1, "flushes" : 1, "flushinvs" : 1, "llsc" : 2 }
+        ops = {}
+        with open(statfile, 'r') as f:
+            for line in f:
+                fields = line.split(" : ")
+                if len(fields) < 3:
+                    continue
+                name = fields[0].strip().rsplit(".", 1)
+                if len(name) != 2 or name[1] not in weights:
+                    continue
+                total = int(fields[2].split(";")[0].split("=")[1])
+                ops[name[0]] = ops.get(name[0], 0) + weights[name[1]] * total
+        return ops
+
+    def structures_Template(self, check, testtimeout=60):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        testDataFileName = "test_memHA_Structures_{0}".format(check)
+        sdlfile = "{0}/testStructures.py".format(test_path)
+        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        grep_outfile = "{0}/{1}.grep".format(tmpdir, testDataFileName)
+        otherargs = '--model-options="--check={0}"'.format(check)
+
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, other_args=otherargs, timeout_sec=testtimeout)
+
+        # Only compare the check results, not the simulator's closing message
+        cmd = 'grep -e "^{0}: " {1} > {2}'.format(check, outfile, grep_outfile)
+        os.system(cmd)
+
+        cmp_result = testing_compare_diff(testDataFileName, grep_outfile, reffile)
+        if cmp_result == False:
+            diffdata = testing_get_diff_data(testDataFileName)
+            log_failure(diffdata)
+        self.assertTrue(cmp_result, "Output file {0} does not match Reference File {1}".format(outfile, reffile))
+
 ###
     # Remove lines containing any string found in 'remove_strs' from in_file
     # If out_file != None, output is out_file
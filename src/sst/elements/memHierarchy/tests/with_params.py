@@ -0,0 +1,56 @@
+import sst
+import sys
+import argparse
+
+# Run another memHierarchy test configuration with some of its parameters overridden
+# --set and --subcomponent apply to every component of the --type(s) given, after the
+# configuration has set up its own, so a --set replaces any value the configuration chose.
+# Overrides that must not change the simulation (e.g., clockless caches) can be compared
+# against the reference file of the wrapped configuration.
+#
+#   sst with_params.py --model-options="--config=testFlushes.py --type=memHierarchy.Cache --set=clockless=1"
+#   sst with_params.py --model-options="--config=testFlushes.py --type=memHierarchy.Cache --subcomponent=replacement=memHierarchy.replacement.srrip"
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--config", required=True, help="Test configuration to run")
+parser.add_argument("--type", action="append", default=[], help="Component type to override")
+parser.add_argument("--set", action="append", default=[], metavar="KEY=VALUE", help="Parameter to set")
+parser.add_argument("--subcomponent", action="append", default=[], metavar="SLOT=TYPE", help="Subcomponent to load into a slot")
+args = parser.parse_args()
+
+def splitOverrides(overrides):
+    values = {}
+    for override in overrides:
+        key, sep, value = override.partition("=")
+        if not sep:
+            sys.exit("with_params.py: '{0}' is not of the form KEY=VALUE".format(override))
+        values[key] = value
+    return values
+
+params = splitOverrides(args.set)
+subcomponents = splitOverrides(args.subcomponent)
+if not args.type:
+    sys.exit("with_params.py: at least one --type is needed")
+
+# Remember the components to override once the configuration is done
+components = []
+_Component = sst.Component
+
+def OverrideComponent(name, type):
+    comp = _Component(name, type)
+    if type in args.type:
+        components.append(comp)
+    return comp
+
+sst.Component = OverrideComponent
+
+sys.argv = [args.config]
+with open(args.config) as f:
+    exec(compile(f.read(), args.config, "exec"))
+
+if not components:
+    sys.exit("with_params.py: {0} has no components of type {1}".format(args.config, ", ".join(args.type)))
+for comp in components:
+    comp.addParams(params)
+    for slot, type in subcomponents.items():
+        comp.setSubComponent(slot, type, 0)
@@ -0,0 +1,46 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_EVENTPOOL_H
+#define COMPONENTS_MERLIN_EVENTPOOL_H
+
+#include "sst/elements/common/recyclingPool.h"
+
+namespace SST {
+namespace Merlin {
+
+// Recycling allocator for router events
+//
+// BaseRtrEvent and its subclasses (RtrEvent, credit_event,
+// internal_router_event and the topology specific events) allocate
+// through here.  Events are freed by whoever ends up holding them:
+// the next router, the endpoint, or the core once the event has been
+// serialized to another rank.  Because of this the pool sits behind
+// the class operator new/delete rather than in the component that
+// made the event, and events created by deserialization come from
+// the pool on the receiving rank.
+//
+// Bins are bounded per thread at 16384 blocks.  Credits and packets
+// are freed on the receiving side, so the bound keeps one-way traffic
+// between threads from growing a pool without limit.
+class EventPool : public SST::Common::RecyclingPool<EventPool, 256, 16384> {};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_EVENTPOOL_H
@@ -0,0 +1,308 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "flowLinkControl.h"
+
+#include <sst/core/output.h>
+
+#include "sst/elements/merlin/merlin.h"
+
+namespace SST {
+using namespace Interfaces;
+
+namespace Merlin {
+
+FlowLinkControl::FlowLinkControl(ComponentId_t cid, Params &params, int vns) :
+    SST::Interfaces::SimpleNetwork(cid),
+    rtr_link(nullptr),
+    req_vns(vns),
+    id(-1), logical_nid(-1), job_id(0), use_nid_map(false),
+    network_initialized(false),
+    receiveFunctor(nullptr), sendFunctor(nullptr),
+    output(getSimulationOutput())
+{
+    // Get the link bandwidth
+    link_bw = params.find<UnitAlgebra>("link_bw");
+    if ( !link_bw.hasUnits("B/s") && !link_bw.hasUnits("b/s") ) {
+        merlin_abort.fatal(CALL_INFO,1,"Error: link_bw must be specified in either B/s or b/s (SI prefix also allowed)\n");
+    }
+
+    if ( link_bw.hasUnits("B/s") ) {
+        link_bw *= UnitAlgebra("8b/B");
+    }
+
+    UnitAlgebra outbuf_size = params.find<UnitAlgebra>("output_buf_size","1kB");
+    if ( !outbuf_size.hasUnits("b") && !outbuf_size.hasUnits("B") ) {
+        merlin_abort.fatal(CALL_INFO,-1,"out_buf_size must be specified in either "
+                           "bits or bytes: %s\n",outbuf_size.toStringBestSI().c_str());
+    }
+    if ( outbuf_size.hasUnits("B") ) outbuf_size *= UnitAlgebra("8b/B");
+    outbuf_bits = outbuf_size.getRoundedValue();
+
+    std::string port_name("rtr_port");
+    if ( isAnonymous() ) {
+        port_name = params.find<std::string>("port_name");
+    }
+
+    rtr_link = configureLink(port_name, std::string("1ps"), new Event::Handler<FlowLinkControl>(this,&FlowLinkControl::handle_input));
+
+    outstanding_bits.assign(req_vns, 0);
+    input_queues.resize(req_vns);
+
+    // See if we need to set up a nid map
+    bool found = false;
+    job_id = params.find<int>("job_id",-1,found);
+    use_nid_map = params.find<bool>("use_nid_remap",false);
+    if ( found ) {
+        if ( use_nid_map ) {
+            std::string nid_map_name = std::string("job_") + std::to_string(job_id) + "_nid_map";
+
+            int job_size = params.find<int>("job_size",-1);
+            if ( job_size == -1 ) {
+                merlin_abort.fatal(CALL_INFO,1,"FlowLinkControl: job_size must be set\n");
+            }
+            logical_nid = params.find<nid_t>("logical_nid",-1);
+            if ( logical_nid == -1 ) {
+                merlin_abort.fatal(CALL_INFO,1,"FlowLinkControl: logical_nid must be set\n");
+            }
+            nid_map.initialize(nid_map_name, job_size * sizeof(nid_t));
+        }
+    }
+    else {
+        std::string nid_map_name = params.find<std::string>("nid_map_name",std::string());
+        if ( !nid_map_name.empty() ) {
+            int job_size = params.find<int>("job_size",-1);
+            if ( job_size == -1 ) {
+                merlin_abort.fatal(CALL_INFO,1,"FlowLinkControl: job_size must be set if nid_map_name is set\n");
+            }
+            logical_nid = params.find<nid_t>("logical_nid",-1);
+            if ( logical_nid == -1 ) {
+                merlin_abort.fatal(CALL_INFO,1,"FlowLinkControl: logical_nid must be set if nid_map_name is set\n");
+            }
+            nid_map.initialize(nid_map_name, job_size * sizeof(nid_t));
+            use_nid_map = true;
+        }
+    }
+
+    packet_latency = registerStatistic<uint64_t>("packet_latency");
+    send_bit_count = registerStatistic<uint64_t>("send_bit_count");
+}
+
+FlowLinkControl::~FlowLinkControl()
+{
+}
+
+void FlowLinkControl::setup()
+{
+    while ( init_events.size() ) {
+        delete init_events.front();
+        init_events.pop_front();
+    }
+}
+
+void FlowLinkControl::init(unsigned int phase)
+{
+    if ( phase == 0 ) {
+        // The flow network takes the min of the two link speeds
+        RtrInitEvent* init_ev = new RtrInitEvent();
+        init_ev->command = RtrInitEvent::REPORT_BW;
+        init_ev->ua_value = link_bw;
+        rtr_link->sendUntimedData(init_ev);
+    }
+    handleUntimedData();
+}
+
+void FlowLinkControl::complete(unsigned int phase)
+{
+    handleUntimedData();
+}
+
+void FlowLinkControl::handleUntimedData()
+{
+    Event* ev;
+    while ( ( ev = rtr_link->recvUntimedData() ) != nullptr ) {
+        BaseRtrEvent* bev = static_cast<BaseRtrEvent*>(ev);
+        switch (bev->getType()) {
+        case BaseRtrEvent::INITIALIZATION:
+        {
+            RtrInitEvent* init_ev = static_cast<RtrInitEvent*>(ev);
+            if ( init_ev->command == RtrInitEvent::REPORT_ID ) {
+                id = init_ev->int_value;
+                if ( logical_nid == -1 ) logical_nid = id;
+                // If we have a nid_map, fill in my mapping
+                if ( use_nid_map ) {
+                    nid_map.write(logical_nid,id);
+                    nid_map.publish();
+                }
+                network_initialized = true;
+            }
+            else if ( init_ev->command == RtrInitEvent::REPORT_BW ) {
+                if ( link_bw > init_ev->ua_value ) link_bw = init_ev->ua_value;
+            }
+            else {
+                merlin_abort.fatal(CALL_INFO, 1, "FlowLinkControl received an unexpected initialization command.  "
+                                   "The most likely cause of this is connecting it to a router instead of a merlin.flownetwork.\n");
+            }
+            delete ev;
+        }
+            break;
+        case BaseRtrEvent::PACKET:
+            init_events.push_back(static_cast<RtrEvent*>(ev));
+            break;
+        default:
+            merlin_abort_full.fatal(CALL_INFO, 1, "Reached state where a non-RtrEvent was not handled.");
+            break;
+        }
+    }
+}
+
+
+void FlowLinkControl::finish(void)
+{
+    for ( int i = 0; i < req_vns; i++ ) {
+        while ( !input_queues[i].empty() ) {
+            delete input_queues[i].front();
+            input_queues[i].pop();
+        }
+    }
+}
+
+
+// Returns true if there is space in the output buffer and false
+// otherwise.  A message is always accepted if nothing is in flight
+// on the VN, so messages larger than the buffer can still be sent.
+bool FlowLinkControl::send(SimpleNetwork::Request* req, int vn) {
+    if ( vn >= req_vns ) return false;
+    if ( !spaceToSend(vn, req->size_in_bits) ) return false;
+    req->vn = vn;
+
+    // Check to see if we need to do a nid translation
+    if ( use_nid_map ) req->dest = nid_map[req->dest];
+
+    RtrEvent* ev = new RtrEvent(req,id,vn);
+    ev->setInjectionTime(getCurrentSimTimeNano());
+    outstanding_bits[vn] += req->size_in_bits;
+
+    if ( ev->getTraceType() != SimpleNetwork::Request::NONE ) {
+        output.output("TRACE(%d): %" PRIu64 " ns: Send on FlowLinkControl in NIC: %s\n",ev->getTraceID(),
+                      getCurrentSimTimeNano(), getName().c_str());
+    }
+
+    send_bit_count->addData(req->size_in_bits);
+    rtr_link->send(ev);
+    return true;
+}
+
+
+bool FlowLinkControl::spaceToSend(int vn, int bits) {
+    if ( outstanding_bits[vn] == 0 ) return true;
+    return outstanding_bits[vn] + bits <= outbuf_bits;
+}
+
+
+SST::Interfaces::SimpleNetwork::Request* FlowLinkControl::recv(int vn) {
+    if ( input_queues[vn].empty() ) return nullptr;
+
+    RtrEvent* event = input_queues[vn].front();
+    input_queues[vn].pop();
+
+    if ( event->getTraceType() != SimpleNetwork::Request::NONE ) {
+        output.output("TRACE(%d): %" PRIu64 " ns: recv called on FlowLinkControl in NIC: %s\n",event->getTraceID(),
+                      getCurrentSimTimeNano(), getName().c_str());
+    }
+
+    SST::Interfaces::SimpleNetwork::Request* ret = event->takeRequest();
+    if ( use_nid_map ) ret->dest = logical_nid;
+    delete event;
+    return ret;
+}
+
+void FlowLinkControl::sendUntimedData(SST::Interfaces::SimpleNetwork::Request* req)
+{
+    if ( use_nid_map ) {
+        req->dest = nid_map[req->dest];
+    }
+    rtr_link->sendUntimedData(new RtrEvent(req,id,0));
+}
+
+SST::Interfaces::SimpleNetwork::Request* FlowLinkControl::recvUntimedData()
+{
+    if ( init_events.size() ) {
+        RtrEvent *ev = init_events.front();
+        init_events.pop_front();
+        SST::Interfaces::SimpleNetwork::Request* ret = ev->takeRequest();
+        delete ev;
+        return ret;
+    } else {
+        return nullptr;
+    }
+}
+
+void FlowLinkControl::sendInitData(SST::Interfaces::SimpleNetwork::Request* req) {
+    sendUntimedData(req);
+}
+
+SST::Interfaces::SimpleNetwork::Request* FlowLinkControl::recvInitData() {
+    return recvUntimedData();
+}
+
+
+void FlowLinkControl::handle_input(Event* ev)
+{
+    BaseRtrEvent* base_event = static_cast<BaseRtrEvent*>(ev);
+    if ( base_event->getType() == BaseRtrEvent::CREDIT ) {
+        // The credit event returns the bits of a message that has
+        // left the endpoint
+        credit_event* ce = static_cast<credit_event*>(ev);
+        int vn = ce->vc;
+        outstanding_bits[vn] -= ce->credits;
+        delete ev;
+
+        if ( sendFunctor != nullptr ) {
+            bool keep = (*sendFunctor)(vn);
+            if ( !keep ) sendFunctor = nullptr;
+        }
+    }
+    else if ( base_event->getType() == BaseRtrEvent::PACKET ) {
+        RtrEvent* event = static_cast<RtrEvent*>(ev);
+        int vn = event->getLogicalVN();
+        input_queues[vn].push(event);
+
+        if ( event->getTraceType() == SimpleNetwork::Request::FULL ) {
+            output.output("TRACE(%d): %" PRIu64 " ns: Received and event on FlowLinkControl in NIC: %s"
+                          " on VN %d from src %" PRIu64 "\n",
+                          event->getTraceID(),
+                          getCurrentSimTimeNano(),
+                          getName().c_str(),
+                          vn,
+                          event->getTrustedSrc());
+        }
+
+        packet_latency->addData(getCurrentSimTimeNano() - event->getInjectionTime());
+        if ( receiveFunctor != nullptr ) {
+            bool keep = (*receiveFunctor)(vn);
+            if ( !keep ) receiveFunctor = nullptr;
+        }
+    }
+    else {
+        delete ev;
+    }
+}
+
+} // namespace Merlin
+} // namespace SST
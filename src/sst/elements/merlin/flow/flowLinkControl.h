@@ -0,0 +1,160 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_FLOW_FLOWLINKCONTROL_H
+#define COMPONENTS_MERLIN_FLOW_FLOWLINKCONTROL_H
+
+#include <sst/core/subcomponent.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <sst/core/interfaces/simpleNetwork.h>
+
+#include <sst/core/statapi/statbase.h>
+#include <sst/core/shared/sharedArray.h>
+
+#include "sst/elements/merlin/router.h"
+
+#include <deque>
+#include <queue>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+// SimpleNetwork for endpoints connected to merlin.flownetwork.  Takes
+// the same parameters as merlin.linkcontrol so it can be used in its
+// place without changing the endpoint.  Messages are handed to the
+// flow network as soon as they are sent.  The output buffer is
+// modeled by limiting the bits each VN has in flight that have not
+// yet left the endpoint; received messages are held until the
+// endpoint reads them.
+class FlowLinkControl : public SST::Interfaces::SimpleNetwork {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        FlowLinkControl,
+        "merlin",
+        "flowlink",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Link control for endpoints connected to a merlin.flownetwork",
+        SST::Interfaces::SimpleNetwork)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"port_name",          "Port name to connect to.  Only used when loaded anonymously",""},
+        {"link_bw",            "Bandwidth of the link specified in either b/s or B/s (can include SI prefix)."},
+        {"input_buf_size",     "Not used, receive buffering is unlimited.  Accepted for compatibility with merlin.linkcontrol.", "1kB"},
+        {"output_buf_size",    "Size of output buffers specified in b or B (can include SI prefix).", "1kB"},
+        {"job_id",             "ID of the job this enpoint is part of.", "" },
+        {"job_size",           "Number of nodes in the job this endpoint is part of.",""},
+        {"logical_nid",        "My logical NID", "" },
+        {"use_nid_remap",      "If true, will remap logical nids in job to physical ids", "false" },
+        {"nid_map_name",       "Base name of shared region where my NID map will be located.  If empty, no NID map will be used.",""},
+        {"vn_remap",           "Not used, the flow network has no VNs.  Accepted for compatibility with merlin.linkcontrol.", "" },
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "packet_latency",     "Histogram of latencies for received packets", "latency", 1},
+        { "send_bit_count",     "Count number of bits sent on link", "bits", 1},
+    )
+
+    SST_ELI_DOCUMENT_PORTS(
+        {"rtr_port", "Port that connects to the flow network", { "merlin.RtrEvent", "merlin.credit_event", "" } },
+    )
+
+private:
+
+    // Link to flow network
+    Link* rtr_link;
+
+    UnitAlgebra link_bw;
+    int outbuf_bits;
+
+    // Initialization events received from network
+    std::deque<RtrEvent*> init_events;
+
+    int req_vns;
+
+    // Bits sent on each VN that have not yet left the endpoint
+    std::vector<int> outstanding_bits;
+
+    // Input queues.  Size is req_vns
+    std::vector<std::queue<RtrEvent*> > input_queues;
+
+    nid_t id;
+    nid_t logical_nid;
+    int job_id;
+    Shared::SharedArray<nid_t> nid_map;
+    bool use_nid_map;
+
+    bool network_initialized;
+
+    // Functors for notifying the parent when there is more space in
+    // output queue or when a new packet arrives
+    HandlerBase* receiveFunctor;
+    HandlerBase* sendFunctor;
+
+    Statistic<uint64_t>* packet_latency;
+    Statistic<uint64_t>* send_bit_count;
+
+    Output& output;
+
+public:
+    FlowLinkControl(ComponentId_t cid, Params &params, int vns);
+
+    ~FlowLinkControl();
+
+    void setup();
+    void init(unsigned int phase);
+    void complete(unsigned int phase);
+    void finish();
+
+    bool send(SST::Interfaces::SimpleNetwork::Request* req, int vn);
+    bool spaceToSend(int vn, int bits);
+    SST::Interfaces::SimpleNetwork::Request* recv(int vn);
+    bool requestToReceive( int vn ) { return ! input_queues[vn].empty(); }
+
+    void sendInitData(SST::Interfaces::SimpleNetwork::Request* ev);
+    SST::Interfaces::SimpleNetwork::Request* recvInitData();
+
+    void sendUntimedData(SST::Interfaces::SimpleNetwork::Request* ev);
+    SST::Interfaces::SimpleNetwork::Request* recvUntimedData();
+
+    inline void setNotifyOnReceive(HandlerBase* functor) { receiveFunctor = functor; }
+    inline void setNotifyOnSend(HandlerBase* functor) { sendFunctor = functor; }
+
+    inline bool isNetworkInitialized() const { return network_initialized; }
+    inline nid_t getEndpointID() const {
+        if ( use_nid_map ) {
+            return logical_nid;
+        }
+        else {
+            return id;
+        }
+    }
+    inline const UnitAlgebra& getLinkBW() const { return link_bw; }
+
+private:
+    void handle_input(Event* ev);
+    void handleUntimedData();
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_FLOW_FLOWLINKCONTROL_H
@@ -0,0 +1,478 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+#include <sst_config.h>
+#include "flowNetwork.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#include "sst/elements/merlin/merlin.h"
+
+using namespace SST;
+using namespace SST::Merlin;
+
+// Bits are considered sent once fewer than this many remain, to
+// absorb rounding in the rate * time updates
+static const double flow_done_bits = 1e-3;
+
+static UnitAlgebra
+getBandwidth(const std::string& name, const std::string& value)
+{
+    UnitAlgebra bw(value);
+    if ( !bw.hasUnits("B/s") && !bw.hasUnits("b/s") ) {
+        merlin_abort.fatal(CALL_INFO,1,"Error: %s must be specified in either B/s or b/s (SI prefix also allowed)\n",
+                           name.c_str());
+    }
+    if ( bw.hasUnits("B/s") ) {
+        bw *= UnitAlgebra("8b/B");
+    }
+    return bw;
+}
+
+static SimTime_t
+getLatencyPs(const std::string& name, const std::string& value)
+{
+    UnitAlgebra lat(value);
+    if ( !lat.hasUnits("s") ) {
+        merlin_abort.fatal(CALL_INFO,1,"Error: %s must be specified in s (SI prefix also allowed)\n",
+                           name.c_str());
+    }
+    return (lat / UnitAlgebra("1ps")).getRoundedValue();
+}
+
+// Bandwidth in bits per ps
+static double
+bitsPerPs(const UnitAlgebra& bw)
+{
+    return bw.getDoubleValue() / 1.0e12;
+}
+
+
+FlowNetwork::FlowNetwork(ComponentId_t cid, Params& params) :
+    Component(cid),
+    topo(NULL),
+    timer(NULL),
+    last_update(0),
+    next_rate_update(0),
+    next_wakeup(std::numeric_limits<SimTime_t>::max()),
+    rates_dirty(false),
+    output(getSimulationOutput())
+{
+    num_ports = params.find<int>("num_ports", -1);
+    if ( num_ports <= 0 ) {
+        merlin_abort.fatal(CALL_INFO,-1,"flownetwork requires num_ports to be specified\n");
+    }
+
+    std::string topo_name = params.find<std::string>("topology");
+    Params topo_params = params.get_scoped_params("topology");
+    topo = FlowTopology::create(topo_name, topo_params, output);
+    if ( topo == NULL ) {
+        merlin_abort.fatal(CALL_INFO,-1,"flownetwork does not support topology '%s'\n", topo_name.c_str());
+    }
+    if ( topo->getNumEndpoints() != num_ports ) {
+        merlin_abort.fatal(CALL_INFO,-1,"flownetwork: topology %s has %d endpoints, but num_ports is %d\n",
+                           topo_name.c_str(), topo->getNumEndpoints(), num_ports);
+    }
+
+    // Bandwidths
+    std::string link_bw_s = params.find<std::string>("link_bw");
+    if ( link_bw_s == "" ) {
+        merlin_abort.fatal(CALL_INFO,-1,"flownetwork requires link_bw to be specified\n");
+    }
+    UnitAlgebra link_bw = getBandwidth("link_bw", link_bw_s);
+
+    std::string host_bw_s = params.find<std::string>("host_link_bw");
+    if ( host_bw_s == "" ) host_bw_s = params.find<std::string>("link_bw:host", link_bw_s);
+    host_link_bw = getBandwidth("host_link_bw", host_bw_s);
+
+    // Latencies
+    link_latency = getLatencyPs("link_latency", params.find<std::string>("link_latency", "0ns"));
+    std::string router_lat_s = params.find<std::string>("router_latency");
+    if ( router_lat_s == "" ) {
+        router_latency = getLatencyPs("input_latency", params.find<std::string>("input_latency", "0ns")) +
+            getLatencyPs("output_latency", params.find<std::string>("output_latency", "0ns"));
+    }
+    else {
+        router_latency = getLatencyPs("router_latency", router_lat_s);
+    }
+    update_interval = getLatencyPs("rate_update_interval", params.find<std::string>("rate_update_interval", "0ns"));
+
+    // Resources
+    int num_links = topo->getNumLinks();
+    num_resources = 2 * num_ports + num_links;
+    capacity.resize(num_resources);
+    for ( int i = 0; i < 2 * num_ports; i++ ) capacity[i] = bitsPerPs(host_link_bw);
+    for ( int i = 0; i < num_links; i++ ) {
+        capacity[2 * num_ports + i] = topo->getLinkWidth(i) * bitsPerPs(link_bw);
+    }
+
+    share_remaining.resize(num_resources);
+    share_count.assign(num_resources, 0);
+    flow_start.resize(num_resources);
+    flow_fill.resize(num_resources);
+
+    // Everything is timed in ps
+    registerTimeBase("1ps", true);
+
+    ports.resize(num_ports);
+    for ( int i = 0; i < num_ports; i++ ) {
+        std::string port_name = "port" + std::to_string(i);
+        ports[i] = configureLink(port_name, new Event::Handler<FlowNetwork,int>(this,&FlowNetwork::handle_input,i));
+    }
+
+    timer = configureSelfLink("flow_timer", new Event::Handler<FlowNetwork>(this,&FlowNetwork::handle_timer));
+
+    stat_flows = registerStatistic<uint64_t>("flows");
+    stat_rate_updates = registerStatistic<uint64_t>("rate_updates");
+    stat_active_flows = registerStatistic<uint64_t>("active_flows");
+}
+
+
+FlowNetwork::~FlowNetwork()
+{
+    for ( auto flow : active ) {
+        delete flow->ev;
+        delete flow;
+    }
+    for ( auto flow : free_flows ) delete flow;
+    delete topo;
+}
+
+
+void
+FlowNetwork::init(unsigned int phase)
+{
+    if ( phase == 0 ) {
+        // Tell each endpoint its ID and the link bandwidth.  IDs are
+        // the port numbers, which follow the merlin topology's
+        // endpoint numbering.
+        for ( int i = 0; i < num_ports; i++ ) {
+            if ( ports[i] == NULL ) continue;
+
+            RtrInitEvent* ev = new RtrInitEvent();
+            ev->command = RtrInitEvent::REPORT_ID;
+            ev->int_value = i;
+            ports[i]->sendUntimedData(ev);
+
+            ev = new RtrInitEvent();
+            ev->command = RtrInitEvent::REPORT_BW;
+            ev->ua_value = host_link_bw;
+            ports[i]->sendUntimedData(ev);
+        }
+    }
+
+    for ( int i = 0; i < num_ports; i++ ) {
+        if ( ports[i] != NULL ) forwardUntimedData(i);
+    }
+}
+
+
+void
+FlowNetwork::complete(unsigned int phase)
+{
+    for ( int i = 0; i < num_ports; i++ ) {
+        if ( ports[i] != NULL ) forwardUntimedData(i);
+    }
+}
+
+
+void
+FlowNetwork::forwardUntimedData(int port)
+{
+    Event* ev;
+    while ( ( ev = ports[port]->recvUntimedData() ) != NULL ) {
+        BaseRtrEvent* bev = static_cast<BaseRtrEvent*>(ev);
+        switch ( bev->getType() ) {
+        case BaseRtrEvent::INITIALIZATION:
+        {
+            // Link bandwidth is the min of the two sides
+            RtrInitEvent* init_ev = static_cast<RtrInitEvent*>(ev);
+            if ( init_ev->command == RtrInitEvent::REPORT_BW ) {
+                double bw = bitsPerPs(init_ev->ua_value);
+                if ( bw < capacity[2 * port] ) {
+                    capacity[2 * port] = bw;
+                    capacity[2 * port + 1] = bw;
+                }
+            }
+            delete ev;
+        }
+            break;
+        case BaseRtrEvent::PACKET:
+        {
+            RtrEvent* rev = static_cast<RtrEvent*>(ev);
+            int dest = rev->getDest();
+            if ( dest == INIT_BROADCAST_ADDR ) {
+                for ( int i = 0; i < num_ports; i++ ) {
+                    if ( i == port || ports[i] == NULL ) continue;
+                    ports[i]->sendUntimedData(rev->clone());
+                }
+                delete rev;
+            }
+            else {
+                if ( dest < 0 || dest >= num_ports || ports[dest] == NULL ) {
+                    merlin_abort.fatal(CALL_INFO,-1,"flownetwork: untimed data sent to invalid destination %d\n", dest);
+                }
+                ports[dest]->sendUntimedData(rev);
+            }
+        }
+            break;
+        default:
+            delete ev;
+            break;
+        }
+    }
+}
+
+
+void
+FlowNetwork::finish()
+{
+    for ( auto flow : active ) {
+        delete flow->ev;
+        free_flows.push_back(flow);
+    }
+    active.clear();
+}
+
+
+void
+FlowNetwork::handle_input(Event* ev, int port)
+{
+    BaseRtrEvent* bev = static_cast<BaseRtrEvent*>(ev);
+    if ( bev->getType() != BaseRtrEvent::PACKET ) {
+        // Endpoints have unbounded receive buffers, so nothing else
+        // is expected
+        delete ev;
+        return;
+    }
+
+    RtrEvent* rev = static_cast<RtrEvent*>(ev);
+    int dest = rev->getDest();
+    if ( dest < 0 || dest >= num_ports || ports[dest] == NULL ) {
+        merlin_abort.fatal(CALL_INFO,-1,"flownetwork: packet from %d sent to invalid destination %d\n", port, dest);
+    }
+
+    // Bring existing flows up to date before this one joins
+    advance();
+
+    Flow* flow;
+    if ( free_flows.empty() ) {
+        flow = new Flow();
+    }
+    else {
+        flow = free_flows.back();
+        free_flows.pop_back();
+    }
+
+    flow->ev = rev;
+    flow->src = port;
+    flow->dest = dest;
+    flow->remaining = rev->getSizeInBits();
+    flow->rate = 0;
+    flow->fixed = false;
+
+    flow->path.clear();
+    flow->path.push_back(2 * port);
+    size_t start = flow->path.size();
+    flow->routers = topo->route(port, dest, flow->path);
+    for ( size_t i = start; i < flow->path.size(); i++ ) flow->path[i] += 2 * num_ports;
+    flow->path.push_back(2 * dest + 1);
+
+    active.push_back(flow);
+    rates_dirty = true;
+
+    // Recompute the rates once all the flows arriving at this time
+    // have been added
+    scheduleWakeup();
+}
+
+
+void
+FlowNetwork::handle_timer(Event* ev)
+{
+    // The event is an empty event used just for timing.  Wakeups that
+    // were superseded by an earlier one still arrive, but advance()
+    // handles being called at any time.
+    SimTime_t now = getCurrentSimTime();
+    if ( now >= next_wakeup ) next_wakeup = std::numeric_limits<SimTime_t>::max();
+
+    advance();
+    if ( rates_dirty && now >= next_rate_update ) {
+        computeRates();
+        next_rate_update = now + update_interval;
+        // Flows that now finish before the next update
+        if ( update_interval > 0 ) finishFlows();
+    }
+    scheduleWakeup();
+}
+
+
+void
+FlowNetwork::advance()
+{
+    SimTime_t now = getCurrentSimTime();
+    if ( now > last_update ) {
+        double elapsed = now - last_update;
+        for ( auto flow : active ) flow->remaining -= flow->rate * elapsed;
+        last_update = now;
+    }
+    finishFlows();
+}
+
+
+void
+FlowNetwork::finishFlows()
+{
+    for ( size_t i = 0; i < active.size(); ) {
+        Flow* flow = active[i];
+        SimTime_t delay = 0;
+        if ( flow->remaining > flow_done_bits ) {
+            // Finish early if it would be done before the next
+            // update.  It still arrives at its exact finish time.
+            if ( flow->rate <= 0 || flow->remaining >= flow->rate * update_interval ) {
+                i++;
+                continue;
+            }
+            delay = std::ceil(flow->remaining / flow->rate);
+        }
+        // Remove by moving the last flow into this slot
+        active[i] = active.back();
+        active.pop_back();
+        finishFlow(flow, delay);
+    }
+}
+
+
+void
+FlowNetwork::finishFlow(Flow* flow, SimTime_t delay)
+{
+    RtrEvent* ev = flow->ev;
+
+    // The message has left the sender, so the space it was using in
+    // the output buffer can be reused
+    ports[flow->src]->send(delay, new credit_event(ev->getRouteVN(), ev->getSizeInBits()));
+
+    SimTime_t latency = flow->routers * router_latency + (flow->routers - 1) * link_latency;
+    ports[flow->dest]->send(delay + latency, ev);
+
+    stat_flows->addData(1);
+    rates_dirty = true;
+
+    flow->ev = NULL;
+    free_flows.push_back(flow);
+}
+
+
+// Max-min fair rates by progressive filling.  The resource with the
+// smallest fair share (remaining bandwidth / flows without a rate) is
+// the bottleneck for all its flows, which get that share.  Fixing a
+// flow's rate never lowers the share of any other resource, so the
+// heap is updated lazily: stale entries are pushed back with their
+// current share when popped.
+void
+FlowNetwork::computeRates()
+{
+    rates_dirty = false;
+    stat_rate_updates->addData(1);
+    stat_active_flows->addData(active.size());
+
+    if ( active.empty() ) return;
+
+    // Count flows on each resource
+    for ( auto flow : active ) {
+        flow->fixed = false;
+        for ( int r : flow->path ) {
+            if ( share_count[r]++ == 0 ) touched.push_back(r);
+        }
+    }
+
+    // Group the flows by resource
+    int total = 0;
+    for ( int r : touched ) {
+        flow_start[r] = total;
+        flow_fill[r] = total;
+        total += share_count[r];
+        share_remaining[r] = capacity[r];
+    }
+    resource_flows.resize(total);
+    for ( auto flow : active ) {
+        for ( int r : flow->path ) resource_flows[flow_fill[r]++] = flow;
+    }
+
+    typedef std::greater<std::pair<double,int> > min_heap;
+    heap.clear();
+    for ( int r : touched ) heap.push_back(std::make_pair(share_remaining[r] / share_count[r], r));
+    std::make_heap(heap.begin(), heap.end(), min_heap());
+
+    while ( !heap.empty() ) {
+        std::pop_heap(heap.begin(), heap.end(), min_heap());
+        std::pair<double,int> entry = heap.back();
+        heap.pop_back();
+
+        int r = entry.second;
+        if ( share_count[r] == 0 ) continue;
+
+        double share = share_remaining[r] / share_count[r];
+        if ( share > entry.first ) {
+            heap.push_back(std::make_pair(share, r));
+            std::push_heap(heap.begin(), heap.end(), min_heap());
+            continue;
+        }
+        if ( share < 0 ) share = 0;
+
+        for ( int i = flow_start[r]; i < flow_fill[r]; i++ ) {
+            Flow* flow = resource_flows[i];
+            if ( flow->fixed ) continue;
+            flow->fixed = true;
+            flow->rate = share;
+            for ( int q : flow->path ) {
+                share_remaining[q] -= share;
+                share_count[q]--;
+            }
+        }
+    }
+
+    touched.clear();
+}
+
+
+void
+FlowNetwork::scheduleWakeup()
+{
+    SimTime_t now = getCurrentSimTime();
+    SimTime_t wakeup = std::numeric_limits<SimTime_t>::max();
+
+    // Next rate update
+    if ( rates_dirty && !active.empty() ) {
+        wakeup = std::max(now, next_rate_update);
+    }
+
+    // Next flow to finish
+    for ( auto flow : active ) {
+        if ( flow->rate <= 0 ) continue;
+        double time = std::ceil(flow->remaining / flow->rate);
+        SimTime_t finish = now + (time < 1 ? 1 : (SimTime_t)time);
+        if ( finish < wakeup ) wakeup = finish;
+    }
+
+    if ( wakeup < next_wakeup ) {
+        timer->send(wakeup - now, NULL);
+        next_wakeup = wakeup;
+    }
+}
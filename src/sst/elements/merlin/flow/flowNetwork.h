@@ -0,0 +1,157 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_FLOW_FLOWNETWORK_H
+#define COMPONENTS_MERLIN_FLOW_FLOWNETWORK_H
+
+#include <sst/core/component.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/output.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <vector>
+
+#include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/flow/flowTopology.h"
+
+namespace SST {
+namespace Merlin {
+
+// Flow level model of a whole merlin network.  Every endpoint (using
+// merlin.flowlink as its SimpleNetwork) connects directly to this
+// component.  Each message is a flow across the endpoint's injection
+// link, the topology links on its route and the destination's
+// ejection link.  Link bandwidth is shared max-min fairly between the
+// flows using it, and rates are recomputed only when a flow starts or
+// finishes.  Once the last bit of a message is injected, it is
+// delivered after the fixed latency of the routers and links on its
+// route.
+class FlowNetwork : public Component {
+
+public:
+
+    SST_ELI_REGISTER_COMPONENT(
+        FlowNetwork,
+        "merlin",
+        "flownetwork",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Flow level model of a merlin network with max-min fair link sharing",
+        COMPONENT_CATEGORY_NETWORK)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"num_ports",          "Number of endpoints connected to the network."},
+        {"topology",           "Name of the merlin topology being modeled (merlin.torus, merlin.mesh, merlin.hyperx, merlin.fattree, merlin.dragonfly or merlin.singlerouter).  Parameters prefixed with topology. are passed to the topology model."},
+        {"link_bw",            "Bandwidth of the router to router links specified in either b/s or B/s (can include SI prefix)."},
+        {"host_link_bw",       "Bandwidth of the endpoint links specified in either b/s or B/s (can include SI prefix).  Defaults to link_bw:host, then link_bw.", ""},
+        {"link_latency",       "Latency of router to router links.  Specified in s (can include SI prefix).", "0ns"},
+        {"router_latency",     "Latency through a router.  Specified in s (can include SI prefix).  Defaults to input_latency + output_latency.", ""},
+        {"input_latency",      "Router input latency, used if router_latency is not set.", "0ns"},
+        {"output_latency",     "Router output latency, used if router_latency is not set.", "0ns"},
+        {"rate_update_interval", "Minimum time between flow rate updates.  Flows that finish within the interval are delivered at their exact finish time, but the bandwidth they free is not given to other flows until the next update.  With 0, rates are updated on every flow arrival and departure.", "0ns"}
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "flows",              "Number of messages carried by the network", "flows", 1},
+        { "rate_updates",       "Number of times flow rates were recomputed", "updates", 1},
+        { "active_flows",       "Number of flows sharing the network at each rate update", "flows", 1}
+    )
+
+    SST_ELI_DOCUMENT_PORTS(
+        {"port%(num_ports)d",  "Ports which connect to endpoints using merlin.flowlink.", { "merlin.RtrEvent", "merlin.credit_event" } }
+    )
+
+private:
+
+    struct Flow {
+        RtrEvent* ev;
+        int src;
+        int dest;
+        int routers;
+        bool fixed;
+        double remaining;           // bits
+        double rate;                // bits per ps
+        std::vector<int> path;      // resources used
+    };
+
+    int num_ports;
+    FlowTopology* topo;
+
+    std::vector<Link*> ports;
+    Link* timer;
+
+    // Resources are the injection (2 * port) and ejection (2 * port + 1)
+    // links of each endpoint, followed by the topology links
+    int num_resources;
+    std::vector<double> capacity;   // bits per ps
+
+    UnitAlgebra host_link_bw;
+    SimTime_t router_latency;       // ps
+    SimTime_t link_latency;         // ps
+    SimTime_t update_interval;      // ps
+
+    std::vector<Flow*> active;
+    std::vector<Flow*> free_flows;
+
+    // Scratch space for the rate computation
+    std::vector<double> share_remaining;   // [resource] unallocated bandwidth
+    std::vector<int> share_count;          // [resource] flows without a rate
+    std::vector<int> flow_start;           // [resource] start in resource_flows
+    std::vector<int> flow_fill;
+    std::vector<int> touched;              // resources used by any flow
+    std::vector<Flow*> resource_flows;
+    std::vector<std::pair<double,int> > heap;
+
+    SimTime_t last_update;          // flows advanced to this time
+    SimTime_t next_rate_update;     // earliest time rates can be updated
+    SimTime_t next_wakeup;
+    bool rates_dirty;
+
+    Statistic<uint64_t>* stat_flows;
+    Statistic<uint64_t>* stat_rate_updates;
+    Statistic<uint64_t>* stat_active_flows;
+
+    Output& output;
+
+public:
+
+    FlowNetwork(ComponentId_t cid, Params& params);
+    ~FlowNetwork();
+
+    void init(unsigned int phase);
+    void complete(unsigned int phase);
+    void finish();
+
+private:
+
+    void handle_input(Event* ev, int port);
+    void handle_timer(Event* ev);
+
+    void forwardUntimedData(int port);
+
+    // Moves every flow forward to the current time and finishes the
+    // ones that are done or will be before the next rate update
+    void advance();
+    void finishFlows();
+    void computeRates();
+    void scheduleWakeup();
+    void finishFlow(Flow* flow, SimTime_t delay);
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_FLOW_FLOWNETWORK_H
@@ -0,0 +1,396 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+#include <sst_config.h>
+#include "flowTopology.h"
+
+#include <stdlib.h>
+
+using namespace SST::Merlin;
+
+void
+FlowTopology::parseDims(const std::string& str, char sep, std::vector<int>& dims)
+{
+    dims.clear();
+    size_t start = 0;
+    while ( true ) {
+        size_t end = str.find(sep, start);
+        dims.push_back(strtol(str.substr(start, end - start).c_str(), NULL, 0));
+        if ( end == std::string::npos ) break;
+        start = end + 1;
+    }
+}
+
+
+namespace {
+
+using namespace SST;
+using namespace SST::Merlin;
+
+// All endpoints on one router
+class FlowTopoSingle : public FlowTopology {
+    int num_ports;
+
+public:
+    FlowTopoSingle(Params& params) {
+        num_ports = params.find<int>("num_ports");
+    }
+
+    int getNumEndpoints() const { return num_ports; }
+    int getNumLinks() const { return 0; }
+    int getLinkWidth(int link) const { return 1; }
+    int route(int src, int dest, std::vector<int>& path) const { return 1; }
+};
+
+
+// Torus (wrap = true) or mesh, dimension order routed.  Each router
+// has a link in the positive and negative direction for each
+// dimension: link (router * dims + dim) * 2 + (negative ? 1 : 0)
+class FlowTopoGrid : public FlowTopology {
+    std::vector<int> dim_size;
+    std::vector<int> dim_width;
+    int local_ports;
+    int num_routers;
+    bool wrap;
+
+public:
+    FlowTopoGrid(Params& params, bool wrap, Output& output) :
+        wrap(wrap)
+    {
+        parseDims(params.find<std::string>("shape"), 'x', dim_size);
+        std::string width = params.find<std::string>("width", "");
+        if ( width.empty() ) dim_width.assign(dim_size.size(), 1);
+        else parseDims(width, 'x', dim_width);
+        if ( dim_width.size() != dim_size.size() ) {
+            output.fatal(CALL_INFO, -1, "flow model: width must have the same number of dimensions as shape\n");
+        }
+        local_ports = params.find<int>("local_ports", 1);
+
+        num_routers = 1;
+        for ( size_t i = 0; i < dim_size.size(); i++ ) num_routers *= dim_size[i];
+    }
+
+    int getNumEndpoints() const { return num_routers * local_ports; }
+    int getNumLinks() const { return num_routers * dim_size.size() * 2; }
+    int getLinkWidth(int link) const { return dim_width[(link / 2) % dim_size.size()]; }
+
+    int route(int src, int dest, std::vector<int>& path) const {
+        int dims = dim_size.size();
+        int src_rtr = src / local_ports;
+        int dest_rtr = dest / local_ports;
+
+        int routers = 1;
+        int rtr = src_rtr;
+        int stride = 1;
+        for ( int d = 0; d < dims; d++ ) {
+            int loc = (src_rtr / stride) % dim_size[d];
+            int dest_loc = (dest_rtr / stride) % dim_size[d];
+
+            int step;
+            int hops;
+            if ( wrap ) {
+                int dist_pos = dest_loc - loc;
+                if ( dist_pos < 0 ) dist_pos += dim_size[d];
+                int dist_neg = loc - dest_loc;
+                if ( dist_neg < 0 ) dist_neg += dim_size[d];
+                step = (dist_pos <= dist_neg) ? 1 : -1;
+                hops = (dist_pos <= dist_neg) ? dist_pos : dist_neg;
+            }
+            else {
+                step = (dest_loc >= loc) ? 1 : -1;
+                hops = (dest_loc >= loc) ? dest_loc - loc : loc - dest_loc;
+            }
+
+            for ( int i = 0; i < hops; i++ ) {
+                path.push_back((rtr * dims + d) * 2 + (step > 0 ? 0 : 1));
+                int next = loc + step;
+                if ( next == dim_size[d] ) next = 0;
+                else if ( next < 0 ) next = dim_size[d] - 1;
+                rtr += (next - loc) * stride;
+                loc = next;
+            }
+            routers += hops;
+            stride *= dim_size[d];
+        }
+        return routers;
+    }
+};
+
+
+// HyperX, dimension order routed.  Each router has a link to every
+// other router in each dimension: link router * sum(shape) +
+// dim_start[dim] + dest_location
+class FlowTopoHyperX : public FlowTopology {
+    std::vector<int> dim_size;
+    std::vector<int> dim_width;
+    std::vector<int> dim_start;
+    int links_per_router;
+    int local_ports;
+    int num_routers;
+
+public:
+    FlowTopoHyperX(Params& params, Output& output) {
+        parseDims(params.find<std::string>("shape"), 'x', dim_size);
+        std::string width = params.find<std::string>("width", "");
+        if ( width.empty() ) dim_width.assign(dim_size.size(), 1);
+        else parseDims(width, 'x', dim_width);
+        if ( dim_width.size() != dim_size.size() ) {
+            output.fatal(CALL_INFO, -1, "flow model: width must have the same number of dimensions as shape\n");
+        }
+        local_ports = params.find<int>("local_ports", 1);
+
+        num_routers = 1;
+        links_per_router = 0;
+        for ( size_t i = 0; i < dim_size.size(); i++ ) {
+            num_routers *= dim_size[i];
+            dim_start.push_back(links_per_router);
+            links_per_router += dim_size[i];
+        }
+    }
+
+    int getNumEndpoints() const { return num_routers * local_ports; }
+    int getNumLinks() const { return num_routers * links_per_router; }
+
+    int getLinkWidth(int link) const {
+        int offset = link % links_per_router;
+        int d = dim_size.size() - 1;
+        while ( dim_start[d] > offset ) d--;
+        return dim_width[d];
+    }
+
+    int route(int src, int dest, std::vector<int>& path) const {
+        int src_rtr = src / local_ports;
+        int dest_rtr = dest / local_ports;
+
+        int routers = 1;
+        int rtr = src_rtr;
+        int stride = 1;
+        for ( size_t d = 0; d < dim_size.size(); d++ ) {
+            int loc = (src_rtr / stride) % dim_size[d];
+            int dest_loc = (dest_rtr / stride) % dim_size[d];
+            if ( loc != dest_loc ) {
+                path.push_back(rtr * links_per_router + dim_start[d] + dest_loc);
+                rtr += (dest_loc - loc) * stride;
+                routers++;
+            }
+            stride *= dim_size[d];
+        }
+        return routers;
+    }
+};
+
+
+// Fattree.  The links into and out of each subtree are modeled as one
+// up and one down link per subtree, with the width of all the links
+// leaving the subtree's top level routers.
+class FlowTopoFatTree : public FlowTopology {
+    std::vector<int> hosts_below;   // [level] hosts under a subtree rooted at level
+    std::vector<int> up_start;      // [level] first up link id
+    std::vector<int> down_start;    // [level] first down link id
+    std::vector<int> width;         // [level] links out of each subtree
+    int total_hosts;
+    int num_links;
+
+public:
+    FlowTopoFatTree(Params& params, Output& output) {
+        std::string shape = params.find<std::string>("shape");
+        std::vector<std::string> levels;
+        size_t start = 0;
+        while ( true ) {
+            size_t end = shape.find(':', start);
+            levels.push_back(shape.substr(start, end - start));
+            if ( end == std::string::npos ) break;
+            start = end + 1;
+        }
+
+        std::vector<int> downs;
+        std::vector<int> ups;
+        for ( size_t i = 0; i < levels.size(); i++ ) {
+            std::vector<int> v;
+            parseDims(levels[i], ',', v);
+            downs.push_back(v[0]);
+            ups.push_back(v.size() > 1 ? v[1] : 0);
+        }
+
+        total_hosts = 1;
+        for ( size_t i = 0; i < downs.size(); i++ ) {
+            total_hosts *= downs[i];
+            hosts_below.push_back(total_hosts);
+        }
+
+        int routers = total_hosts / downs[0];
+        num_links = 0;
+        for ( size_t i = 0; i + 1 < downs.size(); i++ ) {
+            int groups = total_hosts / hosts_below[i];
+            up_start.push_back(num_links);
+            down_start.push_back(num_links + groups);
+            width.push_back((routers / groups) * ups[i]);
+            num_links += 2 * groups;
+            routers = routers * ups[i] / downs[i+1];
+        }
+    }
+
+    int getNumEndpoints() const { return total_hosts; }
+    int getNumLinks() const { return num_links; }
+
+    int getLinkWidth(int link) const {
+        int level = up_start.size() - 1;
+        while ( up_start[level] > link ) level--;
+        return width[level];
+    }
+
+    int route(int src, int dest, std::vector<int>& path) const {
+        int top = 0;
+        while ( src / hosts_below[top] != dest / hosts_below[top] ) top++;
+
+        for ( int i = 0; i < top; i++ ) {
+            path.push_back(up_start[i] + src / hosts_below[i]);
+        }
+        for ( int i = top - 1; i >= 0; i-- ) {
+            path.push_back(down_start[i] + dest / hosts_below[i]);
+        }
+        return 2 * top + 1;
+    }
+};
+
+
+// Dragonfly with minimal routing.  Every pair of routers in a group
+// has a local link: (group * a + src_router) * a + dest_router.
+// Global links are numbered after the local links by group, router
+// and global port, and are assigned to group pairs the same way the
+// merlin dragonfly does it (global_link_map and global_route_mode).
+class FlowTopoDragonfly : public FlowTopology {
+    int p;      // hosts per router
+    int a;      // routers per group
+    int g;      // groups
+    int h;      // global links per router
+    int n;      // links between each pair of groups
+    bool relative;
+
+    // [group_index * n + slice] router and global port
+    std::vector<std::pair<int,int> > global_ports;
+
+    int globalPortFor(int src_group, int dest_group, int slice, int& router) const {
+        int index;
+        if ( relative ) {
+            if ( dest_group > src_group ) index = dest_group - src_group - 1;
+            else index = g - src_group + dest_group - 1;
+        }
+        else {
+            index = dest_group >= src_group ? dest_group - 1 : dest_group;
+        }
+        const std::pair<int,int>& pp = global_ports[index * n + slice];
+        router = pp.first;
+        return pp.second;
+    }
+
+public:
+    FlowTopoDragonfly(Params& params, Output& output) {
+        p = params.find<int>("hosts_per_router");
+        a = params.find<int>("routers_per_group");
+        g = params.find<int>("num_groups");
+        n = params.find<int>("intergroup_links", 1);
+        h = params.find<int>("intergroup_per_router", ((g - 1) * n + a - 1) / a);
+
+        std::string mode = params.find<std::string>("global_route_mode",
+                                                    params.find<std::string>("global_routes", "absolute"));
+        if ( mode == "absolute" ) relative = false;
+        else if ( mode == "relative" ) relative = true;
+        else output.fatal(CALL_INFO, -1, "flow model: invalid global_route_mode specified: %s\n", mode.c_str());
+
+        if ( g < 2 ) return;
+
+        std::vector<int64_t> global_link_map;
+        params.find_array<int64_t>("global_link_map", global_link_map);
+        if ( global_link_map.empty() ) {
+            // Same default as the python dragonfly: links assigned in
+            // order, with the routers at the end of the group leaving
+            // their last global port empty if needed
+            int total = (g - 1) * n;
+            int start_skip = a - (h * a - total);
+            int count = 0;
+            global_link_map.assign(a * h, -1);
+            for ( int r = 0; r < a; r++ ) {
+                int end = r >= start_skip ? h - 1 : h;
+                for ( int k = 0; k < end; k++ ) global_link_map[r * h + k] = count++;
+            }
+        }
+
+        global_ports.assign((g - 1) * n, std::make_pair(0, 0));
+        for ( size_t i = 0; i < global_link_map.size(); i++ ) {
+            int64_t value = global_link_map[i];
+            if ( value == -1 ) continue;
+            int group_index = value % (g - 1);
+            int slice = value / (g - 1);
+            global_ports[group_index * n + slice] = std::make_pair((int)(i / h), (int)(i % h));
+        }
+    }
+
+    int getNumEndpoints() const { return g * a * p; }
+    int getNumLinks() const { return g * a * a + g * a * h; }
+    int getLinkWidth(int link) const { return 1; }
+
+    int route(int src, int dest, std::vector<int>& path) const {
+        int src_group = src / (a * p);
+        int src_rtr = (src / p) % a;
+        int dest_group = dest / (a * p);
+        int dest_rtr = (dest / p) % a;
+
+        if ( src_group == dest_group ) {
+            if ( src_rtr == dest_rtr ) return 1;
+            path.push_back((src_group * a + src_rtr) * a + dest_rtr);
+            return 2;
+        }
+
+        int slice = src % n;
+        int routers = 1;
+
+        int gw_rtr;
+        int gw_port = globalPortFor(src_group, dest_group, slice, gw_rtr);
+        if ( gw_rtr != src_rtr ) {
+            path.push_back((src_group * a + src_rtr) * a + gw_rtr);
+            routers++;
+        }
+        path.push_back(g * a * a + (src_group * a + gw_rtr) * h + gw_port);
+        routers++;
+
+        int far_rtr;
+        globalPortFor(dest_group, src_group, slice, far_rtr);
+        if ( far_rtr != dest_rtr ) {
+            path.push_back((dest_group * a + far_rtr) * a + dest_rtr);
+            routers++;
+        }
+        return routers;
+    }
+};
+
+}
+
+
+FlowTopology*
+FlowTopology::create(const std::string& name, Params& params, Output& output)
+{
+    std::string topo = name;
+    if ( topo.compare(0, 7, "merlin.") == 0 ) topo = topo.substr(7);
+
+    if ( topo == "singlerouter" ) return new FlowTopoSingle(params);
+    if ( topo == "torus" ) return new FlowTopoGrid(params, true, output);
+    if ( topo == "mesh" ) return new FlowTopoGrid(params, false, output);
+    if ( topo == "hyperx" ) return new FlowTopoHyperX(params, output);
+    if ( topo == "fattree" ) return new FlowTopoFatTree(params, output);
+    if ( topo == "dragonfly" ) return new FlowTopoDragonfly(params, output);
+    return NULL;
+}
@@ -0,0 +1,67 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_FLOW_FLOWTOPOLOGY_H
+#define COMPONENTS_MERLIN_FLOW_FLOWTOPOLOGY_H
+
+#include <sst/core/output.h>
+#include <sst/core/params.h>
+
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+// Router to router connectivity of a merlin topology, as used by the
+// flow level network model.  Takes the same parameters as the merlin
+// topology it describes and numbers endpoints the same way.
+//
+// Parallel links between the same pair of routers are modeled as one
+// link with the combined bandwidth (width).  Routes are the minimal
+// deterministic routes of the merlin topology: dimension order for
+// torus, mesh and hyperx, up/down for fattree and minimal (using the
+// same global links) for dragonfly.  For fattree, the up links out of
+// each subtree are modeled as a single link, which assumes traffic is
+// spread evenly over them.
+class FlowTopology {
+public:
+    virtual ~FlowTopology() {}
+
+    // Creates the topology model for merlin topology name (e.g.,
+    // merlin.torus).  Returns NULL if the topology is not supported.
+    static FlowTopology* create(const std::string& name, Params& params, Output& output);
+
+    virtual int getNumEndpoints() const = 0;
+
+    // Router to router links are numbered 0 to getNumLinks()-1
+    virtual int getNumLinks() const = 0;
+
+    // Number of parallel physical links making up link
+    virtual int getLinkWidth(int link) const = 0;
+
+    // Appends the links used going from endpoint src to endpoint
+    // dest to path and returns the number of routers passed through
+    virtual int route(int src, int dest, std::vector<int>& path) const = 0;
+
+protected:
+    static void parseDims(const std::string& str, char sep, std::vector<int>& dims);
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_FLOW_FLOWTOPOLOGY_H
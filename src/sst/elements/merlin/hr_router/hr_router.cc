@@ -152,6 +152,8 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     num_vcs = 0;
     for ( int vcs : vcs_per_vn ) num_vcs += vcs;
 
+    if ( params.find<bool>("event_pool", false) ) EventPool::enable();
+
     // Check to see if remap is on
     vn_remap_shm = params.find<std::string>("vn_remap_shm","");
     if ( vn_remap_shm != "" ) {
@@ -276,12 +278,16 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     }
     params.enableVerify(true);
 
-    // Get the Xbar arbitration
-    std::string xbar_arb = params.find<std::string>("xbar_arb","merlin.xbar_arb_lru");
-
-    Params empty_params; // Empty params sent to subcomponents
-    arb =
-        loadAnonymousSubComponent<XbarArbitration>(xbar_arb, "XbarArb", 0, ComponentInfo::INSERT_STATS, empty_params);
+    // Get the Xbar arbitration.  Use the one in the XbarArb slot if
+    // there is one, otherwise load the one named by xbar_arb.
+    arb = loadUserSubComponent<XbarArbitration>("XbarArb", ComponentInfo::SHARE_NONE);
+    if ( !arb ) {
+        std::string xbar_arb = params.find<std::string>("xbar_arb","merlin.xbar_arb_lru");
+        Params arb_params = params.get_scoped_params("xbar_arb");
+        arb =
+            loadAnonymousSubComponent<XbarArbitration>(xbar_arb, "XbarArb", 0, ComponentInfo::INSERT_STATS, arb_params);
+    }
+    if ( arb->requiresNotification() ) xbar_notify = arb;
 
     my_clock_handler = new Clock::Handler<hr_router>(this,&hr_router::clock_handler);
     xbar_tc = registerClock( xbar_clock, my_clock_handler);
@@ -306,6 +312,10 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
         port_name = port_name + std::to_string(i);
         xbar_stalls[i] = registerStatistic<uint64_t>("xbar_stalls",port_name);
     }
+    event_pool_allocs = registerStatistic<uint64_t>("event_pool_allocs");
+    event_pool_hits = registerStatistic<uint64_t>("event_pool_hits");
+    event_pool_live_max = registerStatistic<uint64_t>("event_pool_live_max");
+    event_pool_live_at_finish = registerStatistic<uint64_t>("event_pool_live_at_finish");
 
     init_vcs();
 }
@@ -457,6 +467,15 @@ void hr_router::finish()
     	ports[i]->finish();
     }
 
+    // The counters belong to the thread, so only the first router or
+    // link control to finish on each thread records them
+    if ( EventPool::isEnabled() && EventPool::claimThreadReport() ) {
+        const EventPool::Counters& pool = EventPool::getCounters();
+        event_pool_allocs->addData(pool.requests);
+        event_pool_hits->addData(pool.hits);
+        event_pool_live_max->addData(pool.liveMax);
+        event_pool_live_at_finish->addData(pool.live);
+    }
 }
 
 void
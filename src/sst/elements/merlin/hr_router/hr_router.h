@@ -54,7 +54,7 @@ public:
         {"id",                 "ID of the router."},
         {"num_ports",          "Number of ports that the router has"},
         {"topology",           "Name of the topology subcomponent that should be loaded to control routing."},
-        {"xbar_arb",           "Arbitration unit to be used for crossbar.","merlin.xbar_arb_lru"},
+        {"xbar_arb",           "Arbitration unit to be used for crossbar if the XbarArb slot is not filled.  Parameters prefixed with xbar_arb. are passed to it.","merlin.xbar_arb_lru"},
         {"link_bw",            "Bandwidth of the links specified in either b/s or B/s (can include SI prefix)."},
         {"flit_size",          "Flit size specified in either b or B (can include SI prefix)."},
         {"xbar_bw",            "Bandwidth of the crossbar specified in either b/s or B/s (can include SI prefix)."},
@@ -68,6 +68,7 @@ public:
         {"num_vns",            "Number of VNs.","2"},
         {"vn_remap",           "Array that specifies the vn remapping for each node in the systsm."},
         {"vn_remap_shm",       "Name of shared memory region for vn remapping.  If empty, no remapping is done", ""},
+        {"event_pool",         "Recycle router events instead of freeing them.  Turning this on in any router or link control enables it for the whole simulation", "false"},
         {"debug",              "Turn on debugging for router. Set to 1 for on, 0 for off.", "0"}
     )
 
@@ -77,7 +78,11 @@ public:
         { "output_port_stalls", "Time output port is stalled (in units of core timebase)", "time in stalls", 1},
         { "xbar_stalls",        "Count number of cycles the xbar is stalled", "cycles", 1},
         { "idle_time",          "Amount of time spent idle for a given port", "units of core timebase", 1},
-        { "width_adj_count",    "Number of times that link width was increased or decreased", "width adjustment count", 1}
+        { "width_adj_count",    "Number of times that link width was increased or decreased", "width adjustment count", 1},
+        { "event_pool_allocs",  "With event_pool, events allocated by the thread this router runs on.  The pool is per thread, so this is recorded at end of simulation by only one router or link control per thread", "events", 3},
+        { "event_pool_hits",    "With event_pool, allocations on this thread served from recycled events.  Recorded once per thread", "events", 3},
+        { "event_pool_live_max","With event_pool, high-water mark of events allocated and not yet freed on this thread.  Recorded once per thread", "events", 3},
+        { "event_pool_live_at_finish","With event_pool, events still allocated on this thread at the end of simulation.  Recorded once per thread", "events", 3}
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -132,6 +137,10 @@ private:
 
     void init_vcs();
     Statistic<uint64_t>** xbar_stalls;
+    Statistic<uint64_t>* event_pool_allocs;
+    Statistic<uint64_t>* event_pool_hits;
+    Statistic<uint64_t>* event_pool_live_max;
+    Statistic<uint64_t>* event_pool_live_at_finish;
 
     Output& output;
 
@@ -0,0 +1,235 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_HR_ROUTER_XBAR_ARB_BITMASK_H
+#define COMPONENTS_HR_ROUTER_XBAR_ARB_BITMASK_H
+
+#include <sst/core/component.h>
+#include <sst/core/output.h>
+
+#include <stdint.h>
+#include <vector>
+
+#include "sst/elements/merlin/router.h"
+
+namespace SST {
+namespace Merlin {
+
+// Base class for arbitration units that track requests as bitmasks.
+//
+// The router tells the unit when an input VC goes between empty and
+// non-empty and when credits are returned to an output VC, so the
+// unit never has to look at VCs that have nothing to send.  It keeps:
+//
+//   - for each input port, a mask of the VCs that have a head event
+//   - a mask of the input ports that have any VC with a head event
+//   - for each output VC, the smallest packet (in flits) that was
+//     found not to fit.  Credits only go down until some are
+//     returned, so packets at least that large are skipped without
+//     asking the port again.
+//
+// Each cycle, collectRequests() turns this into a request matrix: a
+// mask of requesting inputs for each output and a mask of eligible VCs
+// for each input.  Derived classes do the allocation from there.
+class xbar_arb_bitmask : public XbarArbitration {
+
+protected:
+    int num_ports;
+    int num_vcs;
+    int port_words;    // 64-bit words in a mask of ports
+
+    // Incrementally maintained state
+    std::vector<uint64_t> vc_mask;          // [port] VCs with a head event
+    std::vector<uint64_t> active_ports;     // [port_words] ports with any head event
+    std::vector<int> blocked_flits;         // [port*num_vcs+vc] 0 if not blocked
+
+    // Rebuilt each cycle by collectRequests()
+    std::vector<uint64_t> out_requests;     // [port*port_words] inputs requesting each output
+    std::vector<uint64_t> requested_outputs;// [port_words] outputs with any request
+    std::vector<uint64_t> requesting_inputs;// [port_words] inputs with any eligible VC
+    std::vector<uint64_t> eligible_vcs;     // [port] VCs that can move this cycle
+    std::vector<int> vc_next_port;          // [port*num_vcs+vc] output for each eligible VC
+    std::vector<int> vc_flits;              // [port*num_vcs+vc] size of each eligible VC's head
+
+public:
+
+    xbar_arb_bitmask(ComponentId_t cid) :
+        XbarArbitration(cid),
+        num_ports(0),
+        num_vcs(0),
+        port_words(0)
+    {}
+
+    virtual ~xbar_arb_bitmask() {}
+
+    bool requiresNotification() { return true; }
+
+    void vcHeadChanged(int port, int vc, bool has_head) {
+        if ( has_head ) {
+            vc_mask[port] |= (uint64_t)1 << vc;
+            setBit(active_ports.data(), port);
+        }
+        else {
+            vc_mask[port] &= ~((uint64_t)1 << vc);
+            if ( vc_mask[port] == 0 ) clearBit(active_ports.data(), port);
+        }
+    }
+
+    void creditsReturned(int port, int vc) {
+        blocked_flits[port * num_vcs + vc] = 0;
+    }
+
+    virtual void setPorts(int num_ports_s, int num_vcs_s) {
+        num_ports = num_ports_s;
+        num_vcs = num_vcs_s;
+        port_words = (num_ports + 63) / 64;
+
+        if ( num_vcs > 64 ) {
+            Output& out = getSimulationOutput();
+            out.fatal(CALL_INFO, -1, "%s supports at most 64 VCs per port, router has %d\n",
+                      getName().c_str(), num_vcs);
+        }
+
+        vc_mask.assign(num_ports, 0);
+        active_ports.assign(port_words, 0);
+        blocked_flits.assign(num_ports * num_vcs, 0);
+
+        out_requests.assign(num_ports * port_words, 0);
+        requested_outputs.assign(port_words, 0);
+        requesting_inputs.assign(port_words, 0);
+        eligible_vcs.assign(num_ports, 0);
+        vc_next_port.assign(num_ports * num_vcs, -1);
+        vc_flits.assign(num_ports * num_vcs, 0);
+    }
+
+protected:
+
+    static inline void setBit(uint64_t* mask, int bit) {
+        mask[bit >> 6] |= (uint64_t)1 << (bit & 63);
+    }
+
+    static inline void clearBit(uint64_t* mask, int bit) {
+        mask[bit >> 6] &= ~((uint64_t)1 << (bit & 63));
+    }
+
+    // Returns the first set bit in the circular order start, start+1,
+    // ..., words*64-1, 0, ..., start-1, or -1 if no bits are set.
+    // Bits past the number of ports are never set.
+    static inline int nextSetBit(const uint64_t* mask, int words, int start) {
+        int word = start >> 6;
+        uint64_t bits = mask[word] & (~(uint64_t)0 << (start & 63));
+        if ( bits ) return (word << 6) + __builtin_ctzll(bits);
+        for ( int i = 1; i <= words; i++ ) {
+            word = (word + 1 == words) ? 0 : word + 1;
+            bits = mask[word];
+            if ( bits ) return (word << 6) + __builtin_ctzll(bits);
+        }
+        return -1;
+    }
+
+    // Same as nextSetBit() for a single word
+    static inline int nextSetBit(uint64_t mask, int start) {
+        uint64_t bits = mask & (~(uint64_t)0 << start);
+        if ( bits ) return __builtin_ctzll(bits);
+        if ( mask ) return __builtin_ctzll(mask);
+        return -1;
+    }
+
+    // Build the request matrix for this cycle.  A VC is eligible if
+    // its input port is not busy, the output port its head event is
+    // routed to is not busy and the output VC has room for the event.
+    // Sets progress_vc to -1 for every port, then to -2 for ports that
+    // have events but no eligible VC.  Returns the number of inputs
+    // with an eligible VC.
+    int collectRequests(PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc) {
+        for ( int i = 0; i < num_ports; i++ ) progress_vc[i] = -1;
+
+        int requesting = 0;
+        for ( int w = 0; w < port_words; w++ ) {
+            uint64_t active = active_ports[w];
+            while ( active ) {
+                int port = (w << 6) + __builtin_ctzll(active);
+                active &= active - 1;
+
+                if ( in_port_busy[port] > 0 ) continue;
+
+                internal_router_event** vc_heads = ports[port]->getVCHeads();
+                uint64_t eligible = 0;
+                uint64_t vcs = vc_mask[port];
+                while ( vcs ) {
+                    int vc = __builtin_ctzll(vcs);
+                    vcs &= vcs - 1;
+
+                    internal_router_event* src_event = vc_heads[vc];
+                    int next_port = src_event->getNextPort();
+                    if ( out_port_busy[next_port] > 0 ) continue;
+
+                    int next_vc = src_event->getVC();
+                    int flits = src_event->getFlitCount();
+                    int& blocked = blocked_flits[next_port * num_vcs + next_vc];
+                    if ( blocked != 0 && flits >= blocked ) continue;
+                    if ( !ports[next_port]->spaceToSend(next_vc, flits) ) {
+                        blocked = flits;
+                        continue;
+                    }
+
+                    eligible |= (uint64_t)1 << vc;
+                    vc_next_port[port * num_vcs + vc] = next_port;
+                    vc_flits[port * num_vcs + vc] = flits;
+                    setBit(&out_requests[next_port * port_words], port);
+                    setBit(requested_outputs.data(), next_port);
+                }
+
+                eligible_vcs[port] = eligible;
+                if ( eligible ) {
+                    setBit(requesting_inputs.data(), port);
+                    requesting++;
+                }
+                else {
+                    progress_vc[port] = -2;
+                }
+            }
+        }
+        return requesting;
+    }
+
+    // Clear the per cycle request state left by collectRequests()
+    void clearRequests() {
+        for ( int w = 0; w < port_words; w++ ) {
+            uint64_t outs = requested_outputs[w];
+            while ( outs ) {
+                int out = (w << 6) + __builtin_ctzll(outs);
+                outs &= outs - 1;
+                for ( int i = 0; i < port_words; i++ ) out_requests[out * port_words + i] = 0;
+            }
+            requested_outputs[w] = 0;
+            requesting_inputs[w] = 0;
+        }
+    }
+
+    // Move the head event of VC vc at input port to its output
+    inline void grant(int port, int vc, int* in_port_busy, int* out_port_busy, int* progress_vc) {
+        int flits = vc_flits[port * num_vcs + vc];
+        progress_vc[port] = vc;
+        in_port_busy[port] = flits;
+        out_port_busy[vc_next_port[port * num_vcs + vc]] = flits;
+    }
+};
+
+}
+}
+
+#endif // COMPONENTS_HR_ROUTER_XBAR_ARB_BITMASK_H
@@ -0,0 +1,206 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_HR_ROUTER_XBAR_ARB_ISLIP_H
+#define COMPONENTS_HR_ROUTER_XBAR_ARB_ISLIP_H
+
+#include <sst/core/component.h>
+
+#include <vector>
+
+#include "sst/elements/merlin/hr_router/xbar_arb_bitmask.h"
+
+namespace SST {
+namespace Merlin {
+
+// Separable input/output allocator in the style of iSLIP.  Each
+// iteration, every unmatched output grants the first requesting
+// unmatched input at or after its grant pointer, and every input that
+// received grants accepts the first granting output at or after its
+// accept pointer.  Pointers only move past a match made in the first
+// iteration, which keeps them from synchronizing.  Once an input is
+// matched with an output, the VC to move is picked round robin from
+// the input's VCs headed to that output.
+class xbar_arb_islip : public xbar_arb_bitmask {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        xbar_arb_islip,
+        "merlin",
+        "xbar_arb_islip",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "iSLIP style separable arbitration unit for hr_router using bitmask request tracking",
+        SST::Merlin::XbarArbitration)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"iterations", "Number of grant/accept iterations per cycle.", "2"}
+    )
+
+private:
+    int iterations;
+
+    std::vector<int> grant_ptr;             // [output] input with highest priority
+    std::vector<int> accept_ptr;            // [input] output with highest priority
+    std::vector<int> vc_ptr;                // [input] VC with highest priority
+
+    std::vector<uint64_t> matched_inputs;   // [port_words]
+    std::vector<uint64_t> matched_outputs;  // [port_words]
+    std::vector<uint64_t> granted_inputs;   // [port_words] inputs with grants this iteration
+    std::vector<uint64_t> in_grants;        // [port*port_words] outputs granting each input
+    std::vector<uint64_t> candidates;       // [port_words] scratch
+    std::vector<int> match_output;          // [input] output matched this cycle
+
+public:
+
+    xbar_arb_islip(ComponentId_t cid, Params& params) :
+        xbar_arb_bitmask(cid)
+    {
+        iterations = params.find<int>("iterations", 2);
+        if ( iterations < 1 ) iterations = 1;
+    }
+
+    ~xbar_arb_islip() {
+    }
+
+    void setPorts(int num_ports_s, int num_vcs_s) {
+        xbar_arb_bitmask::setPorts(num_ports_s, num_vcs_s);
+
+        grant_ptr.assign(num_ports, 0);
+        accept_ptr.assign(num_ports, 0);
+        vc_ptr.assign(num_ports, 0);
+
+        matched_inputs.assign(port_words, 0);
+        matched_outputs.assign(port_words, 0);
+        granted_inputs.assign(port_words, 0);
+        in_grants.assign(num_ports * port_words, 0);
+        candidates.assign(port_words, 0);
+        match_output.assign(num_ports, -1);
+    }
+
+    // Naming convention is from point of view of the xbar.  So,
+    // in_port_busy is >0 if someone is writing to that xbar port and
+    // out_port_busy is >0 if that xbar port being read.
+    void arbitrate(
+#if VERIFY_DECLOCKING
+                   PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc, bool clocking
+#else
+                   PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc
+#endif
+                   )
+    {
+        if ( collectRequests(ports, in_port_busy, out_port_busy, progress_vc) == 0 ) {
+            clearRequests();
+            return;
+        }
+
+        for ( int iter = 0; iter < iterations; iter++ ) {
+            // Grant: each unmatched output picks one unmatched input
+            bool any_grant = false;
+            for ( int w = 0; w < port_words; w++ ) {
+                uint64_t outs = requested_outputs[w] & ~matched_outputs[w];
+                while ( outs ) {
+                    int out = (w << 6) + __builtin_ctzll(outs);
+                    outs &= outs - 1;
+
+                    const uint64_t* reqs = &out_requests[out * port_words];
+                    bool any_req = false;
+                    for ( int i = 0; i < port_words; i++ ) {
+                        candidates[i] = reqs[i] & ~matched_inputs[i];
+                        any_req |= (candidates[i] != 0);
+                    }
+                    if ( !any_req ) continue;
+
+                    int in = nextSetBit(candidates.data(), port_words, grant_ptr[out]);
+                    setBit(&in_grants[in * port_words], out);
+                    setBit(granted_inputs.data(), in);
+                    any_grant = true;
+                }
+            }
+            if ( !any_grant ) break;
+
+            // Accept: each input with grants picks one output
+            for ( int w = 0; w < port_words; w++ ) {
+                uint64_t ins = granted_inputs[w];
+                granted_inputs[w] = 0;
+                while ( ins ) {
+                    int in = (w << 6) + __builtin_ctzll(ins);
+                    ins &= ins - 1;
+
+                    uint64_t* grants = &in_grants[in * port_words];
+                    int out = nextSetBit(grants, port_words, accept_ptr[in]);
+                    for ( int i = 0; i < port_words; i++ ) grants[i] = 0;
+
+                    setBit(matched_inputs.data(), in);
+                    setBit(matched_outputs.data(), out);
+                    match_output[in] = out;
+
+                    if ( iter == 0 ) {
+                        grant_ptr[out] = (in + 1 == num_ports) ? 0 : in + 1;
+                        accept_ptr[in] = (out + 1 == num_ports) ? 0 : out + 1;
+                    }
+                }
+            }
+        }
+
+        // Pick the VC for each matched input.  Inputs that had
+        // eligible VCs but were not matched are marked as stalled.
+        for ( int w = 0; w < port_words; w++ ) {
+            uint64_t stalled = requesting_inputs[w] & ~matched_inputs[w];
+            while ( stalled ) {
+                progress_vc[(w << 6) + __builtin_ctzll(stalled)] = -2;
+                stalled &= stalled - 1;
+            }
+
+            uint64_t ins = matched_inputs[w];
+            matched_inputs[w] = 0;
+            matched_outputs[w] = 0;
+            while ( ins ) {
+                int in = (w << 6) + __builtin_ctzll(ins);
+                ins &= ins - 1;
+
+                int out = match_output[in];
+                uint64_t vcs = 0;
+                uint64_t eligible = eligible_vcs[in];
+                while ( eligible ) {
+                    int vc = __builtin_ctzll(eligible);
+                    eligible &= eligible - 1;
+                    if ( vc_next_port[in * num_vcs + vc] == out ) vcs |= (uint64_t)1 << vc;
+                }
+
+                int vc = nextSetBit(vcs, vc_ptr[in]);
+                grant(in, vc, in_port_busy, out_port_busy, progress_vc);
+                vc_ptr[in] = (vc + 1 == num_vcs) ? 0 : vc + 1;
+            }
+        }
+
+        clearRequests();
+    }
+
+    void dumpState(std::ostream& stream) {
+        stream << "  iSLIP iterations: " << iterations << std::endl;
+        stream << "  Pointers by port (grant, accept, vc):" << std::endl;
+        for ( int i = 0; i < num_ports; i++ ) {
+            stream << i << ": " << grant_ptr[i] << ", " << accept_ptr[i] << ", " << vc_ptr[i] << std::endl;
+        }
+    }
+
+};
+
+}
+}
+
+#endif // COMPONENTS_HR_ROUTER_XBAR_ARB_ISLIP_H
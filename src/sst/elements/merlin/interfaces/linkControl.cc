@@ -51,6 +51,8 @@ LinkControl::LinkControl(ComponentId_t cid, Params &params, int vns) :
         link_bw *= UnitAlgebra("8b/B");
     }
 
+    if ( params.find<bool>("event_pool", false) ) EventPool::enable();
+
     // Get the buffer sizes
     inbuf_size = params.find<UnitAlgebra>("input_buf_size","1kB");
     if ( !inbuf_size.hasUnits("b") && !inbuf_size.hasUnits("B") ) {
@@ -148,6 +150,10 @@ LinkControl::LinkControl(ComponentId_t cid, Params &params, int vns) :
     output_port_stalls = registerStatistic<uint64_t>("output_port_stalls");
     idle_time = registerStatistic<uint64_t>("idle_time");
     // recv_bit_count = registerStatistic<uint64_t>("recv_bit_count");
+    event_pool_allocs = registerStatistic<uint64_t>("event_pool_allocs");
+    event_pool_hits = registerStatistic<uint64_t>("event_pool_hits");
+    event_pool_live_max = registerStatistic<uint64_t>("event_pool_live_max");
+    event_pool_live_at_finish = registerStatistic<uint64_t>("event_pool_live_at_finish");
 
     last_time = 0;
     last_recv_time = 0;
@@ -402,6 +408,16 @@ void LinkControl::finish(void)
         is_idle = false;
     }
 
+    // The counters belong to the thread, so only the first router or
+    // link control to finish on each thread records them
+    if ( EventPool::isEnabled() && EventPool::claimThreadReport() ) {
+        const EventPool::Counters& pool = EventPool::getCounters();
+        event_pool_allocs->addData(pool.requests);
+        event_pool_hits->addData(pool.hits);
+        event_pool_live_max->addData(pool.liveMax);
+        event_pool_live_at_finish->addData(pool.live);
+    }
+
     // Clean up all the events left in the queues.  This will help
     // track down real memory leaks as all this events won't be in the
     // way.
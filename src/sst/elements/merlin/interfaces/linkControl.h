@@ -68,6 +68,7 @@ public:
         {"use_nid_remap",      "If true, will remap logical nids in job to physical ids", "false" },
         {"nid_map_name",       "Base name of shared region where my NID map will be located.  If empty, no NID map will be used.",""},
         {"vn_remap",           "Remap VNs onto/off of the network.  If empty, no vn remapping is done", "" },
+        {"event_pool",         "Recycle router events instead of freeing them.  Turning this on in any router or link control enables it for the whole simulation", "false"},
 
     )
 
@@ -76,6 +77,10 @@ public:
         { "send_bit_count",     "Count number of bits sent on link", "bits", 1},
         { "output_port_stalls", "Time output port is stalled (in units of core timebase)", "time in stalls", 1},
         { "idle_time",          "Number of (in unites of core timebas) that port was idle", "time spent idle", 1},
+        { "event_pool_allocs",  "With event_pool, events allocated by the thread this link control runs on.  The pool is per thread, so this is recorded at end of simulation by only one router or link control per thread", "events", 3},
+        { "event_pool_hits",    "With event_pool, allocations on this thread served from recycled events.  Recorded once per thread", "events", 3},
+        { "event_pool_live_max","With event_pool, high-water mark of events allocated and not yet freed on this thread.  Recorded once per thread", "events", 3},
+        { "event_pool_live_at_finish","With event_pool, events still allocated on this thread at the end of simulation.  Recorded once per thread", "events", 3},
         // { "recv_bit_count",     "Count number of bits received on the link", "bits", 1},
     )
 
@@ -210,6 +215,10 @@ private:
     Statistic<uint64_t>* output_port_stalls;
     Statistic<uint64_t>* idle_time;
     Statistic<uint64_t>* recv_bit_count;
+    Statistic<uint64_t>* event_pool_allocs;
+    Statistic<uint64_t>* event_pool_hits;
+    Statistic<uint64_t>* event_pool_live_max;
+    Statistic<uint64_t>* event_pool_live_at_finish;
 
     RtrInitEvent* checkInitProtocol(Event* ev, RtrInitEvent::Commands command, uint32_t line, const char* file, const char* func);
 
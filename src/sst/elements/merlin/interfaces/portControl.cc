@@ -20,6 +20,8 @@
 #include "output_arb_basic.h"
 #include "output_arb_qos_multi.h"
 
+#include <algorithm>
+
 #define TRACK 0
 #define TRACK_ID 131
 #define TRACK_PORT 4
@@ -35,8 +37,8 @@ PortControl::recvCtrlEvent(CtrlRtrEvent* ev)
     // sending data.
     CongestionEvent* cev = static_cast<CongestionEvent*>(ev);
     int src = cev->getTarget();
-    auto cs = congestion_map.find(src);
-    if ( cs != congestion_map.end() ) cs->second.reported_done = true;
+    CongestionInfo* info = findCongestionInfo(src);
+    if ( info != nullptr ) info->reported_done = true;
 }
 
 void
@@ -122,6 +124,7 @@ PortControl::recv(int vc)
 	if ( input_buf[vc].empty() ) {
 	    vc_heads[vc] = NULL;
 	    parent->dec_vcs_with_data();
+	    parent->notifyVCHead(port_number, vc, false);
 	}
 	else {
         auto event = input_buf[vc].front();
@@ -160,8 +163,7 @@ PortControl::reportIncomingEvent(internal_router_event* ev)
 
     // Record the event
     int src = ev->getSrc();
-    auto cs = congestion_map.emplace(src,src);
-    CongestionInfo& info = cs.first->second;
+    CongestionInfo& info = addCongestionInfo(src);
 
     bool new_incast = false;
 
@@ -176,7 +178,7 @@ PortControl::reportIncomingEvent(internal_router_event* ev)
 
         // Set the expiration time
         info.expiration_time = getCurrentSimCycle() + (int)(cm_window_factor * ((current_incast + 1) * mtu_ser_time));
-        expiration_queue.push(&info);
+        scheduleExpiration(info);
     }
 
     info.count++;
@@ -209,17 +211,17 @@ PortControl::reportIncomingEvent(internal_router_event* ev)
         SimTime_t throttle_time = 4 * flit_ser_time * total_flits_incoming;
 
         // Send congestion notificaitons
-        for ( auto& x : congestion_map ) {
-            if ( current_incast > x.second.throttle && x.second.active ) {
+        forEachCongestionInfo([&](CongestionInfo& x) {
+            if ( current_incast > x.throttle && x.active ) {
                 CongestionEvent* cev = new CongestionEvent(0, topo->getEndpointID(port_number), current_incast,
-                                                           // x.second.throttle == 0 ? throttle_time : 0 );
+                                                           // x.throttle == 0 ? throttle_time : 0 );
                                                            throttle_time);
-                if ( x.second.throttle == 0 ) x.second.expiration_time += throttle_time;
-                cev->setEndpointDest(x.first);
+                if ( x.throttle == 0 ) x.expiration_time += throttle_time;
+                cev->setEndpointDest(x.src);
                 parent->sendCtrlEvent(cev);
-                x.second.throttle = current_incast;
+                x.throttle = current_incast;
             }
-        }
+        });
     }
 }
 
@@ -400,6 +402,11 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     cm_incast_threshold = params.find<int>("cm_incast_threshold", 6);
     cm_window_factor = 1.5;
 
+    expiration_wheel.resize(expiration_wheel_size);
+    expiration_tick = mtu_ser_time;
+    expiration_last_tick = 0;
+    expiration_pending = 0;
+
     // Register statistics
     std::string port_name("port");
     port_name = port_name + std::to_string(port_number);
@@ -532,6 +539,11 @@ PortControl::initVCs(int vns, int* vcs_per_vn, internal_router_event** vc_heads_
         port_ret_credits[i] = ibs.getRoundedValue();
         xbar_in_credits[i] = obs.getRoundedValue();
         port_out_credits[i] = 0;
+
+        // Every packet is at least one flit, so the credits bound
+        // the number of packets a buffer can hold
+        input_buf[i].reserve(port_ret_credits[i]);
+        output_buf[i].reserve(xbar_in_credits[i]);
     }
 
 
@@ -564,7 +576,7 @@ PortControl::setup() {
 	if (dlink_thresh >= 0) dynlink_timing->send(1,NULL);
     while ( init_events.size() ) {
         delete init_events.front();
-        init_events.pop_front();
+        init_events.pop();
     }
 }
 
@@ -786,7 +798,7 @@ PortControl::init(unsigned int phase) {
                     delete init_ev;
                 }
                 else {
-                    init_events.push_back(ev);
+                    init_events.push(ev);
                 }
             }
         }
@@ -801,7 +813,7 @@ PortControl::complete(unsigned int phase) {
 
     // Need to get all the init events
     while ( ( ev = port_link->recvInitData() ) != NULL ) {
-        init_events.push_back(ev);
+        init_events.push(ev);
     }
 }
 
@@ -830,7 +842,7 @@ PortControl::recvUntimedData()
 {
     if ( connected && init_events.size() ) {
         Event *ev = init_events.front();
-        init_events.pop_front();
+        init_events.pop();
         return ev;
     }
     else {
@@ -973,6 +985,7 @@ PortControl::handle_input_n2r(Event* ev)
             topo->route_packet(port_number, rtr_event->getVC(), rtr_event);
             vc_heads[curr_vc] = rtr_event;
             parent->inc_vcs_with_data();
+            parent->notifyVCHead(port_number, curr_vc, true);
 	    }
 
 	    if ( event->getTraceType() != SST::Interfaces::SimpleNetwork::Request::NONE ) {
@@ -1056,6 +1069,7 @@ PortControl::handle_input_r2r(Event* ev)
             topo->route_packet(port_number, event->getVC(), event);
             vc_heads[curr_vc] = event;
             parent->inc_vcs_with_data();
+            parent->notifyVCHead(port_number, curr_vc, true);
 	    }
 
 	    if ( event->getTraceType() != SimpleNetwork::Request::NONE ) {
@@ -1125,6 +1139,7 @@ PortControl::handle_output(Event* ev) {
 	    // Need to return credits to the output buffer
 	    int size = send_event->getFlitCount();
 	    xbar_in_credits[vc_to_send] += size;
+	    parent->notifyCreditsReturned(port_number, vc_to_send);
         if ( !oql_track_remote ) {
             if ( oql_track_port ) {
                 for ( int i = 0; i < num_vcs; ++i ) {
@@ -1326,26 +1341,26 @@ PortControl::updateCongestionState(internal_router_event* send_event)
     // Update the congestion state.  We react slightly differently
     // depending on if cm has been activated or not.
     int src = send_event->getSrc();
-    auto item = congestion_map.find(src);
-    if ( item != congestion_map.end() ) {
-        CongestionInfo& ci = item->second;
+    CongestionInfo* item = findCongestionInfo(src);
+    if ( item != nullptr ) {
+        CongestionInfo& ci = *item;
         ci.count--;
         ci.flit_count -= send_event->getFlitCount();
         if ( ci.active ) total_incast_flits -= send_event->getFlitCount();
 
         // If stream is inactive and count is zero, we remove it
         if ( ci.count == 0 && !ci.active ) {
-            congestion_map.erase(src);
+            removeCongestionInfo(src);
         }
     }
 
-    // Look through the expiration queue to see if some of the streams
+    // Look through the expiration wheel to see if some of the streams
     // have ended
     SimTime_t now = getCurrentSimCycle();
     int expired = 0;
-    while ( expiration_queue.size() != 0 && expiration_queue.top()->expiration_time <= now ) {
-        CongestionInfo* ci_exp = expiration_queue.top();
-        expiration_queue.pop();
+    collectExpired(now);
+    for ( int exp_src : expired_srcs ) {
+        CongestionInfo* ci_exp = &congestion_table[exp_src];
         bool remove = false;
 
         // If congestion management hasn't been activated and there
@@ -1362,9 +1377,9 @@ PortControl::updateCongestionState(internal_router_event* send_event)
                 remove = true;
             }
             else {
-                // Need to put this back in the queue at the new expiration time
+                // Need to put this back in the wheel at the new expiration time
                 ci_exp->expiration_time = expiration_time;
-                expiration_queue.push(ci_exp);
+                scheduleExpiration(*ci_exp);
             }
         }
 
@@ -1383,10 +1398,8 @@ PortControl::updateCongestionState(internal_router_event* send_event)
             // reaches zero.
             if ( ci_exp->count == 0 ) {
                 // Really time to go.  Remove this from the
-                // congestion_map.  This will invalidate the reference we
-                // have, so be careful.
-                int src = ci_exp->src;
-                congestion_map.erase(src);
+                // congestion_table.
+                removeCongestionInfo(exp_src);
             }
             else {
                 ci_exp->active = false;
@@ -1410,13 +1423,90 @@ PortControl::updateCongestionState(internal_router_event* send_event)
 
         // Need to send updates to the throttle information
         // Send congestion notificaitons
-        for ( auto& x : congestion_map ) {
-            if ( x.second.active ) {
+        forEachCongestionInfo([&](CongestionInfo& x) {
+            if ( x.active ) {
                 CongestionEvent* cev = new CongestionEvent(0, topo->getEndpointID(port_number), send_incast, 0 );
-                cev->setEndpointDest(x.first);
+                cev->setEndpointDest(x.src);
                 parent->sendCtrlEvent(cev);
-                x.second.throttle = send_incast;
+                x.throttle = send_incast;
+            }
+        });
+    }
+}
+
+PortControl::CongestionInfo&
+PortControl::addCongestionInfo(int src)
+{
+    if ( src >= (int)congestion_table.size() ) {
+        size_t size = congestion_table.size() * 2;
+        if ( size < (size_t)src + 1 ) size = src + 1;
+        congestion_table.resize(size);
+        congestion_valid.resize((size + 63) / 64, 0);
+    }
+    uint64_t bit = 1ull << (src & 63);
+    if ( !(congestion_valid[src >> 6] & bit) ) {
+        congestion_valid[src >> 6] |= bit;
+        congestion_table[src] = CongestionInfo(src);
+    }
+    return congestion_table[src];
+}
+
+void
+PortControl::removeCongestionInfo(int src)
+{
+    congestion_valid[src >> 6] &= ~(1ull << (src & 63));
+}
+
+void
+PortControl::scheduleExpiration(const CongestionInfo& info)
+{
+    expiration_wheel[(info.expiration_time / expiration_tick) % expiration_wheel_size].push_back(info.src);
+    expiration_pending++;
+}
+
+// Fills expired_srcs with the sources whose expiration time is at or
+// before now, in order of expiration time, and takes them out of the
+// wheel.
+void
+PortControl::collectExpired(SimTime_t now)
+{
+    expired_srcs.clear();
+    if ( expiration_pending == 0 ) return;
+
+    // Visit every slot that could hold a tick between the last visit
+    // and now.  The slot for the last visit is included because it
+    // may hold entries that expire later in the same tick.
+    SimTime_t now_tick = now / expiration_tick;
+    SimTime_t tick = expiration_last_tick;
+    if ( now_tick - tick >= expiration_wheel_size ) tick = now_tick - expiration_wheel_size + 1;
+    expiration_last_tick = now_tick;
+
+    for ( ; tick <= now_tick; tick++ ) {
+        int index = tick % expiration_wheel_size;
+        std::vector<int>& slot = expiration_wheel[index];
+        size_t keep = 0;
+        for ( size_t i = 0; i < slot.size(); i++ ) {
+            int src = slot[i];
+            SimTime_t expiration_time = congestion_table[src].expiration_time;
+            if ( expiration_time <= now ) {
+                expired_srcs.push_back(src);
+            }
+            else if ( (int)((expiration_time / expiration_tick) % expiration_wheel_size) == index ) {
+                slot[keep++] = src;
+            }
+            else {
+                // Expiration time was pushed out, move to new slot
+                expiration_wheel[(expiration_time / expiration_tick) % expiration_wheel_size].push_back(src);
             }
         }
+        slot.resize(keep);
     }
+    expiration_pending -= expired_srcs.size();
+
+    std::sort(expired_srcs.begin(), expired_srcs.end(), [this](int a, int b) {
+            const CongestionInfo& ca = congestion_table[a];
+            const CongestionInfo& cb = congestion_table[b];
+            if ( ca.expiration_time != cb.expiration_time ) return ca.expiration_time < cb.expiration_time;
+            return a < b;
+        });
 }
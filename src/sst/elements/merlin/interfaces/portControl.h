@@ -30,6 +30,7 @@
 #include <sst/core/statapi/stataccumulator.h>
 
 #include <cstring>
+#include <vector>
 
 #include "sst/elements/merlin/router.h"
 
@@ -110,7 +111,7 @@ private:
 	// Self link for disabling a port temporarily
 	Link* disable_timing;
 
-    std::deque<Event*> init_events;
+    RingQueue<Event*> init_events;
 
     int rtr_id;
     // Number of virtual channels
@@ -246,7 +247,7 @@ private:
 
     // For supporting congestion management
     struct CongestionInfo {
-        const int32_t  src;
+        int32_t  src;
         uint32_t  count;
         uint32_t  total_count;
         uint32_t  flit_count;
@@ -256,36 +257,10 @@ private:
         bool active;
         bool reported_done;
 
-        CongestionInfo(uint32_t src) : src(src), count(0), total_count(0), flit_count(0), throttle(0),last_seen(0), expiration_time(0), active(false), reported_done(false)  {}
+        CongestionInfo(uint32_t src = 0) : src(src), count(0), total_count(0), flit_count(0), throttle(0),last_seen(0), expiration_time(0), active(false), reported_done(false)  {}
 
     };
 
-    class congestion_info_expiration_pq_order {
-    public:
-        /** Compare based off pointers */
-        inline bool operator()(const CongestionInfo* lhs, const CongestionInfo* rhs) const {
-            return lhs->expiration_time > rhs->expiration_time;
-        }
-
-        /** Compare based off references */
-        inline bool operator()(const CongestionInfo& lhs, const CongestionInfo& rhs) const {
-            return lhs.expiration_time > rhs.expiration_time;
-        }
-    };
-
-    class congestion_info_src_set_order {
-    public:
-        /** Compare based off pointers */
-        inline bool operator()(const CongestionInfo* lhs, const CongestionInfo* rhs) const {
-            return lhs->src < rhs->src;
-        }
-
-        /** Compare based off references */
-        inline bool operator()(const CongestionInfo& lhs, const CongestionInfo& rhs) const {
-            return lhs.src < rhs.src;
-        }
-    };
-
     SimTime_t mtu_ser_time;
     SimTime_t flit_ser_time;
     bool enable_congestion_management;
@@ -295,8 +270,22 @@ private:
     int cm_pktsize_threshold;
     double cm_window_factor;
 
-    std::map<uint32_t,CongestionInfo> congestion_map;
-    std::priority_queue<CongestionInfo*, std::vector<CongestionInfo* >, congestion_info_expiration_pq_order> expiration_queue;
+    // Congestion state indexed by source endpoint id.  A bit is set in
+    // congestion_valid for each entry in use, which lets the entries
+    // be visited in source order.
+    std::vector<CongestionInfo> congestion_table;
+    std::vector<uint64_t> congestion_valid;
+
+    // Timing wheel holding the sources of active entries.  A source is
+    // in slot (expiration_time / expiration_tick) % wheel size.
+    // Entries whose expiration time moved are moved to their new slot
+    // when their old slot is next visited.
+    static const int expiration_wheel_size = 256;
+    std::vector<std::vector<int> > expiration_wheel;
+    SimTime_t expiration_tick;
+    SimTime_t expiration_last_tick;
+    int expiration_pending;
+    std::vector<int> expired_srcs;
     int current_incast;
     int total_flits_incoming;
     int total_incast_flits;
@@ -362,6 +351,28 @@ private:
 	uint64_t increaseActive();
 
     void updateCongestionState(internal_router_event* send_event);
+
+    inline CongestionInfo* findCongestionInfo(int src) {
+        if ( src < 0 || src >= (int)congestion_table.size() ) return nullptr;
+        if ( !(congestion_valid[src >> 6] & (1ull << (src & 63))) ) return nullptr;
+        return &congestion_table[src];
+    }
+    CongestionInfo& addCongestionInfo(int src);
+    void removeCongestionInfo(int src);
+    void scheduleExpiration(const CongestionInfo& info);
+    void collectExpired(SimTime_t now);
+
+    // Calls func on each entry in use in order of source id
+    template <typename F>
+    void forEachCongestionInfo(F func) {
+        for ( size_t w = 0; w < congestion_valid.size(); w++ ) {
+            uint64_t bits = congestion_valid[w];
+            while ( bits ) {
+                func(congestion_table[(w << 6) + __builtin_ctzll(bits)]);
+                bits &= bits - 1;
+            }
+        }
+    }
 };
 
 
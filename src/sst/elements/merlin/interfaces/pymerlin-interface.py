@@ -22,7 +22,7 @@ from sst.merlin.base import *
 class LinkControl(NetworkInterface):
     def __init__(self):
         NetworkInterface.__init__(self)
-        self._declareParams("params",["link_bw","input_buf_size","output_buf_size","vn_remap"])
+        self._declareParams("params",["link_bw","input_buf_size","output_buf_size","vn_remap","event_pool"])
         self._subscribeToPlatformParamSet("network_interface")
 
     # returns subcomp, port_name
@@ -42,6 +42,31 @@ class LinkControl(NetworkInterface):
         return sub,"rtr_port"
 
 
+# Network interface for endpoints in a topoFlow network.  Takes the
+# same parameters as LinkControl.
+class FlowLinkControl(NetworkInterface):
+    def __init__(self):
+        NetworkInterface.__init__(self)
+        self._declareParams("params",["link_bw","input_buf_size","output_buf_size","vn_remap"])
+        self._subscribeToPlatformParamSet("network_interface")
+
+    # returns subcomp, port_name
+    def build(self,comp,slot,slot_num,job_id,job_size,logical_nid,use_nid_remap = False):
+        if self._check_first_build():
+            set_name = "params_%s"%self._instance_name
+            sst.addGlobalParams(set_name, self._getGroupParams("params"))
+            sst.addGlobalParam(set_name,"job_id",job_id)
+            sst.addGlobalParam(set_name,"job_size",job_size)
+            sst.addGlobalParam(set_name,"use_nid_remap",use_nid_remap)
+
+
+        sub = comp.setSubComponent(slot,"merlin.flowlink",slot_num)
+        self._applyStatisticsSettings(sub)
+        sub.addGlobalParamSet("params_%s"%self._instance_name)
+        sub.addParam("logical_nid",logical_nid)
+        return sub,"rtr_port"
+
+
 class ReorderLinkControl(NetworkInterface):
     def __init__(self):
         NetworkInterface.__init__(self)
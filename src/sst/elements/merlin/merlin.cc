@@ -27,6 +27,7 @@
 #include "hr_router/xbar_arb_age.h"
 #include "hr_router/xbar_arb_rand.h"
 #include "hr_router/xbar_arb_lru_infx.h"
+#include "hr_router/xbar_arb_islip.h"
 
 #include "arbitration/single_arb_rr.h"
 #include "arbitration/single_arb_lru.h"
@@ -79,6 +80,10 @@ char pymerlin_topo_mesh[] = {
 #include "topology/pymerlin-topo-mesh.inc"
     0x00};
 
+char pymerlin_topo_flow[] = {
+#include "topology/pymerlin-topo-flow.inc"
+    0x00};
+
 class MerlinPyModule : public SSTElementPythonModule {
 public:
     MerlinPyModule(std::string library) :
@@ -94,6 +99,7 @@ public:
         primary_module->addSubModule("topology",pymerlin_topo_hyperx,"topology/pymerlin-topo-hyperx.py");
         primary_module->addSubModule("topology",pymerlin_topo_fattree,"topology/pymerlin-topo-fattree.py");
         primary_module->addSubModule("topology",pymerlin_topo_mesh,"topology/pymerlin-topo-mesh.py");
+        primary_module->addSubModule("topology",pymerlin_topo_flow,"topology/pymerlin-topo-flow.py");
     }
 
     SST_ELI_REGISTER_PYTHON_MODULE(
@@ -606,7 +606,7 @@ class TemplateBase(_AttributeManager):
 class Topology(TemplateBase):
     def __init__(self):
         TemplateBase.__init__(self)
-        self._declareClassVariables(["network_name","endPointLinks","built","router","_prefix"])
+        self._declareClassVariables(["network_name","endPointLinks","built","router","_prefix","partition","_partition_info"])
 
         self._prefix = ""
         self._lockVariable("_prefix")
@@ -651,6 +651,71 @@ class Topology(TemplateBase):
     def _instanceRouter(self,radix,rtr_id):
         return self.router.instanceRouter(self.getRouterNameForId(rtr_id), radix, rtr_id)
 
+    # Partitioning.  If partition is set to True, the topology assigns
+    # the rank and thread of each router and of the component each
+    # endpoint is loaded into, and selects the sst.self partitioner.
+    # Topologies give each router a position, ordered so that routers
+    # in the same group, pod or slab are next to each other, and the
+    # positions are split evenly across ranks and threads.  Endpoints
+    # are placed with their router, so only router to router links are
+    # cut.  Any other components in the simulation need to be given a
+    # rank by the user.
+    def _partitionStart(self,num_positions):
+        if not self.partition: return
+        sst.setProgramOption("partitioner","sst.self")
+        self._partition_info = { "positions" : num_positions,
+                                 "ranks" : sst.getMPIRankCount(),
+                                 "threads" : sst.getThreadCount(),
+                                 "links" : dict() }
+
+    def _getPartitionForPosition(self,position):
+        info = self._partition_info
+        part = position * info["ranks"] * info["threads"] // info["positions"]
+        return (part // info["threads"], part % info["threads"])
+
+    def _setRouterPartition(self,rtr,position):
+        if not self.partition: return
+        rank, thread = self._getPartitionForPosition(position)
+        rtr.setRank(rank,thread)
+
+    def _setEndpointPartition(self,ep,position):
+        if not self.partition: return
+        # Endpoints are usually the network interface subcomponent, so
+        # find the component it was loaded into
+        comp = sst.findComponentByName(ep.getFullName().split(":")[0])
+        rank, thread = self._getPartitionForPosition(position)
+        comp.setRank(rank,thread)
+
+    # Record one end of a router to router link
+    def _partitionLink(self,link,position):
+        if not self.partition: return
+        links = self._partition_info["links"]
+        # Keep a reference to the link so its id can't be reused
+        if id(link) not in links:
+            links[id(link)] = (link, [])
+        links[id(link)][1].append(self._getPartitionForPosition(position))
+
+    # Returns (links cut between ranks, links cut between threads on
+    # the same rank, total router to router links)
+    def getCutSize(self):
+        if not self._partition_info: return None
+        rank_cut = 0
+        thread_cut = 0
+        links = self._partition_info["links"].values()
+        for link, parts in links:
+            if parts[0][0] != parts[-1][0]:
+                rank_cut += 1
+            elif parts[0][1] != parts[-1][1]:
+                thread_cut += 1
+        return (rank_cut, thread_cut, len(links))
+
+    def _partitionReport(self):
+        if not self.partition: return
+        info = self._partition_info
+        rank_cut, thread_cut, total = self.getCutSize()
+        print("%s: partitioned onto %d ranks x %d threads, %d of %d router links cut between ranks, %d between threads"%
+              (self.getName(), info["ranks"], info["threads"], rank_cut, total, thread_cut))
+
 class NetworkInterface(TemplateBase):
     def __init__(self):
         TemplateBase.__init__(self)
@@ -710,7 +775,7 @@ class hr_router(RouterTemplate):
         RouterTemplate.__init__(self)
 
         self._declareParams("params",["link_bw","flit_size","xbar_bw","input_latency","output_latency","input_buf_size","output_buf_size",
-                                      "xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm"])
+                                      "xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm","event_pool"])
 
         self._declareParams("params",["qos_settings"],"portcontrol.arbitration.")
         self._declareParams("params",["output_arb", "enable_congestion_management", "cm_outstanding_threshold", "cm_incast_threshold"],"portcontrol.")
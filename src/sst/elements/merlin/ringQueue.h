@@ -0,0 +1,84 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_RINGQUEUE_H
+#define COMPONENTS_MERLIN_RINGQUEUE_H
+
+#include <cstddef>
+
+namespace SST {
+namespace Merlin {
+
+// FIFO stored in a power of two sized ring.  Has the subset of the
+// std::queue interface used by the router.  VC buffers are bounded by
+// their credits, so they are sized once with reserve() and never
+// reallocate; if a queue does fill up, it doubles in size.
+template <typename T>
+class RingQueue {
+public:
+    RingQueue() : data(nullptr), mask(0), head(0), count(0) {}
+    ~RingQueue() { delete[] data; }
+
+    RingQueue(const RingQueue&) = delete;
+    RingQueue& operator=(const RingQueue&) = delete;
+
+    // Make room for at least n entries
+    void reserve(size_t n) {
+        size_t capacity = 1;
+        while ( capacity < n ) capacity <<= 1;
+        if ( capacity > mask + 1 || data == nullptr ) resize(capacity);
+    }
+
+    inline bool empty() const { return count == 0; }
+    inline size_t size() const { return count; }
+    inline size_t capacity() const { return data == nullptr ? 0 : mask + 1; }
+
+    inline T& front() { return data[head]; }
+    inline const T& front() const { return data[head]; }
+
+    inline void push(const T& value) {
+        if ( data == nullptr || count > mask ) resize(data == nullptr ? 4 : (mask + 1) * 2);
+        data[(head + count) & mask] = value;
+        count++;
+    }
+
+    inline void pop() {
+        head = (head + 1) & mask;
+        count--;
+    }
+
+private:
+    T* data;
+    size_t mask;
+    size_t head;
+    size_t count;
+
+    void resize(size_t capacity) {
+        T* new_data = new T[capacity];
+        for ( size_t i = 0; i < count; i++ ) new_data[i] = data[(head + i) & mask];
+        delete[] data;
+        data = new_data;
+        mask = capacity - 1;
+        head = 0;
+    }
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_RINGQUEUE_H
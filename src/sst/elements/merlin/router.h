@@ -29,6 +29,9 @@
 
 #include <queue>
 
+#include "sst/elements/merlin/eventPool.h"
+#include "sst/elements/merlin/ringQueue.h"
+
 namespace SST {
 namespace Merlin {
 
@@ -39,6 +42,7 @@ const int INIT_BROADCAST_ADDR = -1;
 class TopologyEvent;
 class CtrlRtrEvent;
 class internal_router_event;
+class XbarArbitration;
 
 class Router : public Component {
 private:
@@ -50,12 +54,17 @@ protected:
 
     int vcs_with_data;
 
+    // Arbitration unit to tell about VC head and credit changes.
+    // NULL unless the unit asks for notifications.
+    XbarArbitration* xbar_notify;
+
 public:
 
     Router(ComponentId_t id) :
         Component(id),
         requestNotifyOnEvent(false),
-        vcs_with_data(0)
+        vcs_with_data(0),
+        xbar_notify(NULL)
     {}
 
     virtual ~Router() {}
@@ -68,6 +77,11 @@ public:
     inline void dec_vcs_with_data() { vcs_with_data--; }
     inline int get_vcs_with_data() { return vcs_with_data; }
 
+    // Called by ports when a VC's input queue goes between empty and
+    // non-empty and when credits come back to a VC's output buffer
+    inline void notifyVCHead(int port, int vc, bool has_head);
+    inline void notifyCreditsReturned(int port, int vc);
+
     virtual int const* getOutputBufferCredits() = 0;
     virtual void sendCtrlEvent(CtrlRtrEvent* ev, int port = -1) = 0;
     virtual void recvCtrlEvent(int port, CtrlRtrEvent* ev) = 0;
@@ -86,6 +100,10 @@ public:
 
     inline RtrEventType getType() const { return type; }
 
+    // All router events allocate through EventPool
+    static void* operator new(std::size_t size) { return EventPool::allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { EventPool::release(ptr, size); }
+
     void serialize_order(SST::Core::Serialization::serializer &ser)  override {
         Event::serialize_order(ser);
         ser & type;
@@ -564,7 +582,7 @@ public:
     // params are: parent router, router id, port number, topology object
     SST_ELI_REGISTER_SUBCOMPONENT_API(SST::Merlin::PortInterface, Router*, int, int, Topology*)
 
-    typedef std::queue<internal_router_event*> port_queue_t;
+    typedef RingQueue<internal_router_event*> port_queue_t;
     typedef std::queue<CtrlRtrEvent*> ctrl_queue_t;
 
     virtual void recvCtrlEvent(CtrlRtrEvent* ev) = 0;
@@ -650,8 +668,26 @@ public:
     virtual void reportSkippedCycles(Cycle_t cycles) {};
     virtual void dumpState(std::ostream& stream) {};
 
+    // Units that keep their own record of which VCs have events
+    // waiting return true.  The router will then call vcHeadChanged()
+    // whenever an input VC goes between empty and non-empty and
+    // creditsReturned() whenever an output VC gets credits back.
+    virtual bool requiresNotification() { return false; }
+    virtual void vcHeadChanged(int port, int vc, bool has_head) {}
+    virtual void creditsReturned(int port, int vc) {}
+
 };
 
+inline void Router::notifyVCHead(int port, int vc, bool has_head)
+{
+    if ( xbar_notify ) xbar_notify->vcHeadChanged(port, vc, has_head);
+}
+
+inline void Router::notifyCreditsReturned(int port, int vc)
+{
+    if ( xbar_notify ) xbar_notify->creditsReturned(port, vc);
+}
+
 }
 }
 
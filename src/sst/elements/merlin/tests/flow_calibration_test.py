@@ -0,0 +1,105 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2022 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2022, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Run another merlin test configuration with the flow level network
+# model in place of the routers.  Every LinkControl becomes a
+# FlowLinkControl with the same parameters and the topology is built
+# as a single merlin.flownetwork.  Both the sst.merlin.base style
+# configurations (System/topoFlow) and the older sst.merlin style ones
+# (topo.build() with sst.merlin._params) are supported.  The flow model
+# does not reproduce the flit level model cycle for cycle, so the
+# simulated time is compared against the reference file of the wrapped
+# configuration with a tolerance.
+#
+#   sst flow_calibration_test.py --model-options="--config=dragon_128_test.py"
+#   sst flow_calibration_test.py --model-options="--config=torus_64_test.py"
+
+import sst
+import sys
+import argparse
+import sst.merlin
+import sst.merlin.base
+import sst.merlin.interface
+from sst.merlin.topology import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--config", required=True, help="Test configuration to run")
+parser.add_argument("--rate_update_interval", default="10ns", help="Minimum time between flow rate updates")
+args = parser.parse_args()
+
+# Configurations import LinkControl by name, so swap in the flow
+# version before they run
+sst.merlin.interface.LinkControl = sst.merlin.interface.FlowLinkControl
+
+_setTopology = sst.merlin.base.System.setTopology
+def setTopology(self, topo, allocation_block_size = 1):
+    flow = topoFlow(topo)
+    flow.rate_update_interval = args.rate_update_interval
+    _setTopology(self, flow, allocation_block_size)
+sst.merlin.base.System.setTopology = setTopology
+
+# The older sst.merlin topologies build their routers directly, so
+# replace their build with one that creates the flow network from
+# sst.merlin._params and swaps merlin.linkcontrol for merlin.flowlink
+# in the endpoints
+class FlowNic(object):
+    def __init__(self, comp):
+        self._comp = comp
+
+    def __getattr__(self, name):
+        return getattr(self._comp, name)
+
+    def setSubComponent(self, slot, type, *args):
+        if type == "merlin.linkcontrol":
+            type = "merlin.flowlink"
+        return self._comp.setSubComponent(slot, type, *args)
+
+def buildFlow(self):
+    params = sst.merlin._params
+    topo_name = params["topology"]
+    prefix = topo_name[len("merlin."):] + "."
+    num_nodes = int(params["num_peers"])
+
+    net = sst.Component("flow_network", "merlin.flownetwork")
+    net.addParam("num_ports", num_nodes)
+    net.addParam("topology", topo_name)
+    net.addParam("link_latency", params["link_lat"])
+    net.addParam("rate_update_interval", args.rate_update_interval)
+    for key in ["link_bw", "input_latency", "output_latency"]:
+        if key in params:
+            net.addParam(key, params[key])
+    for key, value in params.items():
+        if key.startswith(prefix):
+            net.addParam("topology.%s"%key[len(prefix):], value)
+    if getattr(self, "global_link_map", None) is not None:
+        net.addParam("topology.global_link_map", self.global_link_map)
+
+    _Component = sst.Component
+    sst.Component = lambda name, type: FlowNic(_Component(name, type))
+    for i in range(num_nodes):
+        endpoint = self._getEndPoint(i)
+        if endpoint is None:
+            continue
+        (ep, port_name, latency) = endpoint.build(i, {})
+        if ep:
+            link = sst.Link("flow_link_%d"%i)
+            link.connect( (ep, port_name, latency), (net, "port%d"%i, latency) )
+    sst.Component = _Component
+
+for topo_class in [sst.merlin.topoTorus, sst.merlin.topoMesh, sst.merlin.topoHyperX,
+                   sst.merlin.topoFatTree, sst.merlin.topoDragonFly]:
+    topo_class.build = buildFlow
+
+sys.argv = [args.config]
+with open(args.config) as f:
+    exec(compile(f.read(), args.config, "exec"))
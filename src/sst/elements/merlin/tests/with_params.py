@@ -0,0 +1,114 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2022 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2022, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Run another merlin test configuration with some of its parameters
+# overridden.  --set applies to every component of the --type(s)
+# given, after the configuration has set its own parameters, so it
+# replaces any value the configuration chose.  --topology-set applies to
+# the topology: to every sst.merlin.topology object that declares the
+# parameter, or to the topology parameters of the older sst.merlin
+# style configurations.  Each override must match something in the
+# configuration.
+#
+#   sst with_params.py --model-options="--config=torus_64_test.py --type=merlin.hr_router --set=event_pool=1"
+#   sst with_params.py --model-options="--config=torus_64_test.py --topology-set=route_table=True"
+
+import sst
+import sys
+import ast
+import argparse
+import sst.merlin
+import sst.merlin.topology
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--config", required=True, help="Test configuration to run")
+parser.add_argument("--type", action="append", default=[], help="Component type to set parameters on")
+parser.add_argument("--set", action="append", default=[], metavar="KEY=VALUE", help="Parameter to set on components of the given types")
+parser.add_argument("--topology-set", action="append", default=[], metavar="KEY=VALUE", help="Attribute to set on the topology")
+args = parser.parse_args()
+
+def splitOverrides(overrides):
+    values = {}
+    for override in overrides:
+        key, sep, value = override.partition("=")
+        if not sep:
+            sys.exit("with_params.py: '{0}' is not of the form KEY=VALUE".format(override))
+        values[key] = value
+    return values
+
+params = splitOverrides(args.set)
+if params and not args.type:
+    sys.exit("with_params.py: --set needs at least one --type")
+
+# Topology attributes are python values (e.g., partition is tested for truth)
+topology_params = {}
+for key, value in splitOverrides(args.topology_set).items():
+    try:
+        topology_params[key] = ast.literal_eval(value)
+    except (ValueError, SyntaxError):
+        topology_params[key] = value
+
+# Remember the components to override once the configuration is done
+components = []
+_Component = sst.Component
+
+def OverrideComponent(name, type):
+    comp = _Component(name, type)
+    if type in args.type:
+        components.append(comp)
+    return comp
+
+sst.Component = OverrideComponent
+
+topology_applied = set()
+
+def overrideTopology(cls):
+    _init = cls.__init__
+    def init(self):
+        _init(self)
+        for key, value in topology_params.items():
+            try:
+                setattr(self, key, value)
+            except KeyError:
+                continue
+            topology_applied.add(key)
+    cls.__init__ = init
+
+# The older sst.merlin topologies pass their parameters to the routers'
+# topology subcomponents through _params.subsetWithRename()
+_subsetWithRename = sst.merlin.Params.subsetWithRename
+
+def subsetWithRename(self, keys):
+    ret = _subsetWithRename(self, keys)
+    ret.update(topology_params)
+    topology_applied.update(topology_params)
+    return ret
+
+if topology_params:
+    for topo in [sst.merlin.topology.topoFatTree, sst.merlin.topology.topoTorus, sst.merlin.topology.topoMesh,
+                 sst.merlin.topology.topoHyperX, sst.merlin.topology.topoDragonFly]:
+        overrideTopology(topo)
+    sst.merlin.Params.subsetWithRename = subsetWithRename
+
+sys.argv = [args.config]
+with open(args.config) as f:
+    exec(compile(f.read(), args.config, "exec"))
+
+if params and not components:
+    sys.exit("with_params.py: {0} has no components of type {1}".format(args.config, ", ".join(args.type)))
+for comp in components:
+    comp.addParams(params)
+
+for key in topology_params:
+    if key not in topology_applied:
+        sys.exit("with_params.py: no topology in {0} takes '{1}'".format(args.config, key))
@@ -0,0 +1,125 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2022 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2022, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Crossbar arbitration benchmark.  A single hr_router with one
+# test_nic on every port and every endpoint sending to every other
+# endpoint, so the crossbar is busy on most cycles.  Each endpoint
+# sends on one VN (id % vcs) and singlerouter uses one VC per VN, so
+# every port has traffic on all VCs.
+#
+# Run directly with sst to simulate one configuration:
+#
+#   sst xbar_arb_bench.py --model-options="--arb=islip --radix=64 --vcs=8"
+#
+# Run with python to compare the arbitration units.  This runs sst
+# for every arbitration unit and radix and reports crossbar cycles
+# simulated per second of wall clock time:
+#
+#   python xbar_arb_bench.py --radix 16 32 64 --vcs 8
+
+import argparse
+import re
+import subprocess
+import sys
+import time
+
+arbs = {
+    "rr" : "merlin.xbar_arb_rr",
+    "lru" : "merlin.xbar_arb_lru",
+    "age" : "merlin.xbar_arb_age",
+    "rand" : "merlin.xbar_arb_rand",
+    "islip" : "merlin.xbar_arb_islip",
+}
+
+xbar_freq_ghz = 1.0     # xbar_bw / flit_size below
+
+
+def build(args):
+    import sst
+
+    rtr = sst.Component("router", "merlin.hr_router")
+    rtr.addParams({
+        "id" : 0,
+        "num_ports" : args.radix,
+        "num_vns" : args.vcs,
+        "link_bw" : "8GB/s",
+        "xbar_bw" : "8GB/s",
+        "flit_size" : "8B",
+        "input_latency" : "10ns",
+        "output_latency" : "10ns",
+        "input_buf_size" : "1kB",
+        "output_buf_size" : "1kB",
+    })
+    rtr.setSubComponent("topology", "merlin.singlerouter")
+
+    arb = rtr.setSubComponent("XbarArb", arbs[args.arb])
+    if args.arb == "islip":
+        arb.addParam("iterations", args.iterations)
+
+    for i in range(args.radix):
+        nic = sst.Component("nic%d"%i, "merlin.test_nic")
+        nic.addParams({
+            "id" : i,
+            "num_peers" : args.radix,
+            "num_messages" : args.messages,
+            "message_size" : "64B",
+        })
+        iface = nic.setSubComponent("networkIF", "merlin.linkcontrol")
+        iface.addParams({
+            "link_bw" : "8GB/s",
+            "input_buf_size" : "1kB",
+            "output_buf_size" : "1kB",
+            "vn_remap" : [i % args.vcs],
+        })
+
+        link = sst.Link("link%d"%i)
+        link.connect( (iface, "rtr_port", "10ns"), (rtr, "port%d"%i, "10ns") )
+
+
+def sweep(args):
+    print("%-6s %6s %4s %10s %10s %14s" % ("arb", "radix", "vcs", "sim (us)", "wall (s)", "xbar cycles/s"))
+    for radix in args.radix:
+        for arb in args.arb:
+            opts = "--arb=%s --radix=%d --vcs=%d --messages=%d --iterations=%d" % (arb, radix, args.vcs, args.messages, args.iterations)
+            start = time.time()
+            out = subprocess.check_output([args.sst, sys.argv[0], "--model-options=" + opts], universal_newlines=True)
+            wall = time.time() - start
+
+            m = re.search(r"Simulation is complete, simulated time: ([0-9.]+) (\w+)", out)
+            if not m:
+                sys.exit("Could not find simulated time in output of %s" % opts)
+            scale = { "ps" : 1e-3, "ns" : 1.0, "us" : 1e3, "ms" : 1e6, "s" : 1e9 }
+            sim_ns = float(m.group(1)) * scale[m.group(2)]
+            print("%-6s %6d %4d %10.1f %10.2f %14.0f" % (arb, radix, args.vcs, sim_ns / 1000, wall, sim_ns * xbar_freq_ghz / wall))
+
+
+try:
+    import sst
+    in_sst = True
+except ImportError:
+    in_sst = False
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--messages", type=int, default=20, help="Messages sent to each peer")
+parser.add_argument("--iterations", type=int, default=2, help="Iterations for the islip unit")
+if in_sst:
+    parser.add_argument("--arb", default="islip", choices=sorted(arbs.keys()), help="Arbitration unit")
+    parser.add_argument("--radix", type=int, default=64, help="Number of router ports")
+    parser.add_argument("--vcs", type=int, default=8, help="Number of VCs")
+    build(parser.parse_args())
+else:
+    parser.add_argument("--arb", nargs="+", default=sorted(arbs.keys()), choices=sorted(arbs.keys()), help="Arbitration units to compare")
+    parser.add_argument("--radix", type=int, nargs="+", default=[16, 32, 64], help="Router radices to run")
+    parser.add_argument("--vcs", type=int, default=8, help="Number of VCs")
+    parser.add_argument("--sst", default="sst", help="sst executable")
+    sweep(parser.parse_args())
@@ -321,6 +321,22 @@ topo_dragonfly::topo_dragonfly(ComponentId_t cid, Params &p, int num_ports, int
 
     rng = new RNG::XORShiftRNG(rtr_id+1);
 
+    // The route table depends on the global link map, which is only
+    // readable once all routers are constructed, so it is built when
+    // the first packet is routed
+    use_route_table = p.find<bool>("route_table", false);
+    validate_route_table = p.find<bool>("route_table_validate", false);
+    if ( use_route_table ) {
+        // remote_router_table keeps router ids within a group in 16 bits
+        // and group_port_table keeps ports in 15
+        if ( params.a > 0x10000 ) {
+            output.fatal(CALL_INFO, -1, "route_table is not supported for groups with router ids above 65535 (%u routers per group)\n", params.a);
+        }
+        if ( num_ports > 0x7fff ) {
+            output.fatal(CALL_INFO, -1, "route_table is not supported for routers with more than 32767 ports\n");
+        }
+    }
+
     output.verbose(CALL_INFO, 1, 1, "%u:%u:  ID: %u   Params:  p = %u  a = %u  k = %u  h = %u  g = %u\n",
             group_id, router_id, rtr_id, params.p, params.a, params.k, params.h, params.g);
 }
@@ -456,7 +472,7 @@ void topo_dragonfly::route_ugal(int port, int vc, internal_router_event* ev)
             // Need to find the lowest weighted route.  Loop over all
             // the slices.
             int min_weight = std::numeric_limits<int>::max();
-            std::vector<std::pair<int,int> > min_ports;
+            min_ports.clear();
             for ( int i = 0; i < params.n; ++i ) {
                 // Direct routes
                 int weight;
@@ -582,7 +598,7 @@ void topo_dragonfly::route_ugal(int port, int vc, internal_router_event* ev)
         // Just routing through.  Need to look at all possible routes
         // to the dest group and pick the lowest weighted route
         int min_weight = std::numeric_limits<int>::max();
-        std::vector<std::pair<int,int> > min_ports;
+        min_ports.clear();
 
         // Look through all routes.  If the port is in current router,
         // weight with 1, other weight with 2
@@ -640,7 +656,7 @@ void topo_dragonfly::route_mina(int port, int vc, internal_router_event* ev)
             // the slices, looking only at minimal routes.  For now,
             // just weight all paths equally.
             int min_weight = std::numeric_limits<int>::max();
-            std::vector<std::pair<int,int> > min_ports;
+            min_ports.clear();
             for ( int i = 0; i < params.n; ++i ) {
 
                 // Direct routes
@@ -831,6 +847,7 @@ void topo_dragonfly::route_adaptive_local(int port, int vc, internal_router_even
 }
 
 void topo_dragonfly::route_packet(int port, int vc, internal_router_event* ev) {
+    if ( use_route_table && group_port_table.empty() ) build_route_table();
     int vn = ev->getVN();
     if ( vns[vn].algorithm == UGAL ) return route_ugal(port,vc,ev);
     if ( vns[vn].algorithm == MIN_A ) return route_mina(port,vc,ev);
@@ -1095,6 +1112,14 @@ int32_t topo_dragonfly::router_to_group(uint32_t group)
 int32_t topo_dragonfly::hops_to_router(uint32_t group, uint32_t router, uint32_t slice)
 {
     int hops = 1;
+    if ( !group_port_table.empty() ) {
+        // Only called for links that are not failed, so the port is
+        // global exactly when the link leaves from this router
+        if ( !is_port_global(group_port_table[group * params.n + slice]) ) hops++;
+        if ( remote_router_table[group * params.n + slice] != router ) hops++;
+        return hops;
+    }
+
     const RouterPortPair& pair = group_to_global_port.getRouterPortPair(group,slice);
     if ( pair.router != router_id ) hops++;
     const RouterPortPair& pair2 = group_to_global_port.getRouterPortPairForGroup(group, group_id, slice);
@@ -1104,6 +1129,68 @@ int32_t topo_dragonfly::hops_to_router(uint32_t group, uint32_t router, uint32_t
 
 /* returns local router port if group can't be reached from this router */
 int32_t topo_dragonfly::port_for_group(uint32_t group, uint32_t slice, int id)
+{
+    if ( group_port_table.empty() ) return compute_port_for_group(group, slice);
+    return group_port_table[group * params.n + slice];
+}
+
+void topo_dragonfly::build_route_table()
+{
+    group_port_table.resize(params.g * params.n, -1);
+    remote_router_table.resize(params.g * params.n, 0);
+    for ( uint32_t group = 0; group < params.g; group++ ) {
+        if ( group == group_id ) continue;
+        for ( uint32_t slice = 0; slice < params.n; slice++ ) {
+            group_port_table[group * params.n + slice] = compute_port_for_group(group, slice);
+            remote_router_table[group * params.n + slice] =
+                group_to_global_port.getRouterPortPairForGroup(group, group_id, slice).router;
+        }
+    }
+    if ( validate_route_table ) check_route_table();
+}
+
+// Look up the port for every (group, slice), and the hops over it to
+// every router in that group, with the tables and with them set aside,
+// and abort on the first difference
+void topo_dragonfly::check_route_table()
+{
+    std::vector<int32_t> computed;
+    std::vector<int16_t> port_table;
+    std::vector<uint16_t> router_table;
+
+    for ( int pass = 0; pass < 2; pass++ ) {
+        // First pass uses the global link map, second pass the tables
+        port_table.swap(group_port_table);
+        router_table.swap(remote_router_table);
+
+        size_t next = 0;
+        for ( uint32_t group = 0; group < params.g; group++ ) {
+            if ( group == group_id ) continue;
+            for ( uint32_t slice = 0; slice < params.n; slice++ ) {
+                int32_t port = port_for_group(group, slice);
+                if ( pass == 0 ) computed.push_back(port);
+                else if ( port != computed[next] ) {
+                    output.fatal(CALL_INFO, -1, "Route table mismatch in router %u for group %u, slice %u: table port %d, computed port %d\n",
+                                 rtr_id, group, slice, port, computed[next]);
+                }
+                next++;
+                if ( port == -1 ) continue;
+
+                for ( uint32_t router = 0; router < params.a; router++ ) {
+                    int32_t hops = hops_to_router(group, router, slice);
+                    if ( pass == 0 ) computed.push_back(hops);
+                    else if ( hops != computed[next] ) {
+                        output.fatal(CALL_INFO, -1, "Route table mismatch in router %u for group %u, router %u, slice %u: table hops %d, computed hops %d\n",
+                                     rtr_id, group, router, slice, hops, computed[next]);
+                    }
+                    next++;
+                }
+            }
+        }
+    }
+}
+
+int32_t topo_dragonfly::compute_port_for_group(uint32_t group, uint32_t slice)
 {
     const RouterPortPair& pair = group_to_global_port.getRouterPortPair(group,slice);
     if ( group_to_global_port.isFailedPort(pair) ) {
@@ -20,6 +20,7 @@
 #define COMPONENTS_MERLIN_TOPOLOGY_DRAGONFLY_H
 
 #include <algorithm>
+#include <vector>
 
 #include <sst/core/event.h>
 #include <sst/core/link.h>
@@ -208,6 +209,8 @@ public:
         {"global_route_mode",     "Mode for intepreting global link map [absolute (default) | relative].","absolute"},
         {"config_failed_links",   "Controls whether or not failed links are considered","False"},
         {"failed_links",          "List of global links to mark as failed.  Only needs to be passed to router 0. Format is \"group1:group2:slice\"",""},
+        {"route_table",           "Route to other groups from a per-router table built when the first packet is routed instead of looking up the global link map for each packet.", "false"},
+        {"route_table_validate",  "When the route table is built, check each group and slice against the global link map and abort on a mismatch.", "false"},
     )
 
     enum RouteAlgo {
@@ -239,6 +242,18 @@ public:
 
     global_route_mode_t global_route_mode;
 
+    // When route_table is set, for each (group, slice): the port that
+    // leads to that group over that slice (-1 if the link is failed),
+    // and the router in the destination group the link lands on.
+    // Indexed by group * params.n + slice.
+    bool use_route_table;
+    bool validate_route_table;
+    std::vector<int16_t> group_port_table;
+    std::vector<uint16_t> remote_router_table;
+
+    // Scratch space for the adaptive algorithms, reused across packets
+    std::vector<std::pair<int,int> > min_ports;
+
 public:
     struct dgnflyAddr {
         uint32_t group;
@@ -279,6 +294,9 @@ private:
     int32_t router_to_group(uint32_t group);
     int32_t port_for_router(uint32_t router);
     int32_t port_for_group(uint32_t group, uint32_t global_slice, int id = -1);
+    int32_t compute_port_for_group(uint32_t group, uint32_t global_slice);
+    void build_route_table();
+    void check_route_table();
     int32_t port_for_group_init(uint32_t group, uint32_t global_slice);
     int32_t hops_to_router(uint32_t group, uint32_t router, uint32_t slice);
 
@@ -144,7 +144,22 @@ topo_fattree::topo_fattree(ComponentId_t cid, Params& params, int num_ports, int
 
     low_host = level_group * rid;
     high_host = low_host + rid - 1;
-    
+
+    use_route_table = params.find<bool>("route_table", false);
+    if ( use_route_table ) {
+        if ( num_ports > 0xffff ) {
+            output.fatal(CALL_INFO, -1, "route_table is not supported for routers with more than 65535 ports\n");
+        }
+        route_table.resize(total_hosts);
+        for ( int dest = 0; dest < total_hosts; dest++ ) {
+            route_table[dest] = compute_deterministic_port(dest);
+        }
+        if ( params.find<bool>("route_table_validate", false) ) check_route_table();
+    }
+
+    delete[] ups;
+    delete[] downs;
+    delete[] routers_per_level;
 }
 
 
@@ -153,15 +168,44 @@ topo_fattree::~topo_fattree()
     delete[] vns;
 }
 
-void topo_fattree::route_deterministic(int port, int vc, internal_router_event* ev)  {
-    int dest = ev->getDest();
+int topo_fattree::compute_deterministic_port(int dest) const {
     // Down routes
     if ( dest >= low_host && dest <= high_host ) {
-        ev->setNextPort((dest - low_host) / down_route_factor);
+        return (dest - low_host) / down_route_factor;
     }
     // Up routes
     else {
-        ev->setNextPort(down_ports + ((dest/down_route_factor) % up_ports));
+        return down_ports + ((dest/down_route_factor) % up_ports);
+    }
+}
+
+void topo_fattree::route_deterministic(int port, int vc, internal_router_event* ev)  {
+    int dest = ev->getDest();
+    if ( !use_route_table ) {
+        ev->setNextPort(compute_deterministic_port(dest));
+        return;
+    }
+
+    ev->setNextPort(route_table[dest]);
+}
+
+// Route to every endpoint with the table and with it disabled and abort
+// on the first difference
+void topo_fattree::check_route_table()
+{
+    for ( int dest = 0; dest < (int)route_table.size(); dest++ ) {
+        internal_router_event computed(new RtrEvent(new SST::Interfaces::SimpleNetwork::Request(dest, 0, 0, true, true), 0, 0));
+        internal_router_event table(new RtrEvent(new SST::Interfaces::SimpleNetwork::Request(dest, 0, 0, true, true), 0, 0));
+
+        use_route_table = false;
+        route_deterministic(0, 0, &computed);
+        use_route_table = true;
+        route_deterministic(0, 0, &table);
+
+        if ( table.getNextPort() != computed.getNextPort() ) {
+            output.fatal(CALL_INFO, -1, "Route table mismatch in router %d for destination %d: table port %d, computed port %d\n",
+                         id, dest, table.getNextPort(), computed.getNextPort());
+        }
     }
 }
 
@@ -170,9 +214,8 @@ void topo_fattree::route_packet(int port, int vc, internal_router_event* ev)
 {
     route_deterministic(port,vc,ev);
     
-    int dest = ev->getDest();
     // Down routes are always deterministic and are already done in route
-    if ( dest >= low_host && dest <= high_host ) {
+    if ( ev->getNextPort() < down_ports ) {
         return;
     }
     // Up routes can be adaptive, so things can change from the normal path
@@ -232,7 +275,7 @@ void topo_fattree::routeInitData(int inPort, internal_router_event* ev, std::vec
         }
     }
     else {
-        route_deterministic(inPort, 0, ev);
+        ev->setNextPort(compute_deterministic_port(ev->getDest()));
         outPorts.push_back(ev->getNextPort());
     }
 }
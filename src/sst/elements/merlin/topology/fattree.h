@@ -22,6 +22,7 @@
 #include <sst/core/event.h>
 #include <sst/core/link.h>
 #include <sst/core/params.h>
+#include <vector>
 
 #include "sst/elements/merlin/router.h"
 
@@ -48,7 +49,9 @@ public:
 
         {"shape",               "Shape of the fattree"},
         {"routing_alg",         "Routing algorithm to use. [deterministic | adaptive]","deterministic"},
-        {"adaptive_threshold",  "Threshold used to determine if a packet will adaptively route."}
+        {"adaptive_threshold",  "Threshold used to determine if a packet will adaptively route."},
+        {"route_table",          "Route from a destination to port table built at startup instead of computing the route for each packet.", "false"},
+        {"route_table_validate", "At startup, route to every endpoint with and without the route table and abort if the ports differ.", "false"}
     )
 
 
@@ -82,6 +85,10 @@ private:
 
     vn_info* vns;
 
+    // Deterministic output port for each destination, when route_table is set
+    bool use_route_table;
+    std::vector<uint16_t> route_table;
+
     void parseShape(const std::string &shape, int *downs, int *ups) const;
 
 
@@ -109,6 +116,8 @@ public:
 
 private:
     void route_deterministic(int port, int vc, internal_router_event* ev);
+    int compute_deterministic_port(int dest) const;
+    void check_route_table();
 };
 
 
@@ -137,8 +137,11 @@ topo_hyperx::topo_hyperx(ComponentId_t cid, Params& params, int num_ports, int r
         total_routers *= dim_size[i];
     }
 
-    
-    
+    use_route_table = params.find<bool>("route_table", false);
+    if ( use_route_table ) {
+        build_route_table();
+        if ( params.find<bool>("route_table_validate", false) ) check_route_table();
+    }
 }
 
 topo_hyperx::~topo_hyperx()
@@ -207,6 +210,7 @@ topo_hyperx::process_input(RtrEvent* ev)
             mid = rng->generateNextUInt32() % total_routers;
         } while ( mid == router_id );
 
+        tt_ev->val_router = mid;
         idToLocation(mid, tt_ev->val_loc);
         tt_ev->val_route_dest = false;
     }
@@ -214,6 +218,7 @@ topo_hyperx::process_input(RtrEvent* ev)
     // Need to figure out what the hyperx address is for easier
     // routing.
     int rtr_id = get_dest_router(tt_ev->getDest());
+    tt_ev->dest_router = rtr_id;
     idToLocation(rtr_id, tt_ev->dest_loc);
 
 	return tt_ev;
@@ -265,6 +270,7 @@ internal_router_event* topo_hyperx::process_InitData_input(RtrEvent* ev)
     tt_ev->setVC(vns[tt_ev->getVN()].start_vc);
     if ( tt_ev->getDest() != INIT_BROADCAST_ADDR ) {
         int rtr_id = get_dest_router(tt_ev->getDest());
+        tt_ev->dest_router = rtr_id;
         idToLocation(rtr_id, tt_ev->dest_loc);
     }
     return tt_ev;
@@ -365,31 +371,114 @@ topo_hyperx::setOutputQueueLengthsArray(int const* array, int vcs)
 
 // Routing algorithms
 
+// Route tables hold the results of computeMinimalPort() and
+// computeDORBase() for every destination router.
+void
+topo_hyperx::build_route_table()
+{
+    if ( local_port_start + num_local_ports > 0x7fff ) {
+        output.fatal(CALL_INFO, -1, "route_table is not supported for routers with more than 32767 ports\n");
+    }
+    if ( dimensions > 0x7f ) {
+        output.fatal(CALL_INFO, -1, "route_table is not supported for more than 127 dimensions\n");
+    }
+
+    int* loc = new int[dimensions];
+    route_min_port.resize(total_routers * dimensions);
+    route_dor_dim.resize(total_routers);
+    for ( int r = 0; r < total_routers; ++r ) {
+        idToLocation(r, loc);
+        for ( int dim = 0; dim < dimensions; ++dim ) {
+            route_min_port[r * dimensions + dim] = computeMinimalPort(loc, dim);
+        }
+        route_dor_dim[r] = computeDORBase(loc).first;
+    }
+    delete[] loc;
+}
+
+// Look up the dimension order step and the minimal port in each
+// dimension for every router with the table and with it disabled, and
+// abort on the first difference.  These are the only lookups the
+// routing algorithms make in the table.
+void
+topo_hyperx::check_route_table()
+{
+    int* loc = new int[dimensions];
+    for ( int r = 0; r < total_routers; ++r ) {
+        idToLocation(r, loc);
+
+        use_route_table = false;
+        std::pair<int,int> computed = routeDORBase(r, loc);
+        use_route_table = true;
+        std::pair<int,int> table = routeDORBase(r, loc);
+        if ( table != computed ) {
+            output.fatal(CALL_INFO, -1, "Route table mismatch in router %d for router %d: table port %d (dim %d), computed port %d (dim %d)\n",
+                         router_id, r, table.second, table.first, computed.second, computed.first);
+        }
+
+        for ( int dim = 0; dim < dimensions; ++dim ) {
+            use_route_table = false;
+            int computed_port = minimalPort(r, loc, dim);
+            use_route_table = true;
+            int table_port = minimalPort(r, loc, dim);
+            if ( table_port != computed_port ) {
+                output.fatal(CALL_INFO, -1, "Route table mismatch in router %d for router %d, dimension %d: table port %d, computed port %d\n",
+                             router_id, r, dim, table_port, computed_port);
+            }
+        }
+    }
+    delete[] loc;
+}
+
+// Returns the first port of the minimal link(s) toward dest_loc in
+// the given dimension, or -1 if the dimension is aligned.
+int
+topo_hyperx::computeMinimalPort(const int* dest_loc, int dim) const
+{
+    if ( dest_loc[dim] == id_loc[dim] ) return -1;
+    // Get offset to the destination in this dimension
+    int offset = dest_loc[dim] - ((dest_loc[dim] > id_loc[dim]) ? 1 : 0);
+    return port_start[dim] + (offset * dim_width[dim]);
+}
+
+int
+topo_hyperx::minimalPort(int dest_router, const int* dest_loc, int dim)
+{
+    if ( !use_route_table ) return computeMinimalPort(dest_loc, dim);
+
+    return route_min_port[dest_router * dimensions + dim];
+}
+
 // This will return the first port for the correct next router.
 // Multipath configurations will need to chose the multipath based on
 // the result.  ret.first is the dimension of the port, ret.second is
 // the first port as described above.  Will return -1 in ret.first if
 // destination is same as router.
 std::pair<int,int>
-topo_hyperx::routeDORBase(int* dest_loc) {
+topo_hyperx::computeDORBase(const int* dest_loc) const {
     // Will ignore VCs and just tell you the next port to for minimal
     // dimension order routing to dest_loc
 
     for ( int dim = 0 ; dim < dimensions ; ++dim ) {
         // Find first unaligned dimension and route to align it
         if ( dest_loc[dim] != id_loc[dim] ) {
-            // Get offset to the first unaligned dimension
-            int offset = dest_loc[dim] - ((dest_loc[dim] > id_loc[dim]) ? 1 : 0);
-            offset *= dim_width[dim];
-            return std::make_pair(dim,port_start[dim] + offset);
+            return std::make_pair(dim,computeMinimalPort(dest_loc, dim));
         }
     }
     return std::make_pair(-1,-1);
 }
 
+std::pair<int,int>
+topo_hyperx::routeDORBase(int dest_router, const int* dest_loc) {
+    if ( !use_route_table ) return computeDORBase(dest_loc);
+
+    int dim = route_dor_dim[dest_router];
+    return std::pair<int,int>(dim, dim == -1 ? -1 : route_min_port[dest_router * dimensions + dim]);
+}
+
 void
 topo_hyperx::routeDOR(int port, int vc, topo_hyperx_event* ev) {
-    std::pair<int,int> next_port = routeDORBase(ev->dest_loc);
+    std::pair<int,int> next_port = routeDORBase(ev->dest_router, ev->dest_loc);
 
     if ( next_port.first == -1 ) {
         ev->setNextPort(get_dest_local_port(ev->getDest()));
@@ -405,7 +494,7 @@ topo_hyperx::routeDOR(int port, int vc, topo_hyperx_event* ev) {
 
 void
 topo_hyperx::routeDORND(int port, int vc, topo_hyperx_event* ev) {
-    std::pair<int,int> next_port = routeDORBase(ev->dest_loc);
+    std::pair<int,int> next_port = routeDORBase(ev->dest_router, ev->dest_loc);
 
     if ( next_port.first == -1 ) {
         ev->setNextPort(get_dest_local_port(ev->getDest()));
@@ -437,7 +526,7 @@ topo_hyperx::routeValiant(int port, int vc, topo_hyperx_event* ev) {
     int next_vc = vc;
     if ( !ev->val_route_dest ) {
         // Still headed toward valiant mid-point
-        std::pair<int,int> next_port = routeDORBase(ev->val_loc);
+        std::pair<int,int> next_port = routeDORBase(ev->val_router, ev->val_loc);
         if ( next_port.first == -1 ) {
             // Made it to valiant midpoint
             ev->val_route_dest = true;
@@ -453,7 +542,7 @@ topo_hyperx::routeValiant(int port, int vc, topo_hyperx_event* ev) {
 
     // Made it to the valiant route (or the function has already
     // returned), so just route minimally to dest
-    std::pair<int,int> next_port = routeDORBase(ev->dest_loc);
+    std::pair<int,int> next_port = routeDORBase(ev->dest_router, ev->dest_loc);
     if ( next_port.first == -1 ) {
         ev->setNextPort(get_dest_local_port(ev->getDest()));
         ev->setVC(vc);
@@ -469,88 +558,72 @@ void
 topo_hyperx::routeDOAL(int port, int vc, topo_hyperx_event* ev) {
     // We still have to go in dimension order, but we can adaptively
     // route once in each dimension.
-    int dest_router = get_dest_router(ev->getDest());
-    if ( dest_router == router_id ) {
+    if ( ev->dest_router == router_id ) {
         ev->setNextPort(get_dest_local_port(ev->getDest()));
+        return;
     }
-    else {
-        for ( int dim = 0 ; dim < dimensions ; dim++ ) {
-            if ( ev->dest_loc[dim] == id_loc[dim] ) continue;
-
-            // Found the dimension to route in.  See if we have
-            // already adaptively routed, if so, then we have to go
-            // direct for this dimension
-            if ( ( vc - vns[ev->getVN()].start_vc ) == 1 ) {
-                // Get offset in the dimension
-                int offset = ev->dest_loc[dim] - ((ev->dest_loc[dim] > id_loc[dim]) ? 1 : 0);
-                offset *= dim_width[dim];
-                
-                // Choose the least loaded route to the next router
-                int min = 0x7FFFFFFF;
-                int min_port;
-                
-                for ( int p = port_start[dim] + offset; p < port_start[dim] + offset + dim_width[dim]; ++p ) {
-                    int weight = output_queue_lengths[p * num_vcs + vc];
-                    if ( weight < min ) {
-                        min = weight;
-                        min_port = p;
-                    }
-                }
 
-                ev->setNextPort(min_port);
-                ev->setVC(vc - 1);
+    // Find the dimension to route in.
+    std::pair<int,int> dor = routeDORBase(ev->dest_router, ev->dest_loc);
+    int dim = dor.first;
+    int min_start = dor.second;
+
+    // See if we have already adaptively routed, if so, then we have
+    // to go direct for this dimension
+    if ( ( vc - vns[ev->getVN()].start_vc ) == 1 ) {
+        // Choose the least loaded route to the next router
+        int min = 0x7FFFFFFF;
+        int min_port;
+
+        for ( int p = min_start; p < min_start + dim_width[dim]; ++p ) {
+            int weight = output_queue_lengths[p * num_vcs + vc];
+            if ( weight < min ) {
+                min = weight;
+                min_port = p;
+            }
+        }
 
-                ev->last_routing_dim = dim;
-                break;
+        ev->setNextPort(min_port);
+        ev->setVC(vc - 1);
+
+        ev->last_routing_dim = dim;
+    }
+    else {
+        // Just entered this dimension, we can adaptively
+        // route.  Need to find out which link is best to
+        // take.  Weight all non-minimal links by multiplying
+        // by 2 and keep the port with the lowest value
+        int min_port = 0;
+        int min_weight = 0x7fffffff;
+        int min_vc = vc;
+        for ( int curr_port = port_start[dim]; curr_port < port_start[dim] + ((dim_size[dim] - 1) * dim_width[dim]); ++curr_port  ) {
+            // See if this is a minimal route
+            if ( curr_port >= min_start && curr_port < min_start + dim_width[dim] ) {
+                // This is a minimal route.  We would use VC 0
+                // in the VN, which is the VC the packet came
+                // in on
+                int weight = output_queue_lengths[curr_port * num_vcs + vc];
+                if ( weight < min_weight ) {
+                    min_weight = weight;
+                    min_port = curr_port;
+                    min_vc = vc;
+                }
             }
             else {
-                // Just entered this dimension, we can adaptively
-                // route.  Need to find out which link is best to
-                // take.  Weight all non-minimal links by multiplying
-                // by 2 and keep the port with the lowest value
-                int min_port = 0;
-                int min_weight = 0x7fffffff;
-                int min_vc = vc;
-                for ( int curr_port = port_start[dim]; curr_port < port_start[dim] + ((dim_size[dim] - 1) * dim_width[dim]); ++curr_port  ) {
-                    // See if this is a minimal route
-                    
-                    // Compute the base offset in this dimension for
-                    // the minimal route (this is essentially what the
-                    // offset would be if the width in this dimension
-                    // is 1).
-                    int offset = ev->dest_loc[dim] - ((ev->dest_loc[dim] > id_loc[dim]) ? 1 : 0);
-                    
-                    // Now get the actual starting port for the minimal link(s)
-                    offset = port_start[dim] + ( offset * dim_width[dim]);
-                    if ( curr_port >= offset && curr_port < offset + dim_width[dim] ) {
-                        // This is a minimal route.  We would use VC 0
-                        // in the VN, which is the VC the packet came
-                        // in on
-                        int weight = output_queue_lengths[curr_port * num_vcs + vc];
-                        if ( weight < min_weight ) {
-                            min_weight = weight;
-                            min_port = curr_port;
-                            min_vc = vc;
-                        }
-                    }
-                    else {
-                        // This is a non-minimal route.  We would use
-                        // VC 1 in the VN, which is one greater than
-                        // the VC the packet came in on
-                        int weight = 2 * output_queue_lengths[curr_port * num_vcs + vc + 1] + 1;
-                        if ( weight < min_weight ) {
-                            min_weight = weight;
-                            min_port = curr_port;
-                            min_vc = vc + 1;
-                        }
-                    }
+                // This is a non-minimal route.  We would use
+                // VC 1 in the VN, which is one greater than
+                // the VC the packet came in on
+                int weight = 2 * output_queue_lengths[curr_port * num_vcs + vc + 1] + 1;
+                if ( weight < min_weight ) {
+                    min_weight = weight;
+                    min_port = curr_port;
+                    min_vc = vc + 1;
                 }
-                // Route on the minimally weighted port
-                ev->setNextPort(min_port);
-                ev->setVC(min_vc);
-                break;
             }
         }
+        // Route on the minimally weighted port
+        ev->setNextPort(min_port);
+        ev->setVC(min_vc);
     }
 }
 
@@ -559,8 +632,7 @@ void
 topo_hyperx::routeMINA(int port, int vc, topo_hyperx_event* ev) {
 
     // Check to see if we made it to the dest router
-    int dest_router = get_dest_router(ev->getDest());
-    if ( dest_router == router_id ) {
+    if ( ev->dest_router == router_id ) {
         ev->setNextPort(get_dest_local_port(ev->getDest()));
         return;
     }
@@ -576,11 +648,9 @@ topo_hyperx::routeMINA(int port, int vc, topo_hyperx_event* ev) {
     int min_weight = 0x7fffffff;;
     int min_port = -1;
     for ( int dim = 0; dim < dimensions; ++dim ) {
-        if ( ev->dest_loc[dim] == id_loc[dim] ) continue;
-
         // Find the minimum weight, minimally-routed port
-        int offset = ev->dest_loc[dim] - ((ev->dest_loc[dim] > id_loc[dim]) ? 1 : 0);
-        offset = port_start[dim] + (offset * dim_width[dim]);
+        int offset = minimalPort(ev->dest_router, ev->dest_loc, dim);
+        if ( offset == -1 ) continue;
 
         for ( int i = offset; i < offset + dim_width[dim]; ++i ) {
             int weight = output_queue_lengths[(i * num_vcs) + vns[vn].start_vc + vc_in_vn + 1];
@@ -600,8 +670,7 @@ topo_hyperx::routeMINA(int port, int vc, topo_hyperx_event* ev) {
 void
 topo_hyperx::routeVDAL(int port, int vc, topo_hyperx_event* ev) {
     // Check to see if we made it to the dest router
-    int dest_router = get_dest_router(ev->getDest());
-    if ( dest_router == router_id ) {
+    if ( ev->dest_router == router_id ) {
         ev->setNextPort(get_dest_local_port(ev->getDest()));
         // trace.getOutput().output("Made it to dest router\n");
         return;
@@ -611,9 +680,11 @@ topo_hyperx::routeVDAL(int port, int vc, topo_hyperx_event* ev) {
     // route in (we will not route in an aligned dimension)
     int vn = ev->getVN();
     
-    // Get the unaligned dimensions
-    std::vector<int> udims;
-    ev->getUnalignedDimensions(id_loc,udims);
+    // Count the unaligned dimensions
+    int num_udims = 0;
+    for ( int dim = 0; dim < dimensions; ++dim ) {
+        if ( minimalPort(ev->dest_router, ev->dest_loc, dim) != -1 ) num_udims++;
+    }
 
 
     // If this is just coming into the network from an endpoint, we
@@ -623,7 +694,7 @@ topo_hyperx::routeVDAL(int port, int vc, topo_hyperx_event* ev) {
 
     // Check to see if there are extra VCs for misroutes.  If not,
     // simply fall back to MIN-A routing
-    if ( udims.size() == vns[vn].num_vcs - vc_in_vn - 1 ) {
+    if ( num_udims == vns[vn].num_vcs - vc_in_vn - 1 ) {
         return routeMINA(port,vc,ev);
     }
     
@@ -633,31 +704,32 @@ topo_hyperx::routeVDAL(int port, int vc, topo_hyperx_event* ev) {
     // routes in the same dimension in a row
 
     int min_weight = 0x7fffffff;
-    std::vector<int> min_ports;
+    std::vector<int>& min_ports = vdal_min_ports;
+    min_ports.clear();
     int next_vc = vc_in_vn + vns[vn].start_vc + 1;
 
-    for (int dim : udims ) {
-        // Within each dimension, look at all the possible routes
+    for ( int dim = 0; dim < dimensions; ++dim ) {
+        int min_start = minimalPort(ev->dest_router, ev->dest_loc, dim);
+        if ( min_start == -1 ) continue;
 
-        int offset = 0;
-        for ( int router = 0; router < dim_size[dim]; ++router ) {
-            // If this is my location in the dimension, skip it
-            if ( router == id_loc[dim] ) continue;
+        // Within each dimension, look at all the possible routes, one
+        // group of dim_width links for each other router in the
+        // dimension
+        for ( int offset = 0; offset < dim_size[dim] - 1; ++offset ) {
+            int first_port = port_start[dim] + (offset * dim_width[dim]);
 
             // Check to see if these are minimally-routed links
-            bool minimal = router == ev->dest_loc[dim];
+            bool minimal = first_port == min_start;
 
             // Check to see if this is the same dimension we routed in
             // last time.  If so, then we only look at minimal routes
             // and will skip non-minimal routes
             if ( !minimal && (dim == ev->last_routing_dim) ) {
-                offset++;
                 continue;
             }
             
             for ( int link = 0; link < dim_width[dim]; ++link ) {
-                // int index = port_start[dim] + ((offset * dim_width[dim]) * num_vcs) + next_vc;
-                int next_port = port_start[dim] + (offset * dim_width[dim]) + link;
+                int next_port = first_port + link;
                 int index = next_port * num_vcs + next_vc;
                 int weight;
                 if ( minimal ) {
@@ -676,7 +748,6 @@ topo_hyperx::routeVDAL(int port, int vc, topo_hyperx_event* ev) {
                     min_ports.push_back(next_port);
                 }
             }
-            offset++;
         }        
     }
     // Route on the minimally weighted port
@@ -697,4 +768,3 @@ topo_hyperx::routeVDAL(int port, int vc, topo_hyperx_event* ev) {
     ev->setNextPort(min_port);
     ev->setVC(next_vc);
 }
-
@@ -37,8 +37,10 @@ public:
     int dimensions;
     // First non aligned dimension
     int last_routing_dim;
+    int dest_router;
     int* dest_loc;
     bool val_route_dest;
+    int val_router;
     int* val_loc;
 
     id_type id;
@@ -49,7 +51,9 @@ public:
         internal_router_event(),
         dimensions(dim),
         last_routing_dim(-1),
-        val_route_dest(false)
+        dest_router(0),
+        val_route_dest(false),
+        val_router(0)
     {
         dest_loc = new int[dim];
         val_loc = new int[dim];
@@ -74,6 +78,8 @@ public:
         internal_router_event::serialize_order(ser);
         ser & dimensions;
         ser & last_routing_dim;
+        ser & dest_router;
+        ser & val_router;
 
         if ( ser.mode() == SST::Core::Serialization::serializer::UNPACK ) {
             dest_loc = new int[dimensions];
@@ -169,7 +175,9 @@ public:
         {"width", "Number of links between routers in each dimension, specified in same manner as for shape.  "
                   "For example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"local_ports", "Number of endpoints attached to each router."},
-        {"algorithm", "Routing algorithm to use.", "DOR"}
+        {"algorithm", "Routing algorithm to use.", "DOR"},
+        {"route_table",          "Route from a destination router to port table built at startup instead of computing the route for each packet.", "false"},
+        {"route_table_validate", "At startup, look up the minimal port in each dimension and the dimension order step for every router with and without the route table and abort on a mismatch.", "false"}
     )
 
     enum RouteAlgo {
@@ -211,6 +219,16 @@ private:
 
     vn_info* vns;
 
+    // When route_table is set, for each destination router: the first
+    // minimal port in each dimension (-1 if aligned), indexed by
+    // router * dimensions + dim, and the dimension order routing
+    // dimension (-1 for this router)
+    bool use_route_table;
+    std::vector<int16_t> route_min_port;
+    std::vector<int8_t> route_dor_dim;
+
+    // Scratch space for VDAL, reused across packets
+    std::vector<int> vdal_min_ports;
 
 public:
     topo_hyperx(ComponentId_t cid, Params& p, int num_ports, int rtr_id, int num_vns);
@@ -243,7 +261,12 @@ private:
     int get_dest_router(int dest_id) const;
     int get_dest_local_port(int dest_id) const;
 
-    std::pair<int,int> routeDORBase(int* dest_loc);
+    void build_route_table();
+    void check_route_table();
+    int computeMinimalPort(const int* dest_loc, int dim) const;
+    int minimalPort(int dest_router, const int* dest_loc, int dim);
+    std::pair<int,int> computeDORBase(const int* dest_loc) const;
+    std::pair<int,int> routeDORBase(int dest_router, const int* dest_loc);
     void routeDOR(int port, int vc, topo_hyperx_event* ev);
     void routeDORND(int port, int vc, topo_hyperx_event* ev);
     void routeMINA(int port, int vc, topo_hyperx_event* ev);
@@ -26,7 +26,7 @@ class topoDragonFly(Topology):
         self._declareClassVariables(["link_latency","host_link_latency","global_link_map"])
         self._declareParams("main",["hosts_per_router","routers_per_group","intergroup_links","num_groups",
                                     "algorithm","adaptive_threshold","global_routes","config_failed_links",
-                                    "failed_links"])
+                                    "failed_links","route_table","route_table_validate"])
         self.global_routes = "absolute"
         self._subscribeToPlatformParamSet("topology")
 
@@ -80,6 +80,9 @@ class topoDragonFly(Topology):
 
         num_ports = self.routers_per_group - 1 + self.hosts_per_router + intergroup_per_router
 
+        # Routers are numbered group by group, so partitioning by
+        # router number keeps groups together
+        self._partitionStart(self.routers_per_group * self.num_groups)
 
         links = dict()
 
@@ -160,6 +163,7 @@ class topoDragonFly(Topology):
             # GROUP ROUTERS
             for r in range(self.routers_per_group):
                 rtr = self._instanceRouter(num_ports,router_num)
+                self._setRouterPartition(rtr,router_num)
 
                 # Insert the topology object
                 sub = rtr.setSubComponent(self.router.getTopologySlotName(),"merlin.dragonfly",0)
@@ -177,6 +181,7 @@ class topoDragonFly(Topology):
                     #(nic, port_name) = endpoint.build(nic_num, {"num_peers":num_peers})
                     (nic, port_name) = endpoint.build(nic_num, {})
                     if nic:
+                        self._setEndpointPartition(nic,router_num)
                         link = sst.Link("link_g%dr%dh%d"%(g, r, p))
                         #network_interface.build(nic,slot,0,link,self.host_link_latency)
                         link.connect( (nic, port_name, self.host_link_latency), (rtr, "port%d"%port, self.host_link_latency) )
@@ -189,13 +194,18 @@ class topoDragonFly(Topology):
                     if p != r:
                         src = min(p,r)
                         dst = max(p,r)
-                        rtr.addLink(getLink("link_g%dr%dr%d"%(g, src, dst)), "port%d"%port, self.link_latency)
+                        link = getLink("link_g%dr%dr%d"%(g, src, dst))
+                        rtr.addLink(link, "port%d"%port, self.link_latency)
+                        self._partitionLink(link,router_num)
                         port = port + 1
 
                 for p in range(igpr):
                     link = getGlobalLink(g,r,p)
                     if link is not None:
                         rtr.addLink(link,"port%d"%port, self.link_latency)
+                        self._partitionLink(link,router_num)
                     port = port +1
 
                 router_num = router_num + 1
+
+        self._partitionReport()
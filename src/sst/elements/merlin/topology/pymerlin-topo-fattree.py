@@ -25,7 +25,7 @@ class topoFatTree(Topology):
         Topology.__init__(self)
         self._declareClassVariables(["link_latency","host_link_latency","bundleEndpoints","_ups","_downs","_routers_per_level","_groups_per_level","_start_ids",
                                      "_total_hosts"])
-        self._declareParams("main",["shape","routing_alg","adaptive_threshold"])        
+        self._declareParams("main",["shape","routing_alg","adaptive_threshold","route_table","route_table_validate"])        
         self._setCallbackOnWrite("shape",self._shape_callback)
         self._subscribeToPlatformParamSet("topology")
 
@@ -117,6 +117,14 @@ class topoFatTree(Topology):
 
         if not self.host_link_latency:
             self.host_link_latency = self.link_latency
+
+        # Routers are partitioned by their position in host order.  A
+        # group of routers is spread over the range of hosts below it,
+        # so the pods of the tree are kept together.
+        hosts_below = [self._downs[0]]
+        for l in range(1,len(self._downs)):
+            hosts_below.append(hosts_below[l-1] * self._downs[l])
+        self._partitionStart(self._total_hosts)
         
         #Recursive function to build levels
         def fattree_rb(self, level, group, links):
@@ -125,12 +133,14 @@ class topoFatTree(Topology):
 
             host_links = []
             if level == 0:
+                position = id * self._downs[0]
                 # create all the nodes
                 for i in range(self._downs[0]):
                     node_id = id * self._downs[0] + i
                     #print("group: %d, id: %d, node_id: %d"%(group, id, node_id))
                     (ep, port_name) = endpoint.build(node_id, {})
                     if ep:
+                        self._setEndpointPartition(ep,position)
                         hlink = sst.Link("hostlink_%d"%node_id)
                         if self.bundleEndpoints:
                            hlink.setNoCut()
@@ -140,6 +150,7 @@ class topoFatTree(Topology):
                 # Create the edge router
                 rtr_id = id
                 rtr = self._instanceRouter(self._ups[0] + self._downs[0], rtr_id)
+                self._setRouterPartition(rtr,position)
                 
                 topology = rtr.setSubComponent(self.router.getTopologySlotName(),"merlin.fattree")
                 self._applyStatisticsSettings(topology)
@@ -149,6 +160,7 @@ class topoFatTree(Topology):
                     rtr.addLink(host_links[l],"port%d"%l, self.link_latency)
                 for l in range(len(links)):
                     rtr.addLink(links[l],"port%d"%(l+self._downs[0]), self.link_latency)
+                    self._partitionLink(links[l],position)
                 return
 
             rtrs_in_group = self._routers_per_level[level] // self._groups_per_level[level]
@@ -175,6 +187,8 @@ class topoFatTree(Topology):
             for i in range(rtrs_in_group):
                 rtr_id = id + i
                 rtr = self._instanceRouter(self._ups[level] + self._downs[level], rtr_id)
+                position = group * hosts_below[level] + i * hosts_below[level] // rtrs_in_group
+                self._setRouterPartition(rtr,position)
 
                 topology = rtr.setSubComponent(self.router.getTopologySlotName(),"merlin.fattree")
                 self._applyStatisticsSettings(topology)
@@ -182,6 +196,7 @@ class topoFatTree(Topology):
                 # Add links
                 for l in range(len(rtr_links[i])):
                     rtr.addLink(rtr_links[i][l],"port%d"%l, self.link_latency)
+                    self._partitionLink(rtr_links[i][l],position)
         #  End recursive function
 
         level = len(self._ups)
@@ -210,6 +225,8 @@ class topoFatTree(Topology):
             for i in range(self._routers_per_level[level]):
                 rtr_id = self._start_ids[len(self._ups)] + i
                 rtr = self._instanceRouter(radix,rtr_id);
+                position = i * self._total_hosts // self._routers_per_level[level]
+                self._setRouterPartition(rtr,position)
 
                 topology = rtr.setSubComponent(self.router.getTopologySlotName(),"merlin.fattree",0)
                 self._applyStatisticsSettings(topology)
@@ -217,6 +234,9 @@ class topoFatTree(Topology):
 
                 for l in range(len(rtr_links[i])):
                     rtr.addLink(rtr_links[i][l], "port%d"%l, self.link_latency)
+                    self._partitionLink(rtr_links[i][l],position)
+
+            self._partitionReport()
 
         else: # Single level case
             # create all the nodes
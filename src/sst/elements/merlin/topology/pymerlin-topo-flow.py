@@ -0,0 +1,108 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2022 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2022, NTESS
+# All rights reserved.
+#
+# Portions are copyright of other developers:
+# See the file CONTRIBUTORS.TXT in the top level directory
+# of the distribution for more information.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+import sst
+from sst.merlin.base import *
+
+
+# Builds a configured topology (topoTorus, topoDragonFly, etc) as a
+# single merlin.flownetwork component instead of routers.  Endpoints
+# must use FlowLinkControl as their network interface.
+#
+#   topo = topoDragonFly()
+#   ... configure topo and topo.router as usual ...
+#   system.setTopology(topoFlow(topo))
+class topoFlow(Topology):
+
+    # Class name of python topology to merlin topology name
+    _topology_names = {
+        "topoTorus" : "merlin.torus",
+        "topoMesh" : "merlin.mesh",
+        "topoHyperX" : "merlin.hyperx",
+        "topoFatTree" : "merlin.fattree",
+        "topoDragonFly" : "merlin.dragonfly",
+        "topoSingle" : "merlin.singlerouter",
+    }
+
+    def __init__(self, topo = None):
+        Topology.__init__(self)
+        self._declareClassVariables(["topology"])
+        self._declareParams("main",["router_latency","host_link_bw","rate_update_interval"])
+        self._setCallbackOnWrite("topology",self._topology_callback)
+        if topo is not None:
+            self.topology = topo
+
+    def _topology_callback(self, variable_name, value):
+        if not value: return
+        self._lockVariable(variable_name)
+
+    def getName(self):
+        return "Flow %s"%self.topology.getName()
+
+    def getNumNodes(self):
+        return self.topology.getNumNodes()
+
+    def getRouterNameForId(self,rtr_id):
+        return "%sflow_network"%self.topology._prefix
+
+    def _getMerlinTopologyName(self):
+        for cls in type(self.topology).__mro__:
+            if cls.__name__ in self._topology_names:
+                return self._topology_names[cls.__name__]
+        print("topoFlow: topology %s is not supported by the flow model."%self.topology.getName())
+        sst.exit()
+
+    def _getVariable(self, obj, name):
+        if name in obj._vars:
+            return obj._vars[name].value
+        return None
+
+    def build(self, endpoint):
+        topo = self.topology
+        num_nodes = topo.getNumNodes()
+
+        link_latency = self._getVariable(topo,"link_latency")
+        host_link_latency = self._getVariable(topo,"host_link_latency")
+        if host_link_latency is None:
+            host_link_latency = link_latency
+
+        net = sst.Component(self.getRouterNameForId(0), "merlin.flownetwork")
+        self._applyStatisticsSettings(net)
+        net.addParams(self._getGroupParams("main"))
+        net.addParam("num_ports",num_nodes)
+        net.addParam("topology",self._getMerlinTopologyName())
+        if link_latency is not None:
+            net.addParam("link_latency",link_latency)
+
+        # Topology parameters are passed through for the topology model
+        for key, value in topo._getGroupParams("main").items():
+            net.addParam("topology.%s"%key,value)
+        global_link_map = self._getVariable(topo,"global_link_map")
+        if global_link_map is not None:
+            net.addParam("topology.global_link_map",global_link_map)
+
+        # Bandwidth and latency come from the router
+        router_params = topo.router._getGroupParams("params")
+        for key in ["link_bw", "link_bw:host", "input_latency", "output_latency"]:
+            if key in router_params:
+                net.addParam(key,router_params[key])
+
+        for i in range(num_nodes):
+            (ep, port_name) = endpoint.build(i, {})
+            if ep:
+                link = sst.Link("%sflow_link_%d"%(topo._prefix,i))
+                link.connect( (ep, port_name, host_link_latency), (net, "port%d"%i, host_link_latency) )
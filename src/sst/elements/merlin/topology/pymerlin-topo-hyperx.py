@@ -25,7 +25,7 @@ class topoHyperX(Topology):
     def __init__(self):
         Topology.__init__(self)
         self._declareClassVariables(["link_latency","host_link_latency","bundleEndpoints","_num_dims","_dim_size","_dim_width"])
-        self._declareParams("main",["shape", "width", "local_ports","algorithm"])
+        self._declareParams("main",["shape", "width", "local_ports","algorithm","route_table","route_table_validate"])
         self._setCallbackOnWrite("shape",self._shape_callback)
         self._setCallbackOnWrite("width",self._shape_callback)
         self._setCallbackOnWrite("local_ports",self._shape_callback)
@@ -127,6 +127,11 @@ class topoHyperX(Topology):
         for x in range(num_dims):
             radix += (self._dim_width[x] * (self._dim_size[x]-1))
         
+        # Dimension 0 varies fastest in the router numbering, so
+        # partitioning by router number cuts the network into slabs
+        # along the last dimension
+        self._partitionStart(num_routers)
+
         links = dict()
         def getLink(name1, name2, num):
             # Sort name1 and name2 so order doesn't matter
@@ -148,6 +153,7 @@ class topoHyperX(Topology):
             #print("Creating router %s (%d)"%(mylocstr,i))
 
             rtr = self._instanceRouter(radix,i)
+            self._setRouterPartition(rtr,i)
 
             topology = rtr.setSubComponent(self.router.getTopologySlotName(),"merlin.hyperx")
             self._applyStatisticsSettings(topology)
@@ -165,7 +171,9 @@ class topoHyperX(Topology):
                         theirlocstr = self._formatShape(theirdims)
                         # Hook up "width" number of links for this dimension
                         for num in range(self._dim_width[dim]):
-                            rtr.addLink(getLink(mylocstr, theirlocstr, num), "port%d"%port, self.link_latency)
+                            link = getLink(mylocstr, theirlocstr, num)
+                            rtr.addLink(link, "port%d"%port, self.link_latency)
+                            self._partitionLink(link,i)
                             #print("Wired up port %d"%port)
                             port = port + 1
 
@@ -174,10 +182,12 @@ class topoHyperX(Topology):
                 nodeID = local_ports * i + n
                 (ep, port_name) = endpoint.build(nodeID, {})
                 if ep:
+                    self._setEndpointPartition(ep,i)
                     nicLink = sst.Link("nic_%d_%d"%(i, n))
                     if self.bundleEndpoints:
                        nicLink.setNoCut()
                     nicLink.connect( (ep, port_name, self.host_link_latency), (rtr, "port%d"%port, self.host_link_latency) )
                 port = port+1
 
+        self._partitionReport()
 
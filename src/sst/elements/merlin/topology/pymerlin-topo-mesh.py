@@ -128,6 +128,11 @@ class _topoMeshBase(Topology):
             radix = radix + (self._dim_width[x] * 2)
             
         
+        # Dimension 0 varies fastest in the router numbering, so
+        # partitioning by router number cuts the network into slabs
+        # along the last dimension
+        self._partitionStart(num_routers)
+
         links = dict()
         def getLink(leftName, rightName, num):
             name = "link_%s_%s_%d"%(leftName, rightName, num)
@@ -142,6 +147,7 @@ class _topoMeshBase(Topology):
             mylocstr = self._formatShape(mydims)
 
             rtr = self._instanceRouter(radix,i)
+            self._setRouterPartition(rtr,i)
             
             topology = rtr.setSubComponent(self.router.getTopologySlotName(),self._getTopologyName())
             self._applyStatisticsSettings(topology)
@@ -156,7 +162,9 @@ class _topoMeshBase(Topology):
                     theirdims[dim] = (mydims[dim] +1 ) % self._dim_size[dim]
                     theirlocstr = self._formatShape(theirdims)
                     for num in range(self._dim_width[dim]):
-                        rtr.addLink(getLink(mylocstr, theirlocstr, num), "port%d"%port, self.link_latency)
+                        link = getLink(mylocstr, theirlocstr, num)
+                        rtr.addLink(link, "port%d"%port, self.link_latency)
+                        self._partitionLink(link,i)
                         port = port+1
                 else:
                     port += self._dim_width[dim]
@@ -166,7 +174,9 @@ class _topoMeshBase(Topology):
                     theirdims[dim] = ((mydims[dim] -1) + self._dim_size[dim]) % self._dim_size[dim]
                     theirlocstr = self._formatShape(theirdims)
                     for num in range(self._dim_width[dim]):
-                        rtr.addLink(getLink(theirlocstr, mylocstr, num), "port%d"%port, self.link_latency)
+                        link = getLink(theirlocstr, mylocstr, num)
+                        rtr.addLink(link, "port%d"%port, self.link_latency)
+                        self._partitionLink(link,i)
                         port = port+1
                 else:
                     port += self._dim_width[dim]
@@ -175,12 +185,14 @@ class _topoMeshBase(Topology):
                 nodeID = local_ports * i + n
                 (ep, port_name) = endpoint.build(nodeID, {})
                 if ep:
+                    self._setEndpointPartition(ep,i)
                     nicLink = sst.Link("nic.%d:%d"%(i, n))
                     if self.bundleEndpoints:
                        nicLink.setNoCut()
                     nicLink.connect( (ep, port_name, self.host_link_latency), (rtr, "port%d"%port, self.host_link_latency) )
                 port = port+1
 
+        self._partitionReport()
 
 
 class topoMesh(_topoMeshBase):
@@ -202,6 +214,7 @@ class topoTorus(_topoMeshBase):
 
     def __init__(self):
         _topoMeshBase.__init__(self)
+        self._declareParams("main",["route_table","route_table_validate"])
 
     def getName(self):
         return "Torus"
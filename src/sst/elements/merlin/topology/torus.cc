@@ -83,6 +83,12 @@ topo_torus::topo_torus(ComponentId_t cid, Params& params, int num_ports, int rtr
 
     id_loc = new int[dimensions];
     idToLocation(router_id, id_loc);
+
+    use_route_table = params.find<bool>("route_table", false);
+    if ( use_route_table ) {
+        build_route_table();
+        if ( params.find<bool>("route_table_validate", false) ) check_route_table();
+    }
 }
 
 topo_torus::~topo_torus()
@@ -96,6 +102,11 @@ topo_torus::~topo_torus()
 void
 topo_torus::route_packet(int port, int vc, internal_router_event* ev)
 {
+    if ( use_route_table ) {
+        route_from_table(port, vc, static_cast<topo_torus_event*>(ev));
+        return;
+    }
+
     int dest_router = get_dest_router(ev->getDest());
     if ( dest_router == router_id ) {
         ev->setNextPort(get_dest_local_port(ev->getDest()));
@@ -152,6 +163,7 @@ topo_torus::process_input(RtrEvent* ev)
     // Need to figure out what the torus address is for easier
     // routing.
     int run_id = get_dest_router(tt_ev->getDest());
+    tt_ev->dest_router = run_id;
     idToLocation(run_id, tt_ev->dest_loc);
 
 	return tt_ev;
@@ -207,6 +219,7 @@ internal_router_event* topo_torus::process_InitData_input(RtrEvent* ev)
         }
     } else {
         int rtr_id = get_dest_router(tt_ev->getDest());
+        tt_ev->dest_router = rtr_id;
         idToLocation(rtr_id, tt_ev->dest_loc);
     }
     return tt_ev;
@@ -286,3 +299,112 @@ topo_torus::getEndpointID(int port)
 }
 
 
+// Route tables
+
+void
+topo_torus::build_route_table()
+{
+    int num_routers = 1;
+    for ( int i = 0 ; i < dimensions ; i++ ) {
+        num_routers *= dim_size[i];
+    }
+    if ( local_port_start + num_local_ports > 0x7fff ) {
+        output.fatal(CALL_INFO, -1, "route_table is not supported for routers with more than 32767 ports\n");
+    }
+
+    int* loc = new int[dimensions];
+    route_table.resize(num_routers);
+    for ( int r = 0 ; r < num_routers ; r++ ) {
+        idToLocation(r, loc);
+        int dim;
+        route_table[r].port = compute_route(loc, r, dim);
+        route_table[r].dim = dim;
+    }
+    delete[] loc;
+}
+
+// Dimension order route to a router: returns the output port and sets
+// dim to the dimension being routed, or returns -1 and sets dim to -1
+// if the destination is this router
+int
+topo_torus::compute_route(const int* dest_loc, int dest_router, int& dim)
+{
+    dim = -1;
+    if ( dest_router == router_id ) return -1;
+
+    for ( int d = 0 ; d < dimensions ; d++ ) {
+        if ( dest_loc[d] != id_loc[d] ) {
+            int dist_neg = id_loc[d] - dest_loc[d];
+            if ( dist_neg < 0 ) dist_neg += dim_size[d];
+            int dist_pos = dest_loc[d] - id_loc[d];
+            if ( dist_pos < 0 ) dist_pos += dim_size[d];
+
+            int go_pos = (dist_pos <= dist_neg);
+            dim = d;
+            return choose_multipath(port_start[d][(go_pos) ? 0 : 1], dim_width[d], (go_pos) ? dist_pos : dist_neg);
+        }
+    }
+    return -1;
+}
+
+// Same result as the computed route in route_packet(), using the table
+void
+topo_torus::route_from_table(int port, int vc, topo_torus_event* ev)
+{
+    const route_entry& entry = route_table[ev->dest_router];
+
+    if ( entry.dim < 0 ) {
+        ev->setNextPort(get_dest_local_port(ev->getDest()));
+        return;
+    }
+
+    if ( entry.dim > ev->routing_dim ) {
+        // Time to change direction
+        ev->routing_dim = entry.dim;
+        ev->setVC(vc & (~1)); // Reset the VC
+    }
+
+    ev->setNextPort(entry.port);
+
+    if ( id_loc[entry.dim] == 0 && port < local_port_start ) { // Crossing dateline
+        ev->setVC(vc ^ 1); // Toggle VC
+    }
+}
+
+// Route a packet to every endpoint through route_packet() with the table
+// and with it disabled, arriving on a router and on a host port on both
+// VCs, and abort on the first difference
+void
+topo_torus::check_route_table()
+{
+    int num_endpoints = route_table.size() * num_local_ports;
+    int in_ports[2] = { 0, local_port_start };
+
+    for ( int dest = 0 ; dest < num_endpoints ; dest++ ) {
+        for ( int i = (local_port_start > 0) ? 0 : 1 ; i < 2 ; i++ ) {
+            for ( int vc = 0 ; vc < 2 ; vc++ ) {
+                topo_torus_event* computed = static_cast<topo_torus_event*>(
+                    process_input(new RtrEvent(new SST::Interfaces::SimpleNetwork::Request(dest, 0, 0, true, true), 0, 0)));
+                topo_torus_event* table = static_cast<topo_torus_event*>(
+                    process_input(new RtrEvent(new SST::Interfaces::SimpleNetwork::Request(dest, 0, 0, true, true), 0, 0)));
+                computed->setVC(vc);
+                table->setVC(vc);
+
+                use_route_table = false;
+                route_packet(in_ports[i], vc, computed);
+                use_route_table = true;
+                route_packet(in_ports[i], vc, table);
+
+                if ( table->getNextPort() != computed->getNextPort() || table->getVC() != computed->getVC() ||
+                     table->routing_dim != computed->routing_dim ) {
+                    output.fatal(CALL_INFO, -1, "Route table mismatch in router %d for destination %d from port %d on VC %d: "
+                                 "table port %d (VC %d, dim %d), computed port %d (VC %d, dim %d)\n",
+                                 router_id, dest, in_ports[i], vc, table->getNextPort(), table->getVC(), table->routing_dim,
+                                 computed->getNextPort(), computed->getVC(), computed->routing_dim);
+                }
+                delete computed;
+                delete table;
+            }
+        }
+    }
+}
@@ -24,6 +24,7 @@
 #include <sst/core/params.h>
 
 #include <string.h>
+#include <vector>
 
 #include "sst/elements/merlin/router.h"
 
@@ -34,10 +35,11 @@ class topo_torus_event : public internal_router_event {
 public:
     int dimensions;
     int routing_dim;
+    int dest_router;
     int* dest_loc;
 
     topo_torus_event() {}
-    topo_torus_event(int dim) {	dimensions = dim; routing_dim = 0; dest_loc = new int[dim]; }
+    topo_torus_event(int dim) {	dimensions = dim; routing_dim = 0; dest_router = 0; dest_loc = new int[dim]; }
     ~topo_torus_event() { delete[] dest_loc; }
     virtual internal_router_event* clone(void) override
     {
@@ -51,6 +53,7 @@ public:
         internal_router_event::serialize_order(ser);
         ser & dimensions;
         ser & routing_dim;
+        ser & dest_router;
 
         if ( ser.mode() == SST::Core::Serialization::serializer::UNPACK ) {
             dest_loc = new int[dimensions];
@@ -94,6 +97,8 @@ public:
         {"width", "Number of links between routers in each dimension, specified in same manner as for shape.  For "
                   "example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"local_ports", "Number of endpoints attached to each router."},
+        {"route_table",          "Route from a destination router to port table built at startup instead of computing the route for each packet.", "false"},
+        {"route_table_validate", "At startup, route to every endpoint with and without the route table and abort if the port, VC or routing dimension differ.", "false"},
     )
 
 
@@ -111,7 +116,16 @@ private:
     int local_port_start;
 
     int num_vns;
-    
+
+    // Output port and dimension for each destination router, when
+    // route_table is set.  dim is -1 for the local router.
+    struct route_entry {
+        int16_t port;
+        int16_t dim;
+    };
+    bool use_route_table;
+    std::vector<route_entry> route_table;
+
 public:
     topo_torus(ComponentId_t cid, Params& params, int num_ports, int rtr_id, int num_vns);
     ~topo_torus();
@@ -140,6 +154,11 @@ private:
     int get_dest_router(int dest_id) const;
     int get_dest_local_port(int dest_id) const;
 
+    void build_route_table();
+    int compute_route(const int* dest_loc, int dest_router, int& dim);
+    void route_from_table(int port, int vc, topo_torus_event* ev);
+    void check_route_table();
+
 };
 
 }
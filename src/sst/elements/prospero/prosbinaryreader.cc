@@ -14,14 +14,20 @@
 // distribution.
 
 
+
 #include "sst_config.h"
 #include "prosbinaryreader.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+
 using namespace SST::Prospero;
 
 
 ProsperoBinaryTraceReader::ProsperoBinaryTraceReader( ComponentId_t id, Params& params, Output* out ) :
-	ProsperoTraceReader(id, params, out) {
+	ProsperoBlockTraceReader(id, params, out), mapped(NULL), mappedLength(0), mappedPos(0) {
 
 	std::string traceFile = params.find<std::string>("file", "");
 	traceInput = fopen(traceFile.c_str(), "rb");
@@ -31,50 +37,65 @@ ProsperoBinaryTraceReader::ProsperoBinaryTraceReader( ComponentId_t id, Params&
                     getName().c_str(), traceFile.c_str());
 	}
 
-	recordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
-	buffer = (char*) malloc(sizeof(char) * recordLength);
+	struct stat traceStat;
+	if(params.find<bool>("mmap", true) && 0 == fstat(fileno(traceInput), &traceStat) &&
+		S_ISREG(traceStat.st_mode) && traceStat.st_size > 0) {
+
+		void* region = mmap(NULL, (size_t) traceStat.st_size, PROT_READ, MAP_PRIVATE, fileno(traceInput), 0);
+
+		if(MAP_FAILED == region) {
+			output->verbose(CALL_INFO, 1, 0, "Unable to map trace file %s, reading it instead.\n", traceFile.c_str());
+		} else {
+			madvise(region, (size_t) traceStat.st_size, MADV_SEQUENTIAL);
+			mapped = (const char*) region;
+			mappedLength = (size_t) traceStat.st_size;
+		}
+	}
+
+	startDecoder();
 }
 
 ProsperoBinaryTraceReader::~ProsperoBinaryTraceReader() {
+	stopDecoder();
+
+	if(NULL != mapped) {
+		munmap((void*) mapped, mappedLength);
+	}
+
 	if(NULL != traceInput) {
 		fclose(traceInput);
 	}
+}
 
-	if(NULL != buffer) {
-		free(buffer);
+bool ProsperoBinaryTraceReader::seekToEntry(const uint64_t entry) {
+	if(NULL != mapped) {
+		// A trailing partial record is never replayed
+		const size_t fullRecords = mappedLength / PROSPERO_BINARY_RECORD_LENGTH;
+		mappedPos = std::min((size_t) entry, fullRecords) * PROSPERO_BINARY_RECORD_LENGTH;
+		return true;
 	}
+
+	return 0 == fseeko(traceInput, (off_t) (entry * PROSPERO_BINARY_RECORD_LENGTH), SEEK_SET);
 }
 
-void ProsperoBinaryTraceReader::copy(char* target, const char* source,
-	const size_t bufferOffset, const size_t len) {
+size_t ProsperoBinaryTraceReader::decodeEntries(ProsperoTraceEntry* entries, const size_t maxEntries,
+	std::string& error) {
 
-	for(size_t i = 0; i < len; ++i) {
-		target[i] = source[bufferOffset + i];
+	if(NULL != mapped) {
+		const size_t count = std::min(maxEntries, (mappedLength - mappedPos) / PROSPERO_BINARY_RECORD_LENGTH);
+		decodeBinaryRecords(mapped + mappedPos, count, entries);
+		mappedPos += count * PROSPERO_BINARY_RECORD_LENGTH;
+		return count;
 	}
-}
 
-ProsperoTraceEntry* ProsperoBinaryTraceReader::readNextEntry() {
-	uint64_t reqAddress = 0;
-	uint64_t reqCycles  = 0;
-	char reqType = 'R';
-	uint32_t reqLength  = 0;
+	buffer.resize(maxEntries * PROSPERO_BINARY_RECORD_LENGTH);
+	const size_t count = fread(buffer.data(), PROSPERO_BINARY_RECORD_LENGTH, maxEntries, traceInput);
 
-	if(feof(traceInput)) {
-		return NULL;
+	if(ferror(traceInput)) {
+		error = "Error reading binary trace file";
+		return 0;
 	}
 
-	if(1 == fread(buffer, (size_t) recordLength, (size_t) 1, traceInput)) {
-		// We DID read an entry
-		copy((char*) &reqCycles,  buffer, (size_t) 0, sizeof(uint64_t));
-		copy((char*) &reqType,    buffer, sizeof(uint64_t), sizeof(char));
-		copy((char*) &reqAddress, buffer, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
-		copy((char*) &reqLength,  buffer, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
-
-		return new ProsperoTraceEntry(reqCycles, reqAddress,
-			reqLength,
-			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
-	} else {
-		// Did not get a full read?
-		return NULL;
-	}
+	decodeBinaryRecords(buffer.data(), count, entries);
+	return count;
 }
@@ -14,20 +14,22 @@
 // distribution.
 
 
+
 #ifndef _H_SST_PROSPERO_BINARY_READER
 #define _H_SST_PROSPERO_BINARY_READER
 
-#include "prosreader.h"
+#include "prosblockreader.h"
+
+#include <stdio.h>
 
 namespace SST {
 namespace Prospero {
 
-class ProsperoBinaryTraceReader : public ProsperoTraceReader {
+class ProsperoBinaryTraceReader : public ProsperoBlockTraceReader {
 
 public:
         ProsperoBinaryTraceReader( ComponentId_t id, Params& params, Output* out );
         ~ProsperoBinaryTraceReader();
-        ProsperoTraceEntry* readNextEntry();
 
  	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
         	ProsperoBinaryTraceReader,
@@ -39,15 +41,24 @@ public:
     	)
 
 	SST_ELI_DOCUMENT_PARAMS(
-		{ "file", "Sets the file for the trace reader to use", "" }
+		{ "file", "Sets the file for the trace reader to use", "" },
+		{ "mmap", "Map the trace into memory instead of reading it, falls back to reading if the file cannot be mapped", "1" },
+		{ "block_entries", "Number of trace entries decoded at a time by the reader thread", "65536" },
+		{ "buffer_blocks", "Number of decoded blocks buffered ahead of the simulation (at least 2)", "2" },
+		{ "start_entry", "Index of the first trace entry to replay", "0" }
 	)
 
+protected:
+	size_t decodeEntries(ProsperoTraceEntry* entries, const size_t maxEntries, std::string& error);
+	bool seekToEntry(const uint64_t entry);
+
 private:
-	void copy(char* target, const char* source,
-		const size_t offset, const size_t len);
 	FILE* traceInput;
-	char* buffer;
-	uint32_t recordLength;
+	std::vector<char> buffer;
+
+	const char* mapped;
+	size_t mappedLength;
+	size_t mappedPos;
 
 };
 
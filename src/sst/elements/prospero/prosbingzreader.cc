@@ -14,6 +14,7 @@
 // distribution.
 
 
+
 #include "sst_config.h"
 #include "prosbingzreader.h"
 
@@ -21,7 +22,7 @@ using namespace SST::Prospero;
 
 
 ProsperoCompressedBinaryTraceReader::ProsperoCompressedBinaryTraceReader( ComponentId_t id, Params& params, Output* out ) :
-	ProsperoTraceReader(id, params, out) {
+	ProsperoBlockTraceReader(id, params, out) {
 
 	std::string traceFile = params.find<std::string>("file", "");
 	traceInput = gzopen(traceFile.c_str(), "rb");
@@ -31,56 +32,33 @@ ProsperoCompressedBinaryTraceReader::ProsperoCompressedBinaryTraceReader( Compon
 			getName().c_str(), traceFile.c_str());
 	}
 
-	recordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
-	buffer = (char*) malloc(sizeof(char) * recordLength);
+	gzbuffer(traceInput, 1024 * 1024);
+
+	startDecoder();
 }
 
 ProsperoCompressedBinaryTraceReader::~ProsperoCompressedBinaryTraceReader() {
+	stopDecoder();
+
 	if(NULL != traceInput) {
 		gzclose(traceInput);
 	}
-
-	if(NULL != buffer) {
-		free(buffer);
-	}
 }
 
-void ProsperoCompressedBinaryTraceReader::copy(char* target, const char* source,
-	const size_t bufferOffset, const size_t len) {
+size_t ProsperoCompressedBinaryTraceReader::decodeEntries(ProsperoTraceEntry* entries, const size_t maxEntries,
+	std::string& error) {
 
-	for(size_t i = 0; i < len; ++i) {
-		target[i] = source[bufferOffset + i];
-	}
-}
-
-ProsperoTraceEntry* ProsperoCompressedBinaryTraceReader::readNextEntry() {
-	output->verbose(CALL_INFO, 4, 0, "Reading next trace entry...\n");
+	buffer.resize(maxEntries * PROSPERO_BINARY_RECORD_LENGTH);
+	const int bytesRead = gzread(traceInput, buffer.data(), (unsigned int) buffer.size());
 
-	uint64_t reqAddress = 0;
-	uint64_t reqCycles  = 0;
-	char reqType = 'R';
-	uint32_t reqLength  = 0;
-
-	if(gzeof(traceInput)) {
-		output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
-		return NULL;
+	if(bytesRead < 0) {
+		int zerr;
+		error = std::string("Error reading compressed trace: ") + gzerror(traceInput, &zerr);
+		return 0;
 	}
 
-	unsigned int bytesRead = gzread(traceInput, buffer, (unsigned int) recordLength);
-
-	if(bytesRead == recordLength) {
-		// We DID read an entry
-		copy((char*) &reqCycles,  buffer, (size_t) 0, sizeof(uint64_t));
-		copy((char*) &reqType,    buffer, sizeof(uint64_t), sizeof(char));
-		copy((char*) &reqAddress, buffer, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
-		copy((char*) &reqLength,  buffer, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
-
-		return new ProsperoTraceEntry(reqCycles, reqAddress,
-			reqLength,
-			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
-	} else {
-		output->verbose(CALL_INFO, 2, 0, "Did not read a full record from the compressed trace, returning empty request.\n");
-		// Did not get a full read?
-		return NULL;
-	}
+	// A trailing partial record is dropped, as a short read always has been
+	const size_t count = (size_t) bytesRead / PROSPERO_BINARY_RECORD_LENGTH;
+	decodeBinaryRecords(buffer.data(), count, entries);
+	return count;
 }
@@ -14,21 +14,21 @@
 // distribution.
 
 
+
 #ifndef _H_SST_PROSPERO_GZ_BINARY_READER
 #define _H_SST_PROSPERO_GZ_BINARY_READER
 
-#include "prosreader.h"
+#include "prosblockreader.h"
 #include "zlib.h"
 
 namespace SST {
 namespace Prospero {
 
-class ProsperoCompressedBinaryTraceReader : public ProsperoTraceReader {
+class ProsperoCompressedBinaryTraceReader : public ProsperoBlockTraceReader {
 
 public:
         ProsperoCompressedBinaryTraceReader( ComponentId_t id, Params& params, Output* out );
         ~ProsperoCompressedBinaryTraceReader();
-        ProsperoTraceEntry* readNextEntry();
 
 	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
                	ProsperoCompressedBinaryTraceReader,
@@ -40,14 +40,18 @@ public:
 	)
 
        	SST_ELI_DOCUMENT_PARAMS(
-               	{ "file", "Sets the file for the trace reader to use", "" }
+               	{ "file", "Sets the file for the trace reader to use", "" },
+               	{ "block_entries", "Number of trace entries decoded at a time by the reader thread", "65536" },
+               	{ "buffer_blocks", "Number of decoded blocks buffered ahead of the simulation (at least 2)", "2" },
+               	{ "start_entry", "Index of the first trace entry to replay, earlier entries are decompressed and dropped", "0" }
        	)
 
+protected:
+	size_t decodeEntries(ProsperoTraceEntry* entries, const size_t maxEntries, std::string& error);
+
 private:
-	void copy(char* target, const char* source, const size_t buffOffset, const size_t len);
 	gzFile traceInput;
-	char* buffer;
-	uint32_t recordLength;
+	std::vector<char> buffer;
 
 };
 
@@ -0,0 +1,161 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+
+#include "sst_config.h"
+#include "prosblkzreader.h"
+#include "zlib.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+using namespace SST::Prospero;
+
+
+ProsperoBlockCompressedTraceReader::ProsperoBlockCompressedTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoBlockTraceReader(id, params, out), nextBlock(0), skipRecords(0), blockRecords(0), blockPos(0) {
+
+	traceFile = params.find<std::string>("file", "");
+	traceInput = fopen(traceFile.c_str(), "rb");
+
+	if(NULL == traceInput) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Unable to open file: %s in block compressed reader.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	if(1 != fread(&header, sizeof(header), 1, traceInput) ||
+		0 != memcmp(header.magic, PROSPERO_BLOCK_TRACE_MAGIC, sizeof(header.magic))) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: %s is not a block compressed Prospero trace.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	if(PROSPERO_BLOCK_TRACE_VERSION != header.version || PROSPERO_BINARY_RECORD_LENGTH != header.recordLength) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: %s has version %" PRIu32 " with %" PRIu32 " byte records, expected version %d with %" PRIu32 " byte records.\n",
+			getName().c_str(), traceFile.c_str(), header.version, header.recordLength,
+			PROSPERO_BLOCK_TRACE_VERSION, (uint32_t) PROSPERO_BINARY_RECORD_LENGTH);
+	}
+
+	ProsperoBlockTraceFooter footer;
+	if(0 != fseeko(traceInput, -((off_t) sizeof(footer)), SEEK_END) ||
+		1 != fread(&footer, sizeof(footer), 1, traceInput) ||
+		0 != memcmp(footer.magic, PROSPERO_BLOCK_TRACE_MAGIC, sizeof(footer.magic))) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: %s has no trace index, the trace may be truncated.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	index.resize(footer.blockCount);
+	if(0 != fseeko(traceInput, (off_t) footer.indexOffset, SEEK_SET) ||
+		(footer.blockCount > 0 && footer.blockCount != fread(index.data(), sizeof(ProsperoBlockTraceIndexEntry), footer.blockCount, traceInput))) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Unable to read the trace index of %s.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	recordCount = footer.recordCount;
+	records.resize((size_t) header.recordsPerBlock * PROSPERO_BINARY_RECORD_LENGTH);
+
+	output->verbose(CALL_INFO, 1, 0, "Opened block compressed trace %s: %" PRIu64 " records in %" PRIu64 " blocks.\n",
+		traceFile.c_str(), recordCount, footer.blockCount);
+
+	startDecoder();
+}
+
+ProsperoBlockCompressedTraceReader::~ProsperoBlockCompressedTraceReader() {
+	stopDecoder();
+
+	if(NULL != traceInput) {
+		fclose(traceInput);
+	}
+}
+
+bool ProsperoBlockCompressedTraceReader::seekToEntry(const uint64_t entry) {
+	blockRecords = 0;
+	blockPos = 0;
+
+	if(entry >= recordCount) {
+		nextBlock = index.size();
+		return true;
+	}
+
+	// Last block starting at or before the entry
+	auto block = std::upper_bound(index.begin(), index.end(), entry,
+		[](const uint64_t e, const ProsperoBlockTraceIndexEntry& idx) { return e < idx.firstRecord; });
+
+	nextBlock = (uint64_t) (block - index.begin()) - 1;
+	skipRecords = entry - index[nextBlock].firstRecord;
+	return true;
+}
+
+bool ProsperoBlockCompressedTraceReader::loadBlock(std::string& error) {
+	ProsperoBlockTraceBlock block;
+
+	if(0 != fseeko(traceInput, (off_t) index[nextBlock].offset, SEEK_SET) ||
+		1 != fread(&block, sizeof(block), 1, traceInput)) {
+		error = "Unable to read block " + std::to_string(nextBlock) + " of " + traceFile;
+		return false;
+	}
+
+	if(block.recordCount > header.recordsPerBlock) {
+		error = "Block " + std::to_string(nextBlock) + " of " + traceFile + " holds more records than the header allows";
+		return false;
+	}
+
+	compressed.resize(block.compressedLength);
+	if(block.compressedLength > 0 &&
+		1 != fread(compressed.data(), block.compressedLength, 1, traceInput)) {
+		error = "Block " + std::to_string(nextBlock) + " of " + traceFile + " is truncated";
+		return false;
+	}
+
+	uLongf length = (uLongf) records.size();
+	if(Z_OK != uncompress((Bytef*) records.data(), &length, (const Bytef*) compressed.data(), block.compressedLength) ||
+		length != (uLongf) block.recordCount * PROSPERO_BINARY_RECORD_LENGTH) {
+		error = "Unable to decompress block " + std::to_string(nextBlock) + " of " + traceFile;
+		return false;
+	}
+
+	nextBlock++;
+	blockRecords = block.recordCount;
+	blockPos = std::min((size_t) skipRecords, blockRecords);
+	skipRecords = 0;
+	return true;
+}
+
+size_t ProsperoBlockCompressedTraceReader::decodeEntries(ProsperoTraceEntry* entries, const size_t maxEntries,
+	std::string& error) {
+
+	size_t count = 0;
+
+	while(count < maxEntries) {
+		if(blockPos == blockRecords) {
+			if(nextBlock >= index.size()) {
+				break;
+			}
+
+			if(!loadBlock(error)) {
+				return 0;
+			}
+			continue;
+		}
+
+		const size_t n = std::min(maxEntries - count, blockRecords - blockPos);
+		decodeBinaryRecords(records.data() + (blockPos * PROSPERO_BINARY_RECORD_LENGTH), n, entries + count);
+		blockPos += n;
+		count += n;
+	}
+
+	return count;
+}
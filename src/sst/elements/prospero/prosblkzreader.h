@@ -0,0 +1,76 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+
+#ifndef _H_SST_PROSPERO_BLOCK_COMPRESSED_READER
+#define _H_SST_PROSPERO_BLOCK_COMPRESSED_READER
+
+#include "prosblockreader.h"
+#include "prosblockformat.h"
+
+#include <stdio.h>
+
+namespace SST {
+namespace Prospero {
+
+class ProsperoBlockCompressedTraceReader : public ProsperoBlockTraceReader {
+
+public:
+        ProsperoBlockCompressedTraceReader( ComponentId_t id, Params& params, Output* out );
+        ~ProsperoBlockCompressedTraceReader();
+
+	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+               	ProsperoBlockCompressedTraceReader,
+               	"prospero",
+               	"ProsperoBlockCompressedTraceReader",
+               	SST_ELI_ELEMENT_VERSION(1,0,0),
+               	"Seekable Block Compressed Binary Trace Reader (see sst-prospero-blocktrace)",
+	       	SST::Prospero::ProsperoTraceReader
+	)
+
+       	SST_ELI_DOCUMENT_PARAMS(
+               	{ "file", "Sets the file for the trace reader to use", "" },
+               	{ "block_entries", "Number of trace entries decoded at a time by the reader thread", "65536" },
+               	{ "buffer_blocks", "Number of decoded blocks buffered ahead of the simulation (at least 2)", "2" },
+               	{ "start_entry", "Index of the first trace entry to replay, found through the trace index", "0" }
+       	)
+
+protected:
+	size_t decodeEntries(ProsperoTraceEntry* entries, const size_t maxEntries, std::string& error);
+	bool seekToEntry(const uint64_t entry);
+
+private:
+	bool loadBlock(std::string& error);
+
+	FILE* traceInput;
+	std::string traceFile;
+	ProsperoBlockTraceHeader header;
+	std::vector<ProsperoBlockTraceIndexEntry> index;
+	uint64_t recordCount;
+
+	std::vector<char> compressed;
+	std::vector<char> records;
+	uint64_t nextBlock;
+	uint64_t skipRecords;
+	size_t blockRecords;
+	size_t blockPos;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,67 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+
+#ifndef _H_SST_PROSPERO_BLOCK_FORMAT
+#define _H_SST_PROSPERO_BLOCK_FORMAT
+
+#include <stdint.h>
+
+/*
+ * Seekable block-compressed binary trace, written by sst-prospero-blocktrace.
+ *
+ *   ProsperoBlockTraceHeader
+ *   blockCount x { ProsperoBlockTraceBlock, compressedLength bytes of zlib data }
+ *   blockCount x ProsperoBlockTraceIndexEntry
+ *   ProsperoBlockTraceFooter
+ *
+ * Each block holds up to recordsPerBlock binary trace records
+ * (PROSPERO_BINARY_RECORD_LENGTH bytes each) compressed independently, so a
+ * reader can use the index to start decompressing at any block.
+ */
+
+// Binary records are: uint64 cycle, char type ('R'/'W'), uint64 address, uint32 length
+#define PROSPERO_BINARY_RECORD_LENGTH (sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t))
+
+#define PROSPERO_BLOCK_TRACE_MAGIC   "PROSBLKZ"
+#define PROSPERO_BLOCK_TRACE_VERSION 1
+
+struct ProsperoBlockTraceHeader {
+	char     magic[8];
+	uint32_t version;
+	uint32_t recordLength;
+	uint32_t recordsPerBlock;
+	uint32_t reserved;
+};
+
+struct ProsperoBlockTraceBlock {
+	uint32_t compressedLength;
+	uint32_t recordCount;
+};
+
+struct ProsperoBlockTraceIndexEntry {
+	uint64_t offset;
+	uint64_t firstRecord;
+};
+
+struct ProsperoBlockTraceFooter {
+	uint64_t indexOffset;
+	uint64_t blockCount;
+	uint64_t recordCount;
+	char     magic[8];
+};
+
+#endif
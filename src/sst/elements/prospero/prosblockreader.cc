@@ -0,0 +1,175 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "prosblockreader.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+using namespace SST::Prospero;
+
+ProsperoBlockTraceReader::ProsperoBlockTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out),
+	blocksProduced(0), blocksReleased(0), stopping(false),
+	current(NULL), currentPos(0), traceEnded(false) {
+
+	startEntry = params.find<uint64_t>("start_entry", 0);
+
+	const uint32_t blockCount = std::max(params.find<uint32_t>("buffer_blocks", 2), (uint32_t) 2);
+	const size_t blockEntries = std::max(params.find<size_t>("block_entries", 65536), (size_t) 1);
+
+	blocks.resize(blockCount);
+	for(uint32_t i = 0; i < blockCount; ++i) {
+		blocks[i].entries.resize(blockEntries);
+		blocks[i].count = 0;
+	}
+}
+
+ProsperoBlockTraceReader::~ProsperoBlockTraceReader() {
+	stopDecoder();
+}
+
+void ProsperoBlockTraceReader::startDecoder() {
+	decoder = std::thread(&ProsperoBlockTraceReader::decodeLoop, this);
+}
+
+void ProsperoBlockTraceReader::stopDecoder() {
+	if(decoder.joinable()) {
+		{
+			std::lock_guard<std::mutex> guard(blockLock);
+			stopping = true;
+		}
+		blockFree.notify_all();
+		decoder.join();
+	}
+}
+
+void ProsperoBlockTraceReader::decodeBinaryRecords(const char* records, const size_t count,
+	ProsperoTraceEntry* entries) {
+
+	for(size_t i = 0; i < count; ++i) {
+		const char* record = records + (i * PROSPERO_BINARY_RECORD_LENGTH);
+
+		uint64_t reqCycles;
+		char reqType;
+		uint64_t reqAddress;
+		uint32_t reqLength;
+
+		memcpy(&reqCycles,  record, sizeof(uint64_t));
+		memcpy(&reqType,    record + sizeof(uint64_t), sizeof(char));
+		memcpy(&reqAddress, record + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+		memcpy(&reqLength,  record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+		entries[i] = ProsperoTraceEntry(reqCycles, reqAddress, reqLength,
+			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
+	}
+}
+
+const ProsperoTraceEntry* ProsperoBlockTraceReader::readNextEntry() {
+	if(NULL == current || currentPos == current->count) {
+		if(!nextBlock()) {
+			return NULL;
+		}
+	}
+
+	return &current->entries[currentPos++];
+}
+
+// Release the block just replayed (the entry handed out last is in it, so this
+// only happens on the following call) and wait for the next one
+bool ProsperoBlockTraceReader::nextBlock() {
+	if(traceEnded) {
+		return false;
+	}
+
+	std::unique_lock<std::mutex> guard(blockLock);
+
+	if(NULL != current) {
+		blocksReleased++;
+		current = NULL;
+		blockFree.notify_one();
+	}
+
+	blockReady.wait(guard, [this] { return blocksProduced > blocksReleased; });
+
+	Block* next = &blocks[blocksReleased % blocks.size()];
+	guard.unlock();
+
+	if(0 == next->count) {
+		if(!next->error.empty()) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: %s\n", getName().c_str(), next->error.c_str());
+		}
+
+		output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
+		traceEnded = true;
+		return false;
+	}
+
+	current = next;
+	currentPos = 0;
+	return true;
+}
+
+// Decode thread: fill free blocks in order until the trace ends
+void ProsperoBlockTraceReader::decodeLoop() {
+	uint64_t skip = 0;
+	if(startEntry > 0 && !seekToEntry(startEntry)) {
+		skip = startEntry;
+	}
+
+	while(true) {
+		Block* block;
+		{
+			std::unique_lock<std::mutex> guard(blockLock);
+			blockFree.wait(guard, [this] { return stopping || (blocksProduced - blocksReleased) < blocks.size(); });
+			if(stopping) {
+				return;
+			}
+			block = &blocks[blocksProduced % blocks.size()];
+		}
+
+		ProsperoTraceEntry* entries = block->entries.data();
+		const size_t maxEntries = block->entries.size();
+
+		block->error.clear();
+		size_t count = decodeEntries(entries, maxEntries, block->error);
+
+		while(skip > 0 && count > 0) {
+			if(count <= skip) {
+				skip -= count;
+				count = decodeEntries(entries, maxEntries, block->error);
+			} else {
+				std::copy(entries + skip, entries + count, entries);
+				count -= skip;
+				skip = 0;
+			}
+		}
+
+		block->count = count;
+
+		{
+			std::lock_guard<std::mutex> guard(blockLock);
+			blocksProduced++;
+		}
+		blockReady.notify_one();
+
+		if(0 == count) {
+			return;
+		}
+	}
+}
@@ -0,0 +1,96 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_BLOCK_READER
+#define _H_SST_PROSPERO_BLOCK_READER
+
+#include "prosreader.h"
+#include "prosblockformat.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SST {
+namespace Prospero {
+
+/*
+ * Common base for the trace readers. A background thread decodes the trace
+ * a block of entries at a time into a ring of buffer_blocks blocks (two by
+ * default, so one is decoded while the other is replayed), and readNextEntry
+ * hands out pointers into the ring.
+ *
+ * Derived readers implement decodeEntries, which always runs on the decode
+ * thread, and optionally seekToEntry. They must call startDecoder at the end
+ * of their constructor and stopDecoder at the start of their destructor.
+ */
+class ProsperoBlockTraceReader : public ProsperoTraceReader {
+
+public:
+	ProsperoBlockTraceReader( ComponentId_t id, Params& params, Output* out );
+	~ProsperoBlockTraceReader();
+	const ProsperoTraceEntry* readNextEntry();
+
+protected:
+	void startDecoder();
+	void stopDecoder();
+
+	// Decode up to maxEntries entries, returns the number decoded, 0 at the end
+	// of the trace. On a read or format error set error and return 0
+	virtual size_t decodeEntries(ProsperoTraceEntry* entries, const size_t maxEntries, std::string& error) = 0;
+
+	// Position the trace so the next decoded entry is entry number startEntry.
+	// Readers that cannot seek return false and the entries are decoded and dropped
+	virtual bool seekToEntry(const uint64_t startEntry) { return false; }
+
+	static void decodeBinaryRecords(const char* records, const size_t count, ProsperoTraceEntry* entries);
+
+	uint64_t startEntry;
+
+private:
+	struct Block {
+		std::vector<ProsperoTraceEntry> entries;
+		size_t count;
+		std::string error;
+	};
+
+	bool nextBlock();
+	void decodeLoop();
+
+	std::vector<Block> blocks;
+
+	// Shared with the decode thread
+	std::thread decoder;
+	std::mutex blockLock;
+	std::condition_variable blockReady;
+	std::condition_variable blockFree;
+	uint64_t blocksProduced;
+	uint64_t blocksReleased;
+	bool stopping;
+
+	// Owned by the simulation thread
+	Block* current;
+	size_t currentPos;
+	bool traceEnded;
+
+};
+
+}
+}
+
+#endif
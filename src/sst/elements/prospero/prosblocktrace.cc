@@ -0,0 +1,169 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <vector>
+
+#include "zlib.h"
+
+#include "prosblockformat.h"
+
+void printUsage() {
+	printf("sst-prospero-blocktrace [options] <input trace> <output trace>\n");
+	printf("\n");
+	printf("Converts a binary or compressed binary Prospero trace into the seekable block\n");
+	printf("compressed format read by prospero.ProsperoBlockCompressedTraceReader.\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("  -b <records>  Records per compressed block (default 65536)\n");
+	printf("  -l <level>    zlib compression level 1-9 (default 6)\n");
+	printf("\n");
+}
+
+void writeOrDie(const void* data, size_t length, FILE* out, const char* outPath) {
+	if(length > 0 && 1 != fwrite(data, length, 1, out)) {
+		fprintf(stderr, "Error: unable to write to %s\n", outPath);
+		exit(-1);
+	}
+}
+
+int main(int argc, char* argv[]) {
+	uint32_t recordsPerBlock = 65536;
+	int level = 6;
+
+	int opt;
+	while((opt = getopt(argc, argv, "b:l:h")) != -1) {
+		switch(opt) {
+		case 'b':
+			recordsPerBlock = (uint32_t) std::strtoul(optarg, NULL, 10);
+			break;
+		case 'l':
+			level = std::atoi(optarg);
+			break;
+		default:
+			printUsage();
+			exit('h' == opt ? 0 : -1);
+		}
+	}
+
+	if(argc - optind != 2 || 0 == recordsPerBlock || level < 1 || level > 9) {
+		printUsage();
+		exit(-1);
+	}
+
+	const char* inPath = argv[optind];
+	const char* outPath = argv[optind + 1];
+
+	// gzread reads uncompressed files as they are
+	gzFile in = gzopen(inPath, "rb");
+	if(Z_NULL == in) {
+		fprintf(stderr, "Error: unable to open input trace %s\n", inPath);
+		exit(-1);
+	}
+	gzbuffer(in, 1024 * 1024);
+
+	FILE* out = fopen(outPath, "wb");
+	if(NULL == out) {
+		fprintf(stderr, "Error: unable to open output trace %s\n", outPath);
+		exit(-1);
+	}
+
+	ProsperoBlockTraceHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, PROSPERO_BLOCK_TRACE_MAGIC, sizeof(header.magic));
+	header.version = PROSPERO_BLOCK_TRACE_VERSION;
+	header.recordLength = PROSPERO_BINARY_RECORD_LENGTH;
+	header.recordsPerBlock = recordsPerBlock;
+	writeOrDie(&header, sizeof(header), out, outPath);
+
+	std::vector<char> records((size_t) recordsPerBlock * PROSPERO_BINARY_RECORD_LENGTH);
+	std::vector<char> compressed(compressBound((uLong) records.size()));
+	std::vector<ProsperoBlockTraceIndexEntry> index;
+
+	uint64_t offset = sizeof(header);
+	uint64_t recordCount = 0;
+	uint64_t compressedBytes = 0;
+
+	while(true) {
+		const int bytesRead = gzread(in, records.data(), (unsigned int) records.size());
+		if(bytesRead < 0) {
+			int zerr;
+			fprintf(stderr, "Error: unable to read input trace %s: %s\n", inPath, gzerror(in, &zerr));
+			exit(-1);
+		}
+
+		// As in the binary readers, a trailing partial record is dropped
+		const uint32_t count = (uint32_t) ((size_t) bytesRead / PROSPERO_BINARY_RECORD_LENGTH);
+		if(0 == count) {
+			break;
+		}
+
+		uLongf compressedLength = (uLongf) compressed.size();
+		if(Z_OK != compress2((Bytef*) compressed.data(), &compressedLength, (const Bytef*) records.data(),
+			(uLong) count * PROSPERO_BINARY_RECORD_LENGTH, level)) {
+			fprintf(stderr, "Error: unable to compress block %zu\n", index.size());
+			exit(-1);
+		}
+
+		ProsperoBlockTraceIndexEntry entry;
+		entry.offset = offset;
+		entry.firstRecord = recordCount;
+		index.push_back(entry);
+
+		ProsperoBlockTraceBlock block;
+		block.compressedLength = (uint32_t) compressedLength;
+		block.recordCount = count;
+		writeOrDie(&block, sizeof(block), out, outPath);
+		writeOrDie(compressed.data(), compressedLength, out, outPath);
+
+		offset += sizeof(block) + compressedLength;
+		recordCount += count;
+		compressedBytes += compressedLength;
+
+		if((size_t) bytesRead < records.size()) {
+			break;
+		}
+	}
+
+	ProsperoBlockTraceFooter footer;
+	memset(&footer, 0, sizeof(footer));
+	footer.indexOffset = offset;
+	footer.blockCount = index.size();
+	footer.recordCount = recordCount;
+	memcpy(footer.magic, PROSPERO_BLOCK_TRACE_MAGIC, sizeof(footer.magic));
+
+	writeOrDie(index.data(), index.size() * sizeof(ProsperoBlockTraceIndexEntry), out, outPath);
+	writeOrDie(&footer, sizeof(footer), out, outPath);
+
+	gzclose(in);
+	if(0 != fclose(out)) {
+		fprintf(stderr, "Error: unable to write to %s\n", outPath);
+		exit(-1);
+	}
+
+	printf("Wrote %" PRIu64 " records in %zu blocks (%" PRIu64 " compressed bytes) to %s\n",
+		recordCount, index.size(), compressedBytes, outPath);
+
+	return 0;
+}
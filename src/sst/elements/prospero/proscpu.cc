@@ -326,7 +326,4 @@ void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
 
 		currentOutstanding++;
 	}
-
-	// Delete this entry, we are done converting it into a request
-	delete entry;
 }
@@ -86,7 +86,7 @@ private:
 
   Output* output;
   ProsperoTraceReader* reader;
-  ProsperoTraceEntry* currentEntry;
+  const ProsperoTraceEntry* currentEntry;
   ProsperoMemoryManager* memMgr;
   StandardMem* cache_link;
   FILE* traceFile;
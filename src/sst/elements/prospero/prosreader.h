@@ -32,6 +32,11 @@ typedef enum {
 
 class ProsperoTraceEntry {
 public:
+	ProsperoTraceEntry() :
+		cycles(0), address(0), length(0), op(READ) {
+
+		}
+
 	ProsperoTraceEntry(
 		const uint64_t eCyc,
 		const uint64_t eAddr,
@@ -48,10 +53,10 @@ public:
 	uint64_t getIssueAtCycle() const { return cycles; }
 	ProsperoTraceEntryOperation getOperationType() const { return op; }
 private:
-	const uint64_t cycles;
-	const uint64_t address;
-	const uint32_t length;
-	const ProsperoTraceEntryOperation op;
+	uint64_t cycles;
+	uint64_t address;
+	uint32_t length;
+	ProsperoTraceEntryOperation op;
 };
 
 class ProsperoTraceReader : public SubComponent {
@@ -64,7 +69,21 @@ public:
         }
 
 	~ProsperoTraceReader() { };
-	virtual ProsperoTraceEntry* readNextEntry() { return NULL; };
+
+	// Returns the next entry or NULL at the end of the trace. The entry is owned
+	// by the reader and is only valid until the next call
+	virtual const ProsperoTraceEntry* readNextEntry() { return NULL; };
+
+	// Copies the next entry out of the reader, returns false at the end of the trace
+	bool copyNextEntry(ProsperoTraceEntry* entry) {
+		const ProsperoTraceEntry* next = readNextEntry();
+		if(NULL == next) {
+			return false;
+		}
+		*entry = *next;
+		return true;
+	}
+
 	void setOutput(Output* out) { output = out; }
 
 protected:
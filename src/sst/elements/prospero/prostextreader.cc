@@ -14,14 +14,16 @@
 // distribution.
 
 
+
 #include "sst_config.h"
 #include "prostextreader.h"
 
 using namespace SST::Prospero;
 
+#define PROSPERO_TEXT_BUFFER_SIZE (1024 * 1024)
 
 ProsperoTextTraceReader::ProsperoTextTraceReader( ComponentId_t id, Params& params, Output* out ) :
-	ProsperoTraceReader(id, params, out) {
+	ProsperoBlockTraceReader(id, params, out), bufferPos(0), bufferLength(0) {
 
 	std::string traceFile = params.find<std::string>("file", "");
 	traceInput = fopen(traceFile.c_str(), "rt");
@@ -31,26 +33,102 @@ ProsperoTextTraceReader::ProsperoTextTraceReader( ComponentId_t id, Params& para
                     getName().c_str(), traceFile.c_str());
 	}
 
+	buffer.resize(PROSPERO_TEXT_BUFFER_SIZE);
+
+	startDecoder();
 }
 
 ProsperoTextTraceReader::~ProsperoTextTraceReader() {
+	stopDecoder();
+
 	if(NULL != traceInput) {
 		fclose(traceInput);
 	}
 }
 
-ProsperoTraceEntry* ProsperoTextTraceReader::readNextEntry() {
-	uint64_t reqAddress = 0;
-	uint64_t reqCycles  = 0;
-	char reqType = 'R';
-	uint32_t reqLength  = 0;
-
-	if(EOF == fscanf(traceInput, "%" PRIu64 " %c %" PRIu64 " %" PRIu32 "",
-		&reqCycles, &reqType, &reqAddress, &reqLength) ) {
-		return NULL;
-	} else {
-		return new ProsperoTraceEntry(reqCycles, reqAddress,
-			reqLength,
+// Next character of the trace without consuming it, EOF at the end of the file
+int ProsperoTextTraceReader::peekChar() {
+	if(bufferPos == bufferLength) {
+		bufferLength = fread(buffer.data(), 1, buffer.size(), traceInput);
+		bufferPos = 0;
+
+		if(0 == bufferLength) {
+			return EOF;
+		}
+	}
+
+	return (unsigned char) buffer[bufferPos];
+}
+
+void ProsperoTextTraceReader::skipSpace() {
+	int next = peekChar();
+	while(' ' == next || '\t' == next || '\n' == next || '\r' == next || '\v' == next || '\f' == next) {
+		bufferPos++;
+		next = peekChar();
+	}
+}
+
+bool ProsperoTextTraceReader::readNumber(uint64_t* value) {
+	skipSpace();
+
+	int next = peekChar();
+	if(next < '0' || next > '9') {
+		return false;
+	}
+
+	uint64_t result = 0;
+	while(next >= '0' && next <= '9') {
+		result = (result * 10) + (uint64_t) (next - '0');
+		bufferPos++;
+		next = peekChar();
+	}
+
+	*value = result;
+	return true;
+}
+
+// Records are "<cycle> <R|W> <address> <length>" separated by any white space
+size_t ProsperoTextTraceReader::decodeEntries(ProsperoTraceEntry* entries, const size_t maxEntries,
+	std::string& error) {
+
+	size_t count = 0;
+
+	while(count < maxEntries) {
+		uint64_t reqCycles  = 0;
+		uint64_t reqAddress = 0;
+		uint64_t reqLength  = 0;
+
+		skipSpace();
+		if(EOF == peekChar()) {
+			break;
+		}
+
+		if(!readNumber(&reqCycles)) {
+			error = "Malformed record in text trace, expected a cycle count";
+			return 0;
+		}
+
+		skipSpace();
+		const int reqType = peekChar();
+		if(EOF == reqType) {
+			error = "Text trace ends part way through a record";
+			return 0;
+		}
+		bufferPos++;
+
+		if(!readNumber(&reqAddress) || !readNumber(&reqLength)) {
+			error = "Malformed record in text trace, expected an address and a length";
+			return 0;
+		}
+
+		entries[count++] = ProsperoTraceEntry(reqCycles, reqAddress, (uint32_t) reqLength,
 			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
 	}
+
+	if(ferror(traceInput)) {
+		error = "Error reading text trace file";
+		return 0;
+	}
+
+	return count;
 }
@@ -14,22 +14,24 @@
 // distribution.
 
 
+
 #ifndef _H_SST_PROSPERO_TEXT_READER
 #define _H_SST_PROSPERO_TEXT_READER
 
-#include "prosreader.h"
+#include "prosblockreader.h"
+
+#include <stdio.h>
 
 using namespace SST::Prospero;
 
 namespace SST {
 namespace Prospero {
 
-class ProsperoTextTraceReader : public ProsperoTraceReader {
+class ProsperoTextTraceReader : public ProsperoBlockTraceReader {
 
 public:
         ProsperoTextTraceReader( ComponentId_t id, Params& params, Output* out );
         ~ProsperoTextTraceReader();
-        ProsperoTraceEntry* readNextEntry();
 
 	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
                	ProsperoTextTraceReader,
@@ -41,11 +43,24 @@ public:
 	)
 
        	SST_ELI_DOCUMENT_PARAMS(
-               	{ "file", "Sets the file for the trace reader to use", "" }
+               	{ "file", "Sets the file for the trace reader to use", "" },
+               	{ "block_entries", "Number of trace entries decoded at a time by the reader thread", "65536" },
+               	{ "buffer_blocks", "Number of decoded blocks buffered ahead of the simulation (at least 2)", "2" },
+               	{ "start_entry", "Index of the first trace entry to replay, earlier entries are parsed and dropped", "0" }
        	)
 
+protected:
+	size_t decodeEntries(ProsperoTraceEntry* entries, const size_t maxEntries, std::string& error);
+
 private:
+	int peekChar();
+	void skipSpace();
+	bool readNumber(uint64_t* value);
+
 	FILE* traceInput;
+	std::vector<char> buffer;
+	size_t bufferPos;
+	size_t bufferLength;
 
 };
 
@@ -8,6 +8,7 @@ traceFile = "File Error"
 traceDir = "Dir Error"
 memSize = "4096"
 useTimingDram="no"
+startEntry = "0"
 
 def main():
     global Tracetype
@@ -15,9 +16,10 @@ def main():
     global traceDir
     global memSize
     global useTimingDram
+    global startEntry
 
     try:
-        opts, args = getopt.getopt(sys.argv[1:], "", ["TraceType=","UseTimingDram=","TraceDir="])
+        opts, args = getopt.getopt(sys.argv[1:], "", ["TraceType=","UseTimingDram=","TraceDir=","StartEntry="])
     except getopt.GetopError as err:
         print(str(err))
         sys.exit(2)
@@ -35,6 +37,9 @@ def main():
                 # print "args are ", o, "and", a
                 Tracetype = "CompressedBinary"
                 traceFile = "sstprospero-0-0-gz.trace"
+            elif a == "blockcompressed":
+                Tracetype = "BlockCompressed"
+                traceFile = "sstprospero-0-0-blk.trace"
             else:
                 print("no match a= ", a)
                 print("Found nothing for o", o)
@@ -43,6 +48,8 @@ def main():
                 useTimingDram = 'yes'
         elif o in ("--TraceDir"):
             traceDir=a
+        elif o in ("--StartEntry"):
+            startEntry=a
         else:
             print("no match for o", o)
             assert False, "Unknown Options !"
@@ -59,7 +66,8 @@ comp_cpu = sst.Component("cpu", "prospero.prosperoCPU")
 comp_cpu.addParams({
        "verbose" : "0",
        "reader" : "prospero.Prospero" + Tracetype + "TraceReader",
-       "readerParams.file" : traceDir + "/" + traceFile
+       "readerParams.file" : traceDir + "/" + traceFile,
+       "readerParams.start_entry" : startEntry
 })
 comp_l1cache = sst.Component("l1cache", "memHierarchy.Cache")
 comp_l1cache.addParams({
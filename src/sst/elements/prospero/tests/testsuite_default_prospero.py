@@ -65,6 +65,23 @@ class testcase_prospero(SSTTestCase):
     def test_prospero_compressed_withtimingdram_using_TAR_traces(self):
         self.prospero_test_template("compressed", WITH_TIMINGDRAM, USE_TAR_TRACES)
 
+    @unittest.skipIf(libz_missing, "test_prospero_blockcompressed_using_TAR_traces test: Requires LIBZ, but LIBZ is not found in build configuration.")
+    def test_prospero_blockcompressed_using_TAR_traces(self):
+        self.prospero_test_template("blockcompressed", NO_TIMINGDRAM, USE_TAR_TRACES)
+
+    @unittest.skipIf(libz_missing, "test_prospero_blockcompressed_withtimingdram_using_TAR_traces test: Requires LIBZ, but LIBZ is not found in build configuration.")
+    def test_prospero_blockcompressed_withtimingdram_using_TAR_traces(self):
+        self.prospero_test_template("blockcompressed", WITH_TIMINGDRAM, USE_TAR_TRACES)
+
+    # Starting mid-trace, on the first entry of a block and inside a block
+    @unittest.skipIf(libz_missing, "test_prospero_blockcompressed_start_block_using_TAR_traces test: Requires LIBZ, but LIBZ is not found in build configuration.")
+    def test_prospero_blockcompressed_start_block_using_TAR_traces(self):
+        self.prospero_start_entry_template(8192)
+
+    @unittest.skipIf(libz_missing, "test_prospero_blockcompressed_start_midblock_using_TAR_traces test: Requires LIBZ, but LIBZ is not found in build configuration.")
+    def test_prospero_blockcompressed_start_midblock_using_TAR_traces(self):
+        self.prospero_start_entry_template(10001)
+
     def test_prospero_text_using_TAR_traces(self):
         self.prospero_test_template("text", NO_TIMINGDRAM, USE_TAR_TRACES)
 
@@ -128,6 +145,13 @@ class testcase_prospero(SSTTestCase):
         trace_files_list = glob.glob(wildcard_filepath)
         self.assertTrue(len(trace_files_list) > 0, "Prospero - No Trace files found in dir {0}".format(prospero_trace_dir))
 
+        # The block compressed trace is converted from the binary trace and
+        # must replay exactly as the binary trace does
+        ref_trace_name = trace_name
+        if trace_name == "blockcompressed":
+            ref_trace_name = "binary"
+            self._create_prospero_blockcompressed_trace_file(prospero_trace_dir)
+
         # Set the various file paths
         if with_timingdram:
             testDataFileName = ("test_prospero_with_timingdram_{0}".format(trace_name))
@@ -142,7 +166,7 @@ class testcase_prospero(SSTTestCase):
             tracetype = "tar"
 
         sdlfile = "{0}/array/trace-common.py".format(test_path)
-        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName.replace(trace_name, ref_trace_name))
         outfile = "{0}/{1}_using_{2}_traces.out".format(outdir, testDataFileName, tracetype)
         errfile = "{0}/{1}_using_{2}_traces.out.err".format(outdir, testDataFileName, tracetype)
         mpioutfiles = "{0}/{1}_using_{2}_traces.out.testfile".format(outdir, testDataFileName, tracetype)
@@ -196,6 +220,57 @@ class testcase_prospero(SSTTestCase):
             self.assertTrue(filesAreTheSame, "Output file {0} does not pass check against the Reference File {1} ".format(outfile, reffile))
 
 
+    # Replays the TAR trace from start_entry with the block compressed reader,
+    # which finds the entry's block through the trace index and drops the
+    # entries before it in that block, and with the binary reader, which
+    # seeks straight to the entry's fixed size record.  Both must produce the
+    # same output, and it must differ from a replay of the whole trace.
+    def prospero_start_entry_template(self, start_entry, testtimeout=240):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        self.testProsperoTARTracesDir = "{0}/testProsperoTARTraces".format(tmpdir)
+        prospero_trace_dir = self.testProsperoTARTracesDir
+
+        wildcard_filepath = "{0}/*.trace".format(prospero_trace_dir)
+        trace_files_list = glob.glob(wildcard_filepath)
+        self.assertTrue(len(trace_files_list) > 0, "Prospero - No Trace files found in dir {0}".format(prospero_trace_dir))
+
+        # The block compressed trace uses 4096 entry blocks
+        self._create_prospero_blockcompressed_trace_file(prospero_trace_dir)
+
+        sdlfile = "{0}/array/trace-common.py".format(test_path)
+        reffile = "{0}/refFiles/test_prospero_wo_timingdram_binary.out".format(test_path)
+
+        outfiles = {}
+        for trace_name in ["binary", "blockcompressed"]:
+            testDataFileName = "test_prospero_wo_timingdram_{0}_start_{1}_using_tar_traces".format(trace_name, start_entry)
+            otherargs = '--model-options=\"--TraceType={0} --UseTimingDram=no --TraceDir={1} --StartEntry={2}\"'.format(trace_name, prospero_trace_dir, start_entry)
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.out.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.out.testfile".format(outdir, testDataFileName)
+
+            log_debug("start_entry = {0}, trace_name = {1}, out file = {2}".format(start_entry, trace_name, outfile))
+
+            self.run_sst(sdlfile, outfile, errfile, other_args = otherargs,
+                         set_cwd=prospero_trace_dir, mpi_out_files=mpioutfiles,
+                         timeout_sec=testtimeout)
+            outfiles[trace_name] = outfile
+
+        ignore_lines = ["WARNING: No components are assigned to"]
+        ignore_lines.append("Notice: memory controller's region is larger than the backend's mem_size")
+        ignore_lines.append("Region: start=")
+
+        filesAreTheSame, statDiffs, othDiffs = testing_stat_output_diff(outfiles["blockcompressed"], outfiles["binary"], ignore_lines, {}, True)
+        if not filesAreTheSame:
+            diffdata = self._prettyPrintDiffs(statDiffs, othDiffs)
+            log_failure(diffdata)
+        self.assertTrue(filesAreTheSame, "Block compressed replay from entry {0} ({1}) does not match the binary replay from the same entry ({2})".format(start_entry, outfiles["blockcompressed"], outfiles["binary"]))
+
+        wholeTrace, statDiffs, othDiffs = testing_stat_output_diff(outfiles["binary"], reffile, ignore_lines, {}, True)
+        self.assertFalse(wholeTrace, "Binary replay from entry {0} ({1}) matches the whole trace replay {2}, start_entry had no effect".format(start_entry, outfiles["binary"], reffile))
+
 #######################
 
     def _setup_prospero_test_dirs(self):
@@ -292,6 +367,20 @@ class testcase_prospero(SSTTestCase):
                 log_debug("Prospero build compressed Traces result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
                 self.assertTrue(rtn.result() == 0, "Compressed Traces failed to compile")
 
+####
+
+    def _create_prospero_blockcompressed_trace_file(self, trace_dir):
+        elem_bin_dir = sstsimulator_conf_get_value_str("SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_BINDIR", "BINDIR_UNDEFINED")
+        filepath_sst_prospero_blocktrace_app = "{0}/sst-prospero-blocktrace".format(elem_bin_dir)
+        self.assertTrue(os.path.isfile(filepath_sst_prospero_blocktrace_app), "Prospero - {0} not found".format(filepath_sst_prospero_blocktrace_app))
+
+        # Small blocks so that the trace spans several of them
+        cmd = "{0} -b 4096 sstprospero-0-0-bin.trace sstprospero-0-0-blk.trace".format(filepath_sst_prospero_blocktrace_app)
+        log_debug("Prospero block compressed Trace build cmd = {0}".format(cmd))
+        rtn = OSCommand(cmd, set_cwd=trace_dir).run()
+        log_debug("Prospero build block compressed Trace result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Block compressed Trace failed to convert")
+
 ####
 
     def _download_prospero_TAR_trace_files(self):
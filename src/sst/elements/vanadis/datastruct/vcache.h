@@ -30,6 +30,10 @@ enum class VanadisCacheRecordDeletion {
     VANADIS_PERFORM_DELETE_ARRAY
 };
 
+// Least recently used cache of up to max_entries records.  Each key maps
+// to its value and to its node in the recency list, so find, store and
+// touch move a record to the front of the list in constant time rather
+// than searching the list for the key.
 template <typename I, typename T, SST::Vanadis::VanadisCacheRecordDeletion D> class VanadisCache {
 public:
     VanadisCache(const size_t cache_entries) : max_entries(cache_entries) { reset(); }
@@ -40,18 +44,7 @@ public:
 
     void clear() {
         for (auto val_itr = data_values.begin(); val_itr != data_values.end(); val_itr++ ) {
-            switch(D) {
-                case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE: 
-                {
-                    delete val_itr->second;
-                } break;
-                case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE_ARRAY:
-                {
-                    delete[] val_itr->second;
-                } break;
-                case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_NO_DELETION:
-                {} break;
-            }
+            delete_value(val_itr->second.value);
         }
 
         ordering_q.clear();
@@ -66,24 +59,29 @@ public:
     bool contains(const I& value) const { return (data_values.find(value) != data_values.end()); }
 
     T find(const I& key) {
-        send_key_to_front(key);
-        return data_values.find(key)->second;
+        auto find_key = data_values.find(key);
+        send_to_front(find_key->second);
+        return find_key->second.value;
     }
 
     void store(const I& key, T value) {
-        if (LIKELY(contains(key))) {
-            send_key_to_front(key);
-	        data_values[key] = value;
+        auto find_key = data_values.find(key);
+
+        if (LIKELY(find_key != data_values.end())) {
+            send_to_front(find_key->second);
+            find_key->second.value = value;
         } else {
             kill_lru_key();
-            data_values.insert(std::pair<I, T>(key, value));
             ordering_q.push_front(key);
+            data_values.insert(std::pair<I, CacheRecord>(key, CacheRecord(value, ordering_q.begin())));
         }
     }
 
     void touch(const I& key) {
-        if (LIKELY(contains(key))) {
-            send_key_to_front(key);
+        auto find_key = data_values.find(key);
+
+        if (LIKELY(find_key != data_values.end())) {
+            send_to_front(find_key->second);
         }
     }
 
@@ -91,55 +89,51 @@ public:
     size_t capacity() const { return max_entries; }
 
 private:
-    void kill_lru_key() {
-        // if we aren't full yet, then keep entries otherwise we will
-        // throw away
-        if (UNLIKELY(ordering_q.size() < max_entries)) {
-            return;
-        }
-
-        const I remove_key = ordering_q.back();
-        ordering_q.pop_back();
+    struct CacheRecord {
+        CacheRecord(T v, typename std::list<I>::iterator itr) : value(v), order_itr(itr) {}
 
-        auto find_key = data_values.find(remove_key);
+        T value;
+        typename std::list<I>::iterator order_itr;
+    };
 
+    void delete_value(T value) {
         switch(D) {
-            case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE: 
+            case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE:
             {
-                delete find_key->second;
+                delete value;
             } break;
             case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE_ARRAY:
             {
-                delete[] find_key->second;
+                delete[] value;
             } break;
             case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_NO_DELETION:
             {} break;
         }
-
-        data_values.erase(find_key);
     }
 
-    void send_key_to_front(const I& key) {
-        bool found_key = false;
-
-        for (auto order_itr = ordering_q.begin(); order_itr != ordering_q.end();) {
-            if (UNLIKELY(key == (*order_itr))) {
-                ordering_q.erase(order_itr);
-                found_key = true;
-                break;
-            } else {
-                order_itr++;
-            }
+    void kill_lru_key() {
+        // if we aren't full yet, then keep entries otherwise we will
+        // throw away
+        if (UNLIKELY(ordering_q.size() < max_entries)) {
+            return;
         }
 
-        if (LIKELY(found_key)) {
-            ordering_q.push_front(key);
-        }
+        auto find_key = data_values.find(ordering_q.back());
+        ordering_q.pop_back();
+
+        delete_value(find_key->second.value);
+        data_values.erase(find_key);
+    }
+
+    // splice relinks the node in place, so the iterator held by the
+    // record stays valid
+    void send_to_front(CacheRecord& record) {
+        ordering_q.splice(ordering_q.begin(), ordering_q, record.order_itr);
     }
 
     const size_t max_entries;
     std::list<I> ordering_q;
-    std::unordered_map<I, T> data_values;
+    std::unordered_map<I, CacheRecord> data_values;
 };
 
 } // namespace Vanadis
@@ -33,6 +33,7 @@
 #include <cstdint>
 #include <sst/core/interfaces/stdMem.h>
 #include <sst/core/subcomponent.h>
+#include <unordered_set>
 
 #define VANADIS_DECODER_ELI_STATISTICS                                                                \
     { "uop_cache_hit", "Count number of times the instruction micro-op cache is hit", "hits", 1 },    \
@@ -115,6 +116,7 @@ public:
         os_handler       = loadUserSubComponent<SST::Vanadis::VanadisCPUOSHandler>("os_handler");
 
         hw_thr = 0;
+        magic_instruction = 0;
 
         os_handler->setThreadLocalStoragePointer(&tls_ptr);
 
@@ -228,9 +230,23 @@ public:
 
     virtual VanadisCPUOSHandler* getOSHandler() { return os_handler; }
 
+    // Instruction encoding the core uses to leave fast-forward, 0 is none.
+    // Decoders record the address of every instruction they see with this
+    // encoding so the core can check retiring instructions against it.
+    void setMagicInstruction(const uint32_t ins) { magic_instruction = ins; }
+    bool isMagicInstructionAddress(const uint64_t addr) const
+    {
+        return magic_instruction_addrs.find(addr) != magic_instruction_addrs.end();
+    }
+
 protected:
     virtual void clearDecoderAfterMisspeculate(SST::Output* output) {};
 
+    void checkMagicInstruction(const uint64_t addr, const uint32_t ins)
+    {
+        if ( UNLIKELY((magic_instruction != 0) && (ins == magic_instruction)) ) { magic_instruction_addrs.insert(addr); }
+    }
+
     uint64_t ip;
     uint64_t icache_line_width;
     uint32_t hw_thr;
@@ -251,6 +267,9 @@ protected:
     bool canIssueStores;
     bool canIssueLoads;
 
+    uint32_t                     magic_instruction;
+    std::unordered_set<uint64_t> magic_instruction_addrs;
+
     Statistic<uint64_t>* stat_uop_hit;
     Statistic<uint64_t>* stat_uop_delayed_rob_full;
     Statistic<uint64_t>* stat_predecode_hit;
@@ -750,6 +750,8 @@ protected:
         const uint32_t ins_mask  = next_ins & MIPS_OP_MASK;
         const uint32_t func_mask = next_ins & MIPS_FUNC_MASK;
 
+        checkMagicInstruction(ins_addr, next_ins);
+
         if ( 0 != (ins_addr & 0x3) ) {
             output->verbose(
                 CALL_INFO, 16, VANADIS_DBG_DECODER_FLG, "[decode] ---> fault address 0x%llu is not aligned at 4 bytes.\n", ins_addr);
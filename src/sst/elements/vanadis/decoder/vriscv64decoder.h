@@ -311,6 +311,8 @@ protected:
         output->verbose(CALL_INFO, 16, 0, "[decode] -> addr: 0x%llx / ins: 0x%08x\n", ins_address, ins);
         output->verbose(CALL_INFO, 16, 0, "[decode] -> ins-bytes: 0x%08x\n", ins);
 
+        checkMagicInstruction(ins_address, ins);
+
         // We are supposed to have 16b packets for RISCV instructions, if we don't then mark fault
         if ( (ins_address & 0x1) != 0 ) {
             bundle->addInstruction(new VanadisInstructionDecodeAlignmentFault(ins_address, hw_thr, options));
@@ -18,6 +18,7 @@
 
 #include "decoder/visaopts.h"
 #include "inst/regfile.h"
+#include "inst/vinstpool.h"
 #include "inst/vinsttype.h"
 #include "inst/vregfmt.h"
 
@@ -47,30 +48,9 @@ public:
         count_isa_fp_reg_in(c_isa_fp_reg_in),
         count_isa_fp_reg_out(c_isa_fp_reg_out)
     {
-        phys_int_regs_in = (count_phys_int_reg_in > 0) ? new uint16_t[count_phys_int_reg_in] : nullptr;
-        std::memset(phys_int_regs_in, 0, count_phys_int_reg_in * sizeof( uint16_t ));
-
-        phys_int_regs_out = (count_phys_int_reg_out > 0) ? new uint16_t[count_phys_int_reg_out] : nullptr;
-        std::memset(phys_int_regs_out, 0, count_phys_int_reg_out * sizeof( uint16_t ) );
-  
-        isa_int_regs_in = (count_isa_int_reg_in > 0) ? new uint16_t[count_isa_int_reg_in] : nullptr;
-        std::memset(isa_int_regs_in, 0, count_isa_int_reg_in * sizeof( uint16_t ));
- 
-        isa_int_regs_out = (count_isa_int_reg_out > 0) ? new uint16_t[count_isa_int_reg_out] : nullptr;
-        std::memset(isa_int_regs_out, 0, count_isa_int_reg_out * sizeof( uint16_t ) );
-
-        phys_fp_regs_in = (count_phys_fp_reg_in > 0) ? new uint16_t[count_phys_fp_reg_in] : nullptr;
-        std::memset(phys_fp_regs_in, 0, count_phys_fp_reg_in * sizeof( uint16_t ));
-
-        phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? new uint16_t[count_phys_fp_reg_out] : nullptr;
-        std::memset(phys_fp_regs_out, 0, count_phys_fp_reg_out * sizeof( uint16_t ));
-
-        isa_fp_regs_in = (count_isa_fp_reg_in > 0) ? new uint16_t[count_isa_fp_reg_in] : nullptr;
-        std::memset(isa_fp_regs_in, 0, count_isa_fp_reg_in * sizeof( uint16_t ) );
-
-        isa_fp_regs_out = (count_isa_fp_reg_out > 0) ? new uint16_t[count_isa_fp_reg_out] : nullptr;
-        std::memset(isa_fp_regs_out, 0, count_isa_fp_reg_out * sizeof( uint16_t ));
-  
+        allocateRegisters();
+        if ( reg_block != nullptr ) std::memset(reg_block, 0, reg_block_count * sizeof(uint16_t));
+
         trapError             = false;
         hasExecuted           = false;
         hasIssued             = false;
@@ -82,14 +62,7 @@ public:
 
     virtual ~VanadisInstruction()
     {
-        if ( phys_int_regs_in != nullptr ) delete[] phys_int_regs_in;
-        if ( phys_int_regs_out != nullptr ) delete[] phys_int_regs_out;
-        if ( isa_int_regs_in != nullptr ) delete[] isa_int_regs_in;
-        if ( isa_int_regs_out != nullptr ) delete[] isa_int_regs_out;
-        if ( phys_fp_regs_in != nullptr ) delete[] phys_fp_regs_in;
-        if ( phys_fp_regs_out != nullptr ) delete[] phys_fp_regs_out;
-        if ( isa_fp_regs_in != nullptr ) delete[] isa_fp_regs_in;
-        if ( isa_fp_regs_out != nullptr ) delete[] isa_fp_regs_out;
+        releaseRegisters();
     }
 
     VanadisInstruction(const VanadisInstruction& copy_me) :
@@ -114,63 +87,14 @@ public:
         isFrontOfROB          = false;
         hasROBSlot            = false;
 
-        phys_int_regs_in  = (count_phys_int_reg_in > 0) ? new uint16_t[count_phys_int_reg_in] : nullptr;
-        phys_int_regs_out = (count_phys_int_reg_out > 0) ? new uint16_t[count_phys_int_reg_out] : nullptr;
-
-        isa_int_regs_in  = (count_isa_int_reg_in > 0) ? new uint16_t[count_isa_int_reg_in] : nullptr;
-        isa_int_regs_out = (count_isa_int_reg_out > 0) ? new uint16_t[count_isa_int_reg_out] : nullptr;
-
-        phys_fp_regs_in  = (count_phys_fp_reg_in > 0) ? new uint16_t[count_phys_fp_reg_in] : nullptr;
-        phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? new uint16_t[count_phys_fp_reg_out] : nullptr;
-
-        isa_fp_regs_in  = (count_isa_fp_reg_in > 0) ? new uint16_t[count_isa_fp_reg_in] : nullptr;
-        isa_fp_regs_out = (count_isa_fp_reg_out > 0) ? new uint16_t[count_isa_fp_reg_out] : nullptr;
-
-        /*
-        std::memcpy(phys_int_regs_in, copy_me.phys_int_regs_in, count_phys_int_reg_in);
-        std::memcpy(phys_int_regs_out, copy_me.phys_int_regs_out, count_phys_int_reg_out);
-        std::memcpy(isa_int_regs_in, copy_me.isa_int_regs_in, count_isa_int_reg_in);
-        std::memcpy(isa_int_regs_out, copy_me.isa_int_regs_out, count_isa_int_reg_out);
-
-        std::memcpy(phys_fp_regs_in, copy_me.phys_fp_regs_in, count_phys_fp_reg_in);
-        std::memcpy(phys_fp_regs_out, copy_me.phys_fp_regs_out, count_phys_fp_reg_out);
-        std::memcpy(isa_fp_regs_in, copy_me.isa_fp_regs_in, count_isa_fp_reg_in);
-        std::memcpy(isa_fp_regs_out, copy_me.isa_fp_regs_out, count_isa_fp_reg_out);
-        */
-
-        for ( uint16_t i = 0; i < count_phys_int_reg_in; ++i ) {
-            phys_int_regs_in[i] = copy_me.phys_int_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_phys_int_reg_out; ++i ) {
-            phys_int_regs_out[i] = copy_me.phys_int_regs_out[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_int_reg_in; ++i ) {
-            isa_int_regs_in[i] = copy_me.isa_int_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_int_reg_out; ++i ) {
-            isa_int_regs_out[i] = copy_me.isa_int_regs_out[i];
-        }
-
-        for ( uint16_t i = 0; i < count_phys_fp_reg_in; ++i ) {
-            phys_fp_regs_in[i] = copy_me.phys_fp_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_phys_fp_reg_out; ++i ) {
-            phys_fp_regs_out[i] = copy_me.phys_fp_regs_out[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_fp_reg_in; ++i ) {
-            isa_fp_regs_in[i] = copy_me.isa_fp_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_fp_reg_out; ++i ) {
-            isa_fp_regs_out[i] = copy_me.isa_fp_regs_out[i];
-        }
+        allocateRegisters();
+        if ( reg_block != nullptr ) std::memcpy(reg_block, copy_me.reg_block, reg_block_count * sizeof(uint16_t));
     }
 
+    // Instructions and their register arrays come from the instruction pool
+    static void* operator new(std::size_t size) { return VanadisInstructionPool::allocate(size); }
+    static void  operator delete(void* ptr, std::size_t size) { VanadisInstructionPool::release(ptr, size); }
+
     void writeIntRegs(char* buffer, size_t max_buff_size)
     {
         size_t index_so_far = 0;
@@ -377,6 +301,37 @@ public:
     virtual void updateFPFlags() {}
 
 protected:
+    // Change the number of integer registers, for instructions which need
+    // more than their base class set up. Integer registers are cleared,
+    // floating point registers are kept.
+    void resizeIntRegisters(
+        const uint16_t c_phys_int_reg_in, const uint16_t c_phys_int_reg_out, const uint16_t c_isa_int_reg_in,
+        const uint16_t c_isa_int_reg_out)
+    {
+        uint16_t* const old_block       = reg_block;
+        const uint32_t  old_block_count = reg_block_count;
+        const uint32_t  old_int_count =
+            count_phys_int_reg_in + count_phys_int_reg_out + count_isa_int_reg_in + count_isa_int_reg_out;
+
+        count_phys_int_reg_in  = c_phys_int_reg_in;
+        count_phys_int_reg_out = c_phys_int_reg_out;
+        count_isa_int_reg_in   = c_isa_int_reg_in;
+        count_isa_int_reg_out  = c_isa_int_reg_out;
+
+        allocateRegisters();
+
+        const uint32_t int_count = count_phys_int_reg_in + count_phys_int_reg_out + count_isa_int_reg_in + count_isa_int_reg_out;
+        if ( int_count > 0 ) std::memset(reg_block, 0, int_count * sizeof(uint16_t));
+        // The FP arrays follow the integer ones in both blocks. Any of them
+        // may be empty, so copy by block offset rather than through the
+        // FP array pointers, which are null for empty arrays.
+        if ( reg_block_count > int_count )
+            std::memcpy(
+                reg_block + int_count, old_block + old_int_count, (reg_block_count - int_count) * sizeof(uint16_t));
+
+        if ( old_block != nullptr ) VanadisInstructionPool::release(old_block, old_block_count * sizeof(uint16_t));
+    }
+
     const uint64_t ins_address;
     const uint32_t hw_thread;
 
@@ -390,6 +345,10 @@ protected:
     uint16_t count_isa_fp_reg_in;
     uint16_t count_isa_fp_reg_out;
 
+    // All eight register arrays live in one block, in this order
+    uint16_t* reg_block;
+    uint32_t  reg_block_count;
+
     uint16_t* phys_int_regs_in;
     uint16_t* phys_int_regs_out;
     uint16_t* isa_int_regs_in;
@@ -409,6 +368,41 @@ protected:
     bool hasROBSlot;
 
     const VanadisDecoderOptions* isa_options;
+
+private:
+    void allocateRegisters()
+    {
+        reg_block_count = count_phys_int_reg_in + count_phys_int_reg_out + count_isa_int_reg_in +
+                          count_isa_int_reg_out + count_phys_fp_reg_in + count_phys_fp_reg_out + count_isa_fp_reg_in +
+                          count_isa_fp_reg_out;
+        reg_block       = (reg_block_count > 0)
+                              ? (uint16_t*)VanadisInstructionPool::allocate(reg_block_count * sizeof(uint16_t))
+                              : nullptr;
+
+        uint16_t* next_reg = reg_block;
+
+        phys_int_regs_in  = (count_phys_int_reg_in > 0) ? next_reg : nullptr;
+        next_reg += count_phys_int_reg_in;
+        phys_int_regs_out = (count_phys_int_reg_out > 0) ? next_reg : nullptr;
+        next_reg += count_phys_int_reg_out;
+        isa_int_regs_in   = (count_isa_int_reg_in > 0) ? next_reg : nullptr;
+        next_reg += count_isa_int_reg_in;
+        isa_int_regs_out  = (count_isa_int_reg_out > 0) ? next_reg : nullptr;
+        next_reg += count_isa_int_reg_out;
+
+        phys_fp_regs_in  = (count_phys_fp_reg_in > 0) ? next_reg : nullptr;
+        next_reg += count_phys_fp_reg_in;
+        phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? next_reg : nullptr;
+        next_reg += count_phys_fp_reg_out;
+        isa_fp_regs_in   = (count_isa_fp_reg_in > 0) ? next_reg : nullptr;
+        next_reg += count_isa_fp_reg_in;
+        isa_fp_regs_out  = (count_isa_fp_reg_out > 0) ? next_reg : nullptr;
+    }
+
+    void releaseRegisters()
+    {
+        if ( reg_block != nullptr ) VanadisInstructionPool::release(reg_block, reg_block_count * sizeof(uint16_t));
+    }
 };
 
 } // namespace Vanadis
@@ -0,0 +1,43 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_INSTRUCTION_POOL
+#define _H_VANADIS_INSTRUCTION_POOL
+
+#include "sst/elements/common/recyclingPool.h"
+
+namespace SST {
+namespace Vanadis {
+
+// Recycling allocator for instructions
+//
+// Every fetch of a cached bundle clones the prototype instructions for the
+// ROB and every retire or pipeline clear deletes them again. VanadisInstruction
+// and its subclasses, and their register index arrays, allocate through here.
+// Instruction classes of the same size share a free list, so a retired
+// instruction is reused by the next clone of any instruction of that size.
+// The allocator itself is the shared RecyclingPool; bins hold at most 4096
+// blocks per thread, well above what a ROB keeps in flight.
+//
+// The pool is off by default. Its effect on simulation speed has not been
+// measured on the vanadis test programs; the instruction_pool statistics
+// show how many allocations it serves.
+class VanadisInstructionPool : public SST::Common::RecyclingPool<VanadisInstructionPool, 512, 4096>
+{};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -83,6 +83,7 @@ public:
             "memory_interface", ComponentInfo::SHARE_PORTS | ComponentInfo::INSERT_STATS, getTimeConverter("1ps"),
             new StandardMem::Handler<SST::Vanadis::VanadisBasicLoadStoreQueue>(
                 this, &VanadisBasicLoadStoreQueue::processIncomingDataCacheEvent));
+        func_mem_if = memInterface;
 
         address_mask = params.find<uint64_t>("address_mask", 0xFFFFFFFFFFFFFFFFULL);
 
@@ -520,6 +521,11 @@ protected:
         assert(ev != nullptr);
         assert(std_mem_handlers != nullptr);
 
+        // fills and write-backs for functional fast-forward
+        if(handleFunctionalResponse(ev)) {
+            return;
+        }
+
         ev->handle(std_mem_handlers);
         output->verbose(CALL_INFO, 16, 0, "completed pass off to incoming handlers\n");
     }
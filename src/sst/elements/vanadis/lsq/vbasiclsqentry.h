@@ -1,3 +1,6 @@
+#ifndef _H_VANADIS_BASIC_LSQ_ENTRY
+#define _H_VANADIS_BASIC_LSQ_ENTRY
+
 
 #include <sst/core/interfaces/stdMem.h>
 
@@ -246,4 +249,6 @@ protected:
 };
 
 }
-}
\ No newline at end of file
+}
+
+#endif
@@ -0,0 +1,148 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_FUNCTIONAL_MEMORY
+#define _H_VANADIS_FUNCTIONAL_MEMORY
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Sparse image of the memory a core touches in functional fast-forward.
+// Lines are keyed by virtual address. A line is read through the data cache
+// the first time it is touched, so the TLB translates it and the OS can
+// fault the page in. After that, loads and stores only use the image. Dirty
+// lines are written back through the data cache when the image is flushed.
+class VanadisFunctionalMemory {
+public:
+    VanadisFunctionalMemory() : line_width(64) {}
+
+    // Only takes effect while the image is empty
+    void setLineWidth(const uint64_t width) {
+        if ( (width > 0) && lines.empty() && fills.empty() ) { line_width = width; }
+    }
+
+    uint64_t getLineWidth() const { return line_width; }
+    uint64_t lineOf(const uint64_t address) const { return address - (address % line_width); }
+
+    // True when every line of [address, address + width) is present. Lines
+    // that are missing and not already being filled are added to missing.
+    bool contains(const uint64_t address, const uint64_t width, std::vector<uint64_t>& missing) {
+        bool present = true;
+
+        for ( uint64_t line = lineOf(address); line < (address + width); line += line_width ) {
+            if ( lines.find(line) == lines.end() ) {
+                present = false;
+
+                if ( fills.insert(line).second ) { missing.push_back(line); }
+            }
+        }
+
+        return present;
+    }
+
+    // True if any line of [address, address + width) could not be read
+    bool faults(const uint64_t address, const uint64_t width) const {
+        for ( uint64_t line = lineOf(address); line < (address + width); line += line_width ) {
+            auto line_itr = lines.find(line);
+
+            if ( (line_itr != lines.end()) && line_itr->second.failed ) { return true; }
+        }
+
+        return false;
+    }
+
+    void install(const uint64_t line, const std::vector<uint8_t>& data, const bool failed) {
+        fills.erase(line);
+
+        Line& new_line = lines[line];
+        new_line.data.assign(line_width, 0);
+        new_line.dirty  = false;
+        new_line.failed = failed;
+
+        if ( !failed ) { std::memcpy(&new_line.data[0], &data[0], std::min((uint64_t)data.size(), line_width)); }
+    }
+
+    // The lines must be present
+    void read(const uint64_t address, const uint64_t width, uint8_t* values) const {
+        for ( uint64_t done = 0; done < width; ) {
+            const uint64_t offset = (address + done) % line_width;
+            const uint64_t count  = std::min(width - done, line_width - offset);
+
+            std::memcpy(&values[done], &lines.at(lineOf(address + done)).data[offset], count);
+            done += count;
+        }
+    }
+
+    void write(const uint64_t address, const uint64_t width, const uint8_t* values) {
+        for ( uint64_t done = 0; done < width; ) {
+            const uint64_t offset = (address + done) % line_width;
+            const uint64_t count  = std::min(width - done, line_width - offset);
+            Line&          line   = lines.at(lineOf(address + done));
+
+            std::memcpy(&line.data[offset], &values[done], count);
+            line.dirty = true;
+            done += count;
+        }
+    }
+
+    bool isDirty() const {
+        for ( auto& next_line : lines ) {
+            if ( next_line.second.dirty ) { return true; }
+        }
+
+        return false;
+    }
+
+    // Calls write_back(line, data) for each dirty line and marks it clean
+    template <typename T>
+    void flush(T write_back) {
+        for ( auto& next_line : lines ) {
+            if ( next_line.second.dirty ) {
+                write_back(next_line.first, next_line.second.data);
+                next_line.second.dirty = false;
+            }
+        }
+    }
+
+    // Drop every line, they will be read again on the next touch. Dirty lines
+    // must be flushed first.
+    void invalidate() { lines.clear(); }
+
+    size_t size() const { return lines.size(); }
+
+private:
+    struct Line {
+        std::vector<uint8_t> data;
+        bool                 dirty;
+        bool                 failed;
+    };
+
+    uint64_t                           line_width;
+    std::unordered_map<uint64_t, Line> lines;
+    std::unordered_set<uint64_t>       fills;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
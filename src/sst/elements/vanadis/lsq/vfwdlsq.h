@@ -0,0 +1,982 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_FORWARDING_LSQ
+#define _H_VANADIS_FORWARDING_LSQ
+
+#include <sst/core/output.h>
+#include <sst/core/subcomponent.h>
+#include <sst/core/interfaces/stdMem.h>
+
+#include "lsq/vlsq.h"
+#include "lsq/vbasiclsqentry.h"
+#include "inst/vstorecond.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cinttypes>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace SST::Interfaces;
+
+namespace SST {
+namespace Vanadis {
+
+// Load-store queue with store-to-load forwarding
+//
+// Follows the same ordering rules as VanadisBasicLoadStoreQueue: operations
+// leave the queue in program order, stores wait in the store buffer until they
+// are at the front of the ROB and fences wait for the thread's loads and stores
+// to drain. The differences are in how the queues are searched:
+//
+// - stores in the store buffer are indexed by cache line, so a load only checks
+//   the stores to the lines it touches
+// - a load that is fully covered by older standard stores takes its value from
+//   their registers byte by byte instead of waiting for them to reach memory
+// - loads in flight are found by request ID and per-thread counts replace the
+//   scans used by fences
+// - store payloads and load results are built in buffers owned by the queue
+class VanadisForwardingLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(VanadisForwardingLoadStoreQueue, "vanadis", "VanadisForwardingLoadStoreQueue",
+                                          SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                          "Implements a load-store queue with store-to-load forwarding for use with the SST standardInterface",
+                                          SST::Vanadis::VanadisLoadStoreQueue)
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS({ "memory_interface", "Set the interface to memory",
+                                          "SST::Interfaces::StandardMem" })
+
+    SST_ELI_DOCUMENT_PORTS({ "dcache_link", "Connects the LSQ to the data cache", {} })
+
+    SST_ELI_DOCUMENT_PARAMS(
+            { "verbose", "Set the verbosity of output for the LSQ", "0" },
+            { "max_stores", "Set the maximum number of stores permitted in the queue", "8" },
+            { "max_loads", "Set the maximum number of loads permitted in the queue", "16" },
+            { "address_mask", "Can mask off address bits if needed during construction of a operation", "0xFFFFFFFFFFFFFFFF"},
+            { "issues_per_cycle", "Maximum number of issues the LSQ can attempt per cycle.", "2"}
+        )
+
+    SST_ELI_DOCUMENT_STATISTICS({ "bytes_read", "Count all the bytes read for data operations", "bytes", 1 },
+                                { "bytes_stored", "Count all the bytes written for data operations", "bytes", 1 },
+                                { "loads_issued", "Count the number of loads issued", "operations", 1 },
+                                { "stores_issued", "Count the number of stores issued", "operations", 1 },
+                                { "fences_issued", "Count the number of fences issued", "operations", 1},
+                                { "loads_executed", "Count the number of loads executed", "operations", 1 },
+                                { "stores_executed", "Count the number of stores executed", "operations", 1 },
+                                { "fences_executed", "Count the number of fences executed", "operations", 1},
+                                { "loads_forwarded", "Count the number of loads whose value came from the store buffer", "operations", 1},
+                                { "load_store_conflicts", "Count the number of times the load at the head of the queue could not issue because it overlaps a store that cannot forward to it", "operations", 1},
+                                { "operations_pending", "Count the number of operations which are held by the LSQ and not ready to be issued to the memory subsystem", "operations", 1},
+                                { "loads_in_flight", "Count the number of loads which are in-flight", "operations", 1},
+                                { "stores_in_flight", "Count the number of stores which are in-flight", "operations", 1},
+                                { "store_buffer_entries", "Count the number of stores held in the store buffer", "operations", 1})
+
+    VanadisForwardingLoadStoreQueue(ComponentId_t id, Params& params) : VanadisLoadStoreQueue(id, params),
+        max_stores(params.find<size_t>("max_stores", 8)),
+        max_loads(params.find<size_t>("max_loads", 16)),
+        max_issue_attempts_per_cycle(params.find("issues_per_cycle", 2)) {
+
+        std_mem_handlers = new VanadisForwardingLoadStoreQueue::StandardMemHandlers(this, output);
+
+        memInterface = loadUserSubComponent<Interfaces::StandardMem>(
+            "memory_interface", ComponentInfo::SHARE_PORTS | ComponentInfo::INSERT_STATS, getTimeConverter("1ps"),
+            new StandardMem::Handler<SST::Vanadis::VanadisForwardingLoadStoreQueue>(
+                this, &VanadisForwardingLoadStoreQueue::processIncomingDataCacheEvent));
+        func_mem_if = memInterface;
+
+        address_mask = params.find<uint64_t>("address_mask", 0xFFFFFFFFFFFFFFFFULL);
+
+        cache_line_width = params.find<uint64_t>("cache_line_width", 64);
+
+        // Store buffer entries are recycled, the buffer never holds more than max_stores
+        store_records.resize(max_stores);
+        for(size_t i = 0; i < max_stores; ++i) {
+            free_store_records.push_back(&store_records[i]);
+        }
+
+        payload.reserve(64);
+        register_value.reserve(64);
+
+        stat_loads_issued = registerStatistic<uint64_t>("loads_issued", "1");
+        stat_stores_issued = registerStatistic<uint64_t>("stores_issued", "1");
+        stat_fences_issued = registerStatistic<uint64_t>("fences_issued", "1");
+
+        stat_loads_executed = registerStatistic<uint64_t>("loads_executed", "1");
+        stat_stores_executed = registerStatistic<uint64_t>("stores_executed", "1");
+        stat_fences_executed = registerStatistic<uint64_t>("fences_executed", "1");
+
+        stat_loads_forwarded = registerStatistic<uint64_t>("loads_forwarded", "1");
+        stat_load_store_conflicts = registerStatistic<uint64_t>("load_store_conflicts", "1");
+
+        stat_loaded_bytes = registerStatistic<uint64_t>("bytes_read", "1");
+        stat_stored_bytes = registerStatistic<uint64_t>("bytes_stored", "1");
+
+        stat_store_buffer_entries = registerStatistic<uint64_t>("store_buffer_entries", "1");
+        stat_stores_pending = registerStatistic<uint64_t>("stores_in_flight", "1");
+        stat_loads_pending = registerStatistic<uint64_t>("loads_in_flight", "1");
+        stat_op_q_size = registerStatistic<uint64_t>("operations_pending", "1");
+    }
+
+    virtual ~VanadisForwardingLoadStoreQueue() {
+        for(auto load_itr = loads_in_flight.begin(); load_itr != loads_in_flight.end(); load_itr++) {
+            if(0 == --load_itr->second->requests) {
+                delete load_itr->second;
+            }
+        }
+
+        delete std_mem_handlers;
+    }
+
+    bool storeFull() override { return op_q.size() >= max_stores; }
+    bool loadFull() override { return op_q.size() >= max_loads; }
+    bool storeBufferFull() override { return std_stores_in_flight.size() >= max_stores; }
+
+    size_t storeSize() override { return op_q.size(); }
+    size_t loadSize() override { return op_q.size(); }
+    size_t storeBufferSize() override { return std_stores_in_flight.size(); }
+
+    void push(VanadisStoreInstruction* store_me) override {
+        op_q.push_back(QueuedOp(VanadisBasicLoadStoreEntryOp::STORE, store_me));
+        stat_store_issued->addData(1);
+    }
+
+    void push(VanadisLoadInstruction* load_me) override {
+        op_q.push_back(QueuedOp(VanadisBasicLoadStoreEntryOp::LOAD, load_me));
+        stat_loads_issued->addData(1);
+    }
+
+    void push(VanadisFenceInstruction* fence) override {
+        op_q.push_back(QueuedOp(VanadisBasicLoadStoreEntryOp::FENCE, fence));
+        stat_fences_issued->addData(1);
+    }
+
+    void clearLSQByThreadID(const uint32_t thread) override {
+        for(auto op_q_itr = op_q.begin(); op_q_itr != op_q.end(); ) {
+            if(op_q_itr->ins->getHWThread() == thread) {
+                op_q_itr = op_q.erase(op_q_itr);
+            } else {
+                ++op_q_itr;
+            }
+        }
+
+        // responses to the loads removed here are dropped when they arrive
+        for(auto load_itr = loads_in_flight.begin(); load_itr != loads_in_flight.end(); ) {
+            LoadRecord* load = load_itr->second;
+
+            if(load->ins->getHWThread() == thread) {
+                load_itr = loads_in_flight.erase(load_itr);
+
+                if(0 == --load->requests) {
+                    threadCount(loads_by_thread, thread)--;
+                    delete load;
+                }
+            } else {
+                ++load_itr;
+            }
+        }
+
+        for(auto store_itr = store_buffer.begin(); store_itr != store_buffer.end(); ) {
+            if((*store_itr)->ins->getHWThread() == thread) {
+                unindexStore(*store_itr);
+                threadCount(stores_by_thread, thread)--;
+                free_store_records.push_back(*store_itr);
+                store_itr = store_buffer.erase(store_itr);
+            } else {
+                ++store_itr;
+            }
+        }
+    }
+
+    // must be implemented to allow the memory system to initialize itself during
+    // boot-up
+    void init(unsigned int phase) override {
+        memInterface->init(phase);
+
+        // update the cache line size each cycle to make sure we get updates
+        cache_line_width = memInterface->getLineSize();
+
+        output->verbose(CALL_INFO, 2, 0, "updating cache line size to: %" PRIu64 "\n", cache_line_width);
+    }
+
+    void printStatus(SST::Output& out) override {
+        if(output->getVerboseLevel() >= 16) {
+            int32_t next_line = 0;
+
+            for(auto op_q_itr = op_q.begin(); op_q_itr != op_q.end(); op_q_itr++) {
+                out.verbose(CALL_INFO, 16, 0, "-> [%4" PRId32 "] type: %5s ins: 0x%8llx thr: %4" PRIu32 "\n",
+                    next_line,
+                    (op_q_itr->op == VanadisBasicLoadStoreEntryOp::LOAD) ? "LOAD" :
+                    (op_q_itr->op == VanadisBasicLoadStoreEntryOp::STORE) ? "STORE" : "FENCE",
+                    op_q_itr->ins->getInstructionAddress(), op_q_itr->ins->getHWThread());
+                next_line++;
+            }
+        }
+    }
+
+    void tick(uint64_t cycle) override {
+        if(output->getVerboseLevel() >= 16) {
+            output->verbose(CALL_INFO, 16, 0, "-> tick LSQ at cycle %" PRIu64 "\n", cycle);
+
+            for(size_t i = 0; i < store_buffer.size(); ++i) {
+                output->verbose(CALL_INFO, 16, 0, "--> stores[%5zu] ins: 0x%llx / thr: %" PRIu32 " / addr: 0x%llx / width: %" PRIu16 "\n",
+                    i, store_buffer[i]->ins->getInstructionAddress(), store_buffer[i]->ins->getHWThread(),
+                    store_buffer[i]->address, store_buffer[i]->width);
+            }
+        }
+
+        stat_op_q_size->addData(op_q.size());
+        stat_loads_pending->addData(loads_in_flight.size());
+        stat_stores_pending->addData(std_stores_in_flight.size());
+        stat_store_buffer_entries->addData(store_buffer.size());
+
+        for(uint32_t attempt = 0; attempt < max_issue_attempts_per_cycle; ++attempt) {
+            // if the attempt failed then stop because it will just fail again this cycle
+            if(!attempt_to_issue(cycle)) {
+                break;
+            }
+        }
+
+        // attempt to issue any front of ROB stores into memory system
+        issueStoreFront();
+    }
+
+protected:
+
+    struct QueuedOp {
+        QueuedOp(VanadisBasicLoadStoreEntryOp op, VanadisInstruction* ins) : op(op), ins(ins) {}
+
+        VanadisBasicLoadStoreEntryOp op;
+        VanadisInstruction*          ins;
+    };
+
+    // A store with a known address that has not been sent to memory yet
+    struct StoreRecord {
+        VanadisStoreInstruction*   ins;
+        uint64_t                   address;
+        uint16_t                   width;
+        bool                       dispatched;
+        StandardMem::Request::id_t request;
+    };
+
+    // A load sent to memory. Split loads have two requests in flight and
+    // assemble their bytes here before the register is written
+    struct LoadRecord {
+        VanadisLoadInstruction* ins;
+        uint64_t                address;
+        uint16_t                width;
+        uint16_t                requests;
+        uint8_t                 data[16];
+    };
+
+    class StandardMemHandlers : public Interfaces::StandardMem::RequestHandler {
+    public:
+        friend class VanadisForwardingLoadStoreQueue;
+
+        StandardMemHandlers(VanadisForwardingLoadStoreQueue* lsq, SST::Output* output) :
+                Interfaces::StandardMem::RequestHandler(output), lsq(lsq) {}
+
+        virtual ~StandardMemHandlers() {}
+
+        virtual void handle(StandardMem::ReadResp* ev) {
+            out->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "-> handle read-response (virt-addr: 0x%llx)\n", ev->vAddr);
+            lsq->stat_loaded_bytes->addData(ev->size);
+
+            auto load_itr = lsq->loads_in_flight.find(ev->getID());
+
+            if(load_itr == lsq->loads_in_flight.end()) {
+                // not found, so previous cleared by a branch mis-predict ignore
+                delete ev;
+                return;
+            }
+
+            LoadRecord* load = load_itr->second;
+            lsq->loads_in_flight.erase(load_itr);
+
+            VanadisLoadInstruction* load_ins = load->ins;
+
+            if(ev->getFail() || (ev->vAddr < 64)) {
+                load_ins->flagError();
+            }
+
+            const uint64_t addr_offset = ev->vAddr - load->address;
+            assert((addr_offset + ev->size) <= sizeof(load->data));
+
+            for(uint64_t i = 0; i < ev->size; ++i) {
+                load->data[addr_offset + i] = ev->data[i];
+            }
+
+            if(0 == --load->requests) {
+                lsq->writeLoadResult(load_ins, load->data, load->width);
+
+                if(out->getVerboseLevel() >= 9) {
+                    out->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_LOAD_FLG,
+                        "---> LSQ Execute: %s (0x%llx / thr: %" PRIu32 ") load data instruction "
+                        "marked executed.\n",
+                        load_ins->getInstCode(), load_ins->getInstructionAddress(), load_ins->getHWThread());
+                }
+
+                load_ins->markExecuted();
+                lsq->stat_loads_executed->addData(1);
+                lsq->threadCount(lsq->loads_by_thread, load_ins->getHWThread())--;
+                delete load;
+            }
+
+            delete ev;
+        }
+
+        virtual void handle(StandardMem::WriteResp* ev) {
+            out->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_STORE_FLG, "-> handle write-response (virt-addr: 0x%llx)\n", ev->vAddr);
+            lsq->stat_stored_bytes->addData(ev->size);
+
+            if ( ev->getFail() ) {
+                if ( !lsq->store_buffer.empty() ) {
+                    StoreRecord* store = lsq->store_buffer.front();
+                    store->ins->flagError();
+
+                    out->verbose(CALL_INFO, 0, 0, "Write failed, instAddr=%#lx pAddr=%#lx vAddr=%#lx\n",
+                            store->ins->getInstructionAddress(), ev->pAddr, ev->vAddr );
+                    return;
+                } else {
+                    out->fatal(CALL_INFO, -1, "Write failed, pAddr=%#lx vAddr=%#lx\n", ev->pAddr, ev->vAddr);
+                }
+            }
+
+            if(lsq->std_stores_in_flight.erase(ev->getID()) > 0) {
+                out->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_STORE_FLG, "--> write-response is a standard store is matched and cleared from in-flight operations successfully.\n");
+                delete ev;
+                return;
+            }
+
+            // this was not a standard store OR was removed by a branch mis-predict
+            if(lsq->store_buffer.empty()) {
+                delete ev;
+                return;
+            }
+
+            StoreRecord* store = lsq->store_buffer.front();
+
+            if(store->dispatched && (store->request == ev->getID())) {
+                VanadisStoreInstruction* store_ins = store->ins;
+
+                switch(store_ins->getTransactionType()) {
+                case MEM_TRANSACTION_LLSC_STORE:
+                {
+                    const uint16_t value_reg = store_ins->getPhysIntRegOut(0);
+
+                    VanadisStoreConditionalInstruction* store_cond_ins = dynamic_cast<VanadisStoreConditionalInstruction*>(store_ins);
+
+                    if(UNLIKELY(nullptr == store_cond_ins)) {
+                        out->fatal(CALL_INFO, -1, "Unable to cast an LLSC_STORE into a store-conditional, logic failure.\n");
+                    }
+
+                    const int64_t result = ev->getSuccess() ? store_cond_ins->getResultSuccess() :
+                        store_cond_ins->getResultFailure();
+
+                    out->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_STORE_FLG, "---> LSQ LLSC-STORE rt: %" PRIu16 " <- %" PRId64 " (%s)\n",
+                        value_reg, result, ev->getSuccess() ? "success" : "failed");
+                    lsq->registerFiles->at(store_ins->getHWThread())->setIntReg<int64_t>(value_reg, result);
+                } break;
+                case MEM_TRANSACTION_LOCK:
+                    break;
+                default:
+                {
+                    // this is a logical error. fatal()
+                    out->fatal(CALL_INFO, -1, "Error - reached a transaction NONE or LLSC_LOAD in a store return. Logical error (ins: 0x%llx / thr: %" PRIu32 ")\n",
+                        store_ins->getInstructionAddress(), store_ins->getHWThread());
+                } break;
+                }
+
+                store_ins->markExecuted();
+                lsq->popStoreFront();
+            }
+
+            delete ev;
+        }
+
+        VanadisForwardingLoadStoreQueue* lsq;
+    };
+
+    void processIncomingDataCacheEvent(StandardMem::Request* ev) {
+        output->verbose(CALL_INFO, 16, 0, "received incoming data cache request -> processIncomingDataCacheEvent()\n");
+
+        assert(ev != nullptr);
+        assert(std_mem_handlers != nullptr);
+
+        // fills and write-backs for functional fast-forward
+        if(handleFunctionalResponse(ev)) {
+            return;
+        }
+
+        ev->handle(std_mem_handlers);
+    }
+
+    uint32_t& threadCount(std::vector<uint32_t>& counts, const uint32_t thr) {
+        if(UNLIKELY(thr >= counts.size())) {
+            counts.resize(thr + 1, 0);
+        }
+
+        return counts[thr];
+    }
+
+    uint64_t lineOf(const uint64_t address) const { return address / cache_line_width; }
+
+    void indexStore(StoreRecord* store) {
+        const uint64_t first_line = lineOf(store->address);
+        const uint64_t last_line  = lineOf(store->address + store->width - 1);
+
+        for(uint64_t line = first_line; line <= last_line; ++line) {
+            store_lines[line].push_back(store);
+        }
+    }
+
+    void unindexStore(StoreRecord* store) {
+        const uint64_t first_line = lineOf(store->address);
+        const uint64_t last_line  = lineOf(store->address + store->width - 1);
+
+        for(uint64_t line = first_line; line <= last_line; ++line) {
+            auto line_itr = store_lines.find(line);
+            assert(line_itr != store_lines.end());
+
+            std::vector<StoreRecord*>& line_stores = line_itr->second;
+
+            for(auto store_itr = line_stores.begin(); store_itr != line_stores.end(); store_itr++) {
+                if(*store_itr == store) {
+                    line_stores.erase(store_itr);
+                    break;
+                }
+            }
+
+            if(line_stores.empty()) {
+                store_lines.erase(line_itr);
+            }
+        }
+    }
+
+    void popStoreFront() {
+        StoreRecord* store = store_buffer.front();
+
+        unindexStore(store);
+        threadCount(stores_by_thread, store->ins->getHWThread())--;
+
+        store_buffer.pop_front();
+        free_store_records.push_back(store);
+    }
+
+    // Stores leave the store buffer in program order so every store in a line
+    // bucket is older than the load being checked. Walking the bucket from the
+    // youngest store, each byte of the load takes its value from the first store
+    // that covers it. The load can only complete from the store buffer if every
+    // byte is covered by a standard store, any other overlap has to wait for the
+    // stores to drain.
+    enum class StoreCheck { NO_CONFLICT, FORWARDED, CONFLICT };
+
+    StoreCheck checkStores(VanadisLoadInstruction* load_ins, const uint64_t load_address, const uint16_t load_width) {
+        const uint32_t thr        = load_ins->getHWThread();
+        const uint64_t first_line = lineOf(load_address);
+        const uint64_t last_line  = lineOf(load_address + load_width - 1);
+
+        bool can_forward = (first_line == last_line) && (load_width <= sizeof(forward_data)) &&
+            (load_ins->getTransactionType() == MEM_TRANSACTION_NONE);
+        bool overlaps = false;
+        uint32_t covered = 0;
+        const uint32_t all_covered = (load_width >= 32) ? 0xFFFFFFFF : ((1U << load_width) - 1);
+
+        for(uint64_t line = first_line; line <= last_line; ++line) {
+            auto line_itr = store_lines.find(line);
+
+            if(line_itr == store_lines.end()) {
+                continue;
+            }
+
+            std::vector<StoreRecord*>& line_stores = line_itr->second;
+
+            for(auto store_itr = line_stores.rbegin(); store_itr != line_stores.rend(); store_itr++) {
+                StoreRecord* store = *store_itr;
+
+                if(store->ins->getHWThread() != thr) {
+                    continue;
+                }
+
+                const uint64_t overlap_start = std::max(load_address, store->address);
+                const uint64_t overlap_end   = std::min(load_address + load_width, store->address + store->width);
+
+                if(overlap_start >= overlap_end) {
+                    continue;
+                }
+
+                overlaps = true;
+
+                if(!can_forward || store->dispatched || (store->ins->getTransactionType() != MEM_TRANSACTION_NONE)) {
+                    return StoreCheck::CONFLICT;
+                }
+
+                VanadisStoreInstruction* store_ins = store->ins;
+                const bool is_fp = store_ins->getValueRegisterType() == STORE_FP_REGISTER;
+                const uint16_t value_reg = is_fp ? store_ins->getPhysFPRegIn(0) : store_ins->getPhysIntRegIn(1);
+
+                for(uint64_t addr = overlap_start; addr < overlap_end; ++addr) {
+                    const uint32_t byte_bit = 1U << (addr - load_address);
+
+                    if((covered & byte_bit) == 0) {
+                        registerFiles->at(thr)->copyFromRegister(value_reg,
+                            store_ins->getRegisterOffset() + (addr - store->address),
+                            &forward_data[addr - load_address], 1, is_fp);
+                        covered |= byte_bit;
+                    }
+                }
+
+                if(covered == all_covered) {
+                    return StoreCheck::FORWARDED;
+                }
+            }
+        }
+
+        return overlaps ? StoreCheck::CONFLICT : StoreCheck::NO_CONFLICT;
+    }
+
+    // Write a completed load's bytes into its target register, extending the
+    // value to the width of the register
+    void writeLoadResult(VanadisLoadInstruction* load_ins, const uint8_t* data, const uint16_t load_width) {
+        const uint32_t hw_thr     = load_ins->getHWThread();
+        const uint64_t reg_offset = load_ins->getRegisterOffset();
+        VanadisRegisterFile* reg_file = registerFiles->at(hw_thr);
+
+        switch(load_ins->getValueRegisterType()) {
+        case LOAD_INT_REGISTER: {
+            const uint16_t target_isa_reg = load_ins->getISAIntRegOut(0);
+            const uint16_t target_reg     = load_ins->getPhysIntRegOut(0);
+
+            assert(target_isa_reg < load_ins->getISAOptions()->countISAIntRegisters());
+
+            if(target_isa_reg == load_ins->getISAOptions()->getRegisterIgnoreWrites()) {
+                break;
+            }
+
+            const uint32_t reg_width = reg_file->getIntRegWidth();
+            register_value.resize(reg_width);
+            reg_file->copyFromIntRegister(target_reg, 0, &register_value[0], reg_width);
+
+            assert((reg_offset + load_width) <= reg_width);
+            std::memcpy(&register_value[reg_offset], data, load_width);
+
+            const uint8_t extend = (load_ins->performSignExtension() &&
+                ((register_value[reg_offset + load_width - 1] & 0x80) != 0)) ? 0xFF : 0x00;
+
+            for(uint64_t i = reg_offset + load_width; i < reg_width; ++i) {
+                register_value[i] = extend;
+            }
+
+            reg_file->copyToIntRegister(target_reg, 0, &register_value[0], reg_width);
+        } break;
+        case LOAD_FP_REGISTER: {
+            const uint16_t target_reg = load_ins->getPhysFPRegOut(0);
+            const uint32_t reg_width  = reg_file->getFPRegWidth();
+
+            register_value.resize(reg_width);
+            reg_file->copyFromFPRegister(target_reg, 0, &register_value[0], reg_width);
+
+            assert((reg_offset + load_width) <= reg_width);
+            std::memcpy(&register_value[reg_offset], data, load_width);
+
+            for(uint64_t i = reg_offset + load_width; i < reg_width; ++i) {
+                register_value[i] = 0x00;
+            }
+
+            reg_file->copyToFPRegister(target_reg, 0, &register_value[0], reg_width);
+        } break;
+        default:
+            output->fatal(CALL_INFO, -1, "Unknown register type.\n");
+        }
+    }
+
+    void issueStoreFront() {
+        if(store_buffer.empty()) {
+            return;
+        }
+
+        StoreRecord* store = store_buffer.front();
+        VanadisStoreInstruction* store_ins = store->ins;
+
+        if(store->dispatched || !store_ins->checkFrontOfROB() || !store_ins->completedIssue()) {
+            return;
+        }
+
+        if(issueStore(store)) {
+            popStoreFront();
+
+            if(output->getVerboseLevel() >= 16) {
+                output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_STORE_FLG, "---> issued store: 0x%llx / thr: %" PRIu32 " into memory system using standard store operation\n",
+                    store_ins->getInstructionAddress(), store_ins->getHWThread());
+            }
+
+            store_ins->markExecuted();
+            stat_stores_executed->addData(1);
+        } else {
+            output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_STORE_FLG, "---> issued non-standard store: 0x%llx / thr: %" PRIu32 " (marked dispatch, will stall until response)\n",
+                store_ins->getInstructionAddress(), store_ins->getHWThread());
+        }
+    }
+
+    // Returns true if the store is complete once sent, false if the store stays
+    // at the head of the store buffer until its response arrives
+    bool issueStore(StoreRecord* store) {
+        VanadisStoreInstruction* store_ins = store->ins;
+        const uint64_t store_address = store->address;
+        const uint64_t store_width   = store->width;
+        const bool     is_fp         = store_ins->getValueRegisterType() == STORE_FP_REGISTER;
+        const uint16_t value_reg     = is_fp ? store_ins->getPhysFPRegIn(0) : store_ins->getPhysIntRegIn(1);
+        VanadisRegisterFile* reg_file = registerFiles->at(store_ins->getHWThread());
+        StandardMem::Request* store_req = nullptr;
+
+        const bool needs_split = lineOf(store_address) != lineOf(store_address + store_width - 1);
+
+        switch(store_ins->getTransactionType()) {
+        case MEM_TRANSACTION_NONE:
+        {
+            if(UNLIKELY(needs_split)) {
+                const uint64_t store_width_right = (store_address + store_width) % cache_line_width;
+                const uint64_t store_width_left  = store_width - store_width_right;
+                const uint64_t store_address_right = store_address + store_width_left;
+
+                if(output->getVerboseLevel() >= 9) {
+                    output->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_STORE_FLG, "---> store-left-at: 0x%llx left-width: %" PRIu64 ", store-right-at: 0x%llx right-width: %" PRIu64 "\n",
+                        store_address, store_width_left, store_address_right, store_width_right);
+                }
+
+                payload.resize(store_width_left);
+                reg_file->copyFromRegister(value_reg, store_ins->getRegisterOffset(), &payload[0], store_width_left, is_fp);
+
+                store_req = new StandardMem::Write(store_address & address_mask, payload.size(), payload,
+                    false, 0, store_address, store_ins->getInstructionAddress(), store_ins->getHWThread());
+                std_stores_in_flight.insert(store_req->getID());
+                memInterface->send(store_req);
+
+                payload.resize(store_width_right);
+                reg_file->copyFromRegister(value_reg, store_ins->getRegisterOffset() + store_width_left, &payload[0],
+                    store_width_right, is_fp);
+
+                store_req = new StandardMem::Write(store_address_right & address_mask, payload.size(), payload,
+                    false, 0, store_address_right, store_ins->getInstructionAddress(), store_ins->getHWThread());
+            } else {
+                payload.resize(store_width);
+                reg_file->copyFromRegister(value_reg, store_ins->getRegisterOffset(), &payload[0], store_width, is_fp);
+
+                if(output->getVerboseLevel() >= 9) {
+                    output->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_STORE_FLG, "---> [memory-transaction]: standard store ins: 0x%llx store-at: 0x%llx width: %" PRIu64 "\n",
+                        store_ins->getInstructionAddress(), store_address, store_width);
+                }
+
+                store_req = new StandardMem::Write(store_address & address_mask, payload.size(), payload,
+                    false, 0, store_address, store_ins->getInstructionAddress(), store_ins->getHWThread());
+            }
+
+            std_stores_in_flight.insert(store_req->getID());
+            memInterface->send(store_req);
+            return true;
+        } break;
+        case MEM_TRANSACTION_LLSC_LOAD:
+        {
+            output->fatal(CALL_INFO, -1, "Error - attempted to issue a LLSC-load via store instruction. Invalid operation.\n");
+        } break;
+        case MEM_TRANSACTION_LLSC_STORE:
+        case MEM_TRANSACTION_LOCK:
+        {
+            if(UNLIKELY(needs_split)) {
+                output->fatal(CALL_INFO, -1, "Error - attempted to perform an %s-store over a split-cache line. This is not permitted.\n",
+                    store_ins->getTransactionType() == MEM_TRANSACTION_LOCK ? "LOCK" : "LLSC");
+            }
+
+            payload.resize(store_width);
+            reg_file->copyFromRegister(value_reg, store_ins->getRegisterOffset(), &payload[0], store_width, is_fp);
+
+            output->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_STORE_FLG, "---> [memory-transaction]: %s-store store-at: 0x%llx width: %" PRIu64 "\n",
+                store_ins->getTransactionType() == MEM_TRANSACTION_LOCK ? "LOCK" : "LLSC", store_address, store_width);
+
+            if(store_ins->getTransactionType() == MEM_TRANSACTION_LOCK) {
+                store_req = new StandardMem::WriteUnlock(store_address & address_mask, payload.size(), payload,
+                            0, store_address, store_ins->getInstructionAddress());
+            } else {
+                store_req = new StandardMem::StoreConditional(store_address & address_mask, payload.size(), payload,
+                            0, store_address, store_ins->getInstructionAddress());
+            }
+        } break;
+        }
+
+        if(nullptr != store_req) {
+            // equivalent to a seg-fault for the store
+            if(store_address < 4096) {
+                store_ins->flagError();
+            }
+
+            memInterface->send(store_req);
+            store->request    = store_req->getID();
+            store->dispatched = true;
+        }
+
+        return false;
+    }
+
+    void issueLoad(VanadisLoadInstruction* load_ins, uint64_t load_address, uint16_t load_width) {
+        const bool needs_split = lineOf(load_address) != lineOf(load_address + load_width - 1);
+
+        if(UNLIKELY(needs_split && (load_ins->getTransactionType() != MEM_TRANSACTION_NONE))) {
+            output->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_LOAD_FLG, "---> load is marked LLSC/LOCK but it requires a cache line split, generates an error\n");
+            load_ins->flagError();
+            return;
+        }
+
+        if(UNLIKELY(load_width > sizeof(LoadRecord::data))) {
+            output->fatal(CALL_INFO, -1, "Error - load of %" PRIu16 " bytes at ins: 0x%llx is wider than the LSQ supports.\n",
+                load_width, load_ins->getInstructionAddress());
+        }
+
+        LoadRecord* load = new LoadRecord();
+        load->ins      = load_ins;
+        load->address  = load_address;
+        load->width    = load_width;
+        load->requests = 0;
+
+        StandardMem::Request* load_req = nullptr;
+
+        switch(load_ins->getTransactionType()) {
+        case MEM_TRANSACTION_NONE:
+        {
+            if(UNLIKELY(needs_split)) {
+                const uint64_t load_width_right = (load_address + load_width) % cache_line_width;
+                const uint64_t load_width_left  = load_width - load_width_right;
+
+                output->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_LOAD_FLG, "---> split load at-left: 0x%llx left-width: %" PRIu64 " / at-right: 0x%llx right-width: %" PRIu64 "\n",
+                    load_address, load_width_left, load_address + load_width_left, load_width_right);
+
+                load_req = new StandardMem::Read(load_address & address_mask, load_width_left, 0,
+                    load_address, load_ins->getInstructionAddress(), load_ins->getHWThread());
+                loads_in_flight[load_req->getID()] = load;
+                load->requests++;
+                memInterface->send(load_req);
+
+                load_req = new StandardMem::Read((load_address + load_width_left) & address_mask, load_width_right, 0,
+                    load_address + load_width_left, load_ins->getInstructionAddress(), load_ins->getHWThread());
+            } else {
+                load_req = new StandardMem::Read(load_address & address_mask, load_width, 0,
+                    load_address, load_ins->getInstructionAddress(), load_ins->getHWThread());
+            }
+        } break;
+        case MEM_TRANSACTION_LLSC_LOAD:
+        {
+            load_req = new StandardMem::LoadLink(load_address & address_mask, load_width, 0,
+                load_address, load_ins->getInstructionAddress(), load_ins->getHWThread());
+        } break;
+        case MEM_TRANSACTION_LOCK:
+        {
+            load_req = new StandardMem::ReadLock(load_address & address_mask, load_width, 0,
+                load_address, load_ins->getInstructionAddress(), load_ins->getHWThread());
+        } break;
+        case MEM_TRANSACTION_LLSC_STORE:
+        {
+            output->fatal(CALL_INFO, -1,
+                "Error - logical error, LOAD instruction is marked with "
+                "an LLSC STORE transaction class.\n");
+        } break;
+        }
+
+        output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "-----> ins: 0x%llx / thr: %" PRIu32 " processed and requests sent to memory system.\n",
+            load_ins->getInstructionAddress(), load_ins->getHWThread());
+
+        loads_in_flight[load_req->getID()] = load;
+        load->requests++;
+        memInterface->send(load_req);
+
+        threadCount(loads_by_thread, load_ins->getHWThread())++;
+    }
+
+    bool attempt_to_issue(uint64_t cycle) {
+        if(op_q.empty()) {
+            return false;
+        }
+
+        QueuedOp& front = op_q.front();
+
+        if(!front.ins->completedIssue()) {
+            return false;
+        }
+
+        switch(front.op) {
+        case VanadisBasicLoadStoreEntryOp::LOAD:
+        {
+            VanadisLoadInstruction* load_ins = (VanadisLoadInstruction*) front.ins;
+
+            if(loads_in_flight.size() >= max_loads) {
+                return false;
+            }
+
+            uint64_t load_address = 0;
+            uint16_t load_width   = 0;
+
+            load_ins->computeLoadAddress(output, registerFiles->at(load_ins->getHWThread()), &load_address, &load_width);
+
+            if(LIKELY(!load_ins->trapsError())) {
+                switch(checkStores(load_ins, load_address, load_width)) {
+                case StoreCheck::NO_CONFLICT:
+                    issueLoad(load_ins, load_address, load_width);
+                    break;
+                case StoreCheck::FORWARDED:
+                    if(output->getVerboseLevel() >= 9) {
+                        output->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_LOAD_FLG, "---> load ins: 0x%llx / thr: %" PRIu32 " forwarded from store buffer (load-addr: 0x%llx / width: %" PRIu16 ")\n",
+                            load_ins->getInstructionAddress(), load_ins->getHWThread(), load_address, load_width);
+                    }
+
+                    if(load_address < 64) {
+                        load_ins->flagError();
+                    }
+
+                    writeLoadResult(load_ins, forward_data, load_width);
+                    load_ins->markExecuted();
+                    stat_loads_forwarded->addData(1);
+                    stat_loads_executed->addData(1);
+                    break;
+                case StoreCheck::CONFLICT:
+                    if(output->getVerboseLevel() >= 16) {
+                        output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "---> load ins: 0x%llx / thr: %" PRIu32 " conflicts with store entry, will not issue until conflict is resolved (load-addr: 0x%llx / width: %" PRIu16 ")\n",
+                            load_ins->getInstructionAddress(), load_ins->getHWThread(), load_address, load_width);
+                    }
+
+                    stat_load_store_conflicts->addData(1);
+                    return false;
+                }
+            }
+
+            op_q.pop_front();
+            return true;
+        } break;
+        case VanadisBasicLoadStoreEntryOp::STORE:
+        {
+            VanadisStoreInstruction* store_ins = (VanadisStoreInstruction*) front.ins;
+
+            if(free_store_records.empty()) {
+                return false;
+            }
+
+            uint64_t store_address = 0;
+            uint16_t store_width   = 0;
+
+            store_ins->computeStoreAddress(output, registerFiles->at(store_ins->getHWThread()), &store_address, &store_width);
+
+            if(store_ins->trapsError()) {
+                output->verbose(CALL_INFO, 16, 0, "----> warning: 0x%llx / thr: %" PRIu32 " traps error, marks executed and does not process.\n",
+                    store_ins->getInstructionAddress(), store_ins->getHWThread());
+                store_ins->markExecuted();
+            } else {
+                StoreRecord* store = free_store_records.back();
+                free_store_records.pop_back();
+
+                store->ins        = store_ins;
+                store->address    = store_address;
+                store->width      = store_width;
+                store->dispatched = false;
+                store->request    = 0;
+
+                store_buffer.push_back(store);
+                indexStore(store);
+                threadCount(stores_by_thread, store_ins->getHWThread())++;
+            }
+
+            op_q.pop_front();
+            return true;
+        } break;
+        case VanadisBasicLoadStoreEntryOp::FENCE:
+        {
+            VanadisFenceInstruction* fence_ins = (VanadisFenceInstruction*) front.ins;
+            const uint32_t thr = fence_ins->getHWThread();
+
+            bool can_execute = true;
+
+            if(fence_ins->createsLoadFence()) {
+                can_execute = (0 == threadCount(loads_by_thread, thr));
+            }
+
+            if(fence_ins->createsStoreFence()) {
+                // stores are fenced if there are no pending stores AND all issued to the memory system
+                // have returned so are currently visible.
+                can_execute = can_execute && (0 == threadCount(stores_by_thread, thr)) &&
+                    std_stores_in_flight.empty();
+            }
+
+            if(can_execute) {
+                fence_ins->markExecuted();
+                stat_fences_executed->addData(1);
+                op_q.pop_front();
+                return true;
+            }
+
+            return false;
+        } break;
+        }
+
+        return false;
+    }
+
+    std::deque<QueuedOp> op_q;
+
+    std::deque<StoreRecord*>                                 store_buffer;
+    std::unordered_map<uint64_t, std::vector<StoreRecord*>> store_lines;
+    std::vector<StoreRecord>                                 store_records;
+    std::vector<StoreRecord*>                                free_store_records;
+
+    std::unordered_map<StandardMem::Request::id_t, LoadRecord*> loads_in_flight;
+    std::unordered_set<StandardMem::Request::id_t>              std_stores_in_flight;
+
+    std::vector<uint32_t> loads_by_thread;
+    std::vector<uint32_t> stores_by_thread;
+
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> register_value;
+    uint8_t              forward_data[16];
+
+    StandardMem* memInterface;
+    StandardMemHandlers* std_mem_handlers;
+
+    const size_t max_stores;
+    const size_t max_loads;
+
+    const uint32_t max_issue_attempts_per_cycle;
+
+    uint64_t cache_line_width;
+
+    Statistic<uint64_t>* stat_store_buffer_entries;
+    Statistic<uint64_t>* stat_op_q_size;
+    Statistic<uint64_t>* stat_stores_pending;
+    Statistic<uint64_t>* stat_loads_pending;
+    Statistic<uint64_t>* stat_stores_issued;
+    Statistic<uint64_t>* stat_loads_issued;
+    Statistic<uint64_t>* stat_fences_issued;
+    Statistic<uint64_t>* stat_stores_executed;
+    Statistic<uint64_t>* stat_loads_executed;
+    Statistic<uint64_t>* stat_fences_executed;
+    Statistic<uint64_t>* stat_loads_forwarded;
+    Statistic<uint64_t>* stat_load_store_conflicts;
+    Statistic<uint64_t>* stat_stored_bytes;
+    Statistic<uint64_t>* stat_loaded_bytes;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -18,15 +18,18 @@
 
 #include <sst/core/output.h>
 #include <sst/core/subcomponent.h>
+#include <sst/core/interfaces/stdMem.h>
 
 #include "inst/regfile.h"
 #include "inst/vfence.h"
 #include "inst/vload.h"
 #include "inst/vstore.h"
+#include "lsq/vfuncmem.h"
 
 #include <cassert>
 #include <cinttypes>
 #include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #define VANADIS_DBG_LSQ_STORE_FLG  (1<<0)
@@ -57,6 +60,9 @@ public:
 
         registerFiles = nullptr;
 
+        func_mem_if = nullptr;
+        func_memory = nullptr;
+
         stat_load_issued = registerStatistic<uint64_t>("loads_issued", "1");
         stat_store_issued = registerStatistic<uint64_t>("stores_issued", "1");
         stat_data_bytes_read = registerStatistic<uint64_t>("bytes_read", "1");
@@ -93,11 +99,103 @@ public:
     
     virtual void printStatus(SST::Output& output) {}
 
+    // Side channel for functional fast-forward. The core executes loads and
+    // stores against func_memory itself and only uses the LSQ's memory
+    // interface to read lines into the image, write dirty lines back and,
+    // optionally, to touch lines so the caches stay warm. These requests do
+    // not go through the queues.
+    void setFunctionalMemory(VanadisFunctionalMemory* mem) {
+        if ( nullptr == func_mem_if ) {
+            output->fatal(CALL_INFO, -1, "Error: this load-store queue does not support functional fast-forward.\n");
+        }
+
+        func_memory = mem;
+        func_memory->setLineWidth(func_mem_if->getLineSize());
+    }
+
+    void functionalFill(const uint32_t hw_thr, const uint64_t line) {
+        Interfaces::StandardMem::Request* req = new Interfaces::StandardMem::Read(
+            line & address_mask, func_memory->getLineWidth(), 0, line, 0, hw_thr);
+
+        func_requests.insert(std::make_pair(req->getID(), FunctionalRequest(FUNC_FILL, line)));
+        func_mem_if->send(req);
+    }
+
+    void functionalWriteBack(const uint32_t hw_thr, const uint64_t line, const std::vector<uint8_t>& data) {
+        Interfaces::StandardMem::Request* req = new Interfaces::StandardMem::Write(
+            line & address_mask, data.size(), data, false, 0, line, 0, hw_thr);
+
+        func_requests.insert(std::make_pair(req->getID(), FunctionalRequest(FUNC_WRITE_BACK, line)));
+        func_mem_if->send(req);
+    }
+
+    // Dropped if too many warming reads are already in flight
+    void functionalWarm(const uint32_t hw_thr, const uint64_t address) {
+        if ( func_requests.size() >= max_func_warm_requests ) { return; }
+
+        const uint64_t line = func_memory->lineOf(address);
+        Interfaces::StandardMem::Request* req = new Interfaces::StandardMem::Read(
+            line & address_mask, func_memory->getLineWidth(), 0, line, 0, hw_thr);
+
+        func_requests.insert(std::make_pair(req->getID(), FunctionalRequest(FUNC_WARM, line)));
+        func_mem_if->send(req);
+    }
+
+    size_t functionalPending() const { return func_requests.size(); }
+
 protected:
+    // Returns true if ev answers a functional request, in which case it has
+    // been consumed
+    bool handleFunctionalResponse(Interfaces::StandardMem::Request* ev) {
+        if ( func_requests.empty() ) { return false; }
+
+        auto req_itr = func_requests.find(ev->getID());
+
+        if ( req_itr == func_requests.end() ) { return false; }
+
+        switch ( req_itr->second.type ) {
+        case FUNC_FILL:
+        {
+            Interfaces::StandardMem::ReadResp* resp = static_cast<Interfaces::StandardMem::ReadResp*>(ev);
+            func_memory->install(req_itr->second.line, resp->data, resp->getFail());
+        } break;
+        case FUNC_WRITE_BACK:
+        {
+            if ( ev->getFail() ) {
+                output->fatal(CALL_INFO, -1, "Error: functional write-back of line 0x%" PRIx64 " failed.\n",
+                    req_itr->second.line);
+            }
+        } break;
+        case FUNC_WARM:
+            break;
+        }
+
+        func_requests.erase(req_itr);
+        delete ev;
+
+        return true;
+    }
+
+    enum FunctionalRequestType { FUNC_FILL, FUNC_WRITE_BACK, FUNC_WARM };
+
+    struct FunctionalRequest {
+        FunctionalRequest(FunctionalRequestType type, uint64_t line) : type(type), line(line) {}
+
+        FunctionalRequestType type;
+        uint64_t              line;
+    };
+
+    static const size_t max_func_warm_requests = 16;
+
     uint64_t address_mask;
     std::vector<VanadisRegisterFile*>* registerFiles;
     SST::Output* output;
 
+    // Set by load-store queues which support functional fast-forward
+    Interfaces::StandardMem* func_mem_if;
+    VanadisFunctionalMemory* func_memory;
+    std::unordered_map<Interfaces::StandardMem::Request::id_t, FunctionalRequest> func_requests;
+
     Statistic<uint64_t>* stat_load_issued;
     Statistic<uint64_t>* stat_store_issued;
     Statistic<uint64_t>* stat_data_bytes_read;
@@ -13,6 +13,11 @@ vanadis_isa = os.getenv("VANADIS_ISA", "RISCV64")
 isa="riscv64"
 
 loader_mode = os.getenv("VANADIS_LOADER_MODE", "0")
+instruction_pool = os.getenv("VANADIS_INSTRUCTION_POOL", "0")
+fast_forward_instructions = os.getenv("VANADIS_FAST_FORWARD_INSTRUCTIONS", "0")
+fast_forward_until_address = os.getenv("VANADIS_FAST_FORWARD_UNTIL_ADDRESS", "0")
+fast_forward_magic_instruction = os.getenv("VANADIS_FAST_FORWARD_MAGIC_INSTRUCTION", "0")
+fast_forward_warm_caches = os.getenv("VANADIS_FAST_FORWARD_WARM_CACHES", "0")
 
 testDir="basic-io"
 exe = "hello-world"
@@ -59,8 +64,10 @@ exe_name= full_exe_name.split("/")[-1]
 
 verbosity = int(os.getenv("VANADIS_VERBOSE", 0))
 os_verbosity = os.getenv("VANADIS_OS_VERBOSE", verbosity)
+cpu_verbosity = os.getenv("VANADIS_CPU_VERBOSE", verbosity)
 pipe_trace_file = os.getenv("VANADIS_PIPE_TRACE", "")
 lsq_entries = os.getenv("VANADIS_LSQ_ENTRIES", 32)
+lsq_type = os.getenv("VANADIS_LSQ", "vanadis.VanadisBasicLoadStoreQueue")
 
 rob_slots = os.getenv("VANADIS_ROB_SLOTS", 64)
 retires_per_cycle = os.getenv("VANADIS_RETIRES_PER_CYCLE", 4)
@@ -234,7 +241,7 @@ branchPredParams = {
 
 cpuParams = {
     "clock" : cpu_clock,
-    "verbose" : verbosity,
+    "verbose" : cpu_verbosity,
     "hardware_threads": numThreads,
     "physical_fp_registers" : 168,
     "physical_int_registers" : 180,
@@ -255,6 +262,11 @@ cpuParams = {
     "start_verbose_when_issue_address": dbgAddr,
     "stop_verbose_when_retire_address": stopDbg,
     "print_rob" : False,
+    "instruction_pool" : instruction_pool,
+    "fast_forward_instructions" : fast_forward_instructions,
+    "fast_forward_until_address" : fast_forward_until_address,
+    "fast_forward_magic_instruction" : fast_forward_magic_instruction,
+    "fast_forward_warm_caches" : fast_forward_warm_caches,
 }
 
 lsqParams = {
@@ -347,7 +359,7 @@ class CPU_Builder:
             branch_pred.enableAllStatistics()
 
         # CPU.lsq
-        cpu_lsq = cpu.setSubComponent( "lsq", "vanadis.VanadisBasicLoadStoreQueue" )
+        cpu_lsq = cpu.setSubComponent( "lsq", lsq_type )
         cpu_lsq.addParams(lsqParams)
         cpu_lsq.enableAllStatistics()
 
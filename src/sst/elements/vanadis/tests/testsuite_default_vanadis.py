@@ -3,6 +3,8 @@
 from sst_unittest import *
 from sst_unittest_support import *
 from sst_unittest_parameterized import parameterized
+import re
+import struct
 import subprocess
 
 module_init = 0
@@ -33,21 +35,21 @@ def build_vanadis_test_matrix():
     #io_tests = []
     for test in io_tests:
         for arch in arch_list:
-            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300])
+            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300, False, "", ""])
 
     location="small/basic-math"
     math_tests = ["sqrt-double","sqrt-float"]
     #math_tests = []
     for test in math_tests:
         for arch in arch_list:
-            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300])
+            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300, False, "", ""])
 
     location="small/basic-ops"
     ops_tests = ["test-branch","test-shift"]
     #ops_tests = []
     for test in ops_tests:
         for arch in arch_list:
-            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300])
+            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300, False, "", ""])
 
 
     location="small/misc"
@@ -55,16 +57,63 @@ def build_vanadis_test_matrix():
     #misc_tests =[]
     for test in misc_tests:
         for arch in arch_list:
-            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300])
+            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300, False, "", ""])
 
     location="small/misc"
     misc_tests = ["fork","clone","pthread"]
     #misc_tests =[]
     for test in misc_tests:
         for arch in arch_list:
-            testlist.append(["basic_vanadis.py", location, test,arch, 2,1,300])
+            testlist.append(["basic_vanadis.py", location, test,arch, 2,1,300, False, "", ""])
+
+    # Recycled instruction objects must not change the results, so these
+    # compare against the same reference files
+    location="small/basic-io"
+    pool_tests = ["hello-world"]
+    for test in pool_tests:
+        for arch in arch_list:
+            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300, True, "", ""])
+
+    location="small/misc"
+    pool_tests = ["stream"]
+    for test in pool_tests:
+        for arch in arch_list:
+            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300, True, "", ""])
+
+    # Fast-forward through the start of the program and finish in detailed
+    # mode. The program output must not change, the statistics do. These
+    # programs print nothing that depends on timing. Each trigger is checked
+    # against the switch point the core reports, see vanadis_check_fast_forward
+    location="small/basic-ops"
+    ff_tests = ["test-branch"]
+    for test in ff_tests:
+        for arch in arch_list:
+            for trigger in ["instructions", "address", "magic"]:
+                testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300, False, trigger, ""])
+
+    location="small/basic-math"
+    ff_tests = ["sqrt-double"]
+    for test in ff_tests:
+        for arch in arch_list:
+            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300, False, "instructions_warm", ""])
 
 
+    # Store-to-load forwarding must not change the results either, though
+    # the LSQ statistics differ so only the program output is compared.
+    # splitLoad reads back each store it makes, so it also checks that
+    # loads_forwarded is non-zero (see vanadis_forwarding_tests)
+    location="small/misc"
+    lsq_tests = ["splitLoad"]
+    for test in lsq_tests:
+        for arch in arch_list:
+            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300, False, "", "VanadisForwardingLoadStoreQueue"])
+
+    location="small/basic-ops"
+    lsq_tests = ["test-branch","test-shift"]
+    for test in lsq_tests:
+        for arch in arch_list:
+            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, 300, False, "", "VanadisForwardingLoadStoreQueue"])
+
     # Process each line and crack up into an index, hash, options and sdl file
     for testnum, test_info in enumerate(testlist):
         # Make testnum start at 1
@@ -76,14 +125,77 @@ def build_vanadis_test_matrix():
         numCores = test_info[4]
         numHwThreads = test_info[5]
         timeout_sec = test_info[6]
+        instruction_pool = test_info[7]
+        fast_forward = test_info[8]
+        lsq = test_info[9]
         testname = "{0}_{1}_{2}".format(elftestdir.replace("/", "_"), elffile,isa)
+        if instruction_pool:
+            testname += "_instruction_pool"
+        if fast_forward:
+            testname += "_fast_forward_" + fast_forward
+        if lsq:
+            testname += "_" + lsq
 
         # Build the test_data structure
-        test_data = (testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec)
+        test_data = (testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec, instruction_pool, fast_forward, lsq)
         vanadis_test_matrix.append(test_data)
 
 ################################################################################
 
+# Instructions to fast-forward for the instruction count trigger
+vanadis_ff_instructions = 100000
+
+# Tests run on VanadisForwardingLoadStoreQueue whose loads must be forwarded from the store buffer
+vanadis_forwarding_tests = ["splitLoad"]
+
+# Minimal little-endian ELF reader, enough to find main() in the test binaries
+def vanadis_elf_sections(elf):
+    is_64 = (elf[4] == 2)
+    if is_64:
+        shoff, = struct.unpack_from("<Q", elf, 0x28)
+        shentsize, shnum = struct.unpack_from("<HH", elf, 0x3A)
+        fmt = "<IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from("<I", elf, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", elf, 0x2E)
+        fmt = "<IIIIIIIIII"
+
+    # name, type, flags, addr, offset, size, link, info, addralign, entsize
+    return is_64, [struct.unpack_from(fmt, elf, shoff + (i * shentsize)) for i in range(shnum)]
+
+def vanadis_elf_word(filename, address):
+    with open(filename, "rb") as fp:
+        elf = fp.read()
+
+    is_64, sections = vanadis_elf_sections(elf)
+    for (name, sh_type, flags, addr, offset, size, link, info, align, entsize) in sections:
+        # allocated and not NOBITS
+        if (flags & 0x2) and sh_type != 8 and addr <= address < addr + size:
+            return struct.unpack_from("<I", elf, offset + address - addr)[0]
+    return None
+
+def vanadis_elf_symbol_word(filename, symbol):
+    with open(filename, "rb") as fp:
+        elf = fp.read()
+
+    is_64, sections = vanadis_elf_sections(elf)
+    for (name, sh_type, flags, addr, offset, size, link, info, align, entsize) in sections:
+        # SYMTAB
+        if sh_type != 2:
+            continue
+        strtab_offset = sections[link][4]
+        for i in range(size // entsize):
+            if is_64:
+                st_name, st_info, st_other, st_shndx, st_value, st_size = struct.unpack_from("<IBBHQQ", elf, offset + (i * entsize))
+            else:
+                st_name, st_value, st_size, st_info, st_other, st_shndx = struct.unpack_from("<IIIBBH", elf, offset + (i * entsize))
+            name_start = strtab_offset + st_name
+            if elf[name_start:elf.index(b"\0", name_start)].decode() == symbol:
+                return st_value, vanadis_elf_word(filename, st_value)
+    return 0, 0
+
+################################################################################
+
 # At startup, build the test matrix
 build_vanadis_test_matrix()
 
@@ -135,20 +247,26 @@ class testcase_vanadis(SSTTestCase):
 #####
 
     @parameterized.expand(vanadis_test_matrix, name_func=gen_custom_name)
-    def test_vanadis_short_tests(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec):
+    def test_vanadis_short_tests(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec, instruction_pool, fast_forward, lsq):
         self._checkSkipConditions( isa )
 
         if MakeTests:
             self.makeTest( testname, isa, elftestdir, elffile )
         log_debug("Running Vanadis test #{0} ({1}): elffile={4} in dir {3}, isa {5}; using sdl={2}".format(testnum, testname, sdlfile, elftestdir, elffile, isa, timeout_sec))
-        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec)
+        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec, instruction_pool, fast_forward, lsq)
 
 #####
 
-    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, testtimeout=120):
+    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, testtimeout=120, instruction_pool=False, fast_forward="", lsq=""):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = "{0}/vanadis_tests/{1}/{2}/{3}".format(self.get_test_output_run_dir(), elftestdir,elffile,isa)
+        if instruction_pool:
+            outdir += "_instruction_pool"
+        if fast_forward:
+            outdir += "_fast_forward_" + fast_forward
+        if lsq:
+            outdir += "_" + lsq
         tmpdir = self.get_test_output_tmp_dir()
         os.makedirs(outdir)
 
@@ -176,6 +294,17 @@ class testcase_vanadis(SSTTestCase):
 
         os.environ['VANADIS_NUM_CORES'] = str(numCores)
         os.environ['VANADIS_NUM_HW_THREADS'] = str(numHwThreads)
+        os.environ['VANADIS_INSTRUCTION_POOL'] = "1" if instruction_pool else "0"
+        # The switch goes at the start of main() for the address and magic
+        # instruction triggers, the magic instruction being whatever is encoded there
+        ff_main_address, ff_main_word = vanadis_elf_symbol_word(testfilepath, "main") if fast_forward else (0, 0)
+        os.environ['VANADIS_FAST_FORWARD_INSTRUCTIONS'] = str(vanadis_ff_instructions) if fast_forward.startswith("instructions") else "0"
+        os.environ['VANADIS_FAST_FORWARD_UNTIL_ADDRESS'] = str(ff_main_address) if fast_forward == "address" else "0"
+        os.environ['VANADIS_FAST_FORWARD_MAGIC_INSTRUCTION'] = str(ff_main_word) if fast_forward == "magic" else "0"
+        os.environ['VANADIS_FAST_FORWARD_WARM_CACHES'] = "1" if fast_forward.endswith("_warm") else "0"
+        # the core reports its switch point at verbosity 1
+        os.environ['VANADIS_CPU_VERBOSE'] = "1" if fast_forward else "0"
+        os.environ['VANADIS_LSQ'] = "vanadis." + (lsq if lsq else "VanadisBasicLoadStoreQueue")
 
         testfile_exists = os.path.exists(testfilepath) and os.path.isfile(testfilepath)
         self.assertTrue(testfile_exists, "Vanadis test {0} does not exist".format(testfilepath))
@@ -193,7 +322,16 @@ class testcase_vanadis(SSTTestCase):
         self.assertTrue(os_outfileexists, "Vanadis test outfile-os not found in directory {0}".format(outdir))
         self.assertTrue(os_errfileexists, "Vanadis test errfile-os not found in directory {0}".format(outdir))
 
-        if ( os.path.exists( ref_sst_outfile ) ):
+        if fast_forward:
+            self.vanadis_check_fast_forward(sst_outfile, testfilepath, fast_forward, ff_main_address, ff_main_word)
+
+        if lsq == "VanadisForwardingLoadStoreQueue" and elffile in vanadis_forwarding_tests:
+            self.vanadis_check_forwarding(sst_outfile)
+
+        # Fast-forward and the other LSQs change the timing and statistics, only the program output is compared
+        if fast_forward or lsq:
+            log_testing_note("vanadis test {0} does not use the default pipeline, did not compare SST output".format(testDataFileName))
+        elif ( os.path.exists( ref_sst_outfile ) ):
             cmp_result = testing_compare_filtered_diff(testname, sst_outfile, ref_sst_outfile ,filters=[StartsWithFilter(" v0.instructions_issued.1")])
             if (cmp_result == False):
                 diffdata = testing_get_diff_data(testname)
@@ -235,6 +373,47 @@ class testcase_vanadis(SSTTestCase):
         # DEVELOPER NOTE: In the future, we may want to compare the SST output (statisics) vs some reference file
 
 
+    # The LSQ statistics are enabled by basic_vanadis.py and printed to the console
+    def vanadis_check_forwarding(self, sst_outfile):
+        with open(sst_outfile) as fp:
+            sst_output = fp.read()
+
+        stats = {}
+        for stat in ["loads_forwarded", "load_store_conflicts"]:
+            match = re.search(r":lsq\.{0}\.1 : Accumulator : Sum\.u64 = (\d+);".format(stat), sst_output)
+            self.assertTrue(match is not None, "Vanadis output file {0} does not report the LSQ statistic {1}".format(sst_outfile, stat))
+            stats[stat] = int(match.group(1))
+
+        log_debug("Vanadis forwarding LSQ: {0} loads forwarded, {1} load/store conflicts".format(stats["loads_forwarded"], stats["load_store_conflicts"]))
+        self.assertTrue(stats["loads_forwarded"] > 0, "Vanadis output file {0} reports no loads forwarded from the store buffer".format(sst_outfile))
+
+    # The core reports where it left fast-forward mode at verbosity 1
+    def vanadis_check_fast_forward(self, sst_outfile, testfilepath, fast_forward, main_address, main_word):
+        with open(sst_outfile) as fp:
+            sst_output = fp.read()
+
+        switch = re.search(r"Leaving fast-forward mode at 0x([0-9a-fA-F]+) after (\d+) instructions \(([^)]*)\)", sst_output)
+        self.assertTrue(switch is not None, "Vanadis output file {0} does not report leaving fast-forward mode".format(sst_outfile))
+
+        switch_address = int(switch.group(1), 16)
+        switch_instructions = int(switch.group(2))
+        switch_reason = switch.group(3)
+
+        if fast_forward.startswith("instructions"):
+            # a branch retires together with its delay slot, which can overshoot by one
+            self.assertEqual(switch_reason, "retired fast_forward_instructions")
+            self.assertTrue(vanadis_ff_instructions <= switch_instructions <= vanadis_ff_instructions + 1,
+                "Fast-forward switched after {0} instructions, expected {1}".format(switch_instructions, vanadis_ff_instructions))
+        elif fast_forward == "address":
+            self.assertEqual(switch_reason, "reached fast_forward_until_address")
+            self.assertEqual(switch_address, main_address)
+            self.assertTrue(switch_instructions > 0)
+        elif fast_forward == "magic":
+            # the same encoding may appear before main(), the switch is at the first one retired
+            self.assertEqual(switch_reason, "retired fast_forward_magic_instruction")
+            self.assertEqual(vanadis_elf_word(testfilepath, switch_address), main_word)
+            self.assertTrue(switch_instructions > 0)
+
 ###############################################
 
     def _checkSkipConditions(self,isa):
@@ -0,0 +1,198 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Microbenchmark for VanadisCache.  Drives the cache with the access
+// pattern of the predecode cache in the instruction loader (contains,
+// then find on a hit or store of a new line on a miss) over a stream of instruction addresses made of loops
+// with different footprints, and runs the same stream through a list
+// based LRU reference.  Hits, misses and the final contents must match
+// the reference; the time per access is reported for both.
+//
+//   make
+//   ./vcache-bench [accesses] [cache-sizes...]
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#ifndef LIKELY
+#define LIKELY(x) __builtin_expect((x), 1)
+#define UNLIKELY(x) __builtin_expect((x), 0)
+#endif
+
+#include "datastruct/vcache.h"
+
+using namespace SST::Vanadis;
+
+// LRU which searches its recency list on every access
+class ReferenceCache {
+public:
+    ReferenceCache(const size_t entries) : max_entries(entries) {}
+
+    ~ReferenceCache() {
+        for (auto itr = values.begin(); itr != values.end(); itr++) {
+            delete[] itr->second;
+        }
+    }
+
+    bool contains(const uint64_t key) const { return values.find(key) != values.end(); }
+
+    uint8_t* find(const uint64_t key) {
+        to_front(key);
+        return values.find(key)->second;
+    }
+
+    void store(const uint64_t key, uint8_t* value) {
+        if (contains(key)) {
+            to_front(key);
+            values[key] = value;
+        } else {
+            if (order.size() >= max_entries) {
+                auto lru = values.find(order.back());
+                delete[] lru->second;
+                values.erase(lru);
+                order.pop_back();
+            }
+            values.insert(std::pair<uint64_t, uint8_t*>(key, value));
+            order.push_front(key);
+        }
+    }
+
+    size_t size() const { return values.size(); }
+
+private:
+    void to_front(const uint64_t key) {
+        for (auto itr = order.begin(); itr != order.end(); itr++) {
+            if (*itr == key) {
+                order.erase(itr);
+                order.push_front(key);
+                return;
+            }
+        }
+    }
+
+    const size_t max_entries;
+    std::list<uint64_t> order;
+    std::unordered_map<uint64_t, uint8_t*> values;
+};
+
+struct Result {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t checksum;
+    double ns_per_access;
+};
+
+static const size_t line_width = 64;
+
+// Loops of 4 to 4096 instructions, each run a few times, with the loop
+// start drawn from a code region four times the largest cache
+static std::vector<uint64_t> make_stream(const size_t accesses, const size_t region) {
+    std::mt19937_64 rng(101);
+    std::vector<uint64_t> stream;
+    stream.reserve(accesses);
+
+    while (stream.size() < accesses) {
+        const uint64_t start = 0x10000 + (rng() % region) * 4;
+        const uint64_t length = 4ULL << (rng() % 11);
+        const uint64_t trips = 1 + (rng() % 8);
+
+        for (uint64_t t = 0; t < trips && stream.size() < accesses; t++) {
+            for (uint64_t i = 0; i < length && stream.size() < accesses; i++) {
+                stream.push_back(start + i * 4);
+            }
+        }
+    }
+
+    return stream;
+}
+
+template <typename C> static Result run(C& cache, const std::vector<uint64_t>& stream) {
+    Result result = { 0, 0, 0, 0.0 };
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const uint64_t addr : stream) {
+        if (cache.contains(addr)) {
+            result.checksum += cache.find(addr)[0];
+            result.hits++;
+        } else {
+            uint8_t* line = new uint8_t[line_width];
+            line[0] = (uint8_t)(addr >> 2);
+            cache.store(addr, line);
+            result.misses++;
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    result.ns_per_access = std::chrono::duration<double, std::nano>(end - start).count() / stream.size();
+
+    // Fold the surviving keys into the checksum so the contents are
+    // compared as well as the hit count
+    for (const uint64_t addr : stream) {
+        if (cache.contains(addr)) {
+            result.checksum += addr;
+        }
+    }
+
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    const size_t accesses = (argc > 1) ? std::strtoull(argv[1], nullptr, 0) : 2000000;
+
+    std::vector<size_t> sizes;
+    for (int i = 2; i < argc; i++) {
+        sizes.push_back(std::strtoull(argv[i], nullptr, 0));
+    }
+    if (sizes.empty()) {
+        sizes = { 64, 256, 1024, 4096 };
+    }
+
+    size_t largest = 0;
+    for (const size_t s : sizes) {
+        largest = (s > largest) ? s : largest;
+    }
+
+    const std::vector<uint64_t> stream = make_stream(accesses, largest * 4);
+    int failed = 0;
+
+    printf("%8s %12s %12s %14s %14s %8s\n", "entries", "hits", "misses", "ref ns/access", "ns/access", "speedup");
+
+    for (const size_t entries : sizes) {
+        ReferenceCache reference(entries);
+        VanadisCache<uint64_t, uint8_t*, VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE_ARRAY> cache(entries);
+
+        const Result ref_result = run(reference, stream);
+        const Result result = run(cache, stream);
+
+        printf("%8zu %12" PRIu64 " %12" PRIu64 " %14.2f %14.2f %7.1fx\n", entries, result.hits, result.misses,
+               ref_result.ns_per_access, result.ns_per_access, ref_result.ns_per_access / result.ns_per_access);
+
+        if (result.hits != ref_result.hits || result.misses != ref_result.misses ||
+            result.checksum != ref_result.checksum || cache.size() != reference.size()) {
+            printf("ERROR: %zu entries: cache does not match the reference (hits %" PRIu64 " vs %" PRIu64 ")\n",
+                   entries, result.hits, ref_result.hits);
+            failed = 1;
+        }
+    }
+
+    return failed;
+}
@@ -70,6 +70,37 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     print_issue_tables  = params.find<bool>("print_issue_tables", true);
     print_rob  = params.find<bool>("print_rob", true);
 
+    if ( params.find<bool>("instruction_pool", false) ) { VanadisInstructionPool::enable(); }
+
+    fast_forward_instructions      = params.find<uint64_t>("fast_forward_instructions", 0);
+    fast_forward_until_address     = params.find<uint64_t>("fast_forward_until_address", 0);
+    fast_forward_magic_instruction = params.find<uint32_t>("fast_forward_magic_instruction", 0);
+    fast_forward_ops_per_cycle     = params.find<uint32_t>("fast_forward_ops_per_cycle", 32);
+    fast_forward_warm_caches       = params.find<bool>("fast_forward_warm_caches", false);
+    ff_draining                    = false;
+    ff_hw_thr                      = 0;
+    ff_ins_retired                 = 0;
+    ff_end_address                 = 0;
+    ff_end_reason                  = "";
+    detailed_ins_retired           = 0;
+
+    fast_forward = (fast_forward_instructions > 0) || (fast_forward_until_address > 0) ||
+                   (fast_forward_magic_instruction > 0);
+    ff_configured = fast_forward;
+
+    if ( fast_forward ) {
+        if ( 0 == fast_forward_ops_per_cycle ) {
+            output->fatal(CALL_INFO, -1, "Error: fast_forward_ops_per_cycle must be at least 1.\n");
+        }
+
+        output->verbose(
+            CALL_INFO, 1, 0,
+            "Starting in fast-forward mode (instructions: %" PRIu64 ", until-address: 0x%llx, magic-instruction: "
+            "0x%08" PRIx32 ", warm caches: %s)\n",
+            fast_forward_instructions, fast_forward_until_address, fast_forward_magic_instruction,
+            fast_forward_warm_caches ? "yes" : "no");
+    }
+
     const uint16_t int_reg_count = params.find<uint16_t>("physical_integer_registers", 128);
     const uint16_t fp_reg_count  = params.find<uint16_t>("physical_fp_registers", 128);
 
@@ -115,6 +146,7 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
         }
 
         thr_decoder->setHardwareThread(i);
+        thr_decoder->setMagicInstruction(fast_forward_magic_instruction);
         thread_decoders.push_back(thr_decoder);
 
 
@@ -348,6 +380,12 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     stat_syscall_cycles       = registerStatistic<uint64_t>("syscall-cycles", "1");
     stat_int_phys_regs_in_use = registerStatistic<uint64_t>("phys_int_reg_in_use", "1");
     stat_fp_phys_regs_in_use  = registerStatistic<uint64_t>("phys_fp_reg_in_use", "1");
+    stat_ins_pool_allocs      = registerStatistic<uint64_t>("instruction_pool_allocs", "1");
+    stat_ins_pool_hits        = registerStatistic<uint64_t>("instruction_pool_hits", "1");
+    stat_ff_ins_retired       = registerStatistic<uint64_t>("fast_forward_instructions", "1");
+    stat_ff_cycles            = registerStatistic<uint64_t>("fast_forward_cycles", "1");
+    stat_ff_line_fills        = registerStatistic<uint64_t>("fast_forward_line_fills", "1");
+    stat_ff_write_backs       = registerStatistic<uint64_t>("fast_forward_write_backs", "1");
 
     //registerAsPrimaryComponent();
     //primaryComponentDoNotEndSim();
@@ -774,7 +812,7 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
                     "perform a cast to a speculated instruction.\n");
             }
 
-            stat_branches->addData(1);
+            if ( !fast_forward ) { stat_branches->addData(1); }
 
             switch ( spec_ins->getDelaySlotType() ) {
             case VANADIS_SINGLE_DELAY_SLOT:
@@ -998,7 +1036,7 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
 #endif
                 handleMisspeculate(ins_thread, pipeline_reset_addr);
 
-                stat_branch_mispredicts->addData(1);
+                if ( !fast_forward ) { stat_branch_mispredicts->addData(1); }
             }
 
             delete rob_front;
@@ -1043,7 +1081,7 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
                 // We spent this cycle waiting on an issued SYSCALL, it has not resolved
                 // at the emulated OS component yet so we have to wait, potentiallty for
                 // a lot longer
-                stat_syscall_cycles->addData(1);
+                if ( !fast_forward ) { stat_syscall_cycles->addData(1); }
 
                 return INT_MAX;
             }
@@ -1062,6 +1100,320 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
     return 0;
 }
 
+// Fast-forward is a functional mode. Instructions run one at a time in program
+// order, straight from the front of the ROB, which here is only the decoder's
+// output queue. There is no issue scan, no functional unit latency and no
+// per-cycle width limit. Renaming and retirement still go through the usual
+// tables so that detailed mode can pick up from the same state.
+//
+// Loads, stores and fences do not use the LSQ. They execute against ff_memory,
+// a sparse image of the lines this core has touched. The first touch of a line
+// reads it through the data cache, which is the only path to memory and to the
+// TLB, so the OS can fault the page in. After that the line costs no simulated
+// time. With fast_forward_warm_caches every access also sends a read to the
+// data cache that nothing waits for, so the caches see the whole access stream.
+//
+// System calls are handed to the OS as soon as they reach the front, and the
+// core waits for the reply. The OS reads and writes user memory on its own
+// path, so dirty lines are written back before the call and the image is
+// dropped. The image is private to the thread that is running, so fast-forward
+// ends when a second hardware thread starts.
+int
+VANADIS_COMPONENT::performFastForward(const uint32_t hw_thr, const uint64_t cycle)
+{
+    VanadisCircularQueue<VanadisInstruction*>* thr_rob = rob[hw_thr];
+    VanadisDecoder*                            decoder = thread_decoders[hw_thr];
+
+    ff_hw_thr = hw_thr;
+
+    for ( uint32_t i = 0; i < fast_forward_ops_per_cycle; ++i ) {
+        if ( thr_rob->empty() ) {
+            decoder->tick(output, cycle);
+
+            // waiting on the instruction cache
+            if ( thr_rob->empty() ) { return 1; }
+        }
+
+        VanadisInstruction* ins      = thr_rob->peek();
+        const uint64_t      ins_addr = ins->getInstructionAddress();
+
+        if ( UNLIKELY(
+                 (fast_forward_until_address > 0) && (ins_addr == fast_forward_until_address) &&
+                 !ins->completedIssue()) ) {
+            endFastForward("reached fast_forward_until_address", ins_addr);
+            return 1;
+        }
+
+        fastForwardIssue(ins);
+
+        // the delay slot has to execute before the branch can retire
+        if ( UNLIKELY(ins->isSpeculated()) &&
+             (((VanadisSpeculatedInstruction*)ins)->getDelaySlotType() != VANADIS_NO_DELAY_SLOT) ) {
+            if ( thr_rob->size() < 2 ) { decoder->tick(output, cycle); }
+            if ( thr_rob->size() >= 2 ) { fastForwardIssue(thr_rob->peekAt(1)); }
+        }
+
+        const uint32_t retired_before = ins_retired_this_cycle;
+        const int      retire_rc      = performRetire(thr_rob, cycle);
+
+        if ( retire_rc == INT_MAX ) { return INT_MAX; }
+
+        // waiting on a line fill or on a SYSCALL
+        if ( ins_retired_this_cycle == retired_before ) { return 1; }
+
+        ff_ins_retired += (ins_retired_this_cycle - retired_before);
+
+        if ( UNLIKELY((fast_forward_magic_instruction != 0) && decoder->isMagicInstructionAddress(ins_addr)) ) {
+            endFastForward("retired fast_forward_magic_instruction", ins_addr);
+            return 1;
+        }
+
+        if ( UNLIKELY((fast_forward_instructions > 0) && (ff_ins_retired >= fast_forward_instructions)) ) {
+            endFastForward("retired fast_forward_instructions", ins_addr);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void
+VANADIS_COMPONENT::fastForwardIssue(VanadisInstruction* ins)
+{
+    const uint32_t hw_thr = ins->getHWThread();
+
+    if ( !ins->completedIssue() ) {
+        if ( (INST_SYSCALL == ins->getInstFuncType()) && !fastForwardFlush(hw_thr) ) { return; }
+
+        // an earlier instruction may have renamed the zero register
+        const uint16_t zero_reg = isa_options[hw_thr]->getRegisterIgnoreWrites();
+
+        if ( zero_reg < isa_options[hw_thr]->countISAIntRegisters() ) {
+            register_files[hw_thr]->setIntReg<uint64_t>(issue_isa_tables[hw_thr]->getIntPhysReg(zero_reg), 0);
+        }
+
+        assignRegistersToInstruction(
+            thread_decoders[hw_thr]->countISAIntReg(), thread_decoders[hw_thr]->countISAFPReg(), ins,
+            int_register_stacks[hw_thr], fp_register_stacks[hw_thr], issue_isa_tables[hw_thr]);
+        ins->markIssued();
+
+        switch ( ins->getInstFuncType() ) {
+        case INST_NOOP:
+        case INST_FAULT:
+            ins->markExecuted();
+            break;
+        default:
+            break;
+        }
+    }
+
+    if ( ins->completedExecution() ) { return; }
+
+    switch ( ins->getInstFuncType() ) {
+    case INST_INT_ARITH:
+    case INST_INT_DIV:
+    case INST_FP_ARITH:
+    case INST_FP_DIV:
+    case INST_BRANCH:
+        ins->execute(output, register_files[hw_thr]);
+        break;
+    case INST_LOAD:
+    case INST_STORE:
+    case INST_FENCE:
+        fastForwardMemory(ins);
+        break;
+    default:
+        break;
+    }
+}
+
+// Loads and stores update the registers the same way the LSQ does when the
+// data comes back. The instruction stays unexecuted while its lines are filled.
+void
+VANADIS_COMPONENT::fastForwardMemory(VanadisInstruction* ins)
+{
+    const uint32_t       hw_thr   = ins->getHWThread();
+    VanadisRegisterFile* reg_file = register_files[hw_thr];
+
+    switch ( ins->getInstFuncType() ) {
+    case INST_LOAD:
+    {
+        VanadisLoadInstruction* load_ins = (VanadisLoadInstruction*)ins;
+
+        uint64_t load_address = 0;
+        uint16_t load_width   = 0;
+
+        load_ins->computeLoadAddress(output, reg_file, &load_address, &load_width);
+
+        // retire reports the error
+        if ( UNLIKELY(load_ins->trapsError()) ) { return; }
+
+        if ( !fastForwardLinesPresent(hw_thr, load_address, load_width) ) { return; }
+
+        if ( UNLIKELY((load_address < 64) || ff_memory.faults(load_address, load_width)) ) {
+            load_ins->flagError();
+            return;
+        }
+
+        const uint16_t reg_offset = load_ins->getRegisterOffset();
+
+        switch ( load_ins->getValueRegisterType() ) {
+        case LOAD_INT_REGISTER:
+        {
+            if ( load_ins->getISAIntRegOut(0) == isa_options[hw_thr]->getRegisterIgnoreWrites() ) { break; }
+
+            const uint16_t       target_reg = load_ins->getPhysIntRegOut(0);
+            const uint32_t       reg_width  = reg_file->getIntRegWidth();
+            std::vector<uint8_t> register_value(reg_width);
+
+            assert((reg_offset + load_width) <= reg_width);
+
+            reg_file->copyFromIntRegister(target_reg, 0, &register_value[0], reg_width);
+            ff_memory.read(load_address, load_width, &register_value[reg_offset]);
+
+            const bool negative =
+                load_ins->performSignExtension() && ((register_value[reg_offset + load_width - 1] & 0x80) != 0);
+
+            for ( uint32_t i = reg_offset + load_width; i < reg_width; ++i ) {
+                register_value[i] = negative ? 0xFF : 0x00;
+            }
+
+            reg_file->copyToIntRegister(target_reg, 0, &register_value[0], reg_width);
+        } break;
+        case LOAD_FP_REGISTER:
+        {
+            const uint16_t       target_reg = load_ins->getPhysFPRegOut(0);
+            const uint32_t       reg_width  = reg_file->getFPRegWidth();
+            std::vector<uint8_t> register_value(reg_width);
+
+            assert((reg_offset + load_width) <= reg_width);
+
+            reg_file->copyFromFPRegister(target_reg, 0, &register_value[0], reg_width);
+            ff_memory.read(load_address, load_width, &register_value[reg_offset]);
+
+            for ( uint32_t i = reg_offset + load_width; i < reg_width; ++i ) {
+                register_value[i] = 0x00;
+            }
+
+            reg_file->copyToFPRegister(target_reg, 0, &register_value[0], reg_width);
+        } break;
+        }
+
+        if ( fast_forward_warm_caches ) { lsq->functionalWarm(hw_thr, load_address); }
+
+        load_ins->markExecuted();
+    } break;
+    case INST_STORE:
+    {
+        VanadisStoreInstruction* store_ins = (VanadisStoreInstruction*)ins;
+
+        uint64_t store_address = 0;
+        uint16_t store_width   = 0;
+
+        store_ins->computeStoreAddress(output, reg_file, &store_address, &store_width);
+
+        if ( UNLIKELY(store_ins->trapsError()) ) {
+            store_ins->markExecuted();
+            return;
+        }
+
+        if ( !fastForwardLinesPresent(hw_thr, store_address, store_width) ) { return; }
+
+        if ( UNLIKELY((store_address < 4096) || ff_memory.faults(store_address, store_width)) ) {
+            store_ins->flagError();
+            return;
+        }
+
+        const bool           is_fp = (store_ins->getValueRegisterType() == STORE_FP_REGISTER);
+        std::vector<uint8_t> payload(store_width);
+
+        reg_file->copyFromRegister(
+            is_fp ? store_ins->getPhysFPRegIn(0) : store_ins->getPhysIntRegIn(1), store_ins->getRegisterOffset(),
+            &payload[0], store_width, is_fp);
+        ff_memory.write(store_address, store_width, &payload[0]);
+
+        // only one thread runs in fast-forward, so nothing can break the link
+        if ( store_ins->getTransactionType() == MEM_TRANSACTION_LLSC_STORE ) {
+            VanadisStoreConditionalInstruction* store_cond_ins =
+                dynamic_cast<VanadisStoreConditionalInstruction*>(store_ins);
+
+            if ( UNLIKELY(nullptr == store_cond_ins) ) {
+                output->fatal(CALL_INFO, -1, "Unable to cast an LLSC_STORE into a store-conditional, logic failure.\n");
+            }
+
+            reg_file->setIntReg<int64_t>(store_ins->getPhysIntRegOut(0), store_cond_ins->getResultSuccess());
+        }
+
+        if ( fast_forward_warm_caches ) { lsq->functionalWarm(hw_thr, store_address); }
+
+        store_ins->markExecuted();
+    } break;
+    case INST_FENCE:
+        // every access has already completed
+        ins->markExecuted();
+        break;
+    default:
+        break;
+    }
+}
+
+// Starts a fill for any line of the access that is not in the image yet
+bool
+VANADIS_COMPONENT::fastForwardLinesPresent(const uint32_t hw_thr, const uint64_t address, const uint64_t width)
+{
+    ff_missing_lines.clear();
+
+    if ( ff_memory.contains(address, width, ff_missing_lines) ) { return true; }
+
+    for ( const uint64_t line : ff_missing_lines ) {
+        lsq->functionalFill(hw_thr, line);
+        stat_ff_line_fills->addData(1);
+    }
+
+    return false;
+}
+
+// Writes the dirty lines back and drops the image. Returns true once nothing
+// is in flight and the image is empty.
+bool
+VANADIS_COMPONENT::fastForwardFlush(const uint32_t hw_thr)
+{
+    if ( ff_memory.isDirty() ) {
+        ff_memory.flush([this, hw_thr](const uint64_t line, const std::vector<uint8_t>& data) {
+            lsq->functionalWriteBack(hw_thr, line, data);
+            stat_ff_write_backs->addData(1);
+        });
+    }
+
+    if ( lsq->functionalPending() > 0 ) { return false; }
+
+    ff_memory.invalidate();
+    return true;
+}
+
+// Detailed mode starts once the image has been written back, see tick
+void
+VANADIS_COMPONENT::endFastForward(const char* reason, const uint64_t address)
+{
+    ff_draining    = true;
+    ff_end_reason  = reason;
+    ff_end_address = address;
+}
+
+void
+VANADIS_COMPONENT::leaveFastForward()
+{
+    fast_forward = false;
+    ff_draining  = false;
+    ff_host_end  = std::chrono::steady_clock::now();
+
+    output->verbose(
+        CALL_INFO, 1, 0,
+        "Leaving fast-forward mode at 0x%" PRIx64 " after %" PRIu64 " instructions (%s), switching to detailed "
+        "mode at cycle %" PRIu64 ".\n",
+        ff_end_address, ff_ins_retired, ff_end_reason, current_cycle);
+}
+
 bool
 VANADIS_COMPONENT::mapInstructiontoFunctionalUnit(
     VanadisInstruction* ins, std::vector<VanadisFunctionalUnit*>& functional_units)
@@ -1178,6 +1530,40 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
         return true;
     }
 
+    if ( fast_forward ) {
+        stat_ff_cycles->addData(1);
+        ins_retired_this_cycle = 0;
+
+        uint32_t running_threads = 0;
+        for ( uint32_t i = 0; i < hw_threads; ++i ) {
+            if ( !halted_masks[i] ) { running_threads++; }
+        }
+
+        // a clone or fork started another thread on this core
+        if ( UNLIKELY((running_threads > 1) && !ff_draining) ) {
+            endFastForward("another hardware thread started", 0);
+        }
+
+        bool tick_return = false;
+        for ( uint32_t i = 0; i < hw_threads; ++i ) {
+            if ( ff_draining ) { break; }
+
+            if ( !halted_masks[i] && (performFastForward(i, cycle) == INT_MAX) ) { tick_return = true; }
+        }
+
+        if ( ff_draining && fastForwardFlush(ff_hw_thr) ) { leaveFastForward(); }
+
+        stat_ff_ins_retired->addData(ins_retired_this_cycle);
+        current_cycle++;
+
+        if ( current_cycle >= max_cycle ) {
+            output->verbose(CALL_INFO, 1, 0, "Reached maximum cycle %" PRIu64 ". Core stops processing.\n", current_cycle);
+            return true;
+        }
+
+        return tick_return;
+    }
+
 #ifdef VANADIS_BUILD_DEBUG
     const auto output_verbosity = output->getVerboseLevel();
 #endif
@@ -1333,6 +1719,7 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
 
     // Record how many instructions we retired this cycle
     stat_ins_retired->addData(ins_retired_this_cycle);
+    detailed_ins_retired += ins_retired_this_cycle;
 
     uint64_t rob_total_count = 0;
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
@@ -1722,11 +2109,43 @@ VANADIS_COMPONENT::recoverRetiredRegisters(
 
 void
 VANADIS_COMPONENT::setup()
-{}
+{
+    // the line width is known once the memory system has initialized
+    if ( fast_forward ) {
+        lsq->setFunctionalMemory(&ff_memory);
+        ff_host_start = std::chrono::steady_clock::now();
+    }
+}
 
 void
 VANADIS_COMPONENT::finish()
-{}
+{
+    // The counters belong to the thread, so only the first core to finish
+    // on each thread records them
+    if ( VanadisInstructionPool::isEnabled() && VanadisInstructionPool::claimThreadReport() ) {
+        const VanadisInstructionPool::Counters& pool = VanadisInstructionPool::getCounters();
+        stat_ins_pool_allocs->addData(pool.requests);
+        stat_ins_pool_hits->addData(pool.hits);
+    }
+
+    // Host time covers the whole simulation, not only this core, so the
+    // rates are only comparable within one run and are not reported by default
+    if ( ff_configured && !fast_forward && (output->getVerboseLevel() >= 2) ) {
+        const double ff_seconds = std::chrono::duration<double>(ff_host_end - ff_host_start).count();
+        const double detailed_seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - ff_host_end).count();
+
+        const double ff_rate       = (ff_seconds > 0) ? (ff_ins_retired / ff_seconds) : 0;
+        const double detailed_rate = (detailed_seconds > 0) ? (detailed_ins_retired / detailed_seconds) : 0;
+
+        output->verbose(
+            CALL_INFO, 2, 0,
+            "Fast-forward: %" PRIu64 " instructions in %.3f s (%.0f instructions/s), detailed: %" PRIu64
+            " instructions in %.3f s (%.0f instructions/s), fast-forward speedup: %.1fx\n",
+            ff_ins_retired, ff_seconds, ff_rate, detailed_ins_retired, detailed_seconds, detailed_rate,
+            (detailed_rate > 0) ? (ff_rate / detailed_rate) : 0);
+    }
+}
 
 void
 VANADIS_COMPONENT::printStatus(SST::Output& output)
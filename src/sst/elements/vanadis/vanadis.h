@@ -24,6 +24,8 @@
 #include "inst/vinst.h"
 #include "lsq/vlsq.h"
 #include "lsq/vbasiclsq.h"
+#include "lsq/vfwdlsq.h"
+#include "lsq/vfuncmem.h"
 #include "velf/velfinfo.h"
 #include "vfpflags.h"
 #include "vfuncunit.h"
@@ -32,6 +34,7 @@
 #include "os/vdumpregsreq.h"
 
 #include <array>
+#include <chrono>
 #include <limits>
 #include <set>
 #include <sst/core/component.h>
@@ -136,7 +139,19 @@ public:
         { "print_issue_tables", "Print registers during issue step (default is yes)" },
         { "print_int_reg", "Print integer registers true/false, auto set to true if verbose > 16" },
         { "print_fp_reg", "Print floating-point registers true/false, auto set to "
-                          "true if verbose > 16" })
+                          "true if verbose > 16" },
+        { "instruction_pool", "Recycle instruction objects instead of freeing them at retire and pipeline clear. "
+                              "Turning this on in any core enables it for the whole simulation", "false" },
+        { "fast_forward_instructions", "Start in fast-forward mode and switch to detailed mode once this many "
+                                       "instructions have retired, 0 is no limit", "0" },
+        { "fast_forward_until_address", "Start in fast-forward mode and switch to detailed mode when the instruction "
+                                        "at this address is next to execute, 0 is none", "0" },
+        { "fast_forward_magic_instruction", "Start in fast-forward mode and switch to detailed mode after an "
+                                            "instruction with this encoding retires, 0 is none", "0" },
+        { "fast_forward_ops_per_cycle", "Instructions per thread executed each cycle in fast-forward mode", "32" },
+        { "fast_forward_warm_caches", "In fast-forward mode, also send a read for the line of every load and store "
+                                      "to the data cache so that the caches stay warm. Nothing waits for these reads",
+          "false" })
 
     SST_ELI_DOCUMENT_STATISTICS(
         { "cycles", "Number of cycles the core executed", "cycles", 1 },
@@ -155,7 +170,22 @@ public:
         { "stores_issued", "Number of store instructions issued to the LSQ", "instructions", 1 },
         { "phys_int_reg_in_use", "Number of physical integer registers that are in use each cycle", "registers", 1 },
         { "phys_fp_reg_in_use", "Number of physical floating point registers than are in use each cycle", "registers",
-          1 })
+          1 },
+        { "instruction_pool_allocs",
+          "With instruction_pool, instruction and register array allocations made by the thread this core runs on. "
+          "The pool is per thread, so this is recorded at end of simulation by only one core per thread",
+          "allocations", 5 },
+        { "instruction_pool_hits",
+          "With instruction_pool, allocations on this thread served from recycled instructions. Hit rate is "
+          "instruction_pool_hits / instruction_pool_allocs. Recorded once per thread",
+          "allocations", 5 },
+        { "fast_forward_instructions", "Number of instructions retired in fast-forward mode. These are not counted "
+                                       "in instructions_retired", "instructions", 5 },
+        { "fast_forward_cycles", "Number of cycles spent in fast-forward mode. These are not counted in cycles",
+          "cycles", 5 },
+        { "fast_forward_line_fills", "Number of lines read into the fast-forward memory image", "lines", 5 },
+        { "fast_forward_write_backs", "Number of dirty lines written back from the fast-forward memory image", "lines",
+          5 })
 
     SST_ELI_DOCUMENT_PORTS({ "icache_link", "Connects the CPU to the instruction cache", {} },
                            { "dcache_link", "Connects the CPU to the data cache", {} },
@@ -231,6 +261,13 @@ private:
     int  performIssue(const uint64_t cycle, uint32_t& rob_start, bool& unallocated_memory_op_seen);
     int  performExecute(const uint64_t cycle);
     int  performRetire(VanadisCircularQueue<VanadisInstruction*>* rob, const uint64_t cycle);
+    int  performFastForward(const uint32_t hw_thr, const uint64_t cycle);
+    void fastForwardIssue(VanadisInstruction* ins);
+    void fastForwardMemory(VanadisInstruction* ins);
+    bool fastForwardLinesPresent(const uint32_t hw_thr, const uint64_t address, const uint64_t width);
+    bool fastForwardFlush(const uint32_t hw_thr);
+    void endFastForward(const char* reason, const uint64_t address);
+    void leaveFastForward();
     int  allocateFunctionalUnit(VanadisInstruction* ins);
     bool mapInstructiontoFunctionalUnit(VanadisInstruction* ins, std::vector<VanadisFunctionalUnit*>& functional_units);
     void printRob(VanadisCircularQueue<VanadisInstruction*>* rob);
@@ -306,6 +343,12 @@ private:
     Statistic<uint64_t>* stat_syscall_cycles;
     Statistic<uint64_t>* stat_int_phys_regs_in_use;
     Statistic<uint64_t>* stat_fp_phys_regs_in_use;
+    Statistic<uint64_t>* stat_ins_pool_allocs;
+    Statistic<uint64_t>* stat_ins_pool_hits;
+    Statistic<uint64_t>* stat_ff_ins_retired;
+    Statistic<uint64_t>* stat_ff_cycles;
+    Statistic<uint64_t>* stat_ff_line_fills;
+    Statistic<uint64_t>* stat_ff_write_backs;
 
     uint32_t ins_issued_this_cycle;
     uint32_t ins_retired_this_cycle;
@@ -315,6 +358,28 @@ private:
     uint64_t start_verbose_when_issue_address;
     uint64_t stop_verbose_when_retire_address;
 
+    // Fast-forward mode, see performFastForward
+    bool        fast_forward;
+    uint64_t    fast_forward_instructions;
+    uint64_t    fast_forward_until_address;
+    uint32_t    fast_forward_magic_instruction;
+    uint32_t    fast_forward_ops_per_cycle;
+    bool        fast_forward_warm_caches;
+    bool        ff_configured;
+    bool        ff_draining;
+    uint32_t    ff_hw_thr;
+    uint64_t    ff_ins_retired;
+    uint64_t    ff_end_address;
+    const char* ff_end_reason;
+
+    VanadisFunctionalMemory ff_memory;
+    std::vector<uint64_t>   ff_missing_lines;
+
+    // Host time, to report how much faster fast-forward runs than detailed mode
+    std::chrono::steady_clock::time_point ff_host_start;
+    std::chrono::steady_clock::time_point ff_host_end;
+    uint64_t                              detailed_ins_retired;
+
     std::vector<VanadisFloatingPointFlags*> fp_flags;
 
     SST::Link* os_link;